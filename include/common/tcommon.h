@@ -275,6 +275,7 @@ typedef struct SQueryTableDataCond {
   int64_t      startVersion;
   int64_t      endVersion;
   bool         notLoadData;  // response the actual data, not only the rows in the attribute of info.row of ssdatablock
+  int32_t      prefetchBlocks;  // number of file blocks to read ahead, 0 to disable
 } SQueryTableDataCond;
 
 int32_t tEncodeDataBlock(void** buf, const SSDataBlock* pBlock);
@@ -383,8 +384,16 @@ typedef struct SSortExecInfo {
   int32_t loops;       // loop count
   int32_t writeBytes;  // write io bytes
   int32_t readBytes;   // read io bytes
+  int64_t stallTime;   // time in us blocked by the spill io
+  int32_t sortThreads; // threads sorting the runs before they are spilled
 } SSortExecInfo;
 
+typedef struct SSpillExecInfo {
+  int64_t writeBytes;  // bytes of the pages flushed to disk
+  int64_t readBytes;   // bytes of the pages loaded from disk
+  int64_t stallTime;   // time in us blocked by the spill io
+} SSpillExecInfo;
+
 typedef struct SNonSortExecInfo {
   int32_t blkNums;
 } SNonSortExecInfo;
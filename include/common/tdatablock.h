@@ -229,6 +229,11 @@ double blockDataGetSerialRowSize(const SSDataBlock* pBlock);
 size_t blockDataGetSerialMetaSize(uint32_t numOfCols);
 
 int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo);
+// encode the sort key of each row into an unsigned integer in the same order, rows with equal integers still need to
+// be compared by the sort key, return false if the type of the sort key can not be encoded
+bool    blockDataBuildSortKeyPrefix(const SSDataBlock* pBlock, const SBlockOrderInfo* pOrder, uint64_t* pKeys);
+// move the row index[i] to the position i, for all the rows of the block
+int32_t blockDataReorder(SSDataBlock* pDataBlock, const int32_t* index);
 /**
  * @brief find how many rows already in order start from first row
  */
@@ -61,6 +61,7 @@ extern char     tsEncryptKey[];
 extern int32_t tsMaxShellConns;
 extern int32_t tsShellActivityTimer;
 extern int32_t tsCompressMsgSize;
+extern int32_t tsCompressMsgType;
 extern int64_t tsTickPerMin[3];
 extern int64_t tsTickPerHour[3];
 extern int32_t tsCountAlwaysReturnValue;
@@ -86,12 +87,15 @@ extern int32_t tsNumOfQnodeFetchThreads;
 extern int32_t tsNumOfSnodeStreamThreads;
 extern int32_t tsNumOfSnodeWriteThreads;
 extern int64_t tsRpcQueueMemoryAllowed;
+extern int64_t tsVnodeQueueMemoryAllowed;
+extern int32_t tsQueueMemoryWaitMs;
 
 // sync raft
 extern int32_t tsElectInterval;
 extern int32_t tsHeartbeatInterval;
 extern int32_t tsHeartbeatTimeout;
 extern int32_t tsSnapReplMaxWaitN;
+extern bool    tsSyncAsyncPersist;
 
 // arbitrator
 extern int32_t tsArbHeartBeatIntervalSec;
@@ -161,6 +165,9 @@ extern int32_t tsQueryRspPolicy;
 extern int64_t tsQueryMaxConcurrentTables;
 extern int32_t tsQuerySmaOptimize;
 extern int32_t tsQueryRsmaTolerance;
+extern int32_t tsQueryPrefetchBlocks;
+extern int32_t tsQuerySortThreads;
+extern bool    tsQuerySpillWriteBehind;
 extern bool    tsQueryPlannerTrace;
 extern int32_t tsQueryNodeChunkSize;
 extern bool    tsQueryUseNodeAllocator;
@@ -1622,16 +1622,38 @@ typedef struct {
   uint32_t encryptionKeyChksum;
 } SClusterCfg;
 
-typedef struct {
-  int32_t openVnodes;
-  int32_t totalVnodes;
-  int32_t masterNum;
-  int64_t numOfSelectReqs;
-  int64_t numOfInsertReqs;
-  int64_t numOfInsertSuccessReqs;
-  int64_t numOfBatchInsertReqs;
-  int64_t numOfBatchInsertSuccessReqs;
-  int64_t errors;
+#define VNODE_ASYNC_PRIORITIES      3   // high, normal and low
+#define VNODE_ASYNC_LATENCY_BUCKETS 16  // tasks with latency in [0, 1ms), [1ms, 2ms), [2ms, 4ms) ... [2^14ms, +inf)
+
+typedef struct {
+  int64_t numOfTasks[VNODE_ASYNC_PRIORITIES];
+  int64_t waitTime[VNODE_ASYNC_PRIORITIES];  // us, from the task is submitted to it starts running
+  int64_t runTime[VNODE_ASYNC_PRIORITIES];   // us
+  int64_t waitBuckets[VNODE_ASYNC_PRIORITIES][VNODE_ASYNC_LATENCY_BUCKETS];
+  int64_t runBuckets[VNODE_ASYNC_PRIORITIES][VNODE_ASYNC_LATENCY_BUCKETS];
+} SVAsyncStat;
+
+#define VNODE_QUEUE_TYPES 7  // write, sync, sync-rd, apply, query, fetch and stream
+
+typedef struct {
+  int64_t memory;      // bytes of the items in the queues of all vnodes
+  int64_t memoryPeak;  // high-water mark of a single queue since last report
+  int64_t rejects;     // items rejected since last report
+} SVQueueStat;
+
+typedef struct {
+  int32_t     openVnodes;
+  int32_t     totalVnodes;
+  int32_t     masterNum;
+  int64_t     numOfSelectReqs;
+  int64_t     numOfInsertReqs;
+  int64_t     numOfInsertSuccessReqs;
+  int64_t     numOfBatchInsertReqs;
+  int64_t     numOfBatchInsertSuccessReqs;
+  int64_t     errors;
+  SVAsyncStat commitStat;  // tasks of the vnode-commit pool
+  SVAsyncStat mergeStat;   // tasks of the vnode-merge pool
+  SVQueueStat queueStat[VNODE_QUEUE_TYPES];
 } SVnodesStat;
 
 typedef struct {
@@ -2179,6 +2201,7 @@ typedef struct STableScanAnalyzeInfo {
   uint32_t filterOutBlocks;
   double   elapsedTime;
   double   filterTime;
+  uint64_t runtimeFilterRows;  // rows dropped by the runtime filter pushed down by join
 } STableScanAnalyzeInfo;
 
 int32_t tSerializeSExplainRsp(void* buf, int32_t bufLen, SExplainRsp* pRsp);
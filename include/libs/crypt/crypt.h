@@ -16,6 +16,7 @@
 #ifndef _CRYPT_H_
 #define _CRYPT_H_
 #include "tdef.h"
+#include "sm4.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -29,9 +30,26 @@ typedef struct SCryptOpts{
   unsigned char  key[17];
 }SCryptOpts;
 
+typedef struct SCryptKey {
+  unsigned char key[17];
+  SM4_KEY       ctx;  // key schedule expanded once by CBC_InitKey
+} SCryptKey;
+
 int32_t CBC_Decrypt(SCryptOpts *opts);
 int32_t CBC_Encrypt(SCryptOpts *opts);
 
+/**
+ * Expand the key once, so that it can be shared by the following page calls on the same file.
+ */
+int32_t CBC_InitKey(SCryptKey *pKey, const char *key);
+
+/**
+ * Encrypt/decrypt a page of len bytes in place with SM4 CBC, unit by unit of unitLen bytes (a multiple of 16), each
+ * unit chained from the same IV. Return the number of bytes processed, or -1 if unitLen is invalid.
+ */
+int32_t CBC_EncryptPage(const SCryptKey *pKey, char *page, int32_t len, int32_t unitLen);
+int32_t CBC_DecryptPage(const SCryptKey *pKey, char *page, int32_t len, int32_t unitLen);
+
 #ifdef __cplusplus
 }
 #endif
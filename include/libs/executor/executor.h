@@ -185,6 +185,17 @@ void qDestroyTask(qTaskInfo_t tinfo);
 
 void qProcessRspMsg(void* parent, struct SRpcMsg* pMsg, struct SEpSet* pEpSet);
 
+/**
+ * start the background workers shared by all the query tasks
+ * @return
+ */
+int32_t qInitExecWorkers();
+
+/**
+ * stop the shared background workers, all the query tasks should have been destroyed
+ */
+void qCleanupExecWorkers();
+
 int32_t qGetExplainExecInfo(qTaskInfo_t tinfo, SArray* pExecInfoList);
 
 void getNextTimeWindow(const SInterval* pInterval, STimeWindow* tw, int32_t order);
@@ -25,6 +25,10 @@
 extern "C" {
 #endif
 
+typedef struct {
+    unsigned int rk[32];  // round keys
+} SM4_KEY;
+
 int SM4_ECB_Encrypt( unsigned char *pKey, 
                       unsigned int KeyLen, 
                       unsigned char *pInData,
@@ -56,6 +60,15 @@ int SM4_CBC_Decrypt(unsigned char *pKey,
                     unsigned int inDataLen,
                     unsigned char *pOutData, 
                     unsigned int *pOutDataLen);
+
+/* expand the 16 bytes key to the round keys, which can be shared by the following calls */
+void SM4_Set_Key(SM4_KEY *pCtx, const unsigned char *pKey);
+
+/* encrypt/decrypt pData of dataLen bytes in place, dataLen should be a multiple of 16 */
+int SM4_CBC_Encrypt_Ex(const SM4_KEY *pCtx, const unsigned char *pIV, unsigned char *pData, unsigned int dataLen);
+
+int SM4_CBC_Decrypt_Ex(const SM4_KEY *pCtx, const unsigned char *pIV, unsigned char *pData, unsigned int dataLen);
+
 #ifdef __cplusplus
 }
 #endif
@@ -51,10 +51,11 @@ extern "C" {
 
 #define SYNC_VND_COMMIT_MIN_MS 3000
 
-#define SYNC_MAX_BATCH_SIZE 1
-#define SYNC_INDEX_BEGIN    0
-#define SYNC_INDEX_INVALID  -1
-#define SYNC_TERM_INVALID   -1
+#define SYNC_MAX_BATCH_SIZE  64                // max raft entries in one append entries msg or wal write
+#define SYNC_MAX_BATCH_BYTES (4 * 1024 * 1024)  // soft limit of the entry bytes in one append entries msg
+#define SYNC_INDEX_BEGIN     0
+#define SYNC_INDEX_INVALID   -1
+#define SYNC_TERM_INVALID    -1
 
 #define SYNC_LEARNER_CATCHUP 10
 
@@ -226,6 +227,8 @@ typedef struct SSyncLogStore {
   SyncTerm (*syncLogLastTerm)(struct SSyncLogStore* pLogStore);
 
   int32_t (*syncLogAppendEntry)(struct SSyncLogStore* pLogStore, SSyncRaftEntry* pEntry, bool forcSync);
+  int32_t (*syncLogAppendEntries)(struct SSyncLogStore* pLogStore, SSyncRaftEntry** ppEntries, int32_t num,
+                                  bool forcSync);
   int32_t (*syncLogGetEntry)(struct SSyncLogStore* pLogStore, SyncIndex index, SSyncRaftEntry** ppEntry);
   int32_t (*syncLogTruncate)(struct SSyncLogStore* pLogStore, SyncIndex fromIndex);
 
@@ -98,6 +98,7 @@ typedef struct SRpcInit {
   int32_t failFastInterval;
 
   int32_t compressSize;  // -1: no compress, 0 : all data compressed, size: compress data if larger than size
+  int8_t  compressType;  // codec of the compressed msgs sent to this end, 1(default): lz4, 2: zstd
   int8_t  encryption;    // encrypt or not
 
   // the following is for client app ecurity only
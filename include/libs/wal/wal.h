@@ -100,6 +100,27 @@ typedef struct {
 } SWalCkHead;
 #pragma pack(pop)
 
+typedef struct {
+  int64_t      index;
+  tmsg_t       msgType;
+  SWalSyncInfo syncMeta;
+  const void  *body;
+  int32_t      bodyLen;
+} SWalAppendEntry;
+
+#define WAL_STAT_HIST_BUCKETS 16  // bucket i counts the values in [2^(i-1), 2^i), and the last one the larger ones
+
+typedef struct {
+  int64_t numOfGroups;
+  int64_t numOfEntries;
+  int64_t numOfFsyncs;
+  int64_t fsyncUs;
+  int64_t groupSizeHist[WAL_STAT_HIST_BUCKETS];     // entries written by one group
+  int64_t fsyncLatencyHist[WAL_STAT_HIST_BUCKETS];  // fsync latency in us
+} SWalWriteStat;
+
+struct SWalGroupBuf;
+
 typedef struct SWal {
   // cfg
   SWalCfg cfg;
@@ -122,6 +143,9 @@ typedef struct SWal {
   SHashObj *pRefHash;  // refId -> SWalRef
   // path
   char path[WAL_PATH_LEN];
+  // reusable buffers for group writes
+  struct SWalGroupBuf *pGroupBuf;
+  SWalWriteStat        writeStat;
   // reusable write head
   SWalCkHead writeHead;
 } SWal;
@@ -179,7 +203,12 @@ int32_t walWriteWithSyncInfo(SWal *, int64_t index, tmsg_t msgType, SWalSyncInfo
 // -1 will be returned for failed writes
 int64_t walAppendLog(SWal *, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta, const void *body, int32_t bodyLen);
 
+// Append entries of consecutive indexes as a group, the log and the index are written with one vectored write each,
+// and at most one fsync is done for the whole group. The last index appended is returned, or -1 for failed writes.
+int64_t walAppendLogs(SWal *, const SWalAppendEntry *pEntries, int32_t num, bool forceFsync);
+
 void walFsync(SWal *, bool force);
+void walGetWriteStat(SWal *, SWalWriteStat *pStat);
 
 // apis for lifecycle management
 int32_t walCommit(SWal *, int64_t ver);
@@ -54,6 +54,13 @@ extern "C" {
 
 typedef struct TdFile *TdFilePtr;
 
+typedef struct {
+  void   *base;
+  int64_t len;
+} TdFileIovec;
+
+#define TD_FILE_IOV_MAX 256  // max number of buffers passed to the system by one vectored io call
+
 #define TD_FILE_CREATE        0x0001
 #define TD_FILE_WRITE         0x0002
 #define TD_FILE_READ          0x0004
@@ -90,7 +97,10 @@ int32_t taosFsyncFile(TdFilePtr pFile);
 
 int64_t taosReadFile(TdFilePtr pFile, void *buf, int64_t count);
 int64_t taosPReadFile(TdFilePtr pFile, void *buf, int64_t count, int64_t offset);
+int64_t taosPReadvFile(TdFilePtr pFile, const TdFileIovec *iov, int32_t iovcnt, int64_t offset);
+int32_t taosPrefetchFile(TdFilePtr pFile, int64_t offset, int64_t count);
 int64_t taosWriteFile(TdFilePtr pFile, const void *buf, int64_t count);
+int64_t taosWritevFile(TdFilePtr pFile, const TdFileIovec *iov, int32_t iovcnt);
 int64_t taosPWriteFile(TdFilePtr pFile, const void *buf, int64_t count, int64_t offset);
 void    taosFprintfFile(TdFilePtr pFile, const char *format, ...);
 
@@ -42,6 +42,12 @@ int32_t BUILDIN_CTZ(uint32_t val);
 #define BUILDIN_CTZ(val)  __builtin_ctz(val)
 #endif
 
+#ifdef WINDOWS
+#define BUILDIN_PREFETCH(addr)
+#else
+#define BUILDIN_PREFETCH(addr) __builtin_prefetch(addr)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -152,12 +152,70 @@ int32_t tsDecompressBigint(void *pIn, int32_t nIn, int32_t nEle, void *pOut, int
 // for internal usage
 int32_t getWordLength(char type);
 
-int32_t tsDecompressIntImpl_Hw(const char *const input, const int32_t nelements, char *const output, const char type);
-int32_t tsDecompressFloatImplAvx512(const char *const input, const int32_t nelements, char *const output);
-int32_t tsDecompressFloatImplAvx2(const char *const input, const int32_t nelements, char *const output);
+int32_t tsDecompressIntImpl_Scalar(const char *const input, const int32_t nelements, char *const output,
+                                   const char type);
+int32_t tsDecompressIntImplAvx2(const char *const input, const int32_t nelements, char *const output, const char type);
+int32_t tsDecompressIntImplAvx512(const char *const input, const int32_t nelements, char *const output,
+                                  const char type);
+int32_t tsDecompressFloatImpl_Scalar(const char *const input, const int32_t nelements, char *const output);
+int32_t tsDecompressTimestampImpl_Scalar(const char *const input, const int32_t nelements, char *const output,
+                                         bool bigEndian);
+int32_t tsDecompressTimestampSse42(const char *const input, const int32_t nelements, char *const output,
+                                   bool bigEndian);
 int32_t tsDecompressTimestampAvx512(const char *const input, const int32_t nelements, char *const output,
                                     bool bigEndian);
-int32_t tsDecompressTimestampAvx2(const char *const input, const int32_t nelements, char *const output, bool bigEndian);
+
+int32_t tsCompressIntImpl_Scalar(const char *const input, const int32_t nelements, char *const output, const char type);
+int32_t tsCompressTimestampImpl_Scalar(const char *const input, const int32_t nelements, char *const output);
+int32_t tsCompressFloatImpl_Scalar(const char *const input, const int32_t nelements, char *const output);
+int32_t tsCompressDoubleImpl_Scalar(const char *const input, const int32_t nelements, char *const output);
+int32_t tsCompressIntImplAvx2(const char *const input, const int32_t nelements, char *const output, const char type);
+int32_t tsCompressTimestampImplAvx2(const char *const input, const int32_t nelements, char *const output);
+int32_t tsCompressFloatImplAvx2(const char *const input, const int32_t nelements, char *const output);
+int32_t tsCompressDoubleImplAvx2(const char *const input, const int32_t nelements, char *const output);
+
+/*************************************************************************
+ *                  COMPRESS KERNEL DISPATCH
+ *************************************************************************/
+// The SIMD kernels are compiled with per-function target attributes, so one binary carries all of them and the
+// kernel set is picked by tsInitCompressKernels on the first use of the codecs in the process, according to the cpu
+// features detected at startup and simdEnable.
+typedef enum {
+  COMPRESS_KERNEL_SCALAR = 0,
+  COMPRESS_KERNEL_SSE42,
+  COMPRESS_KERNEL_AVX2,
+  COMPRESS_KERNEL_AVX512,
+  COMPRESS_KERNEL_MAX,
+} ECompressKernel;
+
+typedef struct {
+  const char *name;
+  int32_t (*decompressInt)(const char *const input, const int32_t nelements, char *const output, const char type);
+  int32_t (*decompressTimestamp)(const char *const input, const int32_t nelements, char *const output,
+                                 bool bigEndian);
+  int32_t (*decompressFloat)(const char *const input, const int32_t nelements, char *const output);
+} SDecompressKernel;
+
+// the encoders of all kernels produce byte-identical output, only the speed differs.
+typedef struct {
+  const char *name;
+  int32_t (*compressInt)(const char *const input, const int32_t nelements, char *const output, const char type);
+  int32_t (*compressTimestamp)(const char *const input, const int32_t nelements, char *const output);
+  int32_t (*compressFloat)(const char *const input, const int32_t nelements, char *const output);
+  int32_t (*compressDouble)(const char *const input, const int32_t nelements, char *const output);
+} SCompressKernel;
+
+extern const SDecompressKernel *tsDecompressKernel;
+extern const SCompressKernel   *tsCompressKernel;
+
+void                     tsInitCompressKernels();
+bool                     tsCompressKernelSupported(ECompressKernel kernel);
+const SDecompressKernel *tsGetDecompressKernel(ECompressKernel kernel);
+int32_t                  tsSetDecompressKernel(ECompressKernel kernel);
+ECompressKernel          tsSelectDecompressKernel();
+const SCompressKernel   *tsGetCompressKernel(ECompressKernel kernel);
+int32_t                  tsSetCompressKernel(ECompressKernel kernel);
+ECompressKernel          tsSelectCompressKernel();
 
 /*************************************************************************
  *                  REGULAR COMPRESSION 2
@@ -201,13 +259,6 @@ int32_t tsDecompressBigint2(void *pIn, int32_t nIn, int32_t nEle, void *pOut, in
 // for internal usage
 int32_t getWordLength(char type);
 
-int32_t tsDecompressIntImpl_Hw(const char *const input, const int32_t nelements, char *const output, const char type);
-int32_t tsDecompressFloatImplAvx512(const char *const input, const int32_t nelements, char *const output);
-int32_t tsDecompressFloatImplAvx2(const char *const input, const int32_t nelements, char *const output);
-int32_t tsDecompressTimestampAvx512(const char *const input, const int32_t nelements, char *const output,
-                                    bool bigEndian);
-int32_t tsDecompressTimestampAvx2(const char *const input, const int32_t nelements, char *const output, bool bigEndian);
-
 /*************************************************************************
  *                  STREAM COMPRESSION
  *************************************************************************/
@@ -31,6 +31,11 @@ typedef struct LRUHandle LRUHandle;
 
 typedef enum { TAOS_LRU_PRIORITY_HIGH, TAOS_LRU_PRIORITY_LOW } LRUPriority;
 
+typedef enum {
+  TAOS_LRU_POLICY_LRU,    // strict LRU with a high-priority pool
+  TAOS_LRU_POLICY_CLOCK,  // CLOCK eviction with TinyLFU admission, scan resistant and read-mostly on hits
+} LRUPolicy;
+
 typedef enum {
   TAOS_LRU_STATUS_OK,
   TAOS_LRU_STATUS_FAIL,
@@ -38,7 +43,7 @@ typedef enum {
   TAOS_LRU_STATUS_OK_OVERWRITTEN
 } LRUStatus;
 
-SLRUCache *taosLRUCacheInit(size_t capacity, int numShardBits, double highPriPoolRatio);
+SLRUCache *taosLRUCacheInit(size_t capacity, int numShardBits, double highPriPoolRatio, LRUPolicy policy);
 void       taosLRUCacheCleanup(SLRUCache *cache);
 
 LRUStatus  taosLRUCacheInsert(SLRUCache *cache, const void *key, size_t keyLen, void *value, size_t charge,
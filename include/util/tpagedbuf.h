@@ -32,6 +32,14 @@ typedef struct SFilePage {
   char    data[];
 } SFilePage;
 
+#define DBUF_WRITE_BEHIND_PAGES 8  // default max in flight pages of write-behind and read-ahead
+
+typedef enum {
+  PAGE_CODEC_NONE = 0,
+  PAGE_CODEC_LZ4,
+  PAGE_CODEC_ZSTD,
+} EPageCodec;
+
 typedef struct SDiskbasedBufStatis {
   int64_t flushBytes;
   int64_t loadBytes;
@@ -39,6 +47,8 @@ typedef struct SDiskbasedBufStatis {
   int32_t getPages;
   int32_t releasePages;
   int32_t flushPages;
+  int32_t readAheadPages;  // pages loaded by read-ahead
+  int64_t stallTime;       // time in us that the caller is blocked by disk io
 } SDiskbasedBufStatis;
 
 /**
@@ -151,6 +161,42 @@ void setBufPageDirty(void* pPage, bool dirty);
  */
 void setBufPageCompressOnDisk(SDiskbasedBuf* pBuf, bool comp);
 
+/**
+ * Set the codec of the pages flushed to disk, it should be called before any page is flushed.
+ * @param pBuf
+ * @param codec
+ */
+void dBufSetPageCodec(SDiskbasedBuf* pBuf, EPageCodec codec);
+
+/**
+ * Start the io threads shared by all the paged buffers for the write-behind and read-ahead.
+ * @return
+ */
+int32_t dBufIoPoolInit();
+
+/**
+ * Stop the shared io threads, no buffer with write-behind enabled should be alive.
+ */
+void dBufIoPoolCleanup();
+
+/**
+ * Flush the evicted pages in the shared io threads, and at most maxPages pages are allowed to be in flight.
+ * Set maxPages to 0 to flush pages synchronously, which is the default, and it is also the case if the io threads are
+ * not started.
+ * @param pBuf
+ * @param maxPages
+ * @return
+ */
+int32_t dBufSetWriteBehind(SDiskbasedBuf* pBuf, int32_t maxPages);
+
+/**
+ * Hint that the page will be accessed soon, so start loading it from disk in background if it is not in memory.
+ * Only works when write-behind is enabled.
+ * @param pBuf
+ * @param id
+ */
+void dBufPrefetchPage(SDiskbasedBuf* pBuf, int32_t id);
+
 /**
  * Set the pageId page buffer is not need
  * @param pBuf
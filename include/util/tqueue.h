@@ -33,15 +33,19 @@ Notes:
 1: taosOpenQueue/taosCloseQueue, taosOpenQset/taosCloseQset is NOT multi-thread safe
 2: after taosCloseQueue/taosCloseQset is called, read/write operation APIs are not safe.
 3: read/write operation APIs are multi-thread safe
+4: writers never block each other, the written items are collected by readers in batch
+5: the items written in budget are limited by the memory of the budget of the queue, writers over the limit are
+   rejected at once, or wait for tsQueueMemoryWaitMs before rejected
 
 To remove the limitation and make this set of queue APIs multi-thread safe, REF(tref.c)
 shall be used to set up the protection.
 
 */
 
-typedef struct STaosQueue STaosQueue;
-typedef struct STaosQset  STaosQset;
-typedef struct STaosQall  STaosQall;
+typedef struct STaosQueue   STaosQueue;
+typedef struct STaosQset    STaosQset;
+typedef struct STaosQall    STaosQall;
+typedef struct STaosQbudget STaosQbudget;
 typedef struct {
   void   *ahandle;
   void   *fp;
@@ -68,7 +72,8 @@ struct STaosQnode {
   int64_t     dataSize;
   int32_t     size;
   int8_t      itype;
-  int8_t      reserved[3];
+  int8_t      charged;  // charged to the budget of the queue
+  int8_t      reserved[2];
   char        item[];
 };
 
@@ -78,6 +83,7 @@ void        taosSetQueueFp(STaosQueue *queue, FItem itemFp, FItems itemsFp);
 void       *taosAllocateQitem(int32_t size, EQItype itype, int64_t dataSize);
 void        taosFreeQitem(void *pItem);
 int32_t     taosWriteQitem(STaosQueue *queue, void *pItem);
+int32_t     taosWriteQitemInBudget(STaosQueue *queue, void *pItem);
 int32_t     taosReadQitem(STaosQueue *queue, void **ppItem);
 bool        taosQueueEmpty(STaosQueue *queue);
 void        taosUpdateItemSize(STaosQueue *queue, int32_t items);
@@ -85,6 +91,13 @@ int32_t     taosQueueItemSize(STaosQueue *queue);
 int64_t     taosQueueMemorySize(STaosQueue *queue);
 void        taosSetQueueCapacity(STaosQueue *queue, int64_t size);
 void        taosSetQueueMemoryCapacity(STaosQueue *queue, int64_t mem);
+void        taosSetQueueBudget(STaosQueue *queue, STaosQbudget *budget);
+int64_t     taosQueueMemoryPeak(STaosQueue *queue, bool reset);
+int64_t     taosQueueRejects(STaosQueue *queue, bool reset);
+
+STaosQbudget *taosOpenQbudget(int64_t memLimit);
+void          taosCloseQbudget(STaosQbudget *budget);
+int64_t       taosQbudgetMemorySize(STaosQbudget *budget);
 
 STaosQall *taosAllocateQall();
 void       taosFreeQall(STaosQall *qall);
@@ -102,9 +115,11 @@ void       taosQsetThreadResume(STaosQset *qset);
 int32_t    taosAddIntoQset(STaosQset *qset, STaosQueue *queue, void *ahandle);
 void       taosRemoveFromQset(STaosQset *qset, STaosQueue *queue);
 int32_t    taosGetQueueNumber(STaosQset *qset);
+int32_t    taosQsetItemSize(STaosQset *qset);
 
 int32_t taosReadQitemFromQset(STaosQset *qset, void **ppItem, SQueueInfo *qinfo);
 int32_t taosReadAllQitemsFromQset(STaosQset *qset, STaosQall *qall, SQueueInfo *qinfo);
+int32_t taosReadQitemsFromQset(STaosQset *qset, STaosQall *qall, int32_t maxItems, SQueueInfo *qinfo);
 void    taosResetQsetThread(STaosQset *qset, void *pItem);
 void    taosQueueSetThreadId(STaosQueue *pQueue, int64_t threadId);
 int64_t taosQueueGetThreadId(STaosQueue *pQueue);
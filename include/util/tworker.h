@@ -23,6 +23,8 @@
 extern "C" {
 #endif
 
+#define QWORKER_BATCH_SIZE 8  // msgs read at once by the workers of the pools reading in batch
+
 typedef struct SWWorkerPool SWWorkerPool;
 
 typedef struct SQueueWorker {
@@ -33,9 +35,10 @@ typedef struct SQueueWorker {
 } SQueueWorker;
 
 typedef struct SQWorkerPool {
-  int32_t       max;  // max number of workers
-  int32_t       min;  // min number of workers
-  int32_t       num;  // current number of workers
+  int32_t       max;        // max number of workers
+  int32_t       min;        // min number of workers
+  int32_t       num;        // current number of workers
+  int32_t       batchSize;  // max number of msgs read by a worker at once, 0 or 1: one by one
   STaosQset    *qset;
   const char   *name;
   SQueueWorker *workers;
@@ -87,6 +90,7 @@ typedef struct {
   const char *name;
   int32_t     min;
   int32_t     max;
+  int32_t     batchSize;  // max number of msgs read by a worker at once, 0(default): one by one
   FItem       fp;
   void       *param;
 } SSingleWorkerCfg;
@@ -152,6 +152,10 @@ static bool clientRpcRfp(int32_t code, tmsg_t msgType) {
       return false;
     }
     return true;
+  } else if (code == TSDB_CODE_OUT_OF_RPC_MEMORY_QUEUE) {
+    // the queue memory of the node is used up, the msg is not processed and can be retried later
+    return msgType != TDMT_SCH_QUERY && msgType != TDMT_SCH_MERGE_QUERY && msgType != TDMT_SCH_FETCH &&
+           msgType != TDMT_SCH_MERGE_FETCH;
   } else {
     return false;
   }
@@ -179,6 +183,7 @@ void *openTransporter(const char *user, const char *auth, int32_t numOfThread) {
   rpcInit.user = (char *)user;
   rpcInit.idleTime = tsShellActivityTimer * 1000;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressType = tsCompressMsgType;
   rpcInit.dfp = destroyAhandle;
 
   rpcInit.retryMinInterval = tsRedirectPeriod;
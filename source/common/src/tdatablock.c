@@ -1163,6 +1163,148 @@ int32_t dataBlockCompar(const void* p1, const void* p2, const void* param) {
   return 0;
 }
 
+static bool isSortKeyPrefixSupported(int8_t type) {
+  // float and double are compared with a tolerance, and the order of nchar is defined by the wide chars, so neither
+  // of them can be encoded into an integer with the same order.
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+    case TSDB_DATA_TYPE_UTINYINT:
+    case TSDB_DATA_TYPE_USMALLINT:
+    case TSDB_DATA_TYPE_UINT:
+    case TSDB_DATA_TYPE_UBIGINT:
+    case TSDB_DATA_TYPE_BINARY:
+    case TSDB_DATA_TYPE_VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool blockDataBuildSortKeyPrefix(const SSDataBlock* pBlock, const SBlockOrderInfo* pOrder, uint64_t* pKeys) {
+  SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, pOrder->slotId);
+  int8_t           type = pCol->info.type;
+  if (!isSortKeyPrefixSupported(type)) {
+    return false;
+  }
+
+  uint64_t nullKey = pOrder->nullFirst ? 0 : UINT64_MAX;
+  bool     desc = (pOrder->order == TSDB_ORDER_DESC);
+
+  for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+    if (pCol->hasNull && colDataIsNull_s(pCol, i)) {
+      pKeys[i] = nullKey;
+      continue;
+    }
+
+    const char* p = colDataGetData(pCol, i);
+    uint64_t    key = 0;
+    switch (type) {
+      case TSDB_DATA_TYPE_BOOL:
+      case TSDB_DATA_TYPE_TINYINT:
+        key = (uint64_t)(int64_t)(*(int8_t*)p) ^ (1ULL << 63);
+        break;
+      case TSDB_DATA_TYPE_SMALLINT:
+        key = (uint64_t)(int64_t)(*(int16_t*)p) ^ (1ULL << 63);
+        break;
+      case TSDB_DATA_TYPE_INT:
+        key = (uint64_t)(int64_t)(*(int32_t*)p) ^ (1ULL << 63);
+        break;
+      case TSDB_DATA_TYPE_BIGINT:
+      case TSDB_DATA_TYPE_TIMESTAMP:
+        key = (uint64_t)(*(int64_t*)p) ^ (1ULL << 63);
+        break;
+      case TSDB_DATA_TYPE_UTINYINT:
+        key = *(uint8_t*)p;
+        break;
+      case TSDB_DATA_TYPE_USMALLINT:
+        key = *(uint16_t*)p;
+        break;
+      case TSDB_DATA_TYPE_UINT:
+        key = *(uint32_t*)p;
+        break;
+      case TSDB_DATA_TYPE_UBIGINT:
+        key = *(uint64_t*)p;
+        break;
+      default: {
+        // the leading bytes in big-endian, binary is compared by strncmp, so the bytes after '\0' are ignored
+        const uint8_t* pVal = (const uint8_t*)varDataVal(p);
+        int32_t        len = TMIN(varDataLen(p), (int32_t)sizeof(uint64_t));
+        for (int32_t j = 0; j < len; ++j) {
+          if (pVal[j] == 0 && type == TSDB_DATA_TYPE_BINARY) {
+            break;
+          }
+          key |= ((uint64_t)pVal[j]) << (56 - 8 * j);
+        }
+        break;
+      }
+    }
+
+    pKeys[i] = desc ? ~key : key;
+  }
+
+  return true;
+}
+
+typedef struct SBlockSortKey {
+  uint64_t key;
+  int32_t  index;
+} SBlockSortKey;
+
+static int32_t dataBlockComparByKey(const void* p1, const void* p2, const void* param) {
+  const SBlockSortKey* pLeft = (const SBlockSortKey*)p1;
+  const SBlockSortKey* pRight = (const SBlockSortKey*)p2;
+  if (pLeft->key != pRight->key) {
+    return pLeft->key < pRight->key ? -1 : 1;
+  }
+
+  return dataBlockCompar(&pLeft->index, &pRight->index, param);
+}
+
+// sort the rows by the prefix of the first sort key, and the sort keys are compared only when the prefixes are equal.
+// Only the first sort key gets a prefix: the rows with equal prefixes are ordered by dataBlockCompar with all the keys,
+// which also breaks the ties of the first key by the following ones.
+static int32_t blockDataSortByKeyPrefix(SSDataBlock* pDataBlock, SSDataBlockSortHelper* pHelper, int32_t* index,
+                                        bool* sorted) {
+  uint32_t         rows = pDataBlock->info.rows;
+  SBlockOrderInfo* pOrder = taosArrayGet(pHelper->orderInfo, 0);
+  *sorted = false;
+
+  SColumnInfoData* pCol = taosArrayGet(pDataBlock->pDataBlock, pOrder->slotId);
+  if (!isSortKeyPrefixSupported(pCol->info.type)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  uint64_t*      pPrefix = taosMemoryMalloc(rows * sizeof(uint64_t));
+  SBlockSortKey* pKeys = taosMemoryMalloc(rows * sizeof(SBlockSortKey));
+  if (pPrefix == NULL || pKeys == NULL) {
+    taosMemoryFree(pPrefix);
+    taosMemoryFree(pKeys);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  if (blockDataBuildSortKeyPrefix(pDataBlock, pOrder, pPrefix)) {
+    for (int32_t i = 0; i < rows; ++i) {
+      pKeys[i].key = pPrefix[i];
+      pKeys[i].index = i;
+    }
+
+    taosqsort_r(pKeys, rows, sizeof(SBlockSortKey), pHelper, dataBlockComparByKey);
+    for (int32_t i = 0; i < rows; ++i) {
+      index[i] = pKeys[i].index;
+    }
+    *sorted = true;
+  }
+
+  taosMemoryFree(pPrefix);
+  taosMemoryFree(pKeys);
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t blockDataAssign(SColumnInfoData* pCols, const SSDataBlock* pDataBlock, const int32_t* index) {
   size_t numOfCols = taosArrayGetSize(pDataBlock->pDataBlock);
   for (int32_t i = 0; i < numOfCols; ++i) {
@@ -1242,6 +1384,22 @@ static void copyBackToBlock(SSDataBlock* pDataBlock, SColumnInfoData* pCols) {
   taosMemoryFreeClear(pCols);
 }
 
+int32_t blockDataReorder(SSDataBlock* pDataBlock, const int32_t* index) {
+  if (pDataBlock->info.rows <= 1) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SColumnInfoData* pCols = createHelpColInfoData(pDataBlock);
+  if (pCols == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return terrno;
+  }
+
+  blockDataAssign(pCols, pDataBlock, index);
+  copyBackToBlock(pDataBlock, pCols);
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t* createTupleIndex(size_t rows) {
   int32_t* index = taosMemoryCalloc(rows, sizeof(int32_t));
   if (index == NULL) {
@@ -1320,7 +1478,16 @@ int32_t blockDataSort(SSDataBlock* pDataBlock, SArray* pOrderInfo) {
   }
 
   terrno = 0;
-  taosqsort_r(index, rows, sizeof(int32_t), &helper, dataBlockCompar);
+  bool sorted = false;
+  int32_t code = blockDataSortByKeyPrefix(pDataBlock, &helper, index, &sorted);
+  if (code != TSDB_CODE_SUCCESS) {
+    destroyTupleIndex(index);
+    terrno = code;
+    return code;
+  }
+  if (!sorted) {
+    taosqsort_r(index, rows, sizeof(int32_t), &helper, dataBlockCompar);
+  }
   if (terrno) return terrno;
 
   int64_t p1 = taosGetTimestampUs();
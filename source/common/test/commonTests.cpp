@@ -10,6 +10,7 @@
 
 #include "taos.h"
 #include "tcommon.h"
+#include "tcompare.h"
 #include "tdatablock.h"
 #include "tdef.h"
 #include "tmisce.h"
@@ -302,6 +303,59 @@ TEST(testCase, Datablock_test) {
   taosArrayDestroy(pOrderInfo);
 }
 
+TEST(testCase, Datablock_sort_prefix_test) {
+  SSDataBlock*    b = createDataBlock();
+  SColumnInfoData infoData = createColumnInfoData(TSDB_DATA_TYPE_INT, 4, 1);
+  blockDataAppendColInfo(b, &infoData);
+  SColumnInfoData infoData1 = createColumnInfoData(TSDB_DATA_TYPE_BINARY, 20, 2);
+  blockDataAppendColInfo(b, &infoData1);
+
+  int32_t rows = 1000;
+  blockDataEnsureCapacity(b, rows);
+
+  SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+  SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 1);
+  char             buf[32] = {0};
+  char             varbuf[32] = {0};
+  for (int32_t i = 0; i < rows; ++i) {
+    int32_t v = (i * 7919) % 101 - 50;
+    colDataSetVal(p0, i, (const char*)&v, (i % 13) == 0);
+
+    // strings sharing a prefix longer than 8 bytes
+    int32_t len = sprintf(buf, "prefix-%d", (i * 31) % 17);
+    STR_TO_VARSTR(varbuf, buf);
+    colDataSetVal(p1, i, (const char*)varbuf, false);
+  }
+  b->info.rows = rows;
+
+  SArray*         pOrderInfo = taosArrayInit(2, sizeof(SBlockOrderInfo));
+  SBlockOrderInfo order = {false, TSDB_ORDER_DESC, 0, NULL};
+  taosArrayPush(pOrderInfo, &order);
+  SBlockOrderInfo order1 = {true, TSDB_ORDER_ASC, 1, NULL};
+  taosArrayPush(pOrderInfo, &order1);
+
+  ASSERT_EQ(blockDataSort(b, pOrderInfo), 0);
+
+  for (int32_t i = 1; i < rows; ++i) {
+    bool prevNull = colDataIsNull_s(p0, i - 1);
+    bool curNull = colDataIsNull_s(p0, i);
+    if (prevNull || curNull) {
+      ASSERT_TRUE(curNull);  // nulls last
+      continue;
+    }
+
+    int32_t prev = *(int32_t*)colDataGetData(p0, i - 1);
+    int32_t cur = *(int32_t*)colDataGetData(p0, i);
+    ASSERT_GE(prev, cur);
+    if (prev == cur) {
+      ASSERT_LE(compareLenPrefixedStr(colDataGetData(p1, i - 1), colDataGetData(p1, i)), 0);
+    }
+  }
+
+  blockDataDestroy(b);
+  taosArrayDestroy(pOrderInfo);
+}
+
 #if 0
 TEST(testCase, non_var_dataBlock_split_test) {
   SSDataBlock* b = static_cast<SSDataBlock*>(taosMemoryCalloc(1, sizeof(SSDataBlock)));
@@ -212,6 +212,7 @@ int32_t mmStartWorker(SMnodeMgmt *pMgmt) {
   SSingleWorkerCfg fCfg = {
       .min = tsNumOfMnodeFetchThreads,
       .max = tsNumOfMnodeFetchThreads,
+      .batchSize = QWORKER_BATCH_SIZE,
       .name = "mnode-fetch",
       .fp = (FItem)mmProcessRpcMsg,
       .param = pMgmt,
@@ -115,6 +115,7 @@ int32_t qmStartWorker(SQnodeMgmt *pMgmt) {
   SSingleWorkerCfg fetchCfg = {
       .min = tsNumOfQnodeFetchThreads,
       .max = tsNumOfQnodeFetchThreads,
+      .batchSize = QWORKER_BATCH_SIZE,
       .name = "qnode-fetch",
       .fp = (FItem)qmProcessQueue,
       .param = pMgmt,
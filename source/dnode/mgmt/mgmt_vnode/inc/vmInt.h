@@ -69,6 +69,7 @@ typedef struct {
   STaosQueue   *pQueryQ;
   STaosQueue   *pStreamQ;
   STaosQueue   *pFetchQ;
+  STaosQbudget *pQbudget;  // memory of the write queue of this vnode
 } SVnodeObj;
 
 typedef struct {
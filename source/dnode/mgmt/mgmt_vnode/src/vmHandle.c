@@ -66,6 +66,34 @@ void vmGetVnodeLoadsLite(SVnodeMgmt *pMgmt, SMonVloadInfo *pInfo) {
   taosThreadRwlockUnlock(&pMgmt->lock);
 }
 
+static void vmGetQueueStat(STaosQueue *queue, SVQueueStat *pStat) {
+  int64_t memoryPeak = taosQueueMemoryPeak(queue, true);
+  pStat->memory += taosQueueMemorySize(queue);
+  pStat->memoryPeak = TMAX(pStat->memoryPeak, memoryPeak);
+  pStat->rejects += taosQueueRejects(queue, true);
+}
+
+static void vmGetQueueStats(SVnodeMgmt *pMgmt, SVQueueStat *pStats) {
+  taosThreadRwlockRdlock(&pMgmt->lock);
+
+  void *pIter = taosHashIterate(pMgmt->hash, NULL);
+  while (pIter) {
+    SVnodeObj *pVnode = *(SVnodeObj **)pIter;
+    if (!pVnode->failed) {
+      vmGetQueueStat(pVnode->pWriteW.queue, &pStats[0]);
+      vmGetQueueStat(pVnode->pSyncW.queue, &pStats[1]);
+      vmGetQueueStat(pVnode->pSyncRdW.queue, &pStats[2]);
+      vmGetQueueStat(pVnode->pApplyW.queue, &pStats[3]);
+      vmGetQueueStat(pVnode->pQueryQ, &pStats[4]);
+      vmGetQueueStat(pVnode->pFetchQ, &pStats[5]);
+      vmGetQueueStat(pVnode->pStreamQ, &pStats[6]);
+    }
+    pIter = taosHashIterate(pMgmt->hash, pIter);
+  }
+
+  taosThreadRwlockUnlock(&pMgmt->lock);
+}
+
 void vmGetMonitorInfo(SVnodeMgmt *pMgmt, SMonVmInfo *pInfo) {
   SMonVloadInfo vloads = {0};
   vmGetVnodeLoads(pMgmt, &vloads, true);
@@ -101,6 +129,8 @@ void vmGetMonitorInfo(SVnodeMgmt *pMgmt, SMonVmInfo *pInfo) {
   pInfo->vstat.numOfInsertSuccessReqs = numOfInsertSuccessReqs;            // delta
   pInfo->vstat.numOfBatchInsertReqs = numOfBatchInsertReqs;                // delta
   pInfo->vstat.numOfBatchInsertSuccessReqs = numOfBatchInsertSuccessReqs;  // delta
+  (void)vnodeGetAsyncStat(&pInfo->vstat.commitStat, &pInfo->vstat.mergeStat);
+  vmGetQueueStats(pMgmt, pInfo->vstat.queueStat);
   pMgmt->state.totalVnodes = totalVnodes;
   pMgmt->state.masterNum = masterNum;
   pMgmt->state.numOfSelectReqs = numOfSelectReqs;
@@ -327,6 +327,13 @@ static bool rpcRfp(int32_t code, tmsg_t msgType) {
       return false;
     }
     return true;
+  } else if (code == TSDB_CODE_OUT_OF_RPC_MEMORY_QUEUE) {
+    // sync msgs are resent by the raft of their own, e.g. by the heartbeat and the replication pipeline
+    if (TMSG_SEG_CODE(msgType) == TDMT_SYNC_MSG_SEG_CODE) {
+      return false;
+    }
+    return msgType != TDMT_SCH_QUERY && msgType != TDMT_SCH_MERGE_QUERY && msgType != TDMT_SCH_FETCH &&
+           msgType != TDMT_SCH_MERGE_FETCH;
   } else {
     return false;
   }
@@ -352,6 +359,7 @@ int32_t dmInitClient(SDnode *pDnode) {
   rpcInit.parent = pDnode;
   rpcInit.rfp = rpcRfp;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressType = tsCompressMsgType;
   rpcInit.dfp = destroyAhandle;
 
   rpcInit.retryMinInterval = tsRedirectPeriod;
@@ -400,6 +408,7 @@ int32_t dmInitStatusClient(SDnode *pDnode) {
   rpcInit.parent = pDnode;
   rpcInit.rfp = rpcRfp;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressType = tsCompressMsgType;
 
   rpcInit.retryMinInterval = tsRedirectPeriod;
   rpcInit.retryStepFactor = tsRedirectFactor;
@@ -445,6 +454,7 @@ int32_t dmInitSyncClient(SDnode *pDnode) {
   rpcInit.parent = pDnode;
   rpcInit.rfp = rpcRfp;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressType = tsCompressMsgType;
 
   rpcInit.retryMinInterval = tsRedirectPeriod;
   rpcInit.retryStepFactor = tsRedirectFactor;
@@ -515,6 +525,7 @@ int32_t dmInitServer(SDnode *pDnode) {
   rpcInit.idleTime = tsShellActivityTimer * 1000;
   rpcInit.parent = pDnode;
   rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressType = tsCompressMsgType;
   taosVersionStrToInt(version, &(rpcInit.compatibilityVer));
   pTrans->serverRpc = rpcOpen(&rpcInit);
   if (pTrans->serverRpc == NULL) {
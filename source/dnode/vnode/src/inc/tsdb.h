@@ -196,6 +196,8 @@ int32_t tBlockDataInit(SBlockData *pBlockData, TABLEID *pId, STSchema *pTSchema,
 void    tBlockDataReset(SBlockData *pBlockData);
 int32_t tBlockDataAppendRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTSchema, int64_t uid);
 int32_t tBlockDataUpdateRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTSchema);
+int32_t tBlockDataAppendBlockRows(SBlockData *pBlockData, SBlockData *pBlockDataFrom, int32_t iRow, int32_t nRow,
+                                  int64_t uid);
 int32_t tBlockDataTryUpsertRow(SBlockData *pBlockData, TSDBROW *pRow, int64_t uid);
 int32_t tBlockDataUpsertRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTSchema, int64_t uid);
 void    tBlockDataClear(SBlockData *pBlockData);
@@ -394,17 +396,43 @@ typedef struct SMemSkipList {
   SMemSkipListNode *pTail;
 } SMemSkipList;
 
+// Rows inserted in key order are appended to chunks of growing size, instead of being linked in the skiplist
+#define MEM_AB_MIN_CHUNK_BITS 3   // rows of the first chunk
+#define MEM_AB_MAX_CHUNK_BITS 10  // rows of the largest chunk
+#define MEM_AB_GEO_CHUNKS     (MEM_AB_MAX_CHUNK_BITS - MEM_AB_MIN_CHUNK_BITS)
+#define MEM_AB_GEO_ROWS       ((((int64_t)1) << MEM_AB_MIN_CHUNK_BITS) * ((1 << MEM_AB_GEO_CHUNKS) - 1))
+
+// Column blocks inserted in key order are kept as a whole, indexed by the key range of each block
+typedef struct SMemAppendBlock {
+  SBlockData *pBlockData;
+  TSKEY       minKey;
+  TSKEY       maxKey;
+} SMemAppendBlock;
+
+// An append buffer holds either rows or column blocks, rows of the other format move the table to the skiplist
+typedef struct SMemAppendBuf {
+  volatile int64_t nRow;
+  TSDBROW **       aChunk;
+  int32_t          nChunk;
+  int32_t          nChunkAlloc;
+  SMemAppendBlock *aBlock;
+  volatile int32_t nBlock;
+  int32_t          nBlockAlloc;
+} SMemAppendBuf;
+
 struct STbData {
-  tb_uid_t     suid;
-  tb_uid_t     uid;
-  TSKEY        minKey;
-  TSKEY        maxKey;
-  SRWLatch     lock;
-  SDelData *   pHead;
-  SDelData *   pTail;
-  SMemSkipList sl;
-  STbData *    next;
-  SRBTreeNode  rbtn[1];
+  tb_uid_t         suid;
+  tb_uid_t         uid;
+  TSKEY            minKey;
+  TSKEY            maxKey;
+  SRWLatch         lock;
+  SDelData *       pHead;
+  SDelData *       pTail;
+  volatile int8_t  useSl;  // rows are in the skiplist since an out-of-order row arrived, otherwise in the append buffer
+  SMemAppendBuf    ab;
+  SMemSkipList     sl;
+  STbData *        next;
+  SRBTreeNode      rbtn[1];
 };
 
 struct SMemTable {
@@ -548,6 +576,12 @@ struct STbDataIter {
   SMemSkipListNode *pNode;
   TSDBROW *         pRow;
   TSDBROW           row;
+  TSDBROW **        aChunk;  // chunks of the append buffer, NULL if iterating the skiplist
+  int64_t           nRow;
+  int64_t           iRow;
+  SMemAppendBlock * aBlock;  // blocks of the append buffer, NULL if iterating the skiplist
+  int32_t           nBlock;
+  int32_t           iBlock;
 };
 
 struct SDelData {
@@ -660,6 +694,8 @@ typedef struct {
   int32_t     fid;
   int64_t     cid;
   int64_t     blkno;
+
+  struct SCryptKey *pCryptKey;  // key schedule expanded at the first encrypted page io
 } STsdbFD;
 
 struct SDelFWriter {
@@ -973,6 +1009,16 @@ static FORCE_INLINE int32_t tsdbKeyCmprFn(const void *p1, const void *p2) {
 // #define SL_NODE_FORWARD(n, l)  ((n)->forwards[l])
 // #define SL_NODE_BACKWARD(n, l) ((n)->forwards[(n)->level + (l)])
 
+static FORCE_INLINE TSDBROW *tsdbMemAppendBufRow(TSDBROW **aChunk, int64_t iRow) {
+  if (iRow < MEM_AB_GEO_ROWS) {
+    int32_t iChunk = 31 - BUILDIN_CLZ((uint32_t)(iRow >> MEM_AB_MIN_CHUNK_BITS) + 1);
+    return &aChunk[iChunk][iRow - ((((int64_t)1) << MEM_AB_MIN_CHUNK_BITS) * ((((int64_t)1) << iChunk) - 1))];
+  } else {
+    iRow -= MEM_AB_GEO_ROWS;
+    return &aChunk[MEM_AB_GEO_CHUNKS + (iRow >> MEM_AB_MAX_CHUNK_BITS)][iRow & ((1 << MEM_AB_MAX_CHUNK_BITS) - 1)];
+  }
+}
+
 static FORCE_INLINE TSDBROW *tsdbTbDataIterGet(STbDataIter *pIter) {
   if (pIter == NULL) return NULL;
 
@@ -980,6 +1026,26 @@ static FORCE_INLINE TSDBROW *tsdbTbDataIterGet(STbDataIter *pIter) {
     return pIter->pRow;
   }
 
+  if (pIter->aChunk) {
+    if (pIter->iRow < 0 || pIter->iRow >= pIter->nRow) {
+      return NULL;
+    }
+
+    pIter->pRow = &pIter->row;
+    pIter->row = *tsdbMemAppendBufRow(pIter->aChunk, pIter->iRow);
+    return pIter->pRow;
+  }
+
+  if (pIter->aBlock) {
+    if (pIter->iBlock < 0 || pIter->iBlock >= pIter->nBlock) {
+      return NULL;
+    }
+
+    pIter->pRow = &pIter->row;
+    pIter->row = tsdbRowFromBlockData(pIter->aBlock[pIter->iBlock].pBlockData, pIter->iRow);
+    return pIter->pRow;
+  }
+
   if (pIter->backward) {
     if (pIter->pNode == pIter->pTbData->sl.pHead) {
       return NULL;
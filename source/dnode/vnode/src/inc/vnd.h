@@ -71,6 +71,7 @@ int32_t vnodeAsyncC(SVAsync* async, int64_t channelId, EVAPriority priority, int
 int32_t vnodeAWait(SVAsync* async, int64_t taskId);
 int32_t vnodeACancel(SVAsync* async, int64_t taskId);
 int32_t vnodeAsyncSetWorkers(SVAsync* async, int32_t numWorkers);
+int32_t vnodeAsyncGetStat(SVAsync* async, SVAsyncStat* stat);
 
 // vnodeModule.c
 extern SVAsync* vnodeAsyncHandle[2];
@@ -98,6 +99,7 @@ struct SVBufPool {
   int32_t           id;
   volatile int32_t  nRef;
   TdThreadSpinlock* lock;
+  int64_t           arenaVer;  // changed when the pool is reset, to invalidate the arenas of the write threads
   int64_t           size;
   uint8_t*          ptr;
   SVBufPoolNode*    pTail;
@@ -139,6 +139,20 @@ static int32_t tsdbCommitTSData(SCommitter2 *committer) {
     }
 
     committer->ctx->hasTSData = true;
+
+    // rows of a column block kept by the memtable are written as a run while nothing else interleaves with them
+    int32_t nRow = tsdbIterMergerGetBlockRows(committer->dataIterMerger, committer->ctx->maxKey);
+    if (nRow > 1) {
+      numOfRow += nRow;
+
+      code = tsdbFSetWriteBlockRows(committer->writer, row, nRow);
+      TSDB_CHECK_CODE(code, lino, _exit);
+
+      code = tsdbIterMergerSkipBlockRows(committer->dataIterMerger, nRow);
+      TSDB_CHECK_CODE(code, lino, _exit);
+      continue;
+    }
+
     numOfRow++;
 
     code = tsdbFSetWriteRow(committer->writer, row);
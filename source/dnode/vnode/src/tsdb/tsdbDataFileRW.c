@@ -324,44 +324,23 @@ _exit:
   return code;
 }
 
-int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData,
-                                          STSchema *pTSchema, int16_t cids[], int32_t ncid) {
+// Load the columns in cids that are not found in pLoaded into bData. The bytes read from file are added to szCol.
+static int32_t tsdbDataFileReadBlockColumns(SDataFileReader *reader, const SBrinRecord *record,
+                                            const SDiskDataHdr *hdr, SBlockData *pLoaded, SBlockData *bData,
+                                            STSchema *pTSchema, int16_t cids[], int32_t ncid, int64_t *szCol) {
   int32_t code = 0;
   int32_t lino = 0;
 
-  SDiskDataHdr hdr;
-  SBuffer     *buffer0 = reader->buffers + 0;
-  SBuffer     *buffer1 = reader->buffers + 1;
-  SBuffer     *assist = reader->buffers + 2;
+  SBuffer *buffer0 = reader->buffers + 0;
+  SBuffer *buffer1 = reader->buffers + 1;
+  SBuffer *assist = reader->buffers + 2;
 
   int32_t encryptAlgorithm = reader->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
-  char* encryptKey = reader->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
-  // load key part
-  tBufferClear(buffer0);
-  code = tsdbReadFileToBuffer(reader->fd[TSDB_FTYPE_DATA], record->blockOffset, record->blockKeySize, buffer0, 0,
-                              encryptAlgorithm, encryptKey);
-  TSDB_CHECK_CODE(code, lino, _exit);
-
-  // SDiskDataHdr
-  SBufferReader br = BUFFER_READER_INITIALIZER(0, buffer0);
-  code = tGetDiskDataHdr(&br, &hdr);
-  TSDB_CHECK_CODE(code, lino, _exit);
-
-  ASSERT(hdr.delimiter == TSDB_FILE_DLMT);
-
-  tBlockDataReset(bData);
-  bData->suid = hdr.suid;
-  bData->uid = hdr.uid;
-  bData->nRow = hdr.nRow;
-
-  // Key part
-  code = tBlockDataDecompressKeyPart(&hdr, &br, bData, assist);
-  TSDB_CHECK_CODE(code, lino, _exit);
-  ASSERT(br.offset == buffer0->size);
+  char   *encryptKey = reader->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
 
   int extraColIdx = -1;
   for (int i = 0; i < ncid; i++) {
-    if (tBlockDataGetColData(bData, cids[i]) == NULL) {
+    if (tBlockDataGetColData(pLoaded, cids[i]) == NULL) {
       extraColIdx = i;
       break;
     }
@@ -373,7 +352,7 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
   
   // load SBlockCol part
   tBufferClear(buffer0);
-  code = tsdbReadFileToBuffer(reader->fd[TSDB_FTYPE_DATA], record->blockOffset + record->blockKeySize, hdr.szBlkCol,
+  code = tsdbReadFileToBuffer(reader->fd[TSDB_FTYPE_DATA], record->blockOffset + record->blockKeySize, hdr->szBlkCol,
                               buffer0, 0, encryptAlgorithm, encryptKey);
   TSDB_CHECK_CODE(code, lino, _exit);
 
@@ -381,14 +360,14 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
   int64_t szHint = 0;
   int     extraCols = 1;
   for (int i = extraColIdx + 1; i < ncid; ++i) {
-    if (tBlockDataGetColData(bData, cids[i]) == NULL) {
+    if (tBlockDataGetColData(pLoaded, cids[i]) == NULL) {
       ++extraCols;
       break;
     }
   }
 
   if (extraCols >= 2) {
-    br = BUFFER_READER_INITIALIZER(0, buffer0);
+    SBufferReader br = BUFFER_READER_INITIALIZER(0, buffer0);
 
     SBlockCol blockCol = {.cid = 0};
     for (int32_t i = extraColIdx; i < ncid; ++i) {
@@ -400,7 +379,7 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
           break;
         }
 
-        code = tGetBlockCol(&br, &blockCol, hdr.fmtVer, hdr.cmprAlg);
+        code = tGetBlockCol(&br, &blockCol, hdr->fmtVer, hdr->cmprAlg);
         TSDB_CHECK_CODE(code, lino, _exit);
       }
 
@@ -423,7 +402,7 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
             break;
           }
 
-          code = tGetBlockCol(&br, &blockCol, hdr.fmtVer, hdr.cmprAlg);
+          code = tGetBlockCol(&br, &blockCol, hdr->fmtVer, hdr->cmprAlg);
           TSDB_CHECK_CODE(code, lino, _exit);
         }
 
@@ -448,12 +427,12 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
   SBlockCol blockCol = {
       .cid = 0,
   };
-  bool firstRead = true;
-  br = BUFFER_READER_INITIALIZER(0, buffer0);
+  bool          firstRead = true;
+  SBufferReader br = BUFFER_READER_INITIALIZER(0, buffer0);
   for (int32_t i = 0; i < ncid; i++) {
     int16_t cid = cids[i];
 
-    if (tBlockDataGetColData(bData, cid)) {  // already loaded
+    if (tBlockDataGetColData(pLoaded, cid)) {  // already loaded
       continue;
     }
 
@@ -463,7 +442,7 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
         break;
       }
 
-      code = tGetBlockCol(&br, &blockCol, hdr.fmtVer, hdr.cmprAlg);
+      code = tGetBlockCol(&br, &blockCol, hdr->fmtVer, hdr->cmprAlg);
       TSDB_CHECK_CODE(code, lino, _exit);
     }
 
@@ -481,24 +460,25 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
           .szValue = 0,
           .offset = 0,
       };
-      code = tBlockDataDecompressColData(&hdr, &none, &br, bData, assist);
+      code = tBlockDataDecompressColData(hdr, &none, &br, bData, assist);
       TSDB_CHECK_CODE(code, lino, _exit);
     } else if (cid == blockCol.cid) {
-      int32_t encryptAlgorithm = reader->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
-      char* encryptKey = reader->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
-     // load from file
+      // load from file
       tBufferClear(buffer1);
       code = tsdbReadFileToBuffer(
-          reader->fd[TSDB_FTYPE_DATA], record->blockOffset + record->blockKeySize + hdr.szBlkCol + blockCol.offset,
+          reader->fd[TSDB_FTYPE_DATA], record->blockOffset + record->blockKeySize + hdr->szBlkCol + blockCol.offset,
           blockCol.szBitmap + blockCol.szOffset + blockCol.szValue, buffer1, firstRead ? szHint : 0,
           encryptAlgorithm, encryptKey);
       TSDB_CHECK_CODE(code, lino, _exit);
 
       firstRead = false;
+      if (szCol != NULL) {
+        *szCol += blockCol.szBitmap + blockCol.szOffset + blockCol.szValue;
+      }
 
       // decode the buffer
       SBufferReader br1 = BUFFER_READER_INITIALIZER(0, buffer1);
-      code = tBlockDataDecompressColData(&hdr, &blockCol, &br1, bData, assist);
+      code = tBlockDataDecompressColData(hdr, &blockCol, &br1, bData, assist);
       TSDB_CHECK_CODE(code, lino, _exit);
     }
   }
@@ -510,6 +490,137 @@ _exit:
   return code;
 }
 
+int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData,
+                                          STSchema *pTSchema, int16_t cids[], int32_t ncid) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  SDiskDataHdr hdr;
+  SBuffer     *buffer0 = reader->buffers + 0;
+  SBuffer     *assist = reader->buffers + 2;
+
+  int32_t encryptAlgorithm = reader->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
+  char* encryptKey = reader->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
+  // load key part
+  tBufferClear(buffer0);
+  code = tsdbReadFileToBuffer(reader->fd[TSDB_FTYPE_DATA], record->blockOffset, record->blockKeySize, buffer0, 0,
+                              encryptAlgorithm, encryptKey);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  // SDiskDataHdr
+  SBufferReader br = BUFFER_READER_INITIALIZER(0, buffer0);
+  code = tGetDiskDataHdr(&br, &hdr);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  ASSERT(hdr.delimiter == TSDB_FILE_DLMT);
+
+  tBlockDataReset(bData);
+  bData->suid = hdr.suid;
+  bData->uid = hdr.uid;
+  bData->nRow = hdr.nRow;
+
+  // Key part
+  code = tBlockDataDecompressKeyPart(&hdr, &br, bData, assist);
+  TSDB_CHECK_CODE(code, lino, _exit);
+  ASSERT(br.offset == buffer0->size);
+
+  code = tsdbDataFileReadBlockColumns(reader, record, &hdr, bData, bData, pTSchema, cids, ncid, NULL);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(reader->config->tsdb->pVnode), lino, code);
+  }
+  return code;
+}
+
+int32_t tsdbDataFileReadBlockDataAppendColumn(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData,
+                                              STSchema *pTSchema, int16_t cids[], int32_t ncid, int64_t *szCol) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  SDiskDataHdr hdr;
+  SBlockData   tBlockData = {0};
+  SBuffer     *buffer0 = reader->buffers + 0;
+
+  int32_t i = 0;
+  while (i < ncid && tBlockDataGetColData(bData, cids[i]) != NULL) {
+    i++;
+  }
+
+  if (i >= ncid) {  // all columns are loaded already
+    goto _exit;
+  }
+
+  int32_t encryptAlgorithm = reader->config->tsdb->pVnode->config.tsdbCfg.encryptAlgorithm;
+  char   *encryptKey = reader->config->tsdb->pVnode->config.tsdbCfg.encryptKey;
+
+  // the key part is only parsed for the SDiskDataHdr, the keys in bData are kept
+  tBufferClear(buffer0);
+  code = tsdbReadFileToBuffer(reader->fd[TSDB_FTYPE_DATA], record->blockOffset, record->blockKeySize, buffer0, 0,
+                              encryptAlgorithm, encryptKey);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  SBufferReader br = BUFFER_READER_INITIALIZER(0, buffer0);
+  code = tGetDiskDataHdr(&br, &hdr);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  ASSERT(hdr.delimiter == TSDB_FILE_DLMT && hdr.uid == bData->uid && hdr.nRow == bData->nRow);
+
+  code = tsdbDataFileReadBlockColumns(reader, record, &hdr, bData, &tBlockData, pTSchema, cids, ncid, szCol);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  // merge the newly loaded columns into bData, which are in ascending order of column id
+  int32_t   nColData = bData->nColData + tBlockData.nColData;
+  SColData *aColData = taosMemoryMalloc(sizeof(SColData) * nColData);
+  if (aColData == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  for (int32_t iOld = 0, iNew = 0, k = 0; k < nColData; k++) {
+    if (iNew >= tBlockData.nColData ||
+        (iOld < bData->nColData && bData->aColData[iOld].cid < tBlockData.aColData[iNew].cid)) {
+      aColData[k] = bData->aColData[iOld++];
+    } else {
+      aColData[k] = tBlockData.aColData[iNew++];
+    }
+  }
+
+  taosMemoryFree(bData->aColData);
+  bData->aColData = aColData;
+  bData->nColData = nColData;
+
+  taosMemoryFreeClear(tBlockData.aColData);
+  tBlockData.nColData = 0;
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(reader->config->tsdb->pVnode), lino, code);
+  }
+  tBlockDataDestroy(&tBlockData);
+  return code;
+}
+
+int32_t tsdbDataFileReaderPrefetchBlock(SDataFileReader *reader, const SBrinRecord *record) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  if (reader->fd[TSDB_FTYPE_DATA] == NULL) {
+    return code;
+  }
+
+  // the column offsets are only known after the block header is loaded, so hint the whole block
+  code = tsdbPrefetchFile(reader->fd[TSDB_FTYPE_DATA], record->blockOffset, record->blockSize);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(reader->config->tsdb->pVnode), lino, code);
+  }
+  return code;
+}
+
 int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *record,
                                  TColumnDataAggArray *columnDataAggArray) {
   int32_t  code = 0;
@@ -59,6 +59,9 @@ int32_t tsdbDataFileReadBrinBlock(SDataFileReader *reader, const SBrinBlk *brinB
 int32_t tsdbDataFileReadBlockData(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData);
 int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData,
                                           STSchema *pTSchema, int16_t cids[], int32_t ncid);
+int32_t tsdbDataFileReadBlockDataAppendColumn(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData,
+                                              STSchema *pTSchema, int16_t cids[], int32_t ncid, int64_t *szCol);
+int32_t tsdbDataFileReaderPrefetchBlock(SDataFileReader *reader, const SBrinRecord *record);
 // .sma
 int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *record,
                                  TColumnDataAggArray *columnDataAggArray);
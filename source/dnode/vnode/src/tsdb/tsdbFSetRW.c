@@ -283,6 +283,46 @@ _exit:
   return code;
 }
 
+// write nRow rows of one table from the column block of row, see tsdbIterMergerGetBlockRows()
+int32_t tsdbFSetWriteBlockRows(SFSetWriter *writer, SRowInfo *row, int32_t nRow) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  if (writer->config->toSttOnly) {
+    code = tsdbSttFileWriteBlockRows(writer->sttWriter, row, nRow);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  } else {
+    // the first row begins the table or updates the last row written, the others follow it
+    code = tsdbFSetWriteRow(writer, row);
+    TSDB_CHECK_CODE(code, lino, _exit);
+
+    for (int32_t iRow = row->row.iRow + 1, eRow = row->row.iRow + nRow; iRow < eRow;) {
+      if (writer->blockData[writer->blockDataIdx].nRow >= writer->config->maxRow) {
+        int32_t idx = ((writer->blockDataIdx + 1) & 1);
+        if (writer->blockData[idx].nRow >= writer->config->maxRow) {
+          code = tsdbDataFileWriteBlockData(writer->dataWriter, &writer->blockData[idx]);
+          TSDB_CHECK_CODE(code, lino, _exit);
+
+          tBlockDataClear(&writer->blockData[idx]);
+        }
+        writer->blockDataIdx = idx;
+      }
+
+      int32_t n = TMIN(eRow - iRow, writer->config->maxRow - writer->blockData[writer->blockDataIdx].nRow);
+      code = tBlockDataAppendBlockRows(&writer->blockData[writer->blockDataIdx], row->row.pBlockData, iRow, n,
+                                       row->uid);
+      TSDB_CHECK_CODE(code, lino, _exit);
+      iRow += n;
+    }
+  }
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(writer->config->tsdb->pVnode), lino, code);
+  }
+  return code;
+}
+
 int32_t tsdbFSetWriteTombRecord(SFSetWriter *writer, const STombRecord *tombRecord) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -737,6 +737,63 @@ SRowInfo *tsdbIterMergerGetData(SIterMerger *merger) {
   return merger->iter ? merger->iter->row : NULL;
 }
 
+/*
+ * Number of rows, starting at the current one, that can be taken from the current memtable column block as they are:
+ * they sort before every other iterator and their timestamps are not larger than maxKey. Returns 0 if the current row
+ * does not come from a column block kept by the memtable.
+ */
+int32_t tsdbIterMergerGetBlockRows(SIterMerger *merger, TSKEY maxKey) {
+  STsdbIter *iter = merger->iter;
+
+  ASSERT(!merger->isTomb);
+  if (iter == NULL || iter->type != TSDB_ITER_TYPE_MEMT || iter->filterByVersion ||
+      iter->row->row.type != TSDBROW_COL_FMT || iter->memtData->tbIter->aBlock == NULL) {
+    return 0;
+  }
+
+  SBlockData *pBlockData = iter->row->row.pBlockData;
+  int32_t     iRow = iter->row->row.iRow;
+
+  SRBTreeNode *node = tRBTreeMin(merger->iterTree);
+  if (node) {
+    STsdbIter *next = TCONTAINER_OF(node, STsdbIter, node);
+    if (next->row->suid == iter->row->suid && next->row->uid == iter->row->uid) {
+      maxKey = TMIN(maxKey, TSDBROW_TS(&next->row->row) - 1);
+    }
+  }
+
+  // timestamps of a kept block are increasing
+  int32_t lidx = iRow;
+  int32_t ridx = pBlockData->nRow;
+  while (lidx < ridx) {
+    int32_t midx = (lidx + ridx) >> 1;
+    if (pBlockData->aTSKEY[midx] <= maxKey) {
+      lidx = midx + 1;
+    } else {
+      ridx = midx;
+    }
+  }
+
+  return lidx - iRow;
+}
+
+// skip nRow rows returned by tsdbIterMergerGetBlockRows(), including the current one
+int32_t tsdbIterMergerSkipBlockRows(SIterMerger *merger, int32_t nRow) {
+  STsdbIter *iter = merger->iter;
+
+  ASSERT(nRow > 0);
+  if (nRow > 1) {
+    STbDataIter *tbIter = iter->memtData->tbIter;
+
+    // the memtable iterator is one row ahead, still in the same block
+    ASSERT(tbIter->aBlock[tbIter->iBlock].pBlockData == iter->row->row.pBlockData);
+    tbIter->iRow = iter->row->row.iRow + nRow - 1;
+    tsdbTbDataIterNext(tbIter);
+  }
+
+  return tsdbIterMergerNext(merger);
+}
+
 STombRecord *tsdbIterMergerGetTombRecord(SIterMerger *merger) {
   ASSERT(merger->isTomb);
   return merger->iter ? merger->iter->record : NULL;
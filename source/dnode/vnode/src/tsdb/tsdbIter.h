@@ -62,6 +62,8 @@ int32_t tsdbIterMergerOpen(const TTsdbIterArray *iterArray, SIterMerger **merger
 int32_t tsdbIterMergerClose(SIterMerger **merger);
 int32_t tsdbIterMergerNext(SIterMerger *merger);
 int32_t tsdbIterMergerSkipTableData(SIterMerger *merger, const TABLEID *tbid);
+int32_t tsdbIterMergerGetBlockRows(SIterMerger *merger, TSKEY maxKey);
+int32_t tsdbIterMergerSkipBlockRows(SIterMerger *merger, int32_t nRow);
 
 SRowInfo    *tsdbIterMergerGetData(SIterMerger *merger);
 STombRecord *tsdbIterMergerGetTombRecord(SIterMerger *merger);
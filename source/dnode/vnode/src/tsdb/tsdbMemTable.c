@@ -32,6 +32,9 @@
 #define SL_MOVE_FROM_POS 0x2
 
 static void    tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, STsdbRowKey *pKey, int32_t flags);
+static int64_t tbDataAppendBufSearch(TSDBROW **aChunk, int64_t nRow, STsdbRowKey *pKey, bool upper);
+static int32_t tbDataAppendBlockSearch(SMemAppendBlock *aBlock, int32_t nBlock, STsdbRowKey *pKey, bool upper);
+static int32_t tbDataBlockRowSearch(SBlockData *pBlockData, STsdbRowKey *pKey, bool upper);
 static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid_t uid, STbData **ppTbData);
 static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
                                         SSubmitTbData *pSubmitTbData, int32_t *affectedRows);
@@ -241,6 +244,52 @@ void tsdbTbDataIterOpen(STbData *pTbData, STsdbRowKey *pFrom, int8_t backward, S
   pIter->pTbData = pTbData;
   pIter->backward = backward;
   pIter->pRow = NULL;
+  pIter->aChunk = NULL;
+  pIter->aBlock = NULL;
+
+  if (!atomic_load_8(&pTbData->useSl) && (pIter->nBlock = atomic_load_32(&pTbData->ab.nBlock)) > 0) {
+    pIter->aBlock = (SMemAppendBlock *)atomic_load_ptr(&pTbData->ab.aBlock);
+    if (pFrom == NULL) {
+      pIter->iBlock = backward ? pIter->nBlock - 1 : 0;
+      pIter->iRow = backward ? pIter->aBlock[pIter->iBlock].pBlockData->nRow - 1 : 0;
+    } else if (backward) {
+      pIter->iBlock = tbDataAppendBlockSearch(pIter->aBlock, pIter->nBlock, pFrom, true);
+      if (pIter->iBlock == pIter->nBlock) {
+        pIter->iBlock--;
+        pIter->iRow = pIter->aBlock[pIter->iBlock].pBlockData->nRow - 1;
+      } else {
+        pIter->iRow = tbDataBlockRowSearch(pIter->aBlock[pIter->iBlock].pBlockData, pFrom, true) - 1;
+        if (pIter->iRow < 0 && --pIter->iBlock >= 0) {
+          pIter->iRow = pIter->aBlock[pIter->iBlock].pBlockData->nRow - 1;
+        }
+      }
+    } else {
+      pIter->iBlock = tbDataAppendBlockSearch(pIter->aBlock, pIter->nBlock, pFrom, false);
+      pIter->iRow = 0;
+      if (pIter->iBlock < pIter->nBlock) {
+        pIter->iRow = tbDataBlockRowSearch(pIter->aBlock[pIter->iBlock].pBlockData, pFrom, false);
+      }
+    }
+    return;
+  }
+
+  if (!atomic_load_8(&pTbData->useSl)) {
+    // the rows published before the chunks are always reachable from the chunks
+    pIter->nRow = atomic_load_64(&pTbData->ab.nRow);
+    pIter->aChunk = (TSDBROW **)atomic_load_ptr(&pTbData->ab.aChunk);
+    if (pIter->aChunk == NULL) {
+      // an empty table, iterate the empty skiplist
+      pIter->pNode = backward ? pHead : pTail;
+    } else if (pFrom == NULL) {
+      pIter->iRow = backward ? pIter->nRow - 1 : 0;
+    } else if (backward) {
+      pIter->iRow = tbDataAppendBufSearch(pIter->aChunk, pIter->nRow, pFrom, true) - 1;
+    } else {
+      pIter->iRow = tbDataAppendBufSearch(pIter->aChunk, pIter->nRow, pFrom, false);
+    }
+    return;
+  }
+
   if (pFrom == NULL) {
     // create from head or tail
     if (backward) {
@@ -262,6 +311,31 @@ void tsdbTbDataIterOpen(STbData *pTbData, STsdbRowKey *pFrom, int8_t backward, S
 
 bool tsdbTbDataIterNext(STbDataIter *pIter) {
   pIter->pRow = NULL;
+  if (pIter->aChunk) {
+    if (pIter->backward) {
+      if (pIter->iRow < 0) return false;
+      return --pIter->iRow >= 0;
+    } else {
+      if (pIter->iRow >= pIter->nRow) return false;
+      return ++pIter->iRow < pIter->nRow;
+    }
+  }
+
+  if (pIter->aBlock) {
+    if (pIter->backward) {
+      if (pIter->iBlock < 0) return false;
+      if (--pIter->iRow < 0 && --pIter->iBlock >= 0) {
+        pIter->iRow = pIter->aBlock[pIter->iBlock].pBlockData->nRow - 1;
+      }
+    } else {
+      if (pIter->iBlock >= pIter->nBlock) return false;
+      if (++pIter->iRow >= pIter->aBlock[pIter->iBlock].pBlockData->nRow && ++pIter->iBlock < pIter->nBlock) {
+        pIter->iRow = 0;
+      }
+    }
+    return pIter->iBlock >= 0 && pIter->iBlock < pIter->nBlock;
+  }
+
   if (pIter->backward) {
     ASSERT(pIter->pNode != pIter->pTbData->sl.pTail);
 
@@ -293,6 +367,10 @@ int64_t tsdbCountTbDataRows(STbData *pTbData) {
   SMemSkipListNode *pNode = pTbData->sl.pHead;
   int64_t           rowsNum = 0;
 
+  if (!atomic_load_8(&pTbData->useSl)) {
+    return atomic_load_64(&pTbData->ab.nRow);
+  }
+
   while (NULL != pNode) {
     pNode = SL_GET_NODE_FORWARD(pNode, 0);
     if (pNode == pTbData->sl.pTail) {
@@ -378,6 +456,14 @@ static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid
   pTbData->maxKey = TSKEY_MIN;
   pTbData->pHead = NULL;
   pTbData->pTail = NULL;
+  pTbData->useSl = 0;
+  pTbData->ab.nRow = 0;
+  pTbData->ab.aChunk = NULL;
+  pTbData->ab.nChunk = 0;
+  pTbData->ab.nChunkAlloc = 0;
+  pTbData->ab.aBlock = NULL;
+  pTbData->ab.nBlock = 0;
+  pTbData->ab.nBlockAlloc = 0;
   pTbData->sl.seed = taosRand();
   pTbData->sl.size = 0;
   pTbData->sl.maxLevel = maxLevel;
@@ -502,7 +588,7 @@ static FORCE_INLINE int8_t tsdbMemSkipListRandLevel(SMemSkipList *pSl) {
   return level;
 }
 static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListNode **pos, TSDBROW *pRow,
-                           int8_t forward) {
+                           int8_t forward, int8_t copy) {
   int32_t           code = 0;
   int8_t            level;
   SMemSkipListNode *pNode = NULL;
@@ -513,7 +599,7 @@ static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListN
   level = tsdbMemSkipListRandLevel(&pTbData->sl);
   nSize = SL_NODE_SIZE(level);
   if (pRow->type == TSDBROW_ROW_FMT) {
-    pNode = (SMemSkipListNode *)vnodeBufPoolMallocAligned(pPool, nSize + pRow->pTSRow->len);
+    pNode = (SMemSkipListNode *)vnodeBufPoolMallocAligned(pPool, copy ? nSize + pRow->pTSRow->len : nSize);
   } else if (pRow->type == TSDBROW_COL_FMT) {
     pNode = (SMemSkipListNode *)vnodeBufPoolMallocAligned(pPool, nSize);
   } else {
@@ -526,7 +612,7 @@ static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListN
 
   pNode->level = level;
   pNode->row = *pRow;
-  if (pRow->type == TSDBROW_ROW_FMT) {
+  if (pRow->type == TSDBROW_ROW_FMT && copy) {
     pNode->row.pTSRow = (SRow *)((char *)pNode + nSize);
     memcpy(pNode->row.pTSRow, pRow->pTSRow, pRow->pTSRow->len);
   }
@@ -574,6 +660,221 @@ _exit:
   return code;
 }
 
+static int64_t tbDataAppendBufCap(int32_t nChunk) {
+  if (nChunk <= MEM_AB_GEO_CHUNKS) {
+    return (((int64_t)1) << MEM_AB_MIN_CHUNK_BITS) * ((((int64_t)1) << nChunk) - 1);
+  }
+  return MEM_AB_GEO_ROWS + ((int64_t)(nChunk - MEM_AB_GEO_CHUNKS) << MEM_AB_MAX_CHUNK_BITS);
+}
+
+// the first row whose key is greater than (upper) or not less than (!upper) the key
+static int64_t tbDataAppendBufSearch(TSDBROW **aChunk, int64_t nRow, STsdbRowKey *pKey, bool upper) {
+  int64_t     lidx = 0;
+  int64_t     ridx = nRow;
+  STsdbRowKey tKey;
+
+  while (lidx < ridx) {
+    int64_t midx = lidx + ((ridx - lidx) >> 1);
+
+    tsdbRowGetKey(tsdbMemAppendBufRow(aChunk, midx), &tKey);
+    int32_t c = tsdbRowKeyCmpr(&tKey, pKey);
+    if (c < 0 || (upper && c == 0)) {
+      lidx = midx + 1;
+    } else {
+      ridx = midx;
+    }
+  }
+
+  return lidx;
+}
+
+// the first block whose last key is greater than (upper) or not less than (!upper) the key
+static int32_t tbDataAppendBlockSearch(SMemAppendBlock *aBlock, int32_t nBlock, STsdbRowKey *pKey, bool upper) {
+  int32_t     lidx = 0;
+  int32_t     ridx = nBlock;
+  STsdbRowKey tKey;
+
+  while (lidx < ridx) {
+    int32_t midx = lidx + ((ridx - lidx) >> 1);
+    int32_t c;
+
+    if (aBlock[midx].maxKey < pKey->key.ts) {
+      c = -1;
+    } else if (aBlock[midx].maxKey > pKey->key.ts) {
+      c = 1;
+    } else {
+      SBlockData *pBlockData = aBlock[midx].pBlockData;
+      tsdbRowGetKey(&tsdbRowFromBlockData(pBlockData, pBlockData->nRow - 1), &tKey);
+      c = tsdbRowKeyCmpr(&tKey, pKey);
+    }
+
+    if (c < 0 || (upper && c == 0)) {
+      lidx = midx + 1;
+    } else {
+      ridx = midx;
+    }
+  }
+
+  return lidx;
+}
+
+// the first row in the block whose key is greater than (upper) or not less than (!upper) the key
+static int32_t tbDataBlockRowSearch(SBlockData *pBlockData, STsdbRowKey *pKey, bool upper) {
+  int32_t     lidx = 0;
+  int32_t     ridx = pBlockData->nRow;
+  STsdbRowKey tKey;
+
+  while (lidx < ridx) {
+    int32_t midx = lidx + ((ridx - lidx) >> 1);
+
+    tsdbRowGetKey(&tsdbRowFromBlockData(pBlockData, midx), &tKey);
+    int32_t c = tsdbRowKeyCmpr(&tKey, pKey);
+    if (c < 0 || (upper && c == 0)) {
+      lidx = midx + 1;
+    } else {
+      ridx = midx;
+    }
+  }
+
+  return lidx;
+}
+
+// keep the column block as a whole if its rows are in key order and after the rows of the table, the key of the last
+// row is returned
+static int32_t tbDataAppendBlock(SMemTable *pMemTable, STbData *pTbData, SBlockData *pBlockData, STsdbRowKey *pKey,
+                                 bool *appended) {
+  int32_t        code = 0;
+  SVBufPool     *pPool = pMemTable->pTsdb->pVnode->inUse;
+  SMemAppendBuf *pBuf = &pTbData->ab;
+  TSDBROW        tRow = tsdbRowFromBlockData(pBlockData, 0);
+  STsdbRowKey    lastKey;
+
+  *appended = false;
+
+  if (pBuf->nBlock > 0) {
+    SBlockData *pLast = pBuf->aBlock[pBuf->nBlock - 1].pBlockData;
+    tsdbRowGetKey(&tsdbRowFromBlockData(pLast, pLast->nRow - 1), &lastKey);
+  }
+
+  for (; tRow.iRow < pBlockData->nRow; tRow.iRow++) {
+    tsdbRowGetKey(&tRow, pKey);
+    if ((tRow.iRow > 0 || pBuf->nBlock > 0) && tsdbRowKeyCmpr(pKey, &lastKey) <= 0) goto _exit;
+    lastKey = *pKey;
+  }
+
+  if (pBuf->nBlock == pBuf->nBlockAlloc) {
+    // the old array may still be used by readers, just leave it in the pool
+    int32_t          nBlockAlloc = pBuf->nBlockAlloc ? pBuf->nBlockAlloc * 2 : 4;
+    SMemAppendBlock *aBlock = (SMemAppendBlock *)vnodeBufPoolMalloc(pPool, sizeof(SMemAppendBlock) * nBlockAlloc);
+    if (aBlock == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+    if (pBuf->nBlock > 0) {
+      memcpy(aBlock, pBuf->aBlock, sizeof(SMemAppendBlock) * pBuf->nBlock);
+    }
+    atomic_store_ptr(&pBuf->aBlock, aBlock);
+    pBuf->nBlockAlloc = nBlockAlloc;
+  }
+
+  pBuf->aBlock[pBuf->nBlock] = (SMemAppendBlock){
+      .pBlockData = pBlockData,
+      .minKey = pBlockData->aTSKEY[0],
+      .maxKey = pBlockData->aTSKEY[pBlockData->nRow - 1],
+  };
+  atomic_store_32(&pBuf->nBlock, pBuf->nBlock + 1);
+  atomic_store_64(&pBuf->nRow, pBuf->nRow + pBlockData->nRow);
+  *appended = true;
+
+_exit:
+  return code;
+}
+
+// append a row after the nRow rows of the append buffer, the row is visible to readers after nRow is published
+static int32_t tbDataAppend(SMemTable *pMemTable, STbData *pTbData, TSDBROW *pRow, int64_t nRow) {
+  int32_t        code = 0;
+  SVBufPool     *pPool = pMemTable->pTsdb->pVnode->inUse;
+  SMemAppendBuf *pBuf = &pTbData->ab;
+
+  if (nRow == tbDataAppendBufCap(pBuf->nChunk)) {
+    if (pBuf->nChunk == pBuf->nChunkAlloc) {
+      // the old array may still be used by readers, just leave it in the pool
+      int32_t    nChunkAlloc = pBuf->nChunkAlloc ? pBuf->nChunkAlloc * 2 : MEM_AB_GEO_CHUNKS + 1;
+      TSDBROW **aChunk = (TSDBROW **)vnodeBufPoolMalloc(pPool, sizeof(TSDBROW *) * nChunkAlloc);
+      if (aChunk == NULL) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _exit;
+      }
+      if (pBuf->nChunk > 0) {
+        memcpy(aChunk, pBuf->aChunk, sizeof(TSDBROW *) * pBuf->nChunk);
+      }
+      atomic_store_ptr(&pBuf->aChunk, aChunk);
+      pBuf->nChunkAlloc = nChunkAlloc;
+    }
+
+    int64_t  nRowInChunk = tbDataAppendBufCap(pBuf->nChunk + 1) - nRow;
+    TSDBROW *pChunk = (TSDBROW *)vnodeBufPoolMallocAligned(pPool, sizeof(TSDBROW) * nRowInChunk);
+    if (pChunk == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+    pBuf->aChunk[pBuf->nChunk++] = pChunk;
+  }
+
+  TSDBROW *pDst = tsdbMemAppendBufRow(pBuf->aChunk, nRow);
+  *pDst = *pRow;
+  if (pRow->type == TSDBROW_ROW_FMT) {
+    pDst->pTSRow = (SRow *)vnodeBufPoolMallocAligned(pPool, pRow->pTSRow->len);
+    if (pDst->pTSRow == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+    memcpy(pDst->pTSRow, pRow->pTSRow, pRow->pTSRow->len);
+  }
+
+_exit:
+  return code;
+}
+
+// an out-of-order row arrives, move the rows in the append buffer to the skiplist
+static int32_t tbDataMoveToSkipList(SMemTable *pMemTable, STbData *pTbData) {
+  int32_t           code = 0;
+  SMemSkipListNode *pos[SL_MAX_LEVEL];
+  int64_t           nRow = pTbData->ab.nRow;
+
+  for (int8_t iLevel = 0; iLevel < pTbData->sl.maxLevel; iLevel++) {
+    pos[iLevel] = pTbData->sl.pHead;
+  }
+
+  if (pTbData->ab.nBlock > 0) {
+    for (int32_t iBlock = 0; iBlock < pTbData->ab.nBlock; iBlock++) {
+      TSDBROW tRow = tsdbRowFromBlockData(pTbData->ab.aBlock[iBlock].pBlockData, 0);
+      for (; tRow.iRow < tRow.pBlockData->nRow; tRow.iRow++) {
+        code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1, 0);
+        if (code) goto _err;
+      }
+    }
+  } else {
+    for (int64_t iRow = 0; iRow < nRow; iRow++) {
+      code = tbDataDoPut(pMemTable, pTbData, pos, tsdbMemAppendBufRow(pTbData->ab.aChunk, iRow), 1, 0);
+      if (code) goto _err;
+    }
+  }
+
+  atomic_store_8(&pTbData->useSl, 1);
+  return code;
+
+_err:
+  // readers still use the append buffer, so just drop the nodes linked
+  for (int8_t iLevel = 0; iLevel < pTbData->sl.maxLevel; iLevel++) {
+    SL_NODE_FORWARD(pTbData->sl.pHead, iLevel) = pTbData->sl.pTail;
+    SL_NODE_BACKWARD(pTbData->sl.pTail, iLevel) = pTbData->sl.pHead;
+  }
+  pTbData->sl.size = 0;
+  pTbData->sl.level = 0;
+  return code;
+}
+
 static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
                                         SSubmitTbData *pSubmitTbData, int32_t *affectedRows) {
   int32_t code = 0;
@@ -625,19 +926,57 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
     if (code) goto _exit;
   }
 
-  // loop to add each row to the skiplist
   SMemSkipListNode *pos[SL_MAX_LEVEL];
   TSDBROW           tRow = tsdbRowFromBlockData(pBlockData, 0);
   STsdbRowKey       key;
 
-  // first row
-  tsdbRowGetKey(&tRow, &key);
-  tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
-  if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0))) goto _exit;
-  pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
+  // keep the whole block in key order
+  if (!pTbData->useSl && pTbData->ab.nChunk == 0) {
+    bool appended = false;
+
+    if ((code = tbDataAppendBlock(pMemTable, pTbData, pBlockData, &key, &appended))) goto _exit;
+    if (appended) {
+      pTbData->minKey = TMIN(pTbData->minKey, pBlockData->aTSKEY[0]);
+      tRow.iRow = pBlockData->nRow;
+    } else if (pTbData->ab.nBlock > 0 && (code = tbDataMoveToSkipList(pMemTable, pTbData))) {
+      goto _exit;
+    }
+  }
+
+  // append the rows in key order
+  if (!pTbData->useSl && pTbData->ab.nBlock == 0) {
+    STsdbRowKey lastKey;
+    int64_t     nAbRow = pTbData->ab.nRow;
+
+    if (nAbRow > 0) {
+      tsdbRowGetKey(tsdbMemAppendBufRow(pTbData->ab.aChunk, nAbRow - 1), &lastKey);
+    }
+
+    for (; tRow.iRow < pBlockData->nRow; ++tRow.iRow) {
+      tsdbRowGetKey(&tRow, &key);
+      if (nAbRow > 0 && tsdbRowKeyCmpr(&key, &lastKey) <= 0) break;
+      if ((code = tbDataAppend(pMemTable, pTbData, &tRow, nAbRow))) break;
+
+      if (nAbRow++ == 0) pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
+      lastKey = key;
+    }
+    atomic_store_64(&pTbData->ab.nRow, nAbRow);
+    if (code) goto _exit;
+
+    if (tRow.iRow < pBlockData->nRow && (code = tbDataMoveToSkipList(pMemTable, pTbData))) goto _exit;
+  }
+
+  // loop to add each remain row to the skiplist
+  if (tRow.iRow < pBlockData->nRow) {
+    // first row
+    tsdbRowGetKey(&tRow, &key);
+    tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
+    if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0, 1))) goto _exit;
+    pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
+    ++tRow.iRow;
+  }
 
   // remain row
-  ++tRow.iRow;
   if (tRow.iRow < pBlockData->nRow) {
     for (int8_t iLevel = pos[0]->level; iLevel < pTbData->sl.maxLevel; iLevel++) {
       pos[iLevel] = SL_NODE_BACKWARD(pos[iLevel], iLevel);
@@ -650,7 +989,7 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
         tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
       }
 
-      if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1))) goto _exit;
+      if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1, 1))) goto _exit;
 
       ++tRow.iRow;
     }
@@ -686,14 +1025,45 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
   TSDBROW           tRow = {.type = TSDBROW_ROW_FMT, .version = version};
   int32_t           iRow = 0;
 
+  // rows of a different format from the column blocks kept
+  if (!pTbData->useSl && pTbData->ab.nBlock > 0 && (code = tbDataMoveToSkipList(pMemTable, pTbData))) {
+    goto _exit;
+  }
+
+  // append the rows in key order
+  if (!pTbData->useSl) {
+    STsdbRowKey lastKey;
+    int64_t     nAbRow = pTbData->ab.nRow;
+
+    if (nAbRow > 0) {
+      tsdbRowGetKey(tsdbMemAppendBufRow(pTbData->ab.aChunk, nAbRow - 1), &lastKey);
+    }
+
+    for (; iRow < nRow; iRow++) {
+      tRow.pTSRow = aRow[iRow];
+      tsdbRowGetKey(&tRow, &key);
+      if (nAbRow > 0 && tsdbRowKeyCmpr(&key, &lastKey) <= 0) break;
+      if ((code = tbDataAppend(pMemTable, pTbData, &tRow, nAbRow))) break;
+
+      if (nAbRow++ == 0) pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
+      lastKey = key;
+    }
+    atomic_store_64(&pTbData->ab.nRow, nAbRow);
+    if (code) goto _exit;
+
+    if (iRow < nRow && (code = tbDataMoveToSkipList(pMemTable, pTbData))) goto _exit;
+  }
+
   // backward put first data
-  tRow.pTSRow = aRow[iRow++];
-  tsdbRowGetKey(&tRow, &key);
-  tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
-  code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0);
-  if (code) goto _exit;
+  if (iRow < nRow) {
+    tRow.pTSRow = aRow[iRow++];
+    tsdbRowGetKey(&tRow, &key);
+    tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
+    code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0, 1);
+    if (code) goto _exit;
 
-  pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
+    pTbData->minKey = TMIN(pTbData->minKey, key.key.ts);
+  }
 
   // forward put rest data
   if (iRow < nRow) {
@@ -709,7 +1079,7 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
         tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
       }
 
-      code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1);
+      code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1, 1);
       if (code) goto _exit;
 
       iRow++;
@@ -734,7 +1104,12 @@ _exit:
   return code;
 }
 
-int32_t tsdbGetNRowsInTbData(STbData *pTbData) { return pTbData->sl.size; }
+int32_t tsdbGetNRowsInTbData(STbData *pTbData) {
+  if (!atomic_load_8(&pTbData->useSl)) {
+    return atomic_load_64(&pTbData->ab.nRow);
+  }
+  return pTbData->sl.size;
+}
 
 int32_t tsdbRefMemTable(SMemTable *pMemTable, SQueryNode *pQNode) {
   int32_t code = 0;
@@ -169,7 +169,7 @@ static int32_t setColumnIdSlotList(SBlockLoadSuppInfo* pSupInfo, SColumnInfo* pC
 
   pSupInfo->smaValid = true;
   pSupInfo->numOfCols = numOfCols;
-  pSupInfo->colId = taosMemoryMalloc(numOfCols * (sizeof(int16_t) * 2 + POINTER_BYTES));
+  pSupInfo->colId = taosMemoryMalloc(numOfCols * (sizeof(int16_t) * 3 + POINTER_BYTES));
   if (pSupInfo->colId == NULL) {
     taosMemoryFree(pSupInfo->colId);
     return TSDB_CODE_OUT_OF_MEMORY;
@@ -177,6 +177,8 @@ static int32_t setColumnIdSlotList(SBlockLoadSuppInfo* pSupInfo, SColumnInfo* pC
 
   pSupInfo->slotId = (int16_t*)((char*)pSupInfo->colId + (sizeof(int16_t) * numOfCols));
   pSupInfo->buildBuf = (char**)((char*)pSupInfo->slotId + (sizeof(int16_t) * numOfCols));
+  pSupInfo->filterColId = (int16_t*)((char*)pSupInfo->buildBuf + (POINTER_BYTES * numOfCols));
+  pSupInfo->numOfFilterCols = 0;
   for (int32_t i = 0; i < numOfCols; ++i) {
     pSupInfo->colId[i] = pCols[i].colId;
     pSupInfo->slotId[i] = pSlotIdList[i];
@@ -371,6 +373,7 @@ void resetDataBlockIterator(SDataBlockIter* pIter, int32_t order, bool needFree)
   pIter->order = order;
   pIter->index = -1;
   pIter->numOfBlocks = 0;
+  pIter->prefetchPos = 0;
   if (pIter->blockList == NULL) {
     pIter->blockList = taosArrayInit(4, sizeof(SFileDataBlockInfo));
   } else {
@@ -513,6 +516,7 @@ static int32_t tsdbReaderCreate(SVnode* pVnode, SQueryTableDataCond* pCond, void
 
   pReader->info.suid = pCond->suid;
   pReader->info.order = pCond->order;
+  pReader->info.prefetchBlocks = pCond->prefetchBlocks;
   pReader->info.verRange = getQueryVerRange(pVnode, pCond, level);
   pReader->info.window = updateQueryTimeWindow(pReader->pTsdb, &pCond->twindows);
 
@@ -1099,6 +1103,22 @@ static void blockInfoToRecord(SBrinRecord* record, SFileDataBlockInfo* pBlockInf
   record->count = pBlockInfo->count;
 }
 
+// When only the filter columns of the file block are loaded, the other columns are left to be copied after they are
+// loaded, and then the filter columns are not copied again.
+static bool skipCopyColumn(SReaderStatus* pStatus, SBlockLoadSuppInfo* pSupInfo, int32_t* pFilterIndex, int32_t i,
+                           bool loaded) {
+  if (pStatus->fBlockLoadStep == FILE_BLOCK_LOAD_FILTER_COLS) {
+    return !loaded;
+  } else if (pStatus->fBlockLoadStep == FILE_BLOCK_LOAD_REST_COLS) {
+    while (*pFilterIndex < pSupInfo->numOfFilterCols && pSupInfo->filterColId[*pFilterIndex] < pSupInfo->colId[i]) {
+      *pFilterIndex += 1;
+    }
+    return (*pFilterIndex < pSupInfo->numOfFilterCols) && (pSupInfo->filterColId[*pFilterIndex] == pSupInfo->colId[i]);
+  } else {
+    return false;
+  }
+}
+
 static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader, SRowKey* pLastProcKey) {
   SReaderStatus*      pStatus = &pReader->status;
   SDataBlockIter*     pBlockIter = &pStatus->blockIter;
@@ -1202,6 +1222,7 @@ static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader, SRowKey* pLastPro
   }
 
   int32_t colIndex = 0;
+  int32_t filterIndex = 0;
   int32_t num = pBlockData->nColData;
   while (i < numOfOutputCols && colIndex < num) {
     rowIndex = 0;
@@ -1209,6 +1230,9 @@ static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader, SRowKey* pLastPro
     SColData* pData = tBlockDataGetColDataByIdx(pBlockData, colIndex);
     if (pData->cid < pSupInfo->colId[i]) {
       colIndex += 1;
+    } else if (pData->cid == pSupInfo->colId[i] && skipCopyColumn(pStatus, pSupInfo, &filterIndex, i, true)) {
+      colIndex += 1;
+      i += 1;
     } else if (pData->cid == pSupInfo->colId[i]) {
       pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
 
@@ -1231,16 +1255,20 @@ static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader, SRowKey* pLastPro
       colIndex += 1;
       i += 1;
     } else {  // the specified column does not exist in file block, fill with null data
-      pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
-      colDataSetNNULL(pColData, 0, dumpedRows);
+      if (!skipCopyColumn(pStatus, pSupInfo, &filterIndex, i, false)) {
+        pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
+        colDataSetNNULL(pColData, 0, dumpedRows);
+      }
       i += 1;
     }
   }
 
   // fill the mis-matched columns with null value
   while (i < numOfOutputCols) {
-    pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
-    colDataSetNNULL(pColData, 0, dumpedRows);
+    if (!skipCopyColumn(pStatus, pSupInfo, &filterIndex, i, false)) {
+      pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
+      colDataSetNNULL(pColData, 0, dumpedRows);
+    }
     i += 1;
   }
 
@@ -1295,12 +1323,81 @@ static FORCE_INLINE STSchema* getTableSchemaImpl(STsdbReader* pReader, uint64_t
   return pReader->info.pSchema;
 }
 
+// Hint the blocks following the current one in the access order to be read from disk in background, while the
+// current one is loaded, decompressed and processed.
+static void doPrefetchFileBlocks(STsdbReader* pReader, SDataBlockIter* pBlockIter) {
+  int32_t depth = pReader->info.prefetchBlocks;
+  if (depth <= 0 || pReader->pFileReader == NULL) {
+    return;
+  }
+
+  bool    asc = ASCENDING_TRAVERSE(pBlockIter->order);
+  int32_t pos = asc ? pBlockIter->index : (pBlockIter->numOfBlocks - 1 - pBlockIter->index);
+  if (pos < pBlockIter->prefetchPos) {
+    pReader->cost.prefetchHits += 1;
+  } else {
+    pReader->cost.prefetchMisses += 1;
+    pBlockIter->prefetchPos = pos + 1;
+  }
+
+  int32_t end = TMIN(pos + 1 + depth, pBlockIter->numOfBlocks);
+  for (; pBlockIter->prefetchPos < end; ++pBlockIter->prefetchPos) {
+    int32_t index = asc ? pBlockIter->prefetchPos : (pBlockIter->numOfBlocks - 1 - pBlockIter->prefetchPos);
+
+    SBrinRecord         record;
+    SFileDataBlockInfo* pBlockInfo = taosArrayGet(pBlockIter->blockList, index);
+    blockInfoToRecord(&record, pBlockInfo, &pReader->suppInfo);
+
+    int32_t code = tsdbDataFileReaderPrefetchBlock(pReader->pFileReader, &record);
+    if (code != TSDB_CODE_SUCCESS) {
+      tsdbWarn("%p failed to prefetch file block, global index:%d, code:%s, %s", pReader, index, tstrerror(code),
+               pReader->idStr);
+      pBlockIter->prefetchPos = pBlockIter->numOfBlocks;
+      break;
+    }
+    pReader->cost.prefetchBlocks += 1;
+  }
+}
+
+static void finishFileBlockLoad(STsdbReader* pReader) {
+  SReaderStatus* pStatus = &pReader->status;
+  if (pStatus->fBlockLoadStep == FILE_BLOCK_LOAD_FILTER_COLS) {
+    // no rows are qualified by the filter columns, the other columns are never loaded
+    pReader->cost.filterOutBlocks += 1;
+    pReader->cost.colSkipSize += pStatus->fBlockSkipSize;
+  }
+
+  pStatus->fBlockLoadStep = FILE_BLOCK_LOAD_ALL;
+  pStatus->fBlockSkipSize = 0;
+}
+
+// Only the columns in pIdList are loaded first if they are part of the queried columns, and the filter of the scan
+// applied on them decides whether the other columns need to be loaded.
+static bool setFilterColumnList(STsdbReader* pReader, const SArray* pIdList) {
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  int32_t             num = taosArrayGetSize(pIdList);
+
+  pSup->numOfFilterCols = 0;
+  for (int32_t i = 1; i < pSup->numOfCols; ++i) {
+    for (int32_t j = 0; j < num; ++j) {
+      if (*(col_id_t*)taosArrayGet(pIdList, j) == pSup->colId[i]) {
+        pSup->filterColId[pSup->numOfFilterCols++] = pSup->colId[i];
+        break;
+      }
+    }
+  }
+
+  return pSup->numOfFilterCols < pSup->numOfCols - 1;
+}
+
 static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
-                                   uint64_t uid) {
+                                   uint64_t uid, bool filterColsOnly) {
   int32_t   code = 0;
   STSchema* pSchema = pReader->info.pSchema;
   int64_t   st = taosGetTimestampUs();
+  int64_t   size = 0;
 
+  finishFileBlockLoad(pReader);
   tBlockDataReset(pBlockData);
 
   if (pReader->info.pSchema == NULL) {
@@ -1315,11 +1412,21 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
   SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(pBlockIter);
   SFileBlockDumpInfo* pDumpInfo = &pReader->status.fBlockDumpInfo;
 
+  doPrefetchFileBlocks(pReader, pBlockIter);
+
   SBrinRecord tmp;
   blockInfoToRecord(&tmp, pBlockInfo, pSup);
   SBrinRecord* pRecord = &tmp;
-  code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, &pSup->colId[1],
-                                           pSup->numOfCols - 1);
+  if (filterColsOnly) {
+    code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, NULL, 0);
+    if (code == TSDB_CODE_SUCCESS) {
+      code = tsdbDataFileReadBlockDataAppendColumn(pReader->pFileReader, pRecord, pBlockData, pSchema,
+                                                   pSup->filterColId, pSup->numOfFilterCols, &size);
+    }
+  } else {
+    code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, &pSup->colId[1],
+                                             pSup->numOfCols - 1);
+  }
   if (code != TSDB_CODE_SUCCESS) {
     tsdbError("%p error occurs in loading file block, global index:%d, table index:%d, brange:%" PRId64 "-%" PRId64
               ", rows:%d, code:%s %s",
@@ -1338,9 +1445,45 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
   pReader->cost.blockLoadTime += elapsedTime;
   pDumpInfo->allDumped = false;
 
+  if (filterColsOnly) {
+    pReader->status.fBlockLoadStep = FILE_BLOCK_LOAD_FILTER_COLS;
+    pReader->status.fBlockSkipSize = pRecord->blockSize - pRecord->blockKeySize - size;
+    pReader->cost.filterColBlocks += 1;
+    pReader->cost.colLoadSize += size;
+  }
+
   return TSDB_CODE_SUCCESS;
 }
 
+// load the columns of current file block other than the filter columns, which have been loaded
+static int32_t doLoadFileBlockRestData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData) {
+  int32_t             code = 0;
+  int64_t             st = taosGetTimestampUs();
+  int64_t             size = 0;
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(pBlockIter);
+
+  if (pBlockData->nRow == 0) {
+    return code;
+  }
+
+  SBrinRecord record;
+  blockInfoToRecord(&record, pBlockInfo, pSup);
+  code = tsdbDataFileReadBlockDataAppendColumn(pReader->pFileReader, &record, pBlockData, pReader->info.pSchema,
+                                               &pSup->colId[1], pSup->numOfCols - 1, &size);
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("%p error occurs in loading the rest columns of file block, global index:%d, table index:%d, brange:%" PRId64
+              "-%" PRId64 ", rows:%d, code:%s %s",
+              pReader, pBlockIter->index, pBlockInfo->tbBlockIdx, pBlockInfo->firstKey, pBlockInfo->lastKey,
+              pBlockInfo->numRow, tstrerror(code), pReader->idStr);
+    return code;
+  }
+
+  pReader->cost.colLoadSize += size;
+  pReader->cost.blockLoadTime += (taosGetTimestampUs() - st) / 1000.0;
+  return code;
+}
+
 /**
  * This is an two rectangles overlap cases.
  */
@@ -2464,7 +2607,7 @@ static int32_t loadNeighborIfOverlap(SFileDataBlockInfo* pBlockInfo, STableBlock
     setFileBlockActiveInBlockIter(pReader, pBlockIter, neighborIndex, step);
 
     // 3. load the neighbor block, and set it to be the currently accessed file data block
-    code = doLoadFileBlockData(pReader, pBlockIter, &pStatus->fileBlockData, pBlockInfo->uid);
+    code = doLoadFileBlockData(pReader, pBlockIter, &pStatus->fileBlockData, pBlockInfo->uid, false);
     if (code != TSDB_CODE_SUCCESS) {
       return code;
     }
@@ -3018,7 +3161,7 @@ static int32_t doBuildDataBlock(STsdbReader* pReader) {
 
   TSDBKEY keyInBuf = getCurrentKeyInBuf(pScanInfo, pReader);
   if (fileBlockShouldLoad(pReader, pBlockInfo, pScanInfo, keyInBuf)) {
-    code = doLoadFileBlockData(pReader, pBlockIter, &pStatus->fileBlockData, pScanInfo->uid);
+    code = doLoadFileBlockData(pReader, pBlockIter, &pStatus->fileBlockData, pScanInfo->uid, false);
     if (code != TSDB_CODE_SUCCESS) {
       return code;
     }
@@ -4421,6 +4564,8 @@ void tsdbReaderClose2(STsdbReader* pReader) {
     tsdbDataFileReaderClose(&pReader->pFileReader);
   }
 
+  finishFileBlockLoad(pReader);
+
   SReadCostSummary* pCost = &pReader->cost;
   SFilesetIter*     pFilesetIter = &pReader->status.fileIter;
   if (pFilesetIter->pSttBlockReader != NULL) {
@@ -4451,12 +4596,16 @@ void tsdbReaderClose2(STsdbReader* pReader) {
       "build in-memory-block-time:%.2f ms, sttBlocks:%" PRId64 ", sttBlocks-time:%.2f ms, sttStatisBlock:%" PRId64
       ", stt-statis-Block-time:%.2f ms, composed-blocks:%" PRId64
       ", composed-blocks-time:%.2fms, STableBlockScanInfo size:%.2f Kb, createTime:%.2f ms,createSkylineIterTime:%.2f "
-      "ms, initSttBlockReader:%.2fms, %s",
+      "ms, initSttBlockReader:%.2fms, prefetch-blocks:%" PRId64 ", prefetch-hits:%" PRId64 ", prefetch-misses:%" PRId64
+      ", filter-col-blocks:%" PRId64 ", filter-out-blocks:%" PRId64 ", col-load-size:%" PRId64
+      ", col-skip-size:%" PRId64 ", %s",
       pReader, pCost->headFileLoad, pCost->headFileLoadTime, pCost->smaDataLoad, pCost->smaLoadTime, pCost->numOfBlocks,
       pCost->blockLoadTime, pCost->buildmemBlock, pCost->sttCost.loadBlocks, pCost->sttCost.blockElapsedTime,
       pCost->sttCost.loadStatisBlocks, pCost->sttCost.statisElapsedTime, pCost->composedBlocks,
       pCost->buildComposedBlockTime, numOfTables * sizeof(STableBlockScanInfo) / 1000.0, pCost->createScanInfoList,
-      pCost->createSkylineIterTime, pCost->initSttBlockReader, pReader->idStr);
+      pCost->createSkylineIterTime, pCost->initSttBlockReader, pCost->prefetchBlocks, pCost->prefetchHits,
+      pCost->prefetchMisses, pCost->filterColBlocks, pCost->filterOutBlocks, pCost->colLoadSize, pCost->colSkipSize,
+      pReader->idStr);
 
   taosMemoryFree(pReader->idStr);
 
@@ -4719,6 +4868,7 @@ static int32_t doTsdbNextDataBlock2(STsdbReader* pReader, bool* hasNext) {
   // cleanup the data that belongs to the previous data block
   SSDataBlock* pBlock = pReader->resBlockInfo.pResBlock;
   blockDataCleanup(pBlock);
+  finishFileBlockLoad(pReader);
 
   *hasNext = false;
 
@@ -4988,7 +5138,7 @@ int32_t tsdbRetrieveDatablockSMA2(STsdbReader* pReader, SSDataBlock* pDataBlock,
   return code;
 }
 
-static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader) {
+static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader, SArray* pIdList) {
   SReaderStatus*      pStatus = &pReader->status;
   int32_t             code = TSDB_CODE_SUCCESS;
   SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(&pStatus->blockIter);
@@ -5002,15 +5152,28 @@ static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader) {
     return NULL;
   }
 
-  code = doLoadFileBlockData(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid);
-  if (code != TSDB_CODE_SUCCESS) {
-    tBlockDataReset(&pStatus->fileBlockData);
-    terrno = code;
-    return NULL;
+  if (pStatus->fBlockLoadStep == FILE_BLOCK_LOAD_FILTER_COLS && pIdList == NULL) {
+    // the filter columns have been copied, copy the other columns of the same rows
+    code = doLoadFileBlockRestData(pReader, &pStatus->blockIter, &pStatus->fileBlockData);
+    if (code == TSDB_CODE_SUCCESS) {
+      pStatus->fBlockLoadStep = FILE_BLOCK_LOAD_REST_COLS;
+      pStatus->fBlockDumpInfo = pStatus->fBlockFilterDumpInfo;
+      code = copyBlockDataToSDataBlock(pReader, &pBlockScanInfo->lastProcKey);
+    }
+
+    pStatus->fBlockLoadStep = FILE_BLOCK_LOAD_ALL;
+  } else {
+    bool filterColsOnly = (pIdList != NULL) && setFilterColumnList(pReader, pIdList);
+    code = doLoadFileBlockData(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid,
+                               filterColsOnly);
+    if (code == TSDB_CODE_SUCCESS) {
+      pStatus->fBlockFilterDumpInfo = pStatus->fBlockDumpInfo;
+      code = copyBlockDataToSDataBlock(pReader, &pBlockScanInfo->lastProcKey);
+    }
   }
 
-  code = copyBlockDataToSDataBlock(pReader, &pBlockScanInfo->lastProcKey);
   if (code != TSDB_CODE_SUCCESS) {
+    pStatus->fBlockLoadStep = FILE_BLOCK_LOAD_ALL;
     tBlockDataReset(&pStatus->fileBlockData);
     terrno = code;
     return NULL;
@@ -5019,6 +5182,8 @@ static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader) {
   return pReader->resBlockInfo.pResBlock;
 }
 
+// If pIdList is not NULL, only the columns in it are loaded and copied for a file data block, and the other columns of
+// the same rows are copied by the next call with a NULL pIdList, unless the data block is released.
 SSDataBlock* tsdbRetrieveDataBlock2(STsdbReader* pReader, SArray* pIdList) {
   STsdbReader* pTReader = pReader;
   if (pReader->type == TIMEWINDOW_RANGE_EXTERNAL) {
@@ -5038,7 +5203,11 @@ SSDataBlock* tsdbRetrieveDataBlock2(STsdbReader* pReader, SArray* pIdList) {
     return pTReader->resBlockInfo.pResBlock;
   }
 
-  SSDataBlock* ret = doRetrieveDataBlock(pTReader);
+  SSDataBlock* ret = doRetrieveDataBlock(pTReader, pIdList);
+  if (pTReader->status.fBlockLoadStep == FILE_BLOCK_LOAD_FILTER_COLS) {
+    // the read mutex is held until the other columns are retrieved, or the data block is released
+    return ret;
+  }
 
   qTrace("tsdb/read-retrieve: %p, unlock read mutex", pReader);
   tsdbReleaseReader(pReader);
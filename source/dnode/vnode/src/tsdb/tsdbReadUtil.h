@@ -62,6 +62,12 @@ typedef enum {
   EXTERNAL_ROWS_NEXT = 0x3,
 } EContentData;
 
+typedef enum {
+  FILE_BLOCK_LOAD_ALL = 0x0,
+  FILE_BLOCK_LOAD_FILTER_COLS = 0x1,  // only the filter columns are loaded, the others are loaded on demand
+  FILE_BLOCK_LOAD_REST_COLS = 0x2,    // the columns other than the filter columns are loaded
+} EFileBlockLoadStep;
+
 typedef struct STsdbReaderInfo {
   uint64_t      suid;
   STSchema*     pSchema;
@@ -69,6 +75,7 @@ typedef struct STsdbReaderInfo {
   STimeWindow   window;
   SVersionRange verRange;
   int16_t       order;
+  int32_t       prefetchBlocks;  // number of file blocks read ahead of the current one, 0 to disable
 } STsdbReaderInfo;
 
 typedef struct SBlockInfoBuf {
@@ -151,6 +158,13 @@ typedef struct SReadCostSummary {
   double  createScanInfoList;
   double  createSkylineIterTime;
   double  initSttBlockReader;
+  int64_t prefetchBlocks;   // file blocks hinted to be read ahead
+  int64_t prefetchHits;     // loaded file blocks that had been read ahead
+  int64_t prefetchMisses;   // loaded file blocks that had not been read ahead
+  int64_t filterColBlocks;  // file blocks loaded with the filter columns first
+  int64_t filterOutBlocks;  // file blocks of which the columns other than the filter columns are never loaded
+  int64_t colLoadSize;      // bytes of columns read and decoded in the blocks loaded with the filter columns first
+  int64_t colSkipSize;      // bytes of columns not read in the blocks filtered out
 } SReadCostSummary;
 
 typedef struct STableUidList {
@@ -182,6 +196,8 @@ typedef struct SBlockLoadSuppInfo {
   int16_t*            colId;
   int16_t*            slotId;
   char**              buildBuf;  // build string tmp buffer, todo remove it later after all string format being updated.
+  int16_t*            filterColId;  // the columns in colId referenced by the filter of the scan, in ascending order
+  int32_t             numOfFilterCols;
   int32_t             numOfCols;
   int32_t             numOfPks;
   SColumnInfo         pk;
@@ -241,7 +257,8 @@ typedef struct SDataBlockIter {
   int32_t    index;
   SArray*    blockList;  // SArray<SFileDataBlockInfo>
   int32_t    order;
-  SDataBlk   block;  // current SDataBlk data
+  SDataBlk   block;        // current SDataBlk data
+  int32_t    prefetchPos;  // blocks before this position in the access order have been read ahead
 } SDataBlockIter;
 
 typedef struct SFileBlockDumpInfo {
@@ -259,6 +276,9 @@ typedef struct SReaderStatus {
   STableBlockScanInfo** pTableIter;         // table iterator used in building in-memory buffer data blocks.
   STableUidList         uidList;            // check tables in uid order, to avoid the repeatly load of blocks in STT.
   SFileBlockDumpInfo    fBlockDumpInfo;
+  EFileBlockLoadStep    fBlockLoadStep;
+  SFileBlockDumpInfo    fBlockFilterDumpInfo;  // dump info before the filter columns of current block are copied
+  int64_t               fBlockSkipSize;        // bytes of the columns of current block not loaded yet
   STFileSet*            pCurrentFileset;  // current opened file set
   SBlockData            fileBlockData;
   SFilesetIter          fileIter;
@@ -162,6 +162,7 @@ void tsdbCloseFile(STsdbFD **ppFD) {
   STsdbFD *pFD = *ppFD;
   if (pFD) {
     taosMemoryFree(pFD->pBuf);
+    taosMemoryFree(pFD->pCryptKey);
     // if (!pFD->s3File) {
     taosCloseFile(&pFD->pFD);
     //}
@@ -170,6 +171,31 @@ void tsdbCloseFile(STsdbFD **ppFD) {
   }
 }
 
+#define TSDB_CRYPT_UNIT_LEN 128  // pages are encrypted unit by unit
+
+static int32_t tsdbGetFileCryptKey(STsdbFD *pFD, char *encryptKey, SCryptKey **ppKey) {
+  int32_t code = 0;
+
+  if (pFD->pCryptKey == NULL) {
+    SCryptKey *pKey = taosMemoryMalloc(sizeof(SCryptKey));
+    if (pKey == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+
+    code = CBC_InitKey(pKey, encryptKey);
+    if (code) {
+      taosMemoryFree(pKey);
+      goto _exit;
+    }
+    pFD->pCryptKey = pKey;
+  }
+  *ppKey = pFD->pCryptKey;
+
+_exit:
+  return code;
+}
+
 static int32_t tsdbWriteFilePage(STsdbFD *pFD, int32_t encryptAlgorithm, char *encryptKey) {
   int32_t code = 0;
 
@@ -201,24 +227,14 @@ static int32_t tsdbWriteFilePage(STsdbFD *pFD, int32_t encryptAlgorithm, char *e
 
     if (encryptAlgorithm == DND_CA_SM4) {
       // if(tsiEncryptAlgorithm == DND_CA_SM4 && (tsiEncryptScope & DND_CS_TSDB) == DND_CS_TSDB){
-      unsigned char PacketData[128];
-      int           NewLen;
-      int32_t       count = 0;
-      while (count < pFD->szPage) {
-        SCryptOpts opts = {0};
-        opts.len = 128;
-        opts.source = pFD->pBuf + count;
-        opts.result = PacketData;
-        opts.unitLen = 128;
-        // strncpy(opts.key, tsEncryptKey, 16);
-        strncpy(opts.key, encryptKey, ENCRYPT_KEY_LEN);
-
-        NewLen = CBC_Encrypt(&opts);
-
-        memcpy(pFD->pBuf + count, PacketData, NewLen);
-        count += NewLen;
+      SCryptKey *pKey = NULL;
+      code = tsdbGetFileCryptKey(pFD, encryptKey, &pKey);
+      if (code) goto _exit;
+
+      if (CBC_EncryptPage(pKey, (char *)pFD->pBuf, pFD->szPage, TSDB_CRYPT_UNIT_LEN) != pFD->szPage) {
+        code = TSDB_CODE_DNODE_INVALID_ENCRYPT_CONFIG;
+        goto _exit;
       }
-      // tsdbDebug("CBC_Encrypt count:%d %s", count, __FUNCTION__);
     }
 
     n = taosWriteFile(pFD->pFD, pFD->pBuf, pFD->szPage);
@@ -299,25 +315,14 @@ static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno, int32_t encryptAlgor
 
   if (encryptAlgorithm == DND_CA_SM4) {
     // if(tsiEncryptAlgorithm == DND_CA_SM4 && (tsiEncryptScope & DND_CS_TSDB) == DND_CS_TSDB){
-    unsigned char PacketData[128];
-    int           NewLen;
-
-    int32_t count = 0;
-    while (count < pFD->szPage) {
-      SCryptOpts opts = {0};
-      opts.len = 128;
-      opts.source = pFD->pBuf + count;
-      opts.result = PacketData;
-      opts.unitLen = 128;
-      // strncpy(opts.key, tsEncryptKey, 16);
-      strncpy(opts.key, encryptKey, ENCRYPT_KEY_LEN);
-
-      NewLen = CBC_Decrypt(&opts);
+    SCryptKey *pKey = NULL;
+    code = tsdbGetFileCryptKey(pFD, encryptKey, &pKey);
+    if (code) goto _exit;
 
-      memcpy(pFD->pBuf + count, PacketData, NewLen);
-      count += NewLen;
+    if (CBC_DecryptPage(pKey, (char *)pFD->pBuf, pFD->szPage, TSDB_CRYPT_UNIT_LEN) != pFD->szPage) {
+      code = TSDB_CODE_DNODE_INVALID_ENCRYPT_CONFIG;
+      goto _exit;
     }
-    // tsdbDebug("CBC_Decrypt count:%d %s", count, __FUNCTION__);
   }
 
   // check
@@ -365,6 +370,56 @@ _exit:
   return code;
 }
 
+#ifndef WINDOWS
+#define TSDB_READ_VEC_PAGES 128  // max number of pages fetched by one vectored read
+
+// Read the whole pages [pgno, pgno + nPage) by one vectored read. The page contents are scattered into pBuf directly
+// and the checksums are verified in place afterwards, instead of copying each page through pFD->pBuf.
+static int32_t tsdbReadFilePages(STsdbFD *pFD, int64_t pgno, int32_t nPage, uint8_t *pBuf) {
+  int32_t     code = 0;
+  int32_t     szPgCont = PAGE_CONTENT_SIZE(pFD->szPage);
+  TSCKSUM     cksum[TSDB_READ_VEC_PAGES];
+  TdFileIovec iov[TSDB_READ_VEC_PAGES * 2];
+
+  ASSERT(nPage <= TSDB_READ_VEC_PAGES);
+
+  int64_t offset = PAGE_OFFSET(pgno, pFD->szPage);
+  if (pFD->lcn > 1) {
+    SVnodeCfg *pCfg = &pFD->pTsdb->pVnode->config;
+    int64_t    chunksize = (int64_t)pCfg->tsdbPageSize * pCfg->s3ChunkSize;
+    int64_t    chunkoffset = chunksize * (pFD->lcn - 1);
+
+    offset -= chunkoffset;
+  }
+  ASSERT(offset >= 0);
+
+  for (int32_t i = 0; i < nPage; ++i) {
+    iov[2 * i] = (TdFileIovec){.base = pBuf + (int64_t)i * szPgCont, .len = szPgCont};
+    iov[2 * i + 1] = (TdFileIovec){.base = &cksum[i], .len = sizeof(TSCKSUM)};
+  }
+
+  int64_t n = taosPReadvFile(pFD->pFD, iov, nPage * 2, offset);
+  if (n < 0) {
+    code = TAOS_SYSTEM_ERROR(errno);
+    goto _exit;
+  } else if (n < (int64_t)nPage * pFD->szPage) {
+    code = TSDB_CODE_FILE_CORRUPTED;
+    goto _exit;
+  }
+
+  // check
+  for (int32_t i = 0; i < nPage; ++i) {
+    if (taosCheckChecksum(pBuf + (int64_t)i * szPgCont, szPgCont, cksum[i])) {
+      code = TSDB_CODE_FILE_CORRUPTED;
+      goto _exit;
+    }
+  }
+
+_exit:
+  return code;
+}
+#endif
+
 static int32_t tsdbReadFileImp(STsdbFD *pFD, int64_t offset, uint8_t *pBuf, int64_t size, int32_t encryptAlgorithm,
                                char *encryptKey) {
   int32_t code = 0;
@@ -379,6 +434,25 @@ static int32_t tsdbReadFileImp(STsdbFD *pFD, int64_t offset, uint8_t *pBuf, int6
 
   while (n < size) {
     if (pFD->pgno != pgno) {
+#ifndef WINDOWS
+      // a run of whole pages is read into the destination at once, the encrypted pages are decrypted one by one
+      int64_t nPage = 0;
+      if (bOffset == 0 && pgno > 1 && encryptAlgorithm != DND_CA_SM4) {
+        nPage = TMIN((size - n) / szPgCont, TSDB_READ_VEC_PAGES);
+        if (pFD->pgno > pgno && pFD->pgno < pgno + nPage) {
+          nPage = pFD->pgno - pgno;  // the page in pFD->pBuf may not be flushed yet
+        }
+      }
+
+      if (nPage > 1) {
+        code = tsdbReadFilePages(pFD, pgno, nPage, pBuf + n);
+        if (code) goto _exit;
+
+        n += nPage * szPgCont;
+        pgno += nPage;
+        continue;
+      }
+#endif
       code = tsdbReadFilePage(pFD, pgno, encryptAlgorithm, encryptKey);
       if (code) goto _exit;
     }
@@ -604,6 +678,45 @@ int32_t tsdbReadFileToBuffer(STsdbFD *pFD, int64_t offset, int64_t size, SBuffer
   return code;
 }
 
+int32_t tsdbPrefetchFile(STsdbFD *pFD, int64_t offset, int64_t size) {
+  int32_t code = 0;
+  if (size <= 0) {
+    goto _exit;
+  }
+
+  if (!pFD->pFD) {
+    code = tsdbOpenFileImpl(pFD);
+    if (code) {
+      goto _exit;
+    }
+  }
+
+  // the remote chunks are fetched through the s3 page cache
+  if (pFD->s3File && pFD->lcn > 1) {
+    goto _exit;
+  }
+
+  int64_t pgno = OFFSET_PGNO(LOGIC_TO_FILE_OFFSET(offset, pFD->szPage), pFD->szPage);
+  int64_t pgnoEnd = OFFSET_PGNO(LOGIC_TO_FILE_OFFSET(offset + size - 1, pFD->szPage), pFD->szPage);
+  int64_t fOffset = PAGE_OFFSET(pgno, pFD->szPage);
+  if (pFD->lcn > 1) {
+    SVnodeCfg *pCfg = &pFD->pTsdb->pVnode->config;
+    int64_t    chunksize = (int64_t)pCfg->tsdbPageSize * pCfg->s3ChunkSize;
+
+    fOffset -= chunksize * (pFD->lcn - 1);
+  }
+  if (fOffset < 0) {
+    goto _exit;
+  }
+
+  if (taosPrefetchFile(pFD->pFD, fOffset, (pgnoEnd - pgno + 1) * pFD->szPage) < 0) {
+    code = TAOS_SYSTEM_ERROR(errno);
+  }
+
+_exit:
+  return code;
+}
+
 int32_t tsdbFsyncFile(STsdbFD *pFD, int32_t encryptAlgorithm, char *encryptKey) {
   int32_t code = 0;
   /*
@@ -1008,6 +1008,50 @@ _exit:
   return code;
 }
 
+// write nRow rows of one table starting at row, which must be a column format row of a block with increasing keys
+int32_t tsdbSttFileWriteBlockRows(SSttFileWriter *writer, SRowInfo *row, int32_t nRow) {
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  // the first row may update the last row written, the others follow it
+  code = tsdbSttFileWriteRow(writer, row);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  SRowInfo rowInfo[1] = {row[0]};
+  int32_t  eRow = row->row.iRow + nRow;
+  for (rowInfo->row.iRow++; rowInfo->row.iRow < eRow; rowInfo->row.iRow++) {
+    for (;;) {
+      code = tStatisBlockPut(writer->staticBlock, rowInfo, writer->config->maxRow);
+      if (code == TSDB_CODE_INVALID_PARA) {
+        code = tsdbSttFileDoWriteStatisBlock(writer);
+        TSDB_CHECK_CODE(code, lino, _exit);
+        continue;
+      } else {
+        TSDB_CHECK_CODE(code, lino, _exit);
+      }
+      break;
+    }
+  }
+
+  for (int32_t iRow = row->row.iRow + 1; iRow < eRow;) {
+    if (writer->blockData->nRow >= writer->config->maxRow) {
+      code = tsdbSttFileDoWriteBlockData(writer);
+      TSDB_CHECK_CODE(code, lino, _exit);
+    }
+
+    int32_t n = TMIN(eRow - iRow, writer->config->maxRow - writer->blockData->nRow);
+    code = tBlockDataAppendBlockRows(writer->blockData, row->row.pBlockData, iRow, n, row->uid);
+    TSDB_CHECK_CODE(code, lino, _exit);
+    iRow += n;
+  }
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(writer->config->tsdb->pVnode), lino, code);
+  }
+  return code;
+}
+
 int32_t tsdbSttFileWriteBlockData(SSttFileWriter *writer, SBlockData *bdata) {
   int32_t code = 0;
   int32_t lino = 0;
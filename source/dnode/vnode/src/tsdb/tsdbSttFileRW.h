@@ -67,6 +67,7 @@ typedef struct SSttFileWriterConfig SSttFileWriterConfig;
 int32_t tsdbSttFileWriterOpen(const SSttFileWriterConfig *config, SSttFileWriter **writer);
 int32_t tsdbSttFileWriterClose(SSttFileWriter **writer, int8_t abort, TFileOpArray *opArray);
 int32_t tsdbSttFileWriteRow(SSttFileWriter *writer, SRowInfo *row);
+int32_t tsdbSttFileWriteBlockRows(SSttFileWriter *writer, SRowInfo *row, int32_t nRow);
 int32_t tsdbSttFileWriteBlockData(SSttFileWriter *writer, SBlockData *pBlockData);
 int32_t tsdbSttFileWriteTombRecord(SSttFileWriter *writer, const STombRecord *record);
 bool    tsdbSttFileWriterIsOpened(SSttFileWriter *writer);
@@ -1343,6 +1343,64 @@ int32_t tBlockDataAppendRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTS
 _exit:
   return code;
 }
+// append rows [iRow, iRow + nRow) of pBlockDataFrom column by column, keys and versions are copied as a whole
+int32_t tBlockDataAppendBlockRows(SBlockData *pBlockData, SBlockData *pBlockDataFrom, int32_t iRow, int32_t nRow,
+                                  int64_t uid) {
+  int32_t code = 0;
+
+  ASSERT(pBlockData->suid || pBlockData->uid);
+  ASSERT(iRow >= 0 && nRow > 0 && iRow + nRow <= pBlockDataFrom->nRow);
+
+  // uid
+  if (pBlockData->uid == 0) {
+    ASSERT(uid);
+    code = tRealloc((uint8_t **)&pBlockData->aUid, sizeof(int64_t) * (pBlockData->nRow + nRow));
+    if (code) goto _exit;
+    for (int32_t i = 0; i < nRow; i++) {
+      pBlockData->aUid[pBlockData->nRow + i] = uid;
+    }
+  }
+  // version
+  code = tRealloc((uint8_t **)&pBlockData->aVersion, sizeof(int64_t) * (pBlockData->nRow + nRow));
+  if (code) goto _exit;
+  memcpy(&pBlockData->aVersion[pBlockData->nRow], &pBlockDataFrom->aVersion[iRow], sizeof(int64_t) * nRow);
+  // timestamp
+  code = tRealloc((uint8_t **)&pBlockData->aTSKEY, sizeof(TSKEY) * (pBlockData->nRow + nRow));
+  if (code) goto _exit;
+  memcpy(&pBlockData->aTSKEY[pBlockData->nRow], &pBlockDataFrom->aTSKEY[iRow], sizeof(TSKEY) * nRow);
+
+  // other columns, matched by cid once per column instead of once per row
+  SColVal   cv = {0};
+  int32_t   iColDataFrom = 0;
+  SColData *pColDataFrom = (iColDataFrom < pBlockDataFrom->nColData) ? &pBlockDataFrom->aColData[iColDataFrom] : NULL;
+
+  for (int32_t iColDataTo = 0; iColDataTo < pBlockData->nColData; iColDataTo++) {
+    SColData *pColDataTo = &pBlockData->aColData[iColDataTo];
+
+    while (pColDataFrom && pColDataFrom->cid < pColDataTo->cid) {
+      pColDataFrom = (++iColDataFrom < pBlockDataFrom->nColData) ? &pBlockDataFrom->aColData[iColDataFrom] : NULL;
+    }
+
+    if (pColDataFrom == NULL || pColDataFrom->cid > pColDataTo->cid) {
+      cv = COL_VAL_NONE(pColDataTo->cid, pColDataTo->type);
+      for (int32_t i = 0; i < nRow; i++) {
+        if ((code = tColDataAppendValue(pColDataTo, &cv))) goto _exit;
+      }
+    } else {
+      for (int32_t i = 0; i < nRow; i++) {
+        tColDataGetValue(pColDataFrom, iRow + i, &cv);
+        if ((code = tColDataAppendValue(pColDataTo, &cv))) goto _exit;
+      }
+
+      pColDataFrom = (++iColDataFrom < pBlockDataFrom->nColData) ? &pBlockDataFrom->aColData[iColDataFrom] : NULL;
+    }
+  }
+  pBlockData->nRow += nRow;
+
+_exit:
+  return code;
+}
+
 int32_t tBlockDataUpdateRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTSchema) {
   int32_t code = 0;
 
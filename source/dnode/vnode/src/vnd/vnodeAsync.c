@@ -26,21 +26,8 @@ typedef struct SVAChannel SVAChannel;
 
 #define EVA_PRIORITY_MAX (EVA_PRIORITY_LOW + 1)
 
-// worker
-typedef enum {
-  EVA_WORKER_STATE_UINIT = 0,
-  EVA_WORKER_STATE_ACTIVE,
-  EVA_WORKER_STATE_IDLE,
-  EVA_WORKER_STATE_STOP,
-} EVWorkerState;
-
-typedef struct {
-  SVAsync      *async;
-  int32_t       workerId;
-  EVWorkerState state;
-  TdThread      thread;
-  SVATask      *runningTask;
-} SVWorker;
+// a task waiting in the run queue gains one priority level per period, so low priority tasks are not starved
+#define VNODE_ASYNC_AGING_PERIOD_US (10 * 1000000ll)
 
 // task
 typedef enum {
@@ -57,6 +44,10 @@ struct SVATask {
   void (*complete)(void *);
   void        *arg;
   EVATaskState state;
+  int32_t      workerId;  // the run queue the task is in
+  int64_t      createTime;
+  int64_t      queueTime;
+  int64_t      startTime;
 
   // wait
   int32_t      numWait;
@@ -69,6 +60,30 @@ struct SVATask {
 
 #define VATASK_PIORITY(task_) ((task_)->priority - ((task_)->priorScore / 4))
 
+// worker
+typedef enum {
+  EVA_WORKER_STATE_UINIT = 0,
+  EVA_WORKER_STATE_ACTIVE,
+  EVA_WORKER_STATE_IDLE,
+  EVA_WORKER_STATE_STOP,
+} EVWorkerState;
+
+typedef struct {
+  SVAsync      *async;
+  int32_t       workerId;
+  EVWorkerState state;
+  TdThread      thread;
+  SVATask      *runningTask;
+
+  // run queue, pushed by the scheduler, popped by the worker itself or stolen by the idle ones
+  TdThreadMutex    qMutex;
+  SVATask          queue[EVA_PRIORITY_MAX];
+  volatile int32_t numQueued;
+
+  // statistics of the tasks run by this worker, updated by itself without async->mutex
+  SVAsyncStat stat;
+} SVWorker;
+
 // async channel
 typedef enum {
   EVA_CHANNEL_STATE_OPEN = 0,
@@ -97,6 +112,7 @@ struct SVAsync {
   int32_t  numWorkers;
   int32_t  numLaunchWorkers;
   int32_t  numIdleWorkers;
+  int32_t  nextWorker;
   SVWorker workers[VNODE_ASYNC_MAX_WORKERS];
 
   // channel
@@ -106,12 +122,136 @@ struct SVAsync {
   SVHashTable *channelTable;
 
   // task
-  int64_t      nextTaskId;
-  int32_t      numTasks;
-  SVATask      queue[EVA_PRIORITY_MAX];
-  SVHashTable *taskTable;
+  int64_t          nextTaskId;
+  int32_t          numTasks;
+  volatile int32_t numQueued;  // tasks in the run queues of all workers
+  SVHashTable     *taskTable;
 };
 
+static int32_t vnodeAsyncLaunchWorker(SVAsync *async);
+
+// push the task to the run queue of a worker, idle workers first, the async->mutex should be held
+static void vnodeAsyncDispatch(SVAsync *async, SVATask *task) {
+  SVWorker *worker = NULL;
+  int32_t   priority = VATASK_PIORITY(task);
+
+  for (int32_t i = 0; i < async->numWorkers; i++) {
+    SVWorker *w = &async->workers[(async->nextWorker + i) % async->numWorkers];
+    if (w->state == EVA_WORKER_STATE_IDLE) {
+      worker = w;
+      break;
+    }
+  }
+  if (worker == NULL) {
+    worker = &async->workers[async->nextWorker % async->numWorkers];
+  }
+  async->nextWorker = (worker->workerId + 1) % async->numWorkers;
+
+  taosThreadMutexLock(&worker->qMutex);
+  task->workerId = worker->workerId;
+  task->queueTime = taosGetTimestampUs();
+  task->next = &worker->queue[priority];
+  task->prev = worker->queue[priority].prev;
+  task->next->prev = task;
+  task->prev->next = task;
+  atomic_add_fetch_32(&worker->numQueued, 1);
+  atomic_add_fetch_32(&async->numQueued, 1);
+  taosThreadMutexUnlock(&worker->qMutex);
+
+  // signal worker or launch new worker, the tasks dispatched when stopping are cancelled by the exiting workers
+  if (async->stop) {
+    return;
+  } else if (async->numIdleWorkers > 0) {
+    taosThreadCondSignal(&(async->hasTask));
+  } else if (async->numLaunchWorkers < async->numWorkers) {
+    vnodeAsyncLaunchWorker(async);
+  }
+}
+
+// remove a waiting task from the run queue, fail if a worker has taken it
+static bool vnodeAsyncUnqueue(SVAsync *async, SVATask *task) {
+  SVWorker *worker = &async->workers[task->workerId];
+  bool      removed = false;
+
+  taosThreadMutexLock(&worker->qMutex);
+  if (task->state == EVA_TASK_STATE_WAITTING) {
+    task->prev->next = task->next;
+    task->next->prev = task->prev;
+    atomic_sub_fetch_32(&worker->numQueued, 1);
+    atomic_sub_fetch_32(&async->numQueued, 1);
+    removed = true;
+  }
+  taosThreadMutexUnlock(&worker->qMutex);
+
+  return removed;
+}
+
+// pop the task with the earliest aged deadline, i.e. queue time plus one aging period per priority level
+static SVATask *vnodeAsyncPopTask(SVAsync *async, SVWorker *worker) {
+  SVATask *task = NULL;
+  int64_t  deadline = 0;
+
+  taosThreadMutexLock(&worker->qMutex);
+  for (int32_t i = 0; i < EVA_PRIORITY_MAX; i++) {
+    SVATask *head = worker->queue[i].next;
+    if (head != &worker->queue[i] && (task == NULL || head->queueTime + i * VNODE_ASYNC_AGING_PERIOD_US < deadline)) {
+      task = head;
+      deadline = head->queueTime + i * VNODE_ASYNC_AGING_PERIOD_US;
+    }
+  }
+  if (task) {
+    task->prev->next = task->next;
+    task->next->prev = task->prev;
+    task->state = EVA_TASK_STATE_RUNNING;
+    task->startTime = taosGetTimestampUs();
+    atomic_sub_fetch_32(&worker->numQueued, 1);
+    atomic_sub_fetch_32(&async->numQueued, 1);
+  }
+  taosThreadMutexUnlock(&worker->qMutex);
+
+  return task;
+}
+
+// pop from the own run queue, or steal from the others
+static SVATask *vnodeAsyncGetTask(SVWorker *worker) {
+  SVAsync *async = worker->async;
+  SVATask *task = NULL;
+
+  if (atomic_load_32(&worker->numQueued) > 0 && (task = vnodeAsyncPopTask(async, worker)) != NULL) {
+    return task;
+  }
+
+  for (int32_t i = 1; i < VNODE_ASYNC_MAX_WORKERS; i++) {
+    SVWorker *victim = &async->workers[(worker->workerId + i) % VNODE_ASYNC_MAX_WORKERS];
+    if (atomic_load_32(&victim->numQueued) > 0 && (task = vnodeAsyncPopTask(async, victim)) != NULL) {
+      return task;
+    }
+  }
+
+  return NULL;
+}
+
+static int32_t vnodeAsyncLatencyBucket(int64_t latency) {
+  int32_t bucket = 0;
+  for (int64_t ms = latency / 1000; ms > 0 && bucket < VNODE_ASYNC_LATENCY_BUCKETS - 1; ms >>= 1) {
+    bucket++;
+  }
+  return bucket;
+}
+
+// only the worker itself writes its statistics, the atomics keep vnodeAsyncGetStat() from reading torn values
+static void vnodeAsyncUpdateStat(SVWorker *worker, SVATask *task) {
+  int32_t priority = task->priority;
+  int64_t waitTime = task->startTime - task->createTime;
+  int64_t runTime = taosGetTimestampUs() - task->startTime;
+
+  atomic_add_fetch_64(&worker->stat.numOfTasks[priority], 1);
+  atomic_add_fetch_64(&worker->stat.waitTime[priority], waitTime);
+  atomic_add_fetch_64(&worker->stat.runTime[priority], runTime);
+  atomic_add_fetch_64(&worker->stat.waitBuckets[priority][vnodeAsyncLatencyBucket(waitTime)], 1);
+  atomic_add_fetch_64(&worker->stat.runBuckets[priority][vnodeAsyncLatencyBucket(runTime)], 1);
+}
+
 static int32_t vnodeAsyncTaskDone(SVAsync *async, SVATask *task) {
   int32_t ret;
 
@@ -145,11 +285,7 @@ static int32_t vnodeAsyncTaskDone(SVAsync *async, SVATask *task) {
       }
 
       if (task->channel->scheduled != NULL) {
-        int32_t priority = VATASK_PIORITY(task->channel->scheduled);
-        task->channel->scheduled->next = &async->queue[priority];
-        task->channel->scheduled->prev = async->queue[priority].prev;
-        task->channel->scheduled->next->prev = task->channel->scheduled;
-        task->channel->scheduled->prev->next = task->channel->scheduled;
+        vnodeAsyncDispatch(async, task->channel->scheduled);
       }
     }
   }
@@ -177,13 +313,12 @@ static int32_t vnodeAsyncTaskDone(SVAsync *async, SVATask *task) {
 }
 
 static int32_t vnodeAsyncCancelAllTasks(SVAsync *async) {
-  while (async->queue[0].next != &async->queue[0] || async->queue[1].next != &async->queue[1] ||
-         async->queue[2].next != &async->queue[2]) {
-    for (int32_t i = 0; i < EVA_PRIORITY_MAX; i++) {
-      while (async->queue[i].next != &async->queue[i]) {
-        SVATask *task = async->queue[i].next;
-        task->prev->next = task->next;
-        task->next->prev = task->prev;
+  // cancelling a channel task may dispatch the next one of the channel
+  while (atomic_load_32(&async->numQueued) > 0) {
+    for (int32_t i = 0; i < VNODE_ASYNC_MAX_WORKERS; i++) {
+      SVATask *task;
+      while (atomic_load_32(&async->workers[i].numQueued) > 0 &&
+             (task = vnodeAsyncPopTask(async, &async->workers[i])) != NULL) {
         vnodeAsyncTaskDone(async, task);
       }
     }
@@ -198,15 +333,33 @@ static void *vnodeAsyncLoop(void *arg) {
   setThreadName(async->label);
 
   for (;;) {
-    taosThreadMutexLock(&async->mutex);
+    bool stop = false;
 
     // finish last running task
     if (worker->runningTask != NULL) {
-      vnodeAsyncTaskDone(async, worker->runningTask);
+      SVATask *task = worker->runningTask;
       worker->runningTask = NULL;
+
+      // a running task can not be cancelled, so its statistics and complete callback need no lock, and the callback
+      // still runs before the task is dropped and its waiters are woken
+      vnodeAsyncUpdateStat(worker, task);
+      if (task->complete) {
+        task->complete(task->arg);
+        task->complete = NULL;
+      }
+
+      // the task table, the handoff to the next task of the channel and the waiters of the task are shared with
+      // vnodeAsyncC(), vnodeAWait() and vnodeACancel(), which keep the channel order and the task lifetime under
+      // async->mutex, so this part stays locked
+      taosThreadMutexLock(&async->mutex);
+      vnodeAsyncTaskDone(async, task);
+      stop = async->stop;
+      taosThreadMutexUnlock(&async->mutex);
     }
 
-    for (;;) {
+    while (stop || (worker->runningTask = vnodeAsyncGetTask(worker)) == NULL) {
+      taosThreadMutexLock(&async->mutex);
+
       if (async->stop || worker->workerId >= async->numWorkers) {
         if (async->stop) {  // cancel all tasks
           vnodeAsyncCancelAllTasks(async);
@@ -217,43 +370,17 @@ static void *vnodeAsyncLoop(void *arg) {
         return NULL;
       }
 
-      for (int32_t i = 0; i < EVA_PRIORITY_MAX; i++) {
-        SVATask *task = async->queue[i].next;
-        if (task != &async->queue[i]) {
-          if (worker->runningTask == NULL) {
-            worker->runningTask = task;
-            task->prev->next = task->next;
-            task->next->prev = task->prev;
-          } else {  // promote priority
-            task->priorScore++;
-            int32_t priority = VATASK_PIORITY(task);
-            if (priority != i) {
-              // remove from current priority queue
-              task->prev->next = task->next;
-              task->next->prev = task->prev;
-              // add to new priority queue
-              task->next = &async->queue[priority];
-              task->prev = async->queue[priority].prev;
-              task->next->prev = task;
-              task->prev->next = task;
-            }
-          }
-        }
-      }
-
-      if (worker->runningTask == NULL) {
+      // tasks are only dispatched with async->mutex held, so no signal is missed
+      if (atomic_load_32(&async->numQueued) == 0) {
         worker->state = EVA_WORKER_STATE_IDLE;
         async->numIdleWorkers++;
         taosThreadCondWait(&async->hasTask, &async->mutex);
         async->numIdleWorkers--;
         worker->state = EVA_WORKER_STATE_ACTIVE;
-      } else {
-        worker->runningTask->state = EVA_TASK_STATE_RUNNING;
-        break;
       }
-    }
 
-    taosThreadMutexUnlock(&async->mutex);
+      taosThreadMutexUnlock(&async->mutex);
+    }
 
     // do run the task
     worker->runningTask->execute(worker->runningTask->arg);
@@ -321,11 +448,18 @@ int32_t vnodeAsyncInit(SVAsync **async, char *label) {
   (*async)->numWorkers = VNODE_ASYNC_DEFAULT_WORKERS;
   (*async)->numLaunchWorkers = 0;
   (*async)->numIdleWorkers = 0;
+  (*async)->nextWorker = 0;
   for (int32_t i = 0; i < VNODE_ASYNC_MAX_WORKERS; i++) {
     (*async)->workers[i].async = (*async);
     (*async)->workers[i].workerId = i;
     (*async)->workers[i].state = EVA_WORKER_STATE_UINIT;
     (*async)->workers[i].runningTask = NULL;
+    taosThreadMutexInit(&(*async)->workers[i].qMutex, NULL);
+    for (int32_t j = 0; j < EVA_PRIORITY_MAX; j++) {
+      (*async)->workers[i].queue[j].next = &(*async)->workers[i].queue[j];
+      (*async)->workers[i].queue[j].prev = &(*async)->workers[i].queue[j];
+    }
+    (*async)->workers[i].numQueued = 0;
   }
 
   // channel
@@ -335,6 +469,9 @@ int32_t vnodeAsyncInit(SVAsync **async, char *label) {
   (*async)->chList.next = &(*async)->chList;
   ret = vHashInit(&(*async)->channelTable, vnodeAsyncChannelHash, vnodeAsyncChannelCompare);
   if (ret != 0) {
+    for (int32_t i = 0; i < VNODE_ASYNC_MAX_WORKERS; i++) {
+      taosThreadMutexDestroy(&(*async)->workers[i].qMutex);
+    }
     taosThreadMutexDestroy(&(*async)->mutex);
     taosThreadCondDestroy(&(*async)->hasTask);
     taosMemoryFree(*async);
@@ -344,13 +481,13 @@ int32_t vnodeAsyncInit(SVAsync **async, char *label) {
   // task
   (*async)->nextTaskId = 0;
   (*async)->numTasks = 0;
-  for (int32_t i = 0; i < EVA_PRIORITY_MAX; i++) {
-    (*async)->queue[i].next = &(*async)->queue[i];
-    (*async)->queue[i].prev = &(*async)->queue[i];
-  }
+  (*async)->numQueued = 0;
   ret = vHashInit(&(*async)->taskTable, vnodeAsyncTaskHash, vnodeAsyncTaskCompare);
   if (ret != 0) {
     vHashDestroy(&(*async)->channelTable);
+    for (int32_t i = 0; i < VNODE_ASYNC_MAX_WORKERS; i++) {
+      taosThreadMutexDestroy(&(*async)->workers[i].qMutex);
+    }
     taosThreadMutexDestroy(&(*async)->mutex);
     taosThreadCondDestroy(&(*async)->hasTask);
     taosMemoryFree(*async);
@@ -403,7 +540,11 @@ int32_t vnodeAsyncDestroy(SVAsync **async) {
   ASSERT((*async)->numIdleWorkers == 0);
   ASSERT((*async)->numChannels == 0);
   ASSERT((*async)->numTasks == 0);
+  ASSERT((*async)->numQueued == 0);
 
+  for (int32_t i = 0; i < VNODE_ASYNC_MAX_WORKERS; i++) {
+    taosThreadMutexDestroy(&(*async)->workers[i].qMutex);
+  }
   taosThreadMutexDestroy(&(*async)->mutex);
   taosThreadCondDestroy(&(*async)->hasTask);
 
@@ -460,6 +601,7 @@ int32_t vnodeAsyncC(SVAsync *async, int64_t channelId, EVAPriority priority, int
   task->complete = complete;
   task->arg = arg;
   task->state = EVA_TASK_STATE_WAITTING;
+  task->createTime = taosGetTimestampUs();
   task->numWait = 0;
   taosThreadCondInit(&task->waitCond, NULL);
 
@@ -494,34 +636,20 @@ int32_t vnodeAsyncC(SVAsync *async, int64_t channelId, EVAPriority priority, int
 
   // add task to queue
   if (task->channel == NULL || task->channel->scheduled == NULL) {
-    // add task to async->queue
+    // add task to the run queue of a worker
     if (task->channel) {
       task->channel->scheduled = task;
     }
 
-    task->next = &async->queue[priority];
-    task->prev = async->queue[priority].prev;
-    task->next->prev = task;
-    task->prev->next = task;
-
-    // signal worker or launch new worker
-    if (async->numIdleWorkers > 0) {
-      taosThreadCondSignal(&(async->hasTask));
-    } else if (async->numLaunchWorkers < async->numWorkers) {
-      vnodeAsyncLaunchWorker(async);
-    }
-  } else if (task->channel->scheduled->state == EVA_TASK_STATE_RUNNING ||
-             priority >= VATASK_PIORITY(task->channel->scheduled)) {
+    vnodeAsyncDispatch(async, task);
+  } else if (priority >= VATASK_PIORITY(task->channel->scheduled) ||
+             !vnodeAsyncUnqueue(async, task->channel->scheduled)) {
     // add task to task->channel->queue
     task->next = &task->channel->queue[priority];
     task->prev = task->channel->queue[priority].prev;
     task->next->prev = task;
     task->prev->next = task;
   } else {
-    // remove task->channel->scheduled from queue
-    task->channel->scheduled->prev->next = task->channel->scheduled->next;
-    task->channel->scheduled->next->prev = task->channel->scheduled->prev;
-
     // promote priority and add task->channel->scheduled to task->channel->queue
     task->channel->scheduled->priorScore++;
     int32_t newPriority = VATASK_PIORITY(task->channel->scheduled);
@@ -532,10 +660,7 @@ int32_t vnodeAsyncC(SVAsync *async, int64_t channelId, EVAPriority priority, int
 
     // add task to queue
     task->channel->scheduled = task;
-    task->next = &async->queue[priority];
-    task->prev = async->queue[priority].prev;
-    task->next->prev = task;
-    task->prev->next = task;
+    vnodeAsyncDispatch(async, task);
   }
 
   taosThreadMutexUnlock(&async->mutex);
@@ -587,11 +712,13 @@ int32_t vnodeACancel(SVAsync *async, int64_t taskId) {
 
   vHashGet(async->taskTable, &task2, (void **)&task);
   if (task) {
-    if (task->state == EVA_TASK_STATE_WAITTING) {
-      // remove from queue
+    if (task->channel != NULL && task->channel->scheduled != task) {
+      // remove from channel queue
       task->next->prev = task->prev;
       task->prev->next = task->next;
       vnodeAsyncTaskDone(async, task);
+    } else if (vnodeAsyncUnqueue(async, task)) {
+      vnodeAsyncTaskDone(async, task);
     } else {
       ret = TSDB_CODE_FAILED;
     }
@@ -689,10 +816,8 @@ int32_t vnodeAChannelDestroy(SVAsync *async, int64_t channelId, bool waitRunning
     }
 
     // cancel or wait the scheduled task
-    if (channel->scheduled == NULL || channel->scheduled->state == EVA_TASK_STATE_WAITTING) {
+    if (channel->scheduled == NULL || vnodeAsyncUnqueue(async, channel->scheduled)) {
       if (channel->scheduled) {
-        channel->scheduled->prev->next = channel->scheduled->next;
-        channel->scheduled->next->prev = channel->scheduled->prev;
         vnodeAsyncTaskDone(async, channel->scheduled);
       }
       taosMemoryFree(channel);
@@ -721,4 +846,27 @@ int32_t vnodeAChannelDestroy(SVAsync *async, int64_t channelId, bool waitRunning
   taosThreadMutexUnlock(&async->mutex);
 
   return 0;
-}
\ No newline at end of file
+}
+
+int32_t vnodeAsyncGetStat(SVAsync *async, SVAsyncStat *stat) {
+  if (async == NULL || stat == NULL) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  // sum the statistics of all workers, without blocking them
+  memset(stat, 0, sizeof(*stat));
+  for (int32_t i = 0; i < VNODE_ASYNC_MAX_WORKERS; i++) {
+    SVAsyncStat *wstat = &async->workers[i].stat;
+    for (int32_t p = 0; p < VNODE_ASYNC_PRIORITIES; p++) {
+      stat->numOfTasks[p] += atomic_load_64(&wstat->numOfTasks[p]);
+      stat->waitTime[p] += atomic_load_64(&wstat->waitTime[p]);
+      stat->runTime[p] += atomic_load_64(&wstat->runTime[p]);
+      for (int32_t b = 0; b < VNODE_ASYNC_LATENCY_BUCKETS; b++) {
+        stat->waitBuckets[p][b] += atomic_load_64(&wstat->waitBuckets[p][b]);
+        stat->runBuckets[p][b] += atomic_load_64(&wstat->runBuckets[p][b]);
+      }
+    }
+  }
+
+  return 0;
+}
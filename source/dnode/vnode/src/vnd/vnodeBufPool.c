@@ -15,6 +15,25 @@
 
 #include "vnd.h"
 
+/*
+ * A pool with lock is shared by several write threads. Each thread carves a chunk out of the pool under the lock, and
+ * serves the small allocations from the chunk without lock. The whole chunk is counted in the pool size once carved, so
+ * the commit is triggered a little earlier, by at most one chunk per thread.
+ */
+#define VNODE_BUFPOOL_ARENA_SIZE  (32 * 1024)
+#define VNODE_BUFPOOL_ARENA_SLOTS 4  // arenas of a thread, for the threads writing into several pools
+
+typedef struct {
+  SVBufPool *pPool;
+  int64_t    version;
+  uint8_t   *ptr;
+  uint8_t   *end;
+} SVBufPoolArena;
+
+static threadlocal SVBufPoolArena vnodeBufPoolArenas[VNODE_BUFPOOL_ARENA_SLOTS];
+static threadlocal int32_t        vnodeBufPoolArenaNext = 0;  // the slot to evict when all are taken
+static volatile int64_t           vnodeBufPoolArenaVer = 0;
+
 /* ------------------------ STRUCTURES ------------------------ */
 static int vnodeBufPoolCreate(SVnode *pVnode, int32_t id, int64_t size, SVBufPool **ppPool) {
   SVBufPool *pPool;
@@ -34,6 +53,7 @@ static int vnodeBufPoolCreate(SVnode *pVnode, int32_t id, int64_t size, SVBufPoo
 
   pPool->pVnode = pVnode;
   pPool->id = id;
+  pPool->arenaVer = atomic_add_fetch_64(&vnodeBufPoolArenaVer, 1);
   pPool->ptr = pPool->node.data;
   pPool->pTail = &pPool->node;
   pPool->node.prev = NULL;
@@ -118,19 +138,18 @@ void vnodeBufPoolReset(SVBufPool *pPool) {
 
   pPool->size = 0;
   pPool->ptr = pPool->node.data;
+  pPool->arenaVer = atomic_add_fetch_64(&vnodeBufPoolArenaVer, 1);
 }
 
-void *vnodeBufPoolMallocAligned(SVBufPool *pPool, int size) {
+// allocate from the pool directly, the caller should hold the lock of the pool if any
+static void *vnodeBufPoolMallocImpl(SVBufPool *pPool, int64_t size, bool aligned) {
   SVBufPoolNode *pNode;
   void          *p = NULL;
-  uint8_t       *ptr = NULL;
-  int            paddingLen = 0;
-  ASSERT(pPool != NULL);
+  int64_t        paddingLen = 0;
 
-  if (pPool->lock) taosThreadSpinLock(pPool->lock);
-
-  ptr = pPool->ptr;
-  paddingLen = (((long)ptr + 7) & ~7) - (long)ptr;
+  if (aligned) {
+    paddingLen = (((uintptr_t)pPool->ptr + 7) & ~(uintptr_t)7) - (uintptr_t)pPool->ptr;
+  }
 
   if (pPool->node.size >= pPool->ptr - pPool->node.data + size + paddingLen) {
     // allocate from the anchor node
@@ -143,7 +162,6 @@ void *vnodeBufPoolMallocAligned(SVBufPool *pPool, int size) {
     pNode = taosMemoryMalloc(sizeof(*pNode) + size);
     if (pNode == NULL) {
       terrno = TSDB_CODE_OUT_OF_MEMORY;
-      if (pPool->lock) taosThreadSpinUnlock(pPool->lock);
       return NULL;
     }
 
@@ -156,41 +174,88 @@ void *vnodeBufPoolMallocAligned(SVBufPool *pPool, int size) {
 
     pPool->size = pPool->size + sizeof(*pNode) + size;
   }
-  if (pPool->lock) taosThreadSpinUnlock(pPool->lock);
+
   return p;
 }
 
-void *vnodeBufPoolMalloc(SVBufPool *pPool, int size) {
-  SVBufPoolNode *pNode;
-  void          *p = NULL;
-  ASSERT(pPool != NULL);
+// the arena of the thread for the pool, or a slot to take for it, either free or evicted in turn
+static SVBufPoolArena *vnodeBufPoolGetArena(SVBufPool *pPool) {
+  SVBufPoolArena *pFree = NULL;
+  for (int32_t i = 0; i < VNODE_BUFPOOL_ARENA_SLOTS; ++i) {
+    SVBufPoolArena *pArena = &vnodeBufPoolArenas[i];
+    if (pArena->pPool == pPool) {
+      return pArena;
+    }
+    if (pArena->pPool == NULL && pFree == NULL) {
+      pFree = pArena;
+    }
+  }
 
-  if (pPool->lock) taosThreadSpinLock(pPool->lock);
-  if (pPool->node.size >= pPool->ptr - pPool->node.data + size) {
-    // allocate from the anchor node
-    p = pPool->ptr;
-    pPool->ptr = pPool->ptr + size;
-    pPool->size += size;
-  } else {
-    // allocate a new node
-    pNode = taosMemoryMalloc(sizeof(*pNode) + size);
-    if (pNode == NULL) {
-      terrno = TSDB_CODE_OUT_OF_MEMORY;
-      if (pPool->lock) taosThreadSpinUnlock(pPool->lock);
-      return NULL;
+  if (pFree == NULL) {
+    // the pool of the evicted arena may be gone already, so the rest of it is abandoned
+    pFree = &vnodeBufPoolArenas[vnodeBufPoolArenaNext];
+    vnodeBufPoolArenaNext = (vnodeBufPoolArenaNext + 1) % VNODE_BUFPOOL_ARENA_SLOTS;
+  }
+  pFree->pPool = NULL;
+  return pFree;
+}
+
+static void *vnodeBufPoolArenaMalloc(SVBufPool *pPool, int size, bool aligned) {
+  SVBufPoolArena *pArena = vnodeBufPoolGetArena(pPool);
+  uint8_t        *p = NULL;
+
+  if (pArena->pPool == pPool && pArena->version == pPool->arenaVer) {
+    p = aligned ? (uint8_t *)(((uintptr_t)pArena->ptr + 7) & ~(uintptr_t)7) : pArena->ptr;
+    if (pArena->end - p >= size) {
+      pArena->ptr = p + size;
+      return p;
     }
+  }
 
-    p = pNode->data;
-    pNode->size = size;
-    pNode->prev = pPool->pTail;
-    pNode->pnext = &pPool->pTail;
-    pPool->pTail->pnext = &pNode->prev;
-    pPool->pTail = pNode;
+  // large ones are allocated from the pool directly, the rest of the arena is kept for the small ones
+  if (size > VNODE_BUFPOOL_ARENA_SIZE / 4) {
+    taosThreadSpinLock(pPool->lock);
+    p = vnodeBufPoolMallocImpl(pPool, size, aligned);
+    taosThreadSpinUnlock(pPool->lock);
+    return p;
+  }
 
-    pPool->size = pPool->size + sizeof(*pNode) + size;
+  // refill the arena, the rest of the old one is given back if nothing has been carved after it
+  taosThreadSpinLock(pPool->lock);
+  if (pArena->pPool == pPool && pArena->version == pPool->arenaVer && pPool->ptr == pArena->end) {
+    pPool->size -= pArena->end - pArena->ptr;
+    pPool->ptr = pArena->ptr;
   }
-  if (pPool->lock) taosThreadSpinUnlock(pPool->lock);
-  return p;
+  uint8_t *pChunk = vnodeBufPoolMallocImpl(pPool, VNODE_BUFPOOL_ARENA_SIZE, true);
+  taosThreadSpinUnlock(pPool->lock);
+  if (pChunk == NULL) {
+    pArena->pPool = NULL;
+    return NULL;
+  }
+
+  pArena->pPool = pPool;
+  pArena->version = pPool->arenaVer;
+  pArena->ptr = pChunk + size;
+  pArena->end = pChunk + VNODE_BUFPOOL_ARENA_SIZE;
+  return pChunk;
+}
+
+void *vnodeBufPoolMallocAligned(SVBufPool *pPool, int size) {
+  ASSERT(pPool != NULL);
+
+  if (pPool->lock) {
+    return vnodeBufPoolArenaMalloc(pPool, size, true);
+  }
+  return vnodeBufPoolMallocImpl(pPool, size, true);
+}
+
+void *vnodeBufPoolMalloc(SVBufPool *pPool, int size) {
+  ASSERT(pPool != NULL);
+
+  if (pPool->lock) {
+    return vnodeBufPoolArenaMalloc(pPool, size, false);
+  }
+  return vnodeBufPoolMallocImpl(pPool, size, false);
 }
 
 void vnodeBufPoolFree(SVBufPool *pPool, void *p) {
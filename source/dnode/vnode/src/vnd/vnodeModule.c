@@ -54,3 +54,11 @@ void vnodeCleanup() {
   walCleanUp();
   smaCleanUp();
 }
+
+int32_t vnodeGetAsyncStat(SVAsyncStat *pCommitStat, SVAsyncStat *pMergeStat) {
+  int32_t code = vnodeAsyncGetStat(vnodeAsyncHandle[0], pCommitStat);
+  if (code == 0) {
+    code = vnodeAsyncGetStat(vnodeAsyncHandle[1], pMergeStat);
+  }
+  return code;
+}
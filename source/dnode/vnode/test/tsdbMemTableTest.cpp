@@ -0,0 +1,484 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// The rows of a table inserted in key order are kept in the append buffer, as rows or as whole column blocks, until
+// an out-of-order row moves them to the skiplist. Each test inserts the same rows into two tables: the table under
+// test, and a table moved to the skiplist by a sentinel row beforehand. The iterators of both tables must return the
+// same rows, from the start or the end, and from any key seeked.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "tsdb.h"
+#include "tsdbIter.h"
+#include "vnd.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+const tb_uid_t MEM_TEST_SUID = 100;
+const tb_uid_t MEM_TEST_UID = 1;
+const tb_uid_t MEM_TEST_SL_UID = 2;  // the reference table in the skiplist
+const TSKEY    MEM_TEST_SENTINEL = TSKEY_MAX - 1;
+
+typedef struct {
+  TSKEY   ts;
+  int32_t c1;
+} SMemTestRow;
+
+typedef struct {
+  TSKEY       ts;
+  int64_t     version;
+  int32_t     c1;
+  std::string c2;
+} SMemTestResult;
+
+bool operator==(const SMemTestResult &r1, const SMemTestResult &r2) {
+  return r1.ts == r2.ts && r1.version == r2.version && r1.c1 == r2.c1 && r1.c2 == r2.c2;
+}
+
+std::ostream &operator<<(std::ostream &os, const SMemTestResult &r) {
+  return os << "{ts:" << r.ts << " ver:" << r.version << " c1:" << r.c1 << " c2:" << r.c2 << "}";
+}
+
+std::string memTestC2(int32_t c1) { return "v" + std::to_string(c1); }
+
+class TsdbMemTableTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    memset(&vnode, 0, sizeof(vnode));
+    vnode.config.vgId = 1;
+    vnode.config.szBuf = 3 * 16 * 1024 * 1024;
+    vnode.config.tsdbCfg.slLevel = 5;
+    vnode.config.cacheLast = 0;
+    taosThreadMutexInit(&vnode.mutex, NULL);
+    taosThreadCondInit(&vnode.poolNotEmpty, NULL);
+    ASSERT_EQ(vnodeOpenBufPool(&vnode), 0);
+
+    vnode.inUse = vnode.freeList;
+    vnode.inUse->nRef = 1;
+    vnode.freeList = vnode.inUse->freeNext;
+    vnode.inUse->freeNext = NULL;
+
+    memset(&tsdb, 0, sizeof(tsdb));
+    tsdb.pVnode = &vnode;
+    ASSERT_EQ(tsdbMemTableCreate(&tsdb, &tsdb.mem), 0);
+
+    SSchema aSchema[] = {
+        {.type = TSDB_DATA_TYPE_TIMESTAMP, .flags = 0, .colId = PRIMARYKEY_TIMESTAMP_COL_ID, .bytes = 8, .name = "ts"},
+        {.type = TSDB_DATA_TYPE_INT, .flags = 0, .colId = 2, .bytes = 4, .name = "c1"},
+        {.type = TSDB_DATA_TYPE_VARCHAR, .flags = 0, .colId = 3, .bytes = 16 + VARSTR_HEADER_SIZE, .name = "c2"},
+    };
+    pTSchema = tBuildTSchema(aSchema, 3, 1);
+    ASSERT_NE(pTSchema, nullptr);
+
+    // the reference table is in the skiplist from its first row on
+    insertRows(MEM_TEST_SL_UID, 0, {{MEM_TEST_SENTINEL, 0}});
+    insertRows(MEM_TEST_SL_UID, 0, {{MEM_TEST_SENTINEL - 1, 0}});
+    ASSERT_TRUE(tbData(MEM_TEST_SL_UID)->useSl);
+  }
+
+  void TearDown() override {
+    (void)tsdbUnrefMemTable(tsdb.mem, NULL, false);
+    (void)vnodeCloseBufPool(&vnode);
+    taosThreadCondDestroy(&vnode.poolNotEmpty);
+    taosThreadMutexDestroy(&vnode.mutex);
+    taosMemoryFree(pTSchema);
+  }
+
+  STbData *tbData(tb_uid_t uid) { return tsdbGetTbDataFromMemTable(tsdb.mem, MEM_TEST_SUID, uid); }
+
+  void insertRows(tb_uid_t uid, int64_t version, const std::vector<SMemTestRow> &rows) {
+    SArray *aRowP = taosArrayInit(rows.size(), sizeof(SRow *));
+    SArray *aColVal = taosArrayInit(3, sizeof(SColVal));
+
+    for (const SMemTestRow &row : rows) {
+      std::string c2 = memTestC2(row.c1);
+      SColVal     colVal = {0};
+
+      taosArrayClear(aColVal);
+      colVal.cid = PRIMARYKEY_TIMESTAMP_COL_ID;
+      colVal.value.type = TSDB_DATA_TYPE_TIMESTAMP;
+      colVal.value.val = row.ts;
+      taosArrayPush(aColVal, &colVal);
+      colVal.cid = 2;
+      colVal.value.type = TSDB_DATA_TYPE_INT;
+      colVal.value.val = row.c1;
+      taosArrayPush(aColVal, &colVal);
+      colVal.cid = 3;
+      colVal.value.type = TSDB_DATA_TYPE_VARCHAR;
+      colVal.value.pData = (uint8_t *)c2.data();
+      colVal.value.nData = c2.size();
+      taosArrayPush(aColVal, &colVal);
+
+      SRow *pRow = NULL;
+      ASSERT_EQ(tRowBuild(aColVal, pTSchema, &pRow), 0);
+      taosArrayPush(aRowP, &pRow);
+    }
+
+    SSubmitTbData submitTbData = {0};
+    submitTbData.suid = MEM_TEST_SUID;
+    submitTbData.uid = uid;
+    submitTbData.sver = 1;
+    submitTbData.aRowP = aRowP;
+
+    int32_t affectedRows = 0;
+    EXPECT_EQ(tsdbInsertTableData(&tsdb, version, &submitTbData, &affectedRows), 0);
+    EXPECT_EQ(affectedRows, rows.size());
+
+    // the rows are copied into the buffer pool
+    for (int32_t i = 0; i < taosArrayGetSize(aRowP); ++i) {
+      tRowDestroy(*(SRow **)taosArrayGet(aRowP, i));
+    }
+    taosArrayDestroy(aRowP);
+    taosArrayDestroy(aColVal);
+  }
+
+  void insertCols(tb_uid_t uid, int64_t version, const std::vector<SMemTestRow> &rows) {
+    SArray   *aCol = taosArrayInit(3, sizeof(SColData));
+    SColData  aColData[3] = {0};
+    SColVal   colVal = {0};
+
+    tColDataInit(&aColData[0], PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, 0);
+    tColDataInit(&aColData[1], 2, TSDB_DATA_TYPE_INT, 0);
+    tColDataInit(&aColData[2], 3, TSDB_DATA_TYPE_VARCHAR, 0);
+    for (const SMemTestRow &row : rows) {
+      std::string c2 = memTestC2(row.c1);
+
+      colVal.cid = PRIMARYKEY_TIMESTAMP_COL_ID;
+      colVal.value.type = TSDB_DATA_TYPE_TIMESTAMP;
+      colVal.value.val = row.ts;
+      ASSERT_EQ(tColDataAppendValue(&aColData[0], &colVal), 0);
+      colVal.cid = 2;
+      colVal.value.type = TSDB_DATA_TYPE_INT;
+      colVal.value.val = row.c1;
+      ASSERT_EQ(tColDataAppendValue(&aColData[1], &colVal), 0);
+      colVal.cid = 3;
+      colVal.value.type = TSDB_DATA_TYPE_VARCHAR;
+      colVal.value.pData = (uint8_t *)c2.data();
+      colVal.value.nData = c2.size();
+      ASSERT_EQ(tColDataAppendValue(&aColData[2], &colVal), 0);
+    }
+    for (int32_t i = 0; i < 3; ++i) {
+      taosArrayPush(aCol, &aColData[i]);
+    }
+
+    SSubmitTbData submitTbData = {0};
+    submitTbData.flags = SUBMIT_REQ_COLUMN_DATA_FORMAT;
+    submitTbData.suid = MEM_TEST_SUID;
+    submitTbData.uid = uid;
+    submitTbData.sver = 1;
+    submitTbData.aCol = aCol;
+
+    int32_t affectedRows = 0;
+    EXPECT_EQ(tsdbInsertTableData(&tsdb, version, &submitTbData, &affectedRows), 0);
+    EXPECT_EQ(affectedRows, rows.size());
+
+    // the column data are copied into the buffer pool
+    taosArrayDestroyEx(aCol, tColDataDestroy);
+  }
+
+  // the same rows into the table under test and the reference table
+  void insertBoth(int64_t version, const std::vector<SMemTestRow> &rows, bool colFormat) {
+    for (tb_uid_t uid : {MEM_TEST_UID, MEM_TEST_SL_UID}) {
+      if (colFormat) {
+        insertCols(uid, version, rows);
+      } else {
+        insertRows(uid, version, rows);
+      }
+    }
+  }
+
+  std::vector<SMemTestResult> scan(tb_uid_t uid, STsdbRowKey *pFrom, int8_t backward, size_t limit) {
+    std::vector<SMemTestResult> results;
+    STbDataIter                 iter = {0};
+
+    tsdbTbDataIterOpen(tbData(uid), pFrom, backward, &iter);
+    for (TSDBROW *pRow = tsdbTbDataIterGet(&iter); pRow != NULL; pRow = tsdbTbDataIterGet(&iter)) {
+      STsdbRowKey key;
+      SColVal     c1, c2;
+
+      tsdbRowGetKey(pRow, &key);
+      tsdbRowGetColVal(pRow, pTSchema, 1, &c1);
+      tsdbRowGetColVal(pRow, pTSchema, 2, &c2);
+      if (key.key.ts < MEM_TEST_SENTINEL - 1) {
+        results.push_back({key.key.ts, key.version, (int32_t)c1.value.val,
+                           std::string((char *)c2.value.pData, c2.value.nData)});
+      }
+
+      if (results.size() >= limit || !tsdbTbDataIterNext(&iter)) break;
+    }
+
+    return results;
+  }
+
+  void checkScan(STsdbRowKey *pFrom, int8_t backward, size_t limit = SIZE_MAX) {
+    std::vector<SMemTestResult> results = scan(MEM_TEST_UID, pFrom, backward, limit);
+    std::vector<SMemTestResult> expected = scan(MEM_TEST_SL_UID, pFrom, backward, limit);
+
+    // the sentinel rows are dropped from the reference, so a backward scan from a key beyond the rows is the same
+    ASSERT_EQ(results.size(), expected.size())
+        << "from:" << (pFrom ? pFrom->key.ts : 0) << " ver:" << (pFrom ? pFrom->version : 0) << " backward:" << (int)backward;
+    for (size_t i = 0; i < results.size(); ++i) {
+      ASSERT_EQ(results[i], expected[i]) << "i:" << i << " from:" << (pFrom ? pFrom->key.ts : 0)
+                                         << " backward:" << (int)backward;
+    }
+  }
+
+  // scan both ways from the start and the end, and a few rows from each key around the rows seeked
+  void checkTable(TSKEY minKey, TSKEY maxKey, int32_t step) {
+    EXPECT_EQ(tsdbGetNRowsInTbData(tbData(MEM_TEST_UID)), tsdbGetNRowsInTbData(tbData(MEM_TEST_SL_UID)) - 2);
+
+    checkScan(NULL, 0);
+    checkScan(NULL, 1);
+
+    for (TSKEY ts = minKey - 2; ts <= maxKey + 2; ts += step) {
+      for (int64_t version : {(int64_t)0, (int64_t)5, (int64_t)INT64_MAX}) {
+        STsdbRowKey key = {0};
+        key.key.ts = ts;
+        key.version = version;
+        checkScan(&key, 0, 4);
+        checkScan(&key, 1, 4);
+      }
+    }
+  }
+
+  std::vector<SMemTestRow> sortedRows(TSKEY start, int32_t nRow, int32_t gap = 2) {
+    std::vector<SMemTestRow> rows;
+    for (int32_t i = 0; i < nRow; ++i) {
+      rows.push_back({start + (TSKEY)i * gap, (int32_t)(start + i)});
+    }
+    return rows;
+  }
+
+  SVnode    vnode;
+  STsdb     tsdb;
+  STSchema *pTSchema = NULL;
+};
+
+}  // namespace
+
+// the rows of submits in key order fill chunks of growing size, and go past the largest chunk size
+TEST_F(TsdbMemTableTest, inOrderRows) {
+  const int32_t nRow = 5000;
+  int64_t       version = 1;
+
+  for (int32_t start = 0; start < nRow; start += 37) {
+    insertBoth(version++, sortedRows(1000 + start * 2, TMIN(37, nRow - start)), false);
+  }
+
+  STbData *pTbData = tbData(MEM_TEST_UID);
+  EXPECT_FALSE(pTbData->useSl);
+  EXPECT_EQ(pTbData->ab.nRow, nRow);
+  EXPECT_EQ(pTbData->ab.nBlock, 0);
+  EXPECT_GT(pTbData->ab.nChunk, MEM_AB_GEO_CHUNKS);
+  EXPECT_EQ(pTbData->minKey, 1000);
+  EXPECT_EQ(pTbData->maxKey, 1000 + (nRow - 1) * 2);
+
+  checkTable(1000, 1000 + nRow * 2, 1);
+}
+
+// a row of the last key and a newer version is still in key order, while a row of an earlier key moves the table to the
+// skiplist, even if the key is in the table already
+TEST_F(TsdbMemTableTest, duplicateKey) {
+  insertBoth(1, sortedRows(100, 50), false);
+  insertBoth(2, {{198, -1}}, false);
+  EXPECT_FALSE(tbData(MEM_TEST_UID)->useSl);
+  EXPECT_EQ(tbData(MEM_TEST_UID)->ab.nRow, 51);
+
+  insertBoth(3, {{150, 1}, {198, 2}, {202, 3}}, false);
+  EXPECT_TRUE(tbData(MEM_TEST_UID)->useSl);
+  EXPECT_EQ(tsdbGetNRowsInTbData(tbData(MEM_TEST_UID)), 54);
+
+  checkTable(100, 210, 1);
+}
+
+// a row before the last one moves the rows appended to the skiplist, and the rows after it go to the skiplist too
+TEST_F(TsdbMemTableTest, outOfOrderRows) {
+  insertBoth(1, sortedRows(1000, 300), false);
+  insertBoth(2, sortedRows(1600, 20), false);
+  EXPECT_FALSE(tbData(MEM_TEST_UID)->useSl);
+
+  insertBoth(3, {{999, 1}, {1001, 2}, {1651, 3}, {1700, 4}}, false);
+  EXPECT_TRUE(tbData(MEM_TEST_UID)->useSl);
+  insertBoth(4, sortedRows(1701, 30, 3), false);
+  insertBoth(5, sortedRows(500, 10), false);
+
+  checkTable(490, 1800, 1);
+}
+
+// in-order column blocks are kept as a whole, and seeked by the key range of each block
+TEST_F(TsdbMemTableTest, inOrderBlocks) {
+  int64_t version = 1;
+  TSKEY   start = 1000;
+  for (int32_t nRow : {1, 7, 100, 4096, 3, 500, 1, 2}) {
+    insertBoth(version++, sortedRows(start, nRow, 3), true);
+    start += nRow * 3;
+  }
+
+  // a block starting at the last key of a newer version, so that the seeks at the key compare the full keys
+  insertBoth(version++, sortedRows(start - 3, 10, 3), true);
+  start += 9 * 3;
+
+  STbData *pTbData = tbData(MEM_TEST_UID);
+  EXPECT_FALSE(pTbData->useSl);
+  EXPECT_EQ(pTbData->ab.nBlock, 9);
+  EXPECT_EQ(pTbData->ab.nChunk, 0);
+  EXPECT_EQ(pTbData->ab.aBlock[3].minKey, 1000 + 108 * 3);
+  EXPECT_EQ(pTbData->ab.aBlock[3].maxKey, 1000 + (108 + 4095) * 3);
+
+  checkTable(1000, start, 1);
+}
+
+// a block overlapping the blocks kept moves the table to the skiplist, reusing the blocks
+TEST_F(TsdbMemTableTest, overlappedBlock) {
+  insertBoth(1, sortedRows(1000, 100), true);
+  insertBoth(2, sortedRows(1200, 100), true);
+  EXPECT_EQ(tbData(MEM_TEST_UID)->ab.nBlock, 2);
+
+  insertBoth(3, sortedRows(1390, 20), true);
+  EXPECT_TRUE(tbData(MEM_TEST_UID)->useSl);
+  insertBoth(4, sortedRows(1500, 10), true);
+
+  checkTable(990, 1530, 1);
+}
+
+// rows of the row format move a block buffer to the skiplist, while a column block is appended to a row buffer row by
+// row
+TEST_F(TsdbMemTableTest, mixedFormats) {
+  insertBoth(1, sortedRows(1000, 100), false);
+  insertBoth(2, sortedRows(1200, 100), true);
+  insertBoth(3, sortedRows(1400, 100), false);
+
+  STbData *pTbData = tbData(MEM_TEST_UID);
+  EXPECT_FALSE(pTbData->useSl);
+  EXPECT_EQ(pTbData->ab.nBlock, 0);
+  EXPECT_EQ(pTbData->ab.nRow, 300);
+  checkTable(990, 1610, 1);
+
+  insertCols(MEM_TEST_UID + 10, 4, sortedRows(1000, 100));
+  EXPECT_EQ(tbData(MEM_TEST_UID + 10)->ab.nBlock, 1);
+  insertRows(MEM_TEST_UID + 10, 5, sortedRows(1200, 10));
+  EXPECT_TRUE(tbData(MEM_TEST_UID + 10)->useSl);
+  EXPECT_EQ(tsdbGetNRowsInTbData(tbData(MEM_TEST_UID + 10)), 110);
+}
+
+// in-order submits with an out-of-order one now and then, of both formats
+TEST_F(TsdbMemTableTest, mixedInserts) {
+  uint32_t seed = 7;
+  TSKEY    last = 10000;
+  for (int64_t version = 1; version <= 200; ++version) {
+    int32_t nRow = 1 + taosRandR(&seed) % 64;
+    int32_t gap = 1 + taosRandR(&seed) % 3;
+    bool    colFormat = taosRandR(&seed) % 2;
+    TSKEY   start = (version % 50 == 0) ? last - taosRandR(&seed) % 1000 : last + 1;
+
+    insertBoth(version, sortedRows(start, nRow, gap), colFormat);
+    last = TMAX(last, start + (nRow - 1) * gap);
+  }
+
+  EXPECT_TRUE(tbData(MEM_TEST_UID)->useSl);
+  checkTable(9000, last, 7);
+}
+
+// the committer takes the rows of a kept block that nothing interleaves with as one run, up to the fileset's max key
+TEST_F(TsdbMemTableTest, commitBlockRows) {
+  const TSKEY maxKey = 1449;
+
+  insertCols(MEM_TEST_UID, 1, sortedRows(1000, 100, 1));
+  insertCols(MEM_TEST_UID, 2, sortedRows(1200, 100, 1));
+  insertCols(MEM_TEST_UID, 3, sortedRows(1400, 100, 1));
+  insertRows(MEM_TEST_UID + 10, 4, sortedRows(1000, 10));
+
+  STsdbIter      *iter = NULL;
+  SIterMerger    *merger = NULL;
+  TTsdbIterArray  iterArray[1] = {0};
+  STsdbIterConfig config = {};
+  config.type = TSDB_ITER_TYPE_MEMT;
+  config.memt = tsdb.mem;
+  config.from->version = VERSION_MIN;
+  config.from->key.ts = TSKEY_MIN;
+  ASSERT_EQ(tsdbIterOpen(&config, &iter), 0);
+  ASSERT_EQ(TARRAY2_APPEND(iterArray, iter), 0);
+  ASSERT_EQ(tsdbIterMergerOpen(iterArray, &merger, false), 0);
+
+  // the rows appended in runs against the same rows appended one by one
+  TABLEID    id = {.suid = MEM_TEST_SUID, .uid = 0};
+  SBlockData blockData = {0};
+  SBlockData expected = {0};
+  ASSERT_EQ(tBlockDataInit(&blockData, &id, pTSchema, NULL, 0), 0);
+  ASSERT_EQ(tBlockDataInit(&expected, &id, pTSchema, NULL, 0), 0);
+
+  std::vector<int32_t> runs;
+  for (SRowInfo *row; (row = tsdbIterMergerGetData(merger)) != NULL;) {
+    if (TSDBROW_TS(&row->row) > maxKey) {
+      TABLEID tbid = {.suid = row->suid, .uid = row->uid};
+      ASSERT_EQ(tsdbIterMergerSkipTableData(merger, &tbid), 0);
+      continue;
+    }
+
+    int32_t nRow = tsdbIterMergerGetBlockRows(merger, maxKey);
+    if (nRow > 1) {
+      runs.push_back(nRow);
+      ASSERT_EQ(tBlockDataAppendBlockRows(&blockData, row->row.pBlockData, row->row.iRow, nRow, row->uid), 0);
+      for (int32_t i = 0; i < nRow; ++i) {
+        TSDBROW tRow = row->row;
+        tRow.iRow += i;
+        ASSERT_EQ(tBlockDataAppendRow(&expected, &tRow, pTSchema, row->uid), 0);
+      }
+      ASSERT_EQ(tsdbIterMergerSkipBlockRows(merger, nRow), 0);
+      continue;
+    }
+
+    EXPECT_EQ(row->uid, MEM_TEST_UID + 10);
+    ASSERT_EQ(tBlockDataAppendRow(&blockData, &row->row, pTSchema, row->uid), 0);
+    ASSERT_EQ(tBlockDataAppendRow(&expected, &row->row, pTSchema, row->uid), 0);
+    ASSERT_EQ(tsdbIterMergerNext(merger), 0);
+  }
+
+  EXPECT_EQ(runs, std::vector<int32_t>({100, 100, 50}));
+  ASSERT_EQ(blockData.nRow, 260);
+  ASSERT_EQ(blockData.nRow, expected.nRow);
+  ASSERT_EQ(blockData.nColData, expected.nColData);
+  for (int32_t iRow = 0; iRow < blockData.nRow; ++iRow) {
+    ASSERT_EQ(blockData.aUid[iRow], expected.aUid[iRow]);
+    ASSERT_EQ(blockData.aVersion[iRow], expected.aVersion[iRow]);
+    ASSERT_EQ(blockData.aTSKEY[iRow], expected.aTSKEY[iRow]);
+    for (int32_t iCol = 0; iCol < blockData.nColData; ++iCol) {
+      SColVal cv1, cv2;
+      tColDataGetValue(&blockData.aColData[iCol], iRow, &cv1);
+      tColDataGetValue(&expected.aColData[iCol], iRow, &cv2);
+      ASSERT_EQ(cv1.flag, cv2.flag);
+      if (IS_VAR_DATA_TYPE(cv1.value.type)) {
+        ASSERT_EQ(std::string((char *)cv1.value.pData, cv1.value.nData),
+                  std::string((char *)cv2.value.pData, cv2.value.nData));
+      } else {
+        ASSERT_EQ(cv1.value.val, cv2.value.val);
+      }
+    }
+  }
+
+  tBlockDataDestroy(&blockData);
+  tBlockDataDestroy(&expected);
+  tsdbIterMergerClose(&merger);
+  TARRAY2_DESTROY(iterArray, tsdbIterClose);
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Throughput of reading a tsdb file page by page and by large reads of contiguous pages, for each tsdb page size, e.g.
+//   tsdbReadFileBench [fileSizeMB] [loops] [dir]
+// The file is in the page cache once written, so it measures the per page cost of the read path rather than the disk.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "os.h"
+#include "tsdbDef.h"
+
+static int32_t benchPageSizes[] = {1, 4, 16, 64};  // KB
+
+#define BENCH_READ_SIZE (1024 * 1024)
+
+static int32_t benchWriteFile(STsdb *pTsdb, const char *path, int64_t size, uint8_t *pBuf) {
+  STsdbFD *pFD = NULL;
+  int32_t  code = tsdbOpenFile(path, pTsdb, TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC, &pFD, 0);
+  if (code) return code;
+
+  for (int64_t offset = 0; offset < size; offset += BENCH_READ_SIZE) {
+    int64_t len = TMIN(BENCH_READ_SIZE, size - offset);
+    for (int64_t i = 0; i < len; ++i) {
+      pBuf[i] = (uint8_t)((offset + i) * 7);
+    }
+    code = tsdbWriteFile(pFD, offset, pBuf, len, 0, NULL);
+    if (code) break;
+  }
+
+  if (code == 0) {
+    code = tsdbFsyncFile(pFD, 0, NULL);
+  }
+  tsdbCloseFile(&pFD);
+  return code;
+}
+
+static int32_t benchReadFile(STsdb *pTsdb, const char *path, int64_t size, int64_t readSize, int32_t loops,
+                             uint8_t *pBuf, int64_t *elapsed) {
+  STsdbFD *pFD = NULL;
+  int32_t  code = tsdbOpenFile(path, pTsdb, TD_FILE_READ, &pFD, 0);
+  if (code) return code;
+
+  int64_t st = taosGetTimestampUs();
+  for (int32_t j = 0; j < loops && code == 0; ++j) {
+    for (int64_t offset = 0; offset < size; offset += readSize) {
+      code = tsdbReadFile(pFD, offset, pBuf, TMIN(readSize, size - offset), 0, 0, NULL);
+      if (code) break;
+    }
+  }
+  *elapsed = taosGetTimestampUs() - st;
+
+  // the last read ends at the end of the file
+  int64_t len = (size % readSize == 0) ? readSize : size % readSize;
+  for (int64_t i = 0; code == 0 && i < len; ++i) {
+    if (pBuf[i] != (uint8_t)((size - len + i) * 7)) {
+      code = TSDB_CODE_FILE_CORRUPTED;
+    }
+  }
+
+  tsdbCloseFile(&pFD);
+  return code;
+}
+
+int main(int argc, char *argv[]) {
+  int64_t     size = (int64_t)((argc > 1) ? atoi(argv[1]) : 256) * 1024 * 1024;
+  int32_t     loops = (argc > 2) ? atoi(argv[2]) : 4;
+  const char *dir = (argc > 3) ? argv[3] : "/tmp";
+
+  char path[PATH_MAX] = {0};
+  snprintf(path, sizeof(path), "%s%stsdbReadFileBench.data", dir, TD_DIRSEP);
+
+  uint8_t *pBuf = (uint8_t *)taosMemoryMalloc(BENCH_READ_SIZE);
+  if (pBuf == NULL) {
+    printf("failed to allocate memory\n");
+    return -1;
+  }
+
+  SVnode vnode = {0};
+  STsdb  tsdb = {.pVnode = &vnode};
+
+  printf("%-10s %-10s %12s %12s %10s\n", "page(KB)", "read", "size(B)", "elapsed(us)", "MB/s");
+  for (int32_t p = 0; p < sizeof(benchPageSizes) / sizeof(benchPageSizes[0]); ++p) {
+    vnode.config.tsdbPageSize = benchPageSizes[p] * 1024;
+
+    int32_t code = benchWriteFile(&tsdb, path, size, pBuf);
+    if (code) {
+      printf("failed to write %s since %s\n", path, tstrerror(code));
+      break;
+    }
+
+    // page sized reads go through the page buffer one by one, large reads fetch the runs of whole pages at once
+    int64_t readSizes[] = {(int64_t)PAGE_CONTENT_SIZE(vnode.config.tsdbPageSize), BENCH_READ_SIZE};
+    const char *names[] = {"page", "coalesced"};
+    for (int32_t r = 0; r < sizeof(readSizes) / sizeof(readSizes[0]); ++r) {
+      int64_t el = 0;
+      code = benchReadFile(&tsdb, path, size, readSizes[r], loops, pBuf, &el);
+      if (code) {
+        printf("failed to read %s since %s\n", path, tstrerror(code));
+        break;
+      }
+      printf("%-10d %-10s %12" PRId64 " %12" PRId64 " %10.1f\n", benchPageSizes[p], names[r], readSizes[r], el,
+             (el > 0) ? (double)size * loops / el : 0);
+    }
+  }
+
+  (void)taosRemoveFile(path);
+  taosMemoryFree(pBuf);
+  return 0;
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+#include "vnd.h"
+
+namespace {
+
+typedef struct {
+  int32_t  seq;
+  int32_t *lastSeq;     // the seq of the last task of the channel executed
+  int32_t *running;     // the tasks of the channel running
+  int32_t *numOfErrors;
+  int32_t *numOfCompletes;
+} SAsyncTestTask;
+
+int32_t asyncTestExecute(void *arg) {
+  SAsyncTestTask *pTask = (SAsyncTestTask *)arg;
+
+  // the tasks of a channel are executed one by one, in the order they are submitted
+  if (atomic_add_fetch_32(pTask->running, 1) != 1) {
+    atomic_add_fetch_32(pTask->numOfErrors, 1);
+  }
+  if (atomic_load_32(pTask->lastSeq) != pTask->seq - 1) {
+    atomic_add_fetch_32(pTask->numOfErrors, 1);
+  }
+  for (volatile int32_t i = 0; i < (pTask->seq % 7) * 1000; i++) {
+  }
+  atomic_store_32(pTask->lastSeq, pTask->seq);
+  atomic_sub_fetch_32(pTask->running, 1);
+  return 0;
+}
+
+void asyncTestComplete(void *arg) {
+  SAsyncTestTask *pTask = (SAsyncTestTask *)arg;
+  atomic_add_fetch_32(pTask->numOfCompletes, 1);
+}
+
+int32_t asyncTestNop(void *arg) { return 0; }
+
+typedef struct {
+  tsem_t  started;
+  tsem_t  resume;
+  int32_t numOfExecutes;
+  int32_t numOfCompletes;
+} SAsyncTestBlocker;
+
+int32_t asyncTestBlock(void *arg) {
+  SAsyncTestBlocker *pBlocker = (SAsyncTestBlocker *)arg;
+  atomic_add_fetch_32(&pBlocker->numOfExecutes, 1);
+  tsem_post(&pBlocker->started);
+  tsem_wait(&pBlocker->resume);
+  return 0;
+}
+
+int32_t asyncTestCount(void *arg) {
+  SAsyncTestBlocker *pBlocker = (SAsyncTestBlocker *)arg;
+  atomic_add_fetch_32(&pBlocker->numOfExecutes, 1);
+  return 0;
+}
+
+void asyncTestBlockerComplete(void *arg) {
+  SAsyncTestBlocker *pBlocker = (SAsyncTestBlocker *)arg;
+  atomic_add_fetch_32(&pBlocker->numOfCompletes, 1);
+}
+
+}  // namespace
+
+// The channels are fewer than the workers, and the tasks without a channel keep the run queues uneven, so that the
+// idle workers steal the tasks dispatched to the busy ones.
+TEST(vnodeAsyncTest, channelOrderWithStealing) {
+  const int32_t numOfChannels = 3;
+  const int32_t numOfTasks = 2000;
+
+  SVAsync *async = NULL;
+  ASSERT_EQ(vnodeAsyncInit(&async, (char *)"vnode-async-test"), 0);
+  ASSERT_EQ(vnodeAsyncSetWorkers(async, 8), 0);
+
+  int64_t         channelIds[numOfChannels] = {0};
+  int32_t         lastSeq[numOfChannels] = {0};
+  int32_t         running[numOfChannels] = {0};
+  int32_t         numOfErrors = 0;
+  int32_t         numOfCompletes = 0;
+  SAsyncTestTask *tasks = (SAsyncTestTask *)taosMemoryCalloc(numOfChannels * numOfTasks, sizeof(SAsyncTestTask));
+  ASSERT_NE(tasks, nullptr);
+
+  for (int32_t c = 0; c < numOfChannels; c++) {
+    ASSERT_EQ(vnodeAChannelInit(async, &channelIds[c]), 0);
+    lastSeq[c] = -1;
+  }
+
+  for (int32_t seq = 0; seq < numOfTasks; seq++) {
+    for (int32_t c = 0; c < numOfChannels; c++) {
+      SAsyncTestTask *pTask = &tasks[seq * numOfChannels + c];
+      pTask->seq = seq;
+      pTask->lastSeq = &lastSeq[c];
+      pTask->running = &running[c];
+      pTask->numOfErrors = &numOfErrors;
+      pTask->numOfCompletes = &numOfCompletes;
+      ASSERT_EQ(
+          vnodeAsyncC(async, channelIds[c], EVA_PRIORITY_NORMAL, asyncTestExecute, asyncTestComplete, pTask, NULL), 0);
+    }
+    if (seq % 3 == 0) {
+      ASSERT_EQ(vnodeAsyncC(async, 0, (EVAPriority)(seq % 2 ? EVA_PRIORITY_HIGH : EVA_PRIORITY_LOW), asyncTestNop, NULL,
+                            NULL, NULL),
+                0);
+    }
+  }
+
+  // the tasks are all done before the channels are destroyed, so that none of them is cancelled
+  while (atomic_load_32(&numOfCompletes) != numOfChannels * numOfTasks) {
+    taosUsleep(1000);
+  }
+  for (int32_t c = 0; c < numOfChannels; c++) {
+    ASSERT_EQ(vnodeAChannelDestroy(async, channelIds[c], true), 0);
+  }
+
+  EXPECT_EQ(numOfErrors, 0);
+  for (int32_t c = 0; c < numOfChannels; c++) {
+    EXPECT_EQ(lastSeq[c], numOfTasks - 1);
+  }
+
+  // the statistics kept by each worker add up to the tasks completed
+  SVAsyncStat stat;
+  int64_t     numInBuckets = 0;
+  ASSERT_EQ(vnodeAsyncGetStat(async, &stat), 0);
+  EXPECT_EQ(stat.numOfTasks[EVA_PRIORITY_NORMAL], numOfChannels * numOfTasks);
+  for (int32_t b = 0; b < VNODE_ASYNC_LATENCY_BUCKETS; b++) {
+    numInBuckets += stat.runBuckets[EVA_PRIORITY_NORMAL][b];
+  }
+  EXPECT_EQ(numInBuckets, numOfChannels * numOfTasks);
+
+  ASSERT_EQ(vnodeAsyncDestroy(&async), 0);
+  taosMemoryFree(tasks);
+}
+
+// A task taken by a worker is running, so that it can not be cancelled, and it is executed and completed exactly once.
+TEST(vnodeAsyncTest, cancelDequeuedTask) {
+  SVAsync *async = NULL;
+  ASSERT_EQ(vnodeAsyncInit(&async, (char *)"vnode-async-test"), 0);
+
+  SAsyncTestBlocker blocker = {0};
+  tsem_init(&blocker.started, 0, 0);
+  tsem_init(&blocker.resume, 0, 0);
+
+  // a task without a channel
+  int64_t taskId = 0;
+  ASSERT_EQ(vnodeAsyncC(async, 0, EVA_PRIORITY_NORMAL, asyncTestBlock, asyncTestBlockerComplete, &blocker, &taskId), 0);
+  tsem_wait(&blocker.started);
+  EXPECT_NE(vnodeACancel(async, taskId), 0);
+  EXPECT_NE(vnodeACancel(async, taskId), 0);
+  tsem_post(&blocker.resume);
+  ASSERT_EQ(vnodeAWait(async, taskId), 0);
+  EXPECT_EQ(atomic_load_32(&blocker.numOfExecutes), 1);
+  EXPECT_EQ(atomic_load_32(&blocker.numOfCompletes), 1);
+
+  // the scheduled task of a channel taken by a worker, and the ones waiting behind it in the channel
+  SAsyncTestBlocker waiting = {0};
+  int64_t           channelId = 0;
+  int64_t           waitingIds[2] = {0};
+  ASSERT_EQ(vnodeAChannelInit(async, &channelId), 0);
+  ASSERT_EQ(
+      vnodeAsyncC(async, channelId, EVA_PRIORITY_LOW, asyncTestBlock, asyncTestBlockerComplete, &blocker, &taskId), 0);
+  tsem_wait(&blocker.started);
+
+  // a higher priority task does not take the place of the running one
+  ASSERT_EQ(vnodeAsyncC(async, channelId, EVA_PRIORITY_HIGH, asyncTestCount, asyncTestBlockerComplete, &waiting,
+                        &waitingIds[0]),
+            0);
+  ASSERT_EQ(vnodeAsyncC(async, channelId, EVA_PRIORITY_NORMAL, asyncTestCount, asyncTestBlockerComplete, &waiting,
+                        &waitingIds[1]),
+            0);
+  EXPECT_NE(vnodeACancel(async, taskId), 0);
+  EXPECT_EQ(vnodeACancel(async, waitingIds[1]), 0);
+  EXPECT_EQ(atomic_load_32(&waiting.numOfCompletes), 1);
+
+  tsem_post(&blocker.resume);
+  ASSERT_EQ(vnodeAWait(async, taskId), 0);
+  ASSERT_EQ(vnodeAWait(async, waitingIds[0]), 0);
+  EXPECT_EQ(atomic_load_32(&blocker.numOfExecutes), 2);
+  EXPECT_EQ(atomic_load_32(&blocker.numOfCompletes), 2);
+  EXPECT_EQ(atomic_load_32(&waiting.numOfExecutes), 1);
+  EXPECT_EQ(atomic_load_32(&waiting.numOfCompletes), 2);
+
+  ASSERT_EQ(vnodeAChannelDestroy(async, channelId, true), 0);
+  ASSERT_EQ(vnodeAsyncDestroy(&async), 0);
+  tsem_destroy(&blocker.started);
+  tsem_destroy(&blocker.resume);
+}
@@ -82,6 +82,8 @@ extern "C" {
 
 #define EXPLAIN_PLANNING_TIME_FORMAT "Planning Time: %.3f ms"
 #define EXPLAIN_EXEC_TIME_FORMAT "Execution Time: %.3f ms"
+#define EXPLAIN_SPILL_IO_FORMAT "  spill write:%.2f Kb  read:%.2f Kb  io stall:%.3f ms"
+#define EXPLAIN_SPILL_FORMAT "Spill: write:%.2f Kb  read:%.2f Kb  io stall:%.3f ms"
 
 //append area
 #define EXPLAIN_LIMIT_FORMAT "limit=%" PRId64
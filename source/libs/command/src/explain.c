@@ -298,6 +298,24 @@ int32_t qExplainBufAppendVerboseExecInfo(SArray *pExecInfo, char *tbuf, int32_t
   return TSDB_CODE_SUCCESS;
 }
 
+// sum the spill io of the operator in all the nodes, return false if nothing is spilled
+static bool qExplainGetSpillExecInfo(SArray *pExecInfo, SSpillExecInfo *pSpill) {
+  int32_t nodeNum = taosArrayGetSize(pExecInfo);
+  for (int32_t i = 0; i < nodeNum; ++i) {
+    SExplainExecInfo *execInfo = taosArrayGet(pExecInfo, i);
+    if (execInfo->verboseInfo == NULL || execInfo->verboseLen < sizeof(SSpillExecInfo)) {
+      continue;
+    }
+
+    SSpillExecInfo *pInfo = (SSpillExecInfo *)execInfo->verboseInfo;
+    pSpill->writeBytes += pInfo->writeBytes;
+    pSpill->readBytes += pInfo->readBytes;
+    pSpill->stallTime += pInfo->stallTime;
+  }
+
+  return pSpill->writeBytes > 0;
+}
+
 int32_t qExplainResAppendRow(SExplainCtx *ctx, char *tbuf, int32_t len, int32_t level) {
   SQueryExplainRowInfo row = {0};
   row.buf = taosMemoryMalloc(len);
@@ -473,6 +491,9 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
           info.loadBlockStatis += pScanInfo->loadBlockStatis;
           info.totalCheckedRows += pScanInfo->totalCheckedRows;
           info.filterOutBlocks += pScanInfo->filterOutBlocks;
+          if (execInfo->verboseLen >= sizeof(STableScanAnalyzeInfo)) {
+            info.runtimeFilterRows += pScanInfo->runtimeFilterRows;
+          }
 
           if (pScanInfo->totalRows > totalRows) {
             totalRows = pScanInfo->totalRows;
@@ -494,6 +515,11 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
 
         EXPLAIN_ROW_APPEND("check_rows=%.1f", ((double)info.totalCheckedRows) / nodeNum);
         EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+
+        if (info.runtimeFilterRows > 0) {
+          EXPLAIN_ROW_APPEND("runtime_filter_rows=%.1f", ((double)info.runtimeFilterRows) / nodeNum);
+          EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+        }
         EXPLAIN_ROW_END();
 
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
@@ -795,6 +821,14 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
         EXPLAIN_ROW_NEW(level + 1, EXPLAIN_MERGEBLOCKS_FORMAT, pAggNode->mergeDataBlock? "True":"False");
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
+
+        SSpillExecInfo spillInfo = {0};
+        if (qExplainGetSpillExecInfo(pResNode->pExecInfo, &spillInfo)) {
+          EXPLAIN_ROW_NEW(level + 1, EXPLAIN_SPILL_FORMAT, spillInfo.writeBytes / 1024.0, spillInfo.readBytes / 1024.0,
+                          spillInfo.stallTime / 1000.0);
+          EXPLAIN_ROW_END();
+          QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
+        }
       }
       break;
     }
@@ -936,6 +970,13 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
         }
 
         EXPLAIN_ROW_APPEND("  loops:%d", pExecInfo->loops);
+        if (pExecInfo->sortThreads > 1) {
+          EXPLAIN_ROW_APPEND("  threads:%d", pExecInfo->sortThreads);
+        }
+        if (pExecInfo->sortMethod == SORT_SPILLED_MERGE_SORT_T) {
+          EXPLAIN_ROW_APPEND(EXPLAIN_SPILL_IO_FORMAT, pExecInfo->writeBytes / 1024.0, pExecInfo->readBytes / 1024.0,
+                             pExecInfo->stallTime / 1000.0);
+        }
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
       }
@@ -1248,7 +1289,15 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
                                      TSDB_EXPLAIN_RESULT_ROW_SIZE, &tlen));
           EXPLAIN_ROW_END();
           QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
-        }        
+        }
+
+        SSpillExecInfo spillInfo = {0};
+        if (qExplainGetSpillExecInfo(pResNode->pExecInfo, &spillInfo)) {
+          EXPLAIN_ROW_NEW(level + 1, EXPLAIN_SPILL_FORMAT, spillInfo.writeBytes / 1024.0, spillInfo.readBytes / 1024.0,
+                          spillInfo.stallTime / 1000.0);
+          EXPLAIN_ROW_END();
+          QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
+        }
       }
       break;
     }
@@ -1293,6 +1342,10 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
           }
 
           EXPLAIN_ROW_APPEND("  loops:%d", pExecInfo->loops);
+          if (pExecInfo->sortMethod == SORT_SPILLED_MERGE_SORT_T) {
+            EXPLAIN_ROW_APPEND(EXPLAIN_SPILL_IO_FORMAT, pExecInfo->writeBytes / 1024.0, pExecInfo->readBytes / 1024.0,
+                               pExecInfo->stallTime / 1000.0);
+          }
           EXPLAIN_ROW_END();
           QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
         }
@@ -1515,6 +1568,13 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
         }
 
         EXPLAIN_ROW_APPEND("  loops:%d", pExecInfo->loops);
+        if (pExecInfo->sortThreads > 1) {
+          EXPLAIN_ROW_APPEND("  threads:%d", pExecInfo->sortThreads);
+        }
+        if (pExecInfo->sortMethod == SORT_SPILLED_MERGE_SORT_T) {
+          EXPLAIN_ROW_APPEND(EXPLAIN_SPILL_IO_FORMAT, pExecInfo->writeBytes / 1024.0, pExecInfo->readBytes / 1024.0,
+                             pExecInfo->stallTime / 1000.0);
+        }
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
       }
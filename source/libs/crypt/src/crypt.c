@@ -24,6 +24,36 @@ int32_t CBC_Decrypt(SCryptOpts *opts) {
   return CBC_DecryptImpl(opts); 
 }
 
+// the IV each unit of a page is chained from
+static const unsigned char cbcPageIV[16] = {0};
+
+int32_t CBC_InitKey(SCryptKey *pKey, const char *key) {
+  memset(pKey, 0, sizeof(SCryptKey));
+  strncpy((char *)pKey->key, key, ENCRYPT_KEY_LEN);
+  SM4_Set_Key(&pKey->ctx, pKey->key);
+  return 0;
+}
+
+static int32_t CBC_ProcessPage(const SCryptKey *pKey, char *page, int32_t len, int32_t unitLen, bool encrypt) {
+  if (unitLen <= 0 || unitLen % 16 != 0) return -1;
+
+  int32_t count = 0;
+  for (; count + unitLen <= len; count += unitLen) {
+    unsigned char *pUnit = (unsigned char *)page + count;
+    int32_t        code = encrypt ? SM4_CBC_Encrypt_Ex(&pKey->ctx, cbcPageIV, pUnit, unitLen)
+                                  : SM4_CBC_Decrypt_Ex(&pKey->ctx, cbcPageIV, pUnit, unitLen);
+    if (code != 0) break;
+  }
+  return count;
+}
+
+int32_t CBC_EncryptPage(const SCryptKey *pKey, char *page, int32_t len, int32_t unitLen) {
+  return CBC_ProcessPage(pKey, page, len, unitLen, true);
+}
+int32_t CBC_DecryptPage(const SCryptKey *pKey, char *page, int32_t len, int32_t unitLen) {
+  return CBC_ProcessPage(pKey, page, len, unitLen, false);
+}
+
 #ifndef TD_ENTERPRISE
 int32_t CBC_EncryptImpl(SCryptOpts *opts) { 
   memcpy(opts->result, opts->source, opts->len);
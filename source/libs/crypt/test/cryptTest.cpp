@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include "crypt.h"
+#include "sm4.h"
+
+namespace {
+
+const int32_t kUnitLen = 128;
+const int32_t kPageLen = 4096;
+
+unsigned char kKey[17] = "1234567890abcdef";
+unsigned char kIV[16] = {0};
+
+void genPlain(unsigned char *buf, int32_t len, uint32_t seed) {
+  for (int32_t i = 0; i < len; ++i) {
+    buf[i] = (unsigned char)taosRandR(&seed);
+  }
+}
+
+}  // namespace
+
+// the in place calls with the key expanded once give the same as the calls expanding the key each time
+TEST(sm4Test, cbcExRoundTrip) {
+  unsigned char plain[kPageLen], expect[kPageLen], page[kPageLen];
+  genPlain(plain, kPageLen, 100);
+
+  for (int32_t i = 0; i < kPageLen; i += kUnitLen) {
+    unsigned int len = 0;
+    ASSERT_EQ(SM4_CBC_Encrypt(kKey, 16, kIV, 16, plain + i, kUnitLen, expect + i, &len), 0);
+    ASSERT_EQ(len, kUnitLen);
+  }
+
+  SM4_KEY ctx;
+  SM4_Set_Key(&ctx, kKey);
+  memcpy(page, plain, kPageLen);
+  for (int32_t i = 0; i < kPageLen; i += kUnitLen) {
+    ASSERT_EQ(SM4_CBC_Encrypt_Ex(&ctx, kIV, page + i, kUnitLen), 0);
+  }
+  ASSERT_EQ(memcmp(page, expect, kPageLen), 0);
+
+  for (int32_t i = 0; i < kPageLen; i += kUnitLen) {
+    ASSERT_EQ(SM4_CBC_Decrypt_Ex(&ctx, kIV, page + i, kUnitLen), 0);
+  }
+  ASSERT_EQ(memcmp(page, plain, kPageLen), 0);
+
+  unsigned char decrypted[kPageLen];
+  for (int32_t i = 0; i < kPageLen; i += kUnitLen) {
+    unsigned int len = 0;
+    ASSERT_EQ(SM4_CBC_Decrypt(kKey, 16, kIV, 16, expect + i, kUnitLen, decrypted + i, &len), 0);
+    ASSERT_EQ(len, kUnitLen);
+  }
+  ASSERT_EQ(memcmp(decrypted, plain, kPageLen), 0);
+}
+
+// a page call gives the same as SM4_CBC_Encrypt/SM4_CBC_Decrypt on each unit, chained from a zero IV
+TEST(cryptTest, pageRoundTrip) {
+  char plain[kPageLen], expect[kPageLen], page[kPageLen];
+  genPlain((unsigned char *)plain, kPageLen, 200);
+
+  for (int32_t i = 0; i < kPageLen; i += kUnitLen) {
+    unsigned int len = 0;
+    ASSERT_EQ(SM4_CBC_Encrypt(kKey, 16, kIV, 16, (unsigned char *)plain + i, kUnitLen, (unsigned char *)expect + i, &len),
+              0);
+    ASSERT_EQ(len, kUnitLen);
+  }
+
+  SCryptKey key;
+  ASSERT_EQ(CBC_InitKey(&key, (char *)kKey), 0);
+  memcpy(page, plain, kPageLen);
+  ASSERT_EQ(CBC_EncryptPage(&key, page, kPageLen, kUnitLen), kPageLen);
+  ASSERT_EQ(memcmp(page, expect, kPageLen), 0);
+
+  ASSERT_EQ(CBC_DecryptPage(&key, page, kPageLen, kUnitLen), kPageLen);
+  ASSERT_EQ(memcmp(page, plain, kPageLen), 0);
+}
+
+TEST(cryptTest, pagePartialUnit) {
+  char page[kPageLen];
+  genPlain((unsigned char *)page, kPageLen, 300);
+
+  SCryptKey key;
+  ASSERT_EQ(CBC_InitKey(&key, (char *)kKey), 0);
+
+  // the tail shorter than a unit is left as it is
+  ASSERT_EQ(CBC_EncryptPage(&key, page, kUnitLen * 2 + 10, kUnitLen), kUnitLen * 2);
+  ASSERT_EQ(CBC_DecryptPage(&key, page, kUnitLen * 2 + 10, kUnitLen), kUnitLen * 2);
+
+  ASSERT_EQ(CBC_EncryptPage(&key, page, kPageLen, 0), -1);
+  ASSERT_EQ(CBC_EncryptPage(&key, page, kPageLen, kUnitLen + 1), -1);
+}
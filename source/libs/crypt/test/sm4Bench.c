@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Throughput of SM4-CBC page encryption and decryption in 128 bytes units, by expanding the key for each unit into a
+// separate buffer and by the key schedule expanded once and in place, e.g.
+//   sm4Bench [numOfPages] [pageSizeKB]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "os.h"
+#include "sm4.h"
+
+#define BENCH_UNIT_LEN 128
+
+static unsigned char benchKey[16] = "1234567890abcdef";
+static unsigned char benchIV[16] = {0};
+
+static void benchPerUnit(unsigned char *pPages, int64_t size, bool decrypt) {
+  unsigned char packetData[BENCH_UNIT_LEN];
+  unsigned int  len = 0;
+
+  for (int64_t i = 0; i < size; i += BENCH_UNIT_LEN) {
+    if (decrypt) {
+      (void)SM4_CBC_Decrypt(benchKey, 16, benchIV, 16, pPages + i, BENCH_UNIT_LEN, packetData, &len);
+    } else {
+      (void)SM4_CBC_Encrypt(benchKey, 16, benchIV, 16, pPages + i, BENCH_UNIT_LEN, packetData, &len);
+    }
+    memcpy(pPages + i, packetData, len);
+  }
+}
+
+static void benchInPlace(const SM4_KEY *pCtx, unsigned char *pPages, int64_t size, bool decrypt) {
+  for (int64_t i = 0; i < size; i += BENCH_UNIT_LEN) {
+    if (decrypt) {
+      (void)SM4_CBC_Decrypt_Ex(pCtx, benchIV, pPages + i, BENCH_UNIT_LEN);
+    } else {
+      (void)SM4_CBC_Encrypt_Ex(pCtx, benchIV, pPages + i, BENCH_UNIT_LEN);
+    }
+  }
+}
+
+int main(int argc, char *argv[]) {
+  int32_t numOfPages = (argc > 1) ? atoi(argv[1]) : 4096;
+  int32_t pageSize = ((argc > 2) ? atoi(argv[2]) : 4) * 1024;
+  int64_t size = (int64_t)numOfPages * pageSize;
+
+  unsigned char *pPages = (unsigned char *)taosMemoryMalloc(size);
+  unsigned char *pPlain = (unsigned char *)taosMemoryMalloc(size);
+  if (pPages == NULL || pPlain == NULL) {
+    printf("failed to allocate memory\n");
+    return -1;
+  }
+
+  uint32_t seed = 100;
+  for (int64_t i = 0; i < size; ++i) {
+    pPlain[i] = (unsigned char)taosRandR(&seed);
+  }
+
+  SM4_KEY ctx;
+  SM4_Set_Key(&ctx, benchKey);
+
+  printf("%-10s %-8s %12s %10s\n", "path", "op", "elapsed(us)", "MB/s");
+  for (int32_t d = 0; d < 2; ++d) {
+    bool decrypt = (d == 1);
+
+    memcpy(pPages, pPlain, size);
+    if (decrypt) benchInPlace(&ctx, pPages, size, false);
+    int64_t st = taosGetTimestampUs();
+    benchPerUnit(pPages, size, decrypt);
+    int64_t el = taosGetTimestampUs() - st;
+    printf("%-10s %-8s %12" PRId64 " %10.1f\n", "per-unit", decrypt ? "decrypt" : "encrypt", el,
+           (el > 0) ? (double)size / el : 0);
+
+    unsigned char *pExpect = (unsigned char *)taosMemoryMalloc(size);
+    memcpy(pExpect, pPages, size);
+
+    memcpy(pPages, pPlain, size);
+    if (decrypt) benchInPlace(&ctx, pPages, size, false);
+    st = taosGetTimestampUs();
+    benchInPlace(&ctx, pPages, size, decrypt);
+    el = taosGetTimestampUs() - st;
+
+    if (memcmp(pExpect, pPages, size) != 0) {
+      printf("%-10s %-8s result mismatch\n", "in-place", decrypt ? "decrypt" : "encrypt");
+    } else {
+      printf("%-10s %-8s %12" PRId64 " %10.1f\n", "in-place", decrypt ? "decrypt" : "encrypt", el,
+             (el > 0) ? (double)size / el : 0);
+    }
+    taosMemoryFree(pExpect);
+  }
+
+  taosMemoryFree(pPages);
+  taosMemoryFree(pPlain);
+  return 0;
+}
@@ -34,6 +34,7 @@ extern "C" {
 #include "scalar.h"
 #include "taosdef.h"
 #include "tarray.h"
+#include "tbloomfilter.h"
 #include "tfill.h"
 #include "thash.h"
 #include "tlockfree.h"
@@ -247,6 +248,17 @@ typedef struct STableMetaCacheInfo {
   uint64_t   cacheHit;
 } STableMetaCacheInfo;
 
+// The bloom filter of the join keys of the build side of hash join, which is pushed down to the table scan of the
+// probe side, so that the rows that never match are dropped before they are returned by the scan.
+typedef struct SJoinRuntimeFilter {
+  SBloomFilter* pBloom;
+  int32_t       keyNum;
+  int32_t*      keySlots;  // slots of the key columns in the result block of the scan
+  char*         keyBuf;    // keys of multiple columns are concatenated in it
+  bool*         pQualified;
+  int32_t       capacity;  // rows of pQualified
+} SJoinRuntimeFilter;
+
 typedef struct STableScanBase {
   STsdbReader*           dataReader;
   SFileBlockLoadRecorder readRecorder;
@@ -260,8 +272,10 @@ typedef struct STableScanBase {
   int32_t                dataBlockLoadFlag;
   SLimitInfo             limitInfo;
   // there are more than one table list exists in one task, if only one vnode exists.
-  STableListInfo* pTableListInfo;
-  TsdReader       readerAPI;
+  STableListInfo*     pTableListInfo;
+  TsdReader           readerAPI;
+  SJoinRuntimeFilter* pRuntimeFilter;
+  SArray*             pFilterColIds;  // SArray<col_id_t>, columns of the filter that are loaded before the others
 } STableScanBase;
 
 typedef struct STableScanInfo {
@@ -819,6 +833,7 @@ void    cleanupExprSupp(SExprSupp* pSup);
 int32_t initAggSup(SExprSupp* pSup, SAggSupporter* pAggSup, SExprInfo* pExprInfo, int32_t numOfCols, size_t keyBufSize,
                    const char* pkey, void* pState, SFunctionStateStore* pStore);
 void    cleanupAggSup(SAggSupporter* pAggSup);
+int32_t getSpillExplainExecInfo(SDiskbasedBuf* pBuf, void** pOptrExplain, uint32_t* len);
 
 void initResultSizeInfo(SResultInfo* pResultInfo, int32_t numOfRows);
 
@@ -851,6 +866,12 @@ extern void doDestroyExchangeOperatorInfo(void* param);
 
 int32_t doFilterImpl(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* pColMatchInfo, SColumnInfoData** pResCol);
 int32_t doFilter(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* pColMatchInfo);
+int32_t doFilterExecute(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColumnInfoData** pResCol, int32_t* status);
+void    applyFilterResult(SSDataBlock* pBlock, const SColumnInfoData* pResCol, int32_t status,
+                          SColMatchInfo* pColMatchInfo);
+int32_t setTableScanRuntimeFilter(struct SOperatorInfo* pOperator, SJoinRuntimeFilter* pFilter);
+int32_t doApplyJoinRuntimeFilter(STableScanBase* pTableScanInfo, SSDataBlock* pBlock);
+void    destroyJoinRuntimeFilter(SJoinRuntimeFilter* pFilter);
 int32_t addTagPseudoColumnData(SReadHandle* pHandle, const SExprInfo* pExpr, int32_t numOfExpr, SSDataBlock* pBlock,
                                int32_t rows, SExecTaskInfo* pTask, STableMetaCacheInfo* pCache);
 
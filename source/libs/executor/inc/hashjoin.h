@@ -24,6 +24,13 @@ extern "C" {
 #define HJOIN_BLK_SIZE_LIMIT 10485760
 #define HJOIN_ROW_BITMAP_SIZE (2 * 1048576)
 #define HJOIN_BLK_THRESHOLD_RATIO 0.9
+#define HJOIN_RUNTIME_FILTER_ERROR_RATE 0.01
+#define HJOIN_BUILD_PARTITION_BITS 4
+#define HJOIN_BUILD_PARTITION_NUM (1 << HJOIN_BUILD_PARTITION_BITS)
+#define HJOIN_PARALLEL_BUILD_ROWS 65536
+
+// the partition of a key is chosen by the top bits of its hash value, the buckets of the hash table by the low bits
+#define HJOIN_PARTITION_IDX(_hashVal) ((_hashVal) >> (32 - HJOIN_BUILD_PARTITION_BITS))
 
 typedef int32_t (*hJoinImplFp)(SOperatorInfo*);
 
@@ -79,6 +86,23 @@ typedef struct SGroupData {
   SBufRowInfo* rows;
 } SGroupData;
 
+typedef struct SHJoinBuildRow {
+  SBufRowInfo* pRow;
+  int64_t      keyOffset;
+  int32_t      keyLen;
+} SHJoinBuildRow;
+
+// The build rows are staged in the partition of their keys first, then the hash table of each partition is built
+// on its own, so that the partitions can be built in parallel.
+typedef struct SHJoinPartition {
+  SArray*    pRows;  // SHJoinBuildRow
+  SArray*    pKeys;  // the keys of the staged rows
+  SSHashObj* pKeyHash;
+  int32_t    code;
+  bool       queued;
+  tsem_t     done;
+} SHJoinPartition;
+
 
 typedef struct SHJoinColMap {
   int32_t  srcSlot;
@@ -143,7 +167,8 @@ typedef struct SHJoinOperatorInfo {
   int32_t          pResColNum;
   int8_t*          pResColMap;
   SArray*          pRowBufs;
-  SSHashObj*       pKeyHash;
+  SHJoinPartition  parts[HJOIN_BUILD_PARTITION_NUM];
+  int64_t          keyNum;
   bool             keyHashBuilt;
   SHJoinCtx        ctx;
   SHJoinExecInfo   execInfo;
@@ -179,6 +204,13 @@ int32_t hJoinCopyMergeMidBlk(SHJoinCtx* pCtx, SSDataBlock** ppMid, SSDataBlock**
 int32_t hJoinHandleMidRemains(SHJoinOperatorInfo* pJoin, SHJoinCtx* pCtx);
 bool hJoinBlkReachThreshold(SHJoinOperatorInfo* pInfo, int64_t blkRows);
 int32_t hJoinCopyNMatchRowsToBlock(SHJoinOperatorInfo* pJoin, SSDataBlock* pRes, int32_t startIdx, int32_t rows);
+int32_t hJoinInitBuildWorker();
+void hJoinCleanupBuildWorker();
+
+static FORCE_INLINE SGroupData* hJoinGetGroup(SHJoinOperatorInfo* pJoin, const char* key, size_t keyLen) {
+  SSHashObj* pHash = pJoin->parts[HJOIN_PARTITION_IDX(MurmurHash3_32(key, keyLen))].pKeyHash;
+  return tSimpleHashGet(pHash, key, keyLen);
+}
 
 
 #ifdef __cplusplus
@@ -45,8 +45,11 @@ typedef struct SSortSource {
     void* param;
     bool  onlyRef;
   };
-  int64_t fetchUs;
-  int64_t fetchNum;
+  int64_t   fetchUs;
+  int64_t   fetchNum;
+  uint64_t* pSortKeys;     // prefix of the first sort key of the rows in the current block
+  int32_t   sortKeyCap;
+  bool      sortKeyValid;  // false if the prefix is not built for the current block
 } SSortSource;
 
 typedef struct SMsortComparParam {
@@ -83,6 +86,25 @@ SSortHandle* tsortCreateSortHandle(SArray* pOrderInfo, int32_t type, int32_t pag
 
 void tsortSetForceUsePQSort(SSortHandle* pHandle);
 
+/**
+ * Sort at most numOfThreads - 1 runs to be spilled in the process-wide sort run worker while the next one is buffered,
+ * each with its share of the sort buffer, 1 to sort them in the query thread.
+ * @param pHandle
+ * @param numOfThreads
+ */
+void tsortSetSortThreads(SSortHandle* pHandle, int32_t numOfThreads);
+
+/**
+ * Start the process-wide sort run worker, the runs are sorted in the query threads if it is not started.
+ * @return
+ */
+int32_t tsortInitRunWorker();
+
+/**
+ * Stop the sort run worker, all the sort handles should have been destroyed.
+ */
+void tsortCleanupRunWorker();
+
 /**
  *
  * @param pSortHandle
@@ -51,6 +51,7 @@ typedef struct SAggOperatorInfo {
 } SAggOperatorInfo;
 
 static void destroyAggOperatorInfo(void* param);
+static int32_t getAggExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len);
 static void setExecutionContext(SOperatorInfo* pOperator, int32_t numOfOutput, uint64_t groupId);
 
 static int32_t createDataBlockForEmptyInput(SOperatorInfo* pOperator, SSDataBlock** ppBlock);
@@ -117,7 +118,7 @@ SOperatorInfo* createAggregateOperatorInfo(SOperatorInfo* downstream, SAggPhysiN
   setOperatorInfo(pOperator, "TableAggregate", QUERY_NODE_PHYSICAL_PLAN_HASH_AGG,
                   !pAggNode->node.forceCreateNonBlockingOptr, OP_NOT_OPENED, pInfo, pTaskInfo);
   pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, getAggregateResult, NULL, destroyAggOperatorInfo,
-                                         optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
+                                         optrDefaultBufFn, getAggExplainExecInfo, optrDefaultGetNextExtFn, NULL);
 
   if (downstream->operatorType == QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN) {
     STableScanInfo* pTableScanInfo = downstream->info;
@@ -494,9 +495,41 @@ int32_t doInitAggInfoSup(SAggSupporter* pAggSup, SqlFunctionCtx* pCtx, int32_t n
     return code;
   }
 
+  if (tsQuerySpillWriteBehind) {
+    dBufSetPageCodec(pAggSup->pResultBuf, PAGE_CODEC_LZ4);
+    code = dBufSetWriteBehind(pAggSup->pResultBuf, DBUF_WRITE_BEHIND_PAGES);
+    if (code != TSDB_CODE_SUCCESS) {
+      qError("Enable write-behind of agg result buf failed since %s, %s", tstrerror(code), pKey);
+      return code;
+    }
+  }
+
   return code;
 }
 
+int32_t getSpillExplainExecInfo(SDiskbasedBuf* pBuf, void** pOptrExplain, uint32_t* len) {
+  SSpillExecInfo* pInfo = taosMemoryCalloc(1, sizeof(SSpillExecInfo));
+  if (pInfo == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  if (pBuf != NULL) {
+    SDiskbasedBufStatis st = getDBufStatis(pBuf);
+    pInfo->writeBytes = st.flushBytes;
+    pInfo->readBytes = st.loadBytes;
+    pInfo->stallTime = st.stallTime;
+  }
+
+  *pOptrExplain = pInfo;
+  *len = sizeof(SSpillExecInfo);
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t getAggExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len) {
+  SAggOperatorInfo* pInfo = pOptr->info;
+  return getSpillExplainExecInfo(pInfo->aggSup.pResultBuf, pOptrExplain, len);
+}
+
 void cleanupAggSup(SAggSupporter* pAggSup) {
   taosMemoryFreeClear(pAggSup->keyBuf);
   tSimpleHashCleanup(pAggSup->pResultRowHashTable);
@@ -1801,6 +1801,9 @@ int32_t initQueryTableDataCond(SQueryTableDataCond* pCond, const STableScanPhysi
   pCond->notLoadData = (pTableScanNode->dataRequired == FUNC_DATA_REQUIRED_NOT_LOAD) &&
                        (pTableScanNode->scan.node.pConditions == NULL) && (pTableScanNode->interval == 0);
 
+  // blocks answered by the sma are not loaded at all, so only read ahead when the data of each block is required
+  pCond->prefetchBlocks = (pTableScanNode->dataRequired == FUNC_DATA_REQUIRED_DATA_LOAD) ? tsQueryPrefetchBlocks : 0;
+
   int32_t j = 0;
   for (int32_t i = 0; i < pCond->numOfCols; ++i) {
     STargetNode* pNode = (STargetNode*)nodesListGetNode(pTableScanNode->scan.pScanCols, i);
@@ -18,6 +18,7 @@
 #include "trpc.h"
 #include "wal.h"
 #include "operator.h"
+#include "hashjoin.h"
 #include "planner.h"
 #include "querytask.h"
 #include "tdatablock.h"
@@ -523,6 +524,22 @@ void qUpdateOperatorParam(qTaskInfo_t tinfo, void* pParam) {
   ((SExecTaskInfo*)tinfo)->paramSet = false;
 }
 
+int32_t qInitExecWorkers() {
+  int32_t code = tsortInitRunWorker();
+  int32_t ioCode = dBufIoPoolInit();
+  int32_t joinCode = hJoinInitBuildWorker();
+  if (code == TSDB_CODE_SUCCESS) {
+    code = (ioCode != TSDB_CODE_SUCCESS) ? ioCode : joinCode;
+  }
+  return code;
+}
+
+void qCleanupExecWorkers() {
+  tsortCleanupRunWorker();
+  dBufIoPoolCleanup();
+  hJoinCleanupBuildWorker();
+}
+
 int32_t qCreateExecTask(SReadHandle* readHandle, int32_t vgId, uint64_t taskId, SSubplan* pSubplan,
                         qTaskInfo_t* pTaskInfo, DataSinkHandle* handle, char* sql, EOPTR_EXEC_MODEL model) {
   SExecTaskInfo** pTask = (SExecTaskInfo**)pTaskInfo;
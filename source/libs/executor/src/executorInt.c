@@ -516,21 +516,33 @@ int32_t doFilter(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* p
     return TSDB_CODE_SUCCESS;
   }
 
+  SColumnInfoData* p = NULL;
+  int32_t          status = 0;
+
+  int32_t code = doFilterExecute(pBlock, pFilterInfo, &p, &status);
+  if (code == TSDB_CODE_SUCCESS) {
+    applyFilterResult(pBlock, p, status, pColMatchInfo);
+  }
+
+  colDataDestroy(p);
+  taosMemoryFree(p);
+  return code;
+}
+
+int32_t doFilterExecute(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColumnInfoData** pResCol, int32_t* status) {
   SFilterColumnParam param1 = {.numOfCols = taosArrayGetSize(pBlock->pDataBlock), .pDataBlock = pBlock->pDataBlock};
-  SColumnInfoData*   p = NULL;
 
   int32_t code = filterSetDataFromSlotId(pFilterInfo, &param1);
   if (code != TSDB_CODE_SUCCESS) {
-    goto _err;
+    return code;
   }
 
-  int32_t status = 0;
-  code = filterExecute(pFilterInfo, pBlock, &p, NULL, param1.numOfCols, &status);
-  if (code != TSDB_CODE_SUCCESS) {
-    goto _err;
-  }
+  return filterExecute(pFilterInfo, pBlock, pResCol, NULL, param1.numOfCols, status);
+}
 
-  extractQualifiedTupleByFilterResult(pBlock, p, status);
+void applyFilterResult(SSDataBlock* pBlock, const SColumnInfoData* pResCol, int32_t status,
+                       SColMatchInfo* pColMatchInfo) {
+  extractQualifiedTupleByFilterResult(pBlock, pResCol, status);
 
   if (pColMatchInfo != NULL) {
     size_t size = taosArrayGetSize(pColMatchInfo->pList);
@@ -545,12 +557,6 @@ int32_t doFilter(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* p
       }
     }
   }
-  code = TSDB_CODE_SUCCESS;
-
-_err:
-  colDataDestroy(p);
-  taosMemoryFree(p);
-  return code;
 }
 
 void extractQualifiedTupleByFilterResult(SSDataBlock* pBlock, const SColumnInfoData* p, int32_t status) {
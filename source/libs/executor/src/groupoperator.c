@@ -28,16 +28,32 @@
 #include "thash.h"
 #include "ttypes.h"
 
+// the rows of a block are grouped in batch by these buffers, if all group by columns are fixed-width
+typedef struct SGroupBatchSupp {
+  int32_t   capacity;    // max rows of the buffers
+  char*     pKeys;       // group keys of rows, each one takes groupKeyLen bytes
+  int32_t*  pKeyLen;     // actual length of the group keys
+  uint32_t* pHash;       // hash values of the group keys
+  int32_t*  pGroupId;    // group id of rows, numbered in the order of first appearance in the block
+  int32_t*  pFirstRow;   // first row of groups
+  int32_t*  pOffset;     // end position of groups in pIndex
+  int32_t*  pIndex;      // rows ordered by group id
+  int32_t   numOfSlots;  // power of two
+  int32_t*  pSlots;      // open addressing hash table of group id
+} SGroupBatchSupp;
+
 typedef struct SGroupbyOperatorInfo {
-  SOptrBasicInfo binfo;
-  SAggSupporter  aggSup;
-  SArray*        pGroupCols;     // group by columns, SArray<SColumn>
-  SArray*        pGroupColVals;  // current group column values, SArray<SGroupKeys>
-  bool           isInit;         // denote if current val is initialized or not
-  char*          keyBuf;         // group by keys for hash
-  int32_t        groupKeyLen;    // total group by column width
-  SGroupResInfo  groupResInfo;
-  SExprSupp      scalarSup;
+  SOptrBasicInfo  binfo;
+  SAggSupporter   aggSup;
+  SArray*         pGroupCols;     // group by columns, SArray<SColumn>
+  SArray*         pGroupColVals;  // current group column values, SArray<SGroupKeys>
+  bool            isInit;         // denote if current val is initialized or not
+  char*           keyBuf;         // group by keys for hash
+  int32_t         groupKeyLen;    // total group by column width
+  SGroupResInfo   groupResInfo;
+  SExprSupp       scalarSup;
+  bool            fixedKey;  // all group by columns are fixed-width
+  SGroupBatchSupp batchSup;
 } SGroupbyOperatorInfo;
 
 // The sort in partition may be needed later.
@@ -67,12 +83,37 @@ static int32_t* setupColumnOffset(const SSDataBlock* pBlock, int32_t rowCapacity
 static int32_t  setGroupResultOutputBuf(SOperatorInfo* pOperator, SOptrBasicInfo* binfo, int32_t numOfCols, char* pData,
                                         int32_t bytes, uint64_t groupId, SDiskbasedBuf* pBuf, SAggSupporter* pAggSup);
 static SArray*  extractColumnInfo(SNodeList* pNodeList);
+static int32_t  getGroupbyExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len);
+static int32_t  getPartitionExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len);
 
 static void freeGroupKey(void* param) {
   SGroupKeys* pKey = (SGroupKeys*)param;
   taosMemoryFree(pKey->pData);
 }
 
+static void cleanupGroupBatchSupp(SGroupBatchSupp* pSupp) {
+  taosMemoryFreeClear(pSupp->pKeys);
+  taosMemoryFreeClear(pSupp->pKeyLen);
+  taosMemoryFreeClear(pSupp->pHash);
+  taosMemoryFreeClear(pSupp->pGroupId);
+  taosMemoryFreeClear(pSupp->pFirstRow);
+  taosMemoryFreeClear(pSupp->pOffset);
+  taosMemoryFreeClear(pSupp->pIndex);
+  taosMemoryFreeClear(pSupp->pSlots);
+  pSupp->capacity = 0;
+  pSupp->numOfSlots = 0;
+}
+
+static int32_t getGroupbyExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len) {
+  SGroupbyOperatorInfo* pInfo = pOptr->info;
+  return getSpillExplainExecInfo(pInfo->aggSup.pResultBuf, pOptrExplain, len);
+}
+
+static int32_t getPartitionExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len) {
+  SPartitionOperatorInfo* pInfo = pOptr->info;
+  return getSpillExplainExecInfo(pInfo->pBuf, pOptrExplain, len);
+}
+
 static void destroyGroupOperatorInfo(void* param) {
   SGroupbyOperatorInfo* pInfo = (SGroupbyOperatorInfo*)param;
   if (pInfo == NULL) {
@@ -81,6 +122,7 @@ static void destroyGroupOperatorInfo(void* param) {
 
   cleanupBasicInfo(&pInfo->binfo);
   taosMemoryFreeClear(pInfo->keyBuf);
+  cleanupGroupBatchSupp(&pInfo->batchSup);
   taosArrayDestroy(pInfo->pGroupCols);
   taosArrayDestroyEx(pInfo->pGroupColVals, freeGroupKey);
   cleanupExprSupp(&pInfo->scalarSup);
@@ -272,10 +314,232 @@ static void doAssignGroupKeys(SqlFunctionCtx* pCtx, int32_t numOfOutput, int32_t
   }
 }
 
+static bool isFixedGroupKey(const SArray* pGroupCols) {
+  for (int32_t i = 0; i < taosArrayGetSize(pGroupCols); ++i) {
+    SColumn* pCol = (SColumn*)taosArrayGet(pGroupCols, i);
+    if (IS_VAR_DATA_TYPE(pCol->type) || pCol->type == TSDB_DATA_TYPE_JSON) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static int32_t ensureGroupBatchSupp(SGroupBatchSupp* pSupp, int32_t rows, int32_t keyLen) {
+  if (rows <= pSupp->capacity) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  cleanupGroupBatchSupp(pSupp);
+
+  int32_t numOfSlots = 16;
+  while (numOfSlots < rows * 2) {
+    numOfSlots <<= 1;
+  }
+
+  pSupp->pKeys = taosMemoryMalloc((int64_t)rows * keyLen);
+  pSupp->pKeyLen = taosMemoryMalloc(rows * sizeof(int32_t));
+  pSupp->pHash = taosMemoryMalloc(rows * sizeof(uint32_t));
+  pSupp->pGroupId = taosMemoryMalloc(rows * sizeof(int32_t));
+  pSupp->pFirstRow = taosMemoryMalloc(rows * sizeof(int32_t));
+  pSupp->pOffset = taosMemoryMalloc(rows * sizeof(int32_t));
+  pSupp->pIndex = taosMemoryMalloc(rows * sizeof(int32_t));
+  pSupp->pSlots = taosMemoryMalloc(numOfSlots * sizeof(int32_t));
+  if (pSupp->pKeys == NULL || pSupp->pKeyLen == NULL || pSupp->pHash == NULL || pSupp->pGroupId == NULL ||
+      pSupp->pFirstRow == NULL || pSupp->pOffset == NULL || pSupp->pIndex == NULL || pSupp->pSlots == NULL) {
+    cleanupGroupBatchSupp(pSupp);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pSupp->capacity = rows;
+  pSupp->numOfSlots = numOfSlots;
+  return TSDB_CODE_SUCCESS;
+}
+
+// build the group keys of all rows column by column, in the same format of buildGroupKeys, and then hash them
+static void buildGroupKeysInBatch(SGroupbyOperatorInfo* pInfo, SSDataBlock* pBlock) {
+  SGroupBatchSupp* pSupp = &pInfo->batchSup;
+  int32_t          rows = pBlock->info.rows;
+  int32_t          keyLen = pInfo->groupKeyLen;
+  int32_t          numOfGroupCols = taosArrayGetSize(pInfo->pGroupCols);
+
+  for (int32_t j = 0; j < rows; ++j) {
+    pSupp->pKeyLen[j] = sizeof(int8_t) * numOfGroupCols;
+  }
+
+  for (int32_t i = 0; i < numOfGroupCols; ++i) {
+    SColumn*         pCol = (SColumn*)taosArrayGet(pInfo->pGroupCols, i);
+    SColumnInfoData* pColInfoData = taosArrayGet(pBlock->pDataBlock, pCol->slotId);
+    SColumnDataAgg*  pColAgg = (pBlock->pBlockAgg != NULL) ? pBlock->pBlockAgg[pCol->slotId] : NULL;
+    int32_t          bytes = pCol->bytes;
+
+    if (!pColInfoData->hasNull) {
+      for (int32_t j = 0; j < rows; ++j) {
+        char* pKey = pSupp->pKeys + (int64_t)j * keyLen;
+        pKey[i] = 0;
+        memcpy(pKey + pSupp->pKeyLen[j], colDataGetNumData(pColInfoData, j), bytes);
+        pSupp->pKeyLen[j] += bytes;
+      }
+      continue;
+    }
+
+    for (int32_t j = 0; j < rows; ++j) {
+      char* pKey = pSupp->pKeys + (int64_t)j * keyLen;
+      if (colDataIsNull(pColInfoData, rows, j, pColAgg)) {
+        pKey[i] = 1;
+        continue;
+      }
+
+      pKey[i] = 0;
+      memcpy(pKey + pSupp->pKeyLen[j], colDataGetNumData(pColInfoData, j), bytes);
+      pSupp->pKeyLen[j] += bytes;
+    }
+  }
+
+  for (int32_t j = 0; j < rows; ++j) {
+    pSupp->pHash[j] = MurmurHash3_32(pSupp->pKeys + (int64_t)j * keyLen, pSupp->pKeyLen[j]);
+  }
+}
+
+static FORCE_INLINE bool groupBatchKeyEqual(const SGroupBatchSupp* pSupp, int32_t keyLen, int32_t r1, int32_t r2) {
+  return pSupp->pHash[r1] == pSupp->pHash[r2] && pSupp->pKeyLen[r1] == pSupp->pKeyLen[r2] &&
+         memcmp(pSupp->pKeys + (int64_t)r1 * keyLen, pSupp->pKeys + (int64_t)r2 * keyLen, pSupp->pKeyLen[r1]) == 0;
+}
+
+#define GROUP_BATCH_PREFETCH_DIST 8
+
+// probe the block-local hash table for all rows, and return the number of distinct groups in this block
+static int32_t assignGroupIdInBatch(SGroupBatchSupp* pSupp, int32_t rows, int32_t keyLen) {
+  uint32_t mask = pSupp->numOfSlots - 1;
+  int32_t  numOfGroups = 0;
+
+  memset(pSupp->pSlots, 0xFF, pSupp->numOfSlots * sizeof(int32_t));
+  for (int32_t j = 0; j < rows; ++j) {
+    if (j + GROUP_BATCH_PREFETCH_DIST < rows) {
+      BUILDIN_PREFETCH(&pSupp->pSlots[pSupp->pHash[j + GROUP_BATCH_PREFETCH_DIST] & mask]);
+    }
+
+    // rows of the same group are usually adjacent
+    if (j > 0 && groupBatchKeyEqual(pSupp, keyLen, j - 1, j)) {
+      pSupp->pGroupId[j] = pSupp->pGroupId[j - 1];
+      continue;
+    }
+
+    uint32_t pos = pSupp->pHash[j] & mask;
+    while (1) {
+      int32_t groupId = pSupp->pSlots[pos];
+      if (groupId == -1) {
+        pSupp->pSlots[pos] = numOfGroups;
+        pSupp->pFirstRow[numOfGroups] = j;
+        pSupp->pGroupId[j] = numOfGroups++;
+        break;
+      }
+
+      if (groupBatchKeyEqual(pSupp, keyLen, pSupp->pFirstRow[groupId], j)) {
+        pSupp->pGroupId[j] = groupId;
+        break;
+      }
+
+      pos = (pos + 1) & mask;
+    }
+  }
+
+  return numOfGroups;
+}
+
+static void doAggregateGroup(SOperatorInfo* pOperator, SSDataBlock* pBlock, char* pKey, int32_t len,
+                             int32_t rowIndex, int32_t num) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SqlFunctionCtx*       pCtx = pOperator->exprSupp.pCtx;
+
+  int32_t ret = setGroupResultOutputBuf(pOperator, &(pInfo->binfo), pOperator->exprSupp.numOfExprs, pKey, len,
+                                        pBlock->info.id.groupId, pInfo->aggSup.pResultBuf, &pInfo->aggSup);
+  if (ret != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, TSDB_CODE_APP_ERROR);
+  }
+
+  applyAggFunctionOnPartialTuples(pTaskInfo, pCtx, NULL, rowIndex, num, pBlock->info.rows,
+                                  pOperator->exprSupp.numOfExprs);
+  doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, rowIndex);
+}
+
+// Group the rows of the block in one pass with the fixed-width keys, instead of comparing and building the keys row
+// by row. If the rows of some groups are scattered in the block, the block is reordered by group, so that the
+// aggregate functions are applied only once for each group.
+static void doHashGroupbyAggInBatch(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SGroupBatchSupp*      pSupp = &pInfo->batchSup;
+  int32_t               rows = pBlock->info.rows;
+  int32_t               keyLen = pInfo->groupKeyLen;
+
+  int32_t code = ensureGroupBatchSupp(pSupp, rows, keyLen);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+
+  buildGroupKeysInBatch(pInfo, pBlock);
+  int32_t numOfGroups = assignGroupIdInBatch(pSupp, rows, keyLen);
+
+  int32_t numOfRuns = 1;
+  for (int32_t j = 1; j < rows; ++j) {
+    numOfRuns += (pSupp->pGroupId[j] != pSupp->pGroupId[j - 1]);
+  }
+
+  // reordering the block costs a copy of all columns, so it is done only if it saves enough calls of the functions
+  if (numOfRuns >= numOfGroups * 2) {
+    memset(pSupp->pOffset, 0, numOfGroups * sizeof(int32_t));
+    for (int32_t j = 0; j < rows; ++j) {
+      pSupp->pOffset[pSupp->pGroupId[j]] += 1;
+    }
+
+    int32_t start = 0;
+    for (int32_t g = 0; g < numOfGroups; ++g) {
+      int32_t num = pSupp->pOffset[g];
+      pSupp->pOffset[g] = start;
+      start += num;
+    }
+
+    // a stable counting sort, so the rows in each group keep their original order
+    for (int32_t j = 0; j < rows; ++j) {
+      pSupp->pIndex[pSupp->pOffset[pSupp->pGroupId[j]]++] = j;
+    }
+
+    if (blockDataReorder(pBlock, pSupp->pIndex) == TSDB_CODE_SUCCESS) {
+      for (int32_t g = 0; g < numOfGroups; ++g) {
+        int32_t rowIndex = (g == 0) ? 0 : pSupp->pOffset[g - 1];
+        int32_t row = pSupp->pFirstRow[g];
+        doAggregateGroup(pOperator, pBlock, pSupp->pKeys + (int64_t)row * keyLen, pSupp->pKeyLen[row], rowIndex,
+                         pSupp->pOffset[g] - rowIndex);
+      }
+      return;
+    }
+
+    terrno = TSDB_CODE_SUCCESS;
+  }
+
+  int32_t rowIndex = 0;
+  for (int32_t j = 1; j <= rows; ++j) {
+    if (j < rows && pSupp->pGroupId[j] == pSupp->pGroupId[rowIndex]) {
+      continue;
+    }
+
+    doAggregateGroup(pOperator, pBlock, pSupp->pKeys + (int64_t)rowIndex * keyLen, pSupp->pKeyLen[rowIndex], rowIndex,
+                     j - rowIndex);
+    rowIndex = j;
+  }
+}
+
 static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
   SGroupbyOperatorInfo* pInfo = pOperator->info;
 
+  if (pInfo->fixedKey && pBlock->info.rows > 0) {
+    doHashGroupbyAggInBatch(pOperator, pBlock);
+    return;
+  }
+
   SqlFunctionCtx* pCtx = pOperator->exprSupp.pCtx;
   int32_t         numOfGroupCols = taosArrayGetSize(pInfo->pGroupCols);
   //  if (type == TSDB_DATA_TYPE_FLOAT || type == TSDB_DATA_TYPE_DOUBLE) {
@@ -525,6 +789,8 @@ SOperatorInfo* createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode*
     goto _error;
   }
 
+  pInfo->fixedKey = isFixedGroupKey(pInfo->pGroupCols);
+
   int32_t    num = 0;
   SExprInfo* pExprInfo = createExprInfo(pAggNode->pAggFuncs, pAggNode->pGroupKeys, &num);
   code = initAggSup(&pOperator->exprSupp, &pInfo->aggSup, pExprInfo, num, pInfo->groupKeyLen, pTaskInfo->id.str,
@@ -546,7 +812,7 @@ SOperatorInfo* createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode*
   pInfo->binfo.outputTsOrder = pAggNode->node.outputTsOrder;
 
   pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, hashGroupbyAggregate, NULL, destroyGroupOperatorInfo,
-                                         optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
+                                         optrDefaultBufFn, getGroupbyExplainExecInfo, optrDefaultGetNextExtFn, NULL);
   code = appendDownstream(pOperator, &downstream, 1);
   if (code != TSDB_CODE_SUCCESS) {
     goto _error;
@@ -965,6 +1231,16 @@ SOperatorInfo* createPartitionOperatorInfo(SOperatorInfo* downstream, SPartition
     goto _error;
   }
 
+  if (tsQuerySpillWriteBehind) {
+    dBufSetPageCodec(pInfo->pBuf, PAGE_CODEC_LZ4);
+    code = dBufSetWriteBehind(pInfo->pBuf, DBUF_WRITE_BEHIND_PAGES);
+    if (code != TSDB_CODE_SUCCESS) {
+      terrno = code;
+      pTaskInfo->code = code;
+      goto _error;
+    }
+  }
+
   pInfo->rowCapacity = blockDataGetCapacityInRow(pInfo->binfo.pRes, getBufPageSize(pInfo->pBuf),
                                                  blockDataGetSerialMetaSize(taosArrayGetSize(pInfo->binfo.pRes->pDataBlock)));
   pInfo->columnOffset = setupColumnOffset(pInfo->binfo.pRes, pInfo->rowCapacity);
@@ -981,7 +1257,8 @@ SOperatorInfo* createPartitionOperatorInfo(SOperatorInfo* downstream, SPartition
   pOperator->exprSupp.pExprInfo = pExprInfo;
 
   pOperator->fpSet =
-      createOperatorFpSet(optrDummyOpenFn, hashPartition, NULL, destroyPartitionOperatorInfo, optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
+      createOperatorFpSet(optrDummyOpenFn, hashPartition, NULL, destroyPartitionOperatorInfo, optrDefaultBufFn,
+                          getPartitionExplainExecInfo, optrDefaultGetNextExtFn, NULL);
 
   code = appendDownstream(pOperator, &downstream, 1);
   if (code != TSDB_CODE_SUCCESS) {
@@ -56,7 +56,7 @@ int32_t hInnerJoinDo(struct SOperatorInfo* pOperator) {
       continue;
     }
     
-    SGroupData* pGroup = tSimpleHashGet(pJoin->pKeyHash, pProbe->keyData, bufLen);
+    SGroupData* pGroup = hJoinGetGroup(pJoin, pProbe->keyData, bufLen);
 /*
     size_t keySize = 0;
     int32_t* pKey = tSimpleHashGetKey(pGroup, &keySize);
@@ -141,7 +141,7 @@ int32_t hLeftJoinHandleSeqProbeRows(struct SOperatorInfo* pOperator, SHJoinOpera
       continue;
     }
     
-    SGroupData* pGroup = tSimpleHashGet(pJoin->pKeyHash, pProbe->keyData, bufLen);
+    SGroupData* pGroup = hJoinGetGroup(pJoin, pProbe->keyData, bufLen);
 /*
     size_t keySize = 0;
     int32_t* pKey = tSimpleHashGetKey(pGroup, &keySize);
@@ -244,7 +244,7 @@ int32_t hLeftJoinHandleProbeRows(struct SOperatorInfo* pOperator, SHJoinOperator
       continue;
     }
     
-    SGroupData* pGroup = tSimpleHashGet(pJoin->pKeyHash, pProbe->keyData, bufLen);
+    SGroupData* pGroup = hJoinGetGroup(pJoin, pProbe->keyData, bufLen);
 /*
     size_t keySize = 0;
     int32_t* pKey = tSimpleHashGetKey(pGroup, &keySize);
@@ -25,9 +25,13 @@
 #include "thash.h"
 #include "tmsg.h"
 #include "ttypes.h"
+#include "tworker.h"
 #include "hashjoin.h"
 #include "functionMgt.h"
 
+// the partitions of the build tables of all the hash joins of the process are built by this pool
+static SSingleWorker hJoinBuildWorker = {0};
+
 
 bool hJoinBlkReachThreshold(SHJoinOperatorInfo* pInfo, int64_t blkRows) {
   if (INT64_MAX == pInfo->ctx.limit || pInfo->pFinFilter != NULL) {
@@ -464,6 +468,41 @@ static void hJoinDestroyKeyHash(SSHashObj** ppHash) {
   *ppHash = NULL;
 }
 
+static int32_t hJoinInitPartitions(SHJoinOperatorInfo* pInfo) {
+  int64_t inputRows = pInfo->pBuild->inputStat.inputRowNum;
+  size_t  rowCap = inputRows > 0 ? (inputRows / HJOIN_BUILD_PARTITION_NUM + 1) : 64;
+  size_t  hashCap = inputRows > 0 ? (rowCap * 1.5) : 64;
+  for (int32_t i = 0; i < HJOIN_BUILD_PARTITION_NUM; ++i) {
+    SHJoinPartition* pPart = &pInfo->parts[i];
+    pPart->pRows = taosArrayInit(rowCap, sizeof(SHJoinBuildRow));
+    pPart->pKeys = taosArrayInit(rowCap * sizeof(int64_t), 1);
+    pPart->pKeyHash = tSimpleHashInit(hashCap, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
+    if (NULL == pPart->pRows || NULL == pPart->pKeys || NULL == pPart->pKeyHash) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static void hJoinDestroyPartitions(SHJoinOperatorInfo* pJoin) {
+  for (int32_t i = 0; i < HJOIN_BUILD_PARTITION_NUM; ++i) {
+    SHJoinPartition* pPart = &pJoin->parts[i];
+    int32_t          rowNum = taosArrayGetSize(pPart->pRows);
+    for (int32_t m = 0; m < rowNum; ++m) {
+      taosMemoryFree(((SHJoinBuildRow*)taosArrayGet(pPart->pRows, m))->pRow);
+    }
+    taosArrayDestroy(pPart->pRows);
+    pPart->pRows = NULL;
+    taosArrayDestroy(pPart->pKeys);
+    pPart->pKeys = NULL;
+
+    hJoinDestroyKeyHash(&pPart->pKeyHash);
+  }
+
+  pJoin->keyNum = 0;
+}
+
 static FORCE_INLINE char* hJoinRetrieveColDataFromRowBufs(SArray* pRowBufs, SBufRowInfo* pRow) {
   if ((uint16_t)-1 == pRow->pageId) {
     return NULL;
@@ -756,56 +795,32 @@ static FORCE_INLINE int32_t hJoinGetValBufSize(SHJoinTableCtx* pTable, int32_t r
 }
 
 
-static int32_t hJoinAddRowToHashImpl(SHJoinOperatorInfo* pJoin, SGroupData* pGroup, SHJoinTableCtx* pTable, size_t keyLen, int32_t rowIdx) {
-  SGroupData group = {0};
-  SBufRowInfo* pRow = NULL;
-
-  if (NULL == pGroup) {
-    group.rows = taosMemoryMalloc(sizeof(SBufRowInfo));
-    if (NULL == group.rows) {
-      return TSDB_CODE_OUT_OF_MEMORY;
-    }
-    pRow = group.rows;
-  } else {
-    pRow = taosMemoryMalloc(sizeof(SBufRowInfo));
-    if (NULL == pRow) {
-      return TSDB_CODE_OUT_OF_MEMORY;
-    }
-  }
-
-  int32_t code = hJoinGetValBufFromPages(pJoin->pRowBufs, hJoinGetValBufSize(pTable, rowIdx), &pTable->valData, pRow);
+// Copy the values of the row into the row bufs and stage the row in the partition of its key.
+static int32_t hJoinAddRowToPartition(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock, size_t keyLen, int32_t rowIdx) {
+  SHJoinTableCtx* pBuild = pJoin->pBuild;
+  int32_t code = hJoinSetValColsData(pBlock, pBuild);
   if (code) {
-    taosMemoryFree(pRow);
     return code;
   }
 
-  if (NULL == pGroup) {
-    pRow->next = NULL;
-    if (tSimpleHashPut(pJoin->pKeyHash, pTable->keyData, keyLen, &group, sizeof(group))) {
-      taosMemoryFree(pRow);
-      return TSDB_CODE_OUT_OF_MEMORY;
-    }
-  } else {
-    pRow->next = pGroup->rows;
-    pGroup->rows = pRow;
+  SBufRowInfo* pRow = taosMemoryMalloc(sizeof(SBufRowInfo));
+  if (NULL == pRow) {
+    return TSDB_CODE_OUT_OF_MEMORY;
   }
 
-  return TSDB_CODE_SUCCESS;
-}
-
-static int32_t hJoinAddRowToHash(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock, size_t keyLen, int32_t rowIdx) {
-  SHJoinTableCtx* pBuild = pJoin->pBuild;
-  int32_t code = hJoinSetValColsData(pBlock, pBuild);
+  code = hJoinGetValBufFromPages(pJoin->pRowBufs, hJoinGetValBufSize(pBuild, rowIdx), &pBuild->valData, pRow);
   if (code) {
+    taosMemoryFree(pRow);
     return code;
   }
 
-  SGroupData* pGroup = tSimpleHashGet(pJoin->pKeyHash, pBuild->keyData, keyLen);
-  code = hJoinAddRowToHashImpl(pJoin, pGroup, pBuild, keyLen, rowIdx);
-  if (code) {
-    return code;
+  SHJoinPartition* pPart = &pJoin->parts[HJOIN_PARTITION_IDX(MurmurHash3_32(pBuild->keyData, keyLen))];
+  SHJoinBuildRow   row = {.pRow = pRow, .keyOffset = taosArrayGetSize(pPart->pKeys), .keyLen = keyLen};
+  if (NULL == taosArrayAddBatch(pPart->pKeys, pBuild->keyData, keyLen) || NULL == taosArrayPush(pPart->pRows, &row)) {
+    taosMemoryFree(pRow);
+    return TSDB_CODE_OUT_OF_MEMORY;
   }
-  
+
   hJoinCopyValColsDataToBuf(pBuild, rowIdx);
 
   return TSDB_CODE_SUCCESS;
@@ -872,7 +887,7 @@ static int32_t hJoinAddBlockRowsToHash(SSDataBlock* pBlock, SHJoinOperatorInfo*
     if (hJoinCopyKeyColsDataToBuf(pBuild, i, &bufLen)) {
       continue;
     }
-    code = hJoinAddRowToHash(pJoin, pBlock, bufLen, i);
+    code = hJoinAddRowToPartition(pJoin, pBlock, bufLen, i);
     if (code) {
       return code;
     }
@@ -881,6 +896,110 @@ static int32_t hJoinAddBlockRowsToHash(SSDataBlock* pBlock, SHJoinOperatorInfo*
   return code;
 }
 
+// Add the staged rows of the partition into its hash table in order, the rows of the same key are linked in the reverse
+// order as before. The staged rows are released either way.
+static int32_t hJoinBuildPartitionHash(SHJoinPartition* pPart) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  int32_t rowNum = taosArrayGetSize(pPart->pRows);
+  for (int32_t i = 0; i < rowNum; ++i) {
+    SHJoinBuildRow* pBuildRow = taosArrayGet(pPart->pRows, i);
+    SBufRowInfo*    pRow = pBuildRow->pRow;
+    if (code) {
+      taosMemoryFree(pRow);
+      continue;
+    }
+
+    char*       pKey = (char*)pPart->pKeys->pData + pBuildRow->keyOffset;
+    SGroupData* pGroup = tSimpleHashGet(pPart->pKeyHash, pKey, pBuildRow->keyLen);
+    if (NULL == pGroup) {
+      SGroupData group = {.rows = pRow};
+      pRow->next = NULL;
+      if (tSimpleHashPut(pPart->pKeyHash, pKey, pBuildRow->keyLen, &group, sizeof(group))) {
+        taosMemoryFree(pRow);
+        code = TSDB_CODE_OUT_OF_MEMORY;
+      }
+    } else {
+      pRow->next = pGroup->rows;
+      pGroup->rows = pRow;
+    }
+  }
+
+  taosArrayDestroy(pPart->pRows);
+  pPart->pRows = NULL;
+  taosArrayDestroy(pPart->pKeys);
+  pPart->pKeys = NULL;
+
+  return code;
+}
+
+static void hJoinBuildWorkerFp(SQueueInfo* pInfo, void* pItem) {
+  SHJoinPartition* pPart = *(SHJoinPartition**)pItem;
+  taosFreeQitem(pItem);
+
+  pPart->code = hJoinBuildPartitionHash(pPart);
+  (void)tsem_post(&pPart->done);
+}
+
+int32_t hJoinInitBuildWorker() {
+  int32_t          numOfThreads = TMAX((int32_t)tsNumOfCores / 2, 1);
+  SSingleWorkerCfg cfg = {.min = numOfThreads, .max = numOfThreads, .name = "hjoin-build", .fp = hJoinBuildWorkerFp};
+  if (tSingleWorkerInit(&hJoinBuildWorker, &cfg) != 0) {
+    qError("failed to init hash join build worker since %s, hash tables are built in query threads", terrstr());
+    hJoinBuildWorker.queue = NULL;
+    return terrno;
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+void hJoinCleanupBuildWorker() {
+  tSingleWorkerCleanup(&hJoinBuildWorker);
+  memset(&hJoinBuildWorker, 0, sizeof(SSingleWorker));  // so that it can be started again
+}
+
+// Build the hash tables of the partitions in the build worker once the build table is large enough, the partitions
+// that can not be queued are built in the query thread. All the queued partitions are waited for before return.
+static int32_t hJoinBuildPartitions(SHJoinOperatorInfo* pJoin) {
+  bool parallel = (hJoinBuildWorker.queue != NULL && pJoin->execInfo.buildBlkRows >= HJOIN_PARALLEL_BUILD_ROWS);
+  for (int32_t i = 0; i < HJOIN_BUILD_PARTITION_NUM; ++i) {
+    SHJoinPartition*  pPart = &pJoin->parts[i];
+    SHJoinPartition** pItem = NULL;
+    if (parallel && taosArrayGetSize(pPart->pRows) > 0) {
+      pItem = taosAllocateQitem(sizeof(SHJoinPartition*), DEF_QITEM, 0);
+    }
+    if (pItem != NULL) {
+      *pItem = pPart;
+      pPart->queued = true;
+      (void)tsem_init(&pPart->done, 0, 0);
+      if (taosWriteQitem(hJoinBuildWorker.queue, pItem) != 0) {
+        taosFreeQitem(pItem);
+        (void)tsem_destroy(&pPart->done);
+        pPart->queued = false;
+      }
+    }
+
+    if (!pPart->queued) {
+      pPart->code = hJoinBuildPartitionHash(pPart);
+    }
+  }
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  for (int32_t i = 0; i < HJOIN_BUILD_PARTITION_NUM; ++i) {
+    SHJoinPartition* pPart = &pJoin->parts[i];
+    if (pPart->queued) {
+      (void)tsem_wait(&pPart->done);
+      (void)tsem_destroy(&pPart->done);
+      pPart->queued = false;
+    }
+
+    if (code == TSDB_CODE_SUCCESS) {
+      code = pPart->code;
+    }
+    pJoin->keyNum += tSimpleHashGetSize(pPart->pKeyHash);
+  }
+
+  return code;
+}
+
 static int32_t hJoinBuildHash(struct SOperatorInfo* pOperator, bool* queryDone) {
   SHJoinOperatorInfo* pJoin = pOperator->info;
   SSDataBlock* pBlock = NULL;
@@ -901,16 +1020,82 @@ static int32_t hJoinBuildHash(struct SOperatorInfo* pOperator, bool* queryDone)
     }
   }
 
-  if (IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType) && tSimpleHashGetSize(pJoin->pKeyHash) <= 0) {
+  code = hJoinBuildPartitions(pJoin);
+  if (code) {
+    return code;
+  }
+
+  if (IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType) && pJoin->keyNum <= 0) {
     hJoinSetDone(pOperator);
     *queryDone = true;
   }
-  
-  //qTrace("build table rows:%" PRId64, hJoinGetRowsNumOfKeyHash(pJoin->pKeyHash));
 
   return TSDB_CODE_SUCCESS;
 }
 
+// Build a bloom filter of the keys in the hash table and push it down to the table scan of the probe side, so that the
+// probe rows that never match are dropped by the scan. Only inner join is supported, since the probe rows without any
+// match are also returned by the outer join.
+static void hJoinPushDownRuntimeFilter(struct SOperatorInfo* pOperator) {
+  SHJoinOperatorInfo* pJoin = pOperator->info;
+  SHJoinTableCtx*     pBuild = pJoin->pBuild;
+  SHJoinTableCtx*     pProbe = pJoin->pProbe;
+
+  if (!IS_INNER_NONE_JOIN(pJoin->joinType, pJoin->subType) || NULL != pProbe->primExpr || pJoin->keyNum <= 0) {
+    return;
+  }
+
+  SOperatorInfo* pDownstream = pOperator->pDownstream[pProbe->downStreamIdx];
+  if (QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN != pDownstream->operatorType || pBuild->keyNum != pProbe->keyNum) {
+    return;
+  }
+
+  int64_t bufSize = 0;
+  for (int32_t i = 0; i < pProbe->keyNum; ++i) {
+    if (pBuild->keyCols[i].vardata != pProbe->keyCols[i].vardata ||
+        (!pProbe->keyCols[i].vardata && pBuild->keyCols[i].bytes != pProbe->keyCols[i].bytes)) {
+      return;
+    }
+    bufSize += pProbe->keyCols[i].bytes;
+  }
+
+  SJoinRuntimeFilter* pFilter = taosMemoryCalloc(1, sizeof(SJoinRuntimeFilter));
+  if (NULL == pFilter) {
+    return;
+  }
+
+  pFilter->keyNum = pProbe->keyNum;
+  pFilter->keySlots = taosMemoryMalloc(pProbe->keyNum * sizeof(int32_t));
+  pFilter->keyBuf = taosMemoryMalloc(bufSize);
+  pFilter->pBloom = tBloomFilterInit(pJoin->keyNum, HJOIN_RUNTIME_FILTER_ERROR_RATE);
+  if (NULL == pFilter->keySlots || NULL == pFilter->keyBuf || NULL == pFilter->pBloom) {
+    destroyJoinRuntimeFilter(pFilter);
+    return;
+  }
+
+  for (int32_t i = 0; i < pProbe->keyNum; ++i) {
+    pFilter->keySlots[i] = pProbe->keyCols[i].srcSlot;
+  }
+
+  for (int32_t i = 0; i < HJOIN_BUILD_PARTITION_NUM; ++i) {
+    void*   pIte = NULL;
+    int32_t iter = 0;
+    while ((pIte = tSimpleHashIterate(pJoin->parts[i].pKeyHash, pIte, &iter)) != NULL) {
+      size_t keyLen = 0;
+      void*  pKey = tSimpleHashGetKey(pIte, &keyLen);
+      (void)tBloomFilterPut(pFilter->pBloom, pKey, keyLen);
+    }
+  }
+
+  if (TSDB_CODE_SUCCESS != setTableScanRuntimeFilter(pDownstream, pFilter)) {
+    destroyJoinRuntimeFilter(pFilter);
+    return;
+  }
+
+  qDebug("%s hash join runtime filter of %" PRId64 " keys pushed down to the probe scan",
+         GET_TASKID(pOperator->pTaskInfo), pJoin->keyNum);
+}
+
 static int32_t hJoinPrepareStart(struct SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   SHJoinOperatorInfo* pJoin = pOperator->info;
   SHJoinTableCtx* pProbe = pJoin->pProbe;
@@ -963,7 +1148,7 @@ void hJoinSetDone(struct SOperatorInfo* pOperator) {
   setOperatorCompleted(pOperator);
 
   SHJoinOperatorInfo* pInfo = pOperator->info;
-  hJoinDestroyKeyHash(&pInfo->pKeyHash);
+  hJoinDestroyPartitions(pInfo);
 
   qDebug("hash Join done");  
 }
@@ -997,6 +1182,8 @@ static SSDataBlock* hJoinMainProcess(struct SOperatorInfo* pOperator) {
     if (queryDone) {
       goto _return;
     }
+
+    hJoinPushDownRuntimeFilter(pOperator);
   }
 
   blockDataCleanup(pRes);
@@ -1061,7 +1248,7 @@ static void destroyHashJoinOperator(void* param) {
          pJoinOperator->execInfo.buildBlkNum, pJoinOperator->execInfo.buildBlkRows, pJoinOperator->execInfo.probeBlkNum, 
          pJoinOperator->execInfo.probeBlkRows, pJoinOperator->execInfo.resRows);
 
-  hJoinDestroyKeyHash(&pJoinOperator->pKeyHash);
+  hJoinDestroyPartitions(pJoinOperator);
 
   hJoinFreeTableInfo(&pJoinOperator->tbs[0]);
   hJoinFreeTableInfo(&pJoinOperator->tbs[1]);
@@ -1160,12 +1347,7 @@ SOperatorInfo* createHashJoinOperatorInfo(SOperatorInfo** pDownstream, int32_t n
 
   HJ_ERR_JRET(hJoinInitBufPages(pInfo));
 
-  size_t hashCap = pInfo->pBuild->inputStat.inputRowNum > 0 ? (pInfo->pBuild->inputStat.inputRowNum * 1.5) : 1024;
-  pInfo->pKeyHash = tSimpleHashInit(hashCap, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
-  if (pInfo->pKeyHash == NULL) {
-    code = TSDB_CODE_OUT_OF_MEMORY;
-    goto _return;
-  }
+  HJ_ERR_JRET(hJoinInitPartitions(pInfo));
 
   HJ_ERR_JRET(hJoinHandleConds(pInfo, pJoinNode));
 
@@ -292,6 +292,147 @@ bool applyLimitOffset(SLimitInfo* pLimitInfo, SSDataBlock* pBlock, SExecTaskInfo
   return false;
 }
 
+void destroyJoinRuntimeFilter(SJoinRuntimeFilter* pFilter) {
+  if (pFilter == NULL) {
+    return;
+  }
+
+  tBloomFilterDestroy(pFilter->pBloom);
+  taosMemoryFree(pFilter->keySlots);
+  taosMemoryFree(pFilter->keyBuf);
+  taosMemoryFree(pFilter->pQualified);
+  taosMemoryFree(pFilter);
+}
+
+int32_t setTableScanRuntimeFilter(SOperatorInfo* pOperator, SJoinRuntimeFilter* pFilter) {
+  if (pOperator->operatorType != QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN) {
+    return TSDB_CODE_OPS_NOT_SUPPORT;
+  }
+
+  // rows can not be dropped before limit/offset are applied in the scan
+  STableScanInfo* pInfo = pOperator->info;
+  SLimitInfo*     pLimitInfo = &pInfo->base.limitInfo;
+  if (pLimitInfo->limit.limit >= 0 || pLimitInfo->limit.offset > 0 || pLimitInfo->slimit.limit >= 0 ||
+      pLimitInfo->slimit.offset > 0) {
+    return TSDB_CODE_OPS_NOT_SUPPORT;
+  }
+
+  for (int32_t i = 0; i < pFilter->keyNum; ++i) {
+    if (pFilter->keySlots[i] >= taosArrayGetSize(pInfo->pResBlock->pDataBlock)) {
+      return TSDB_CODE_OPS_NOT_SUPPORT;
+    }
+  }
+
+  destroyJoinRuntimeFilter(pInfo->base.pRuntimeFilter);
+  pInfo->base.pRuntimeFilter = pFilter;
+  return TSDB_CODE_SUCCESS;
+}
+
+// Drop the rows of which the join keys are definitely not in the build side of the join. The rows with null keys are
+// dropped as well, since they never match.
+int32_t doApplyJoinRuntimeFilter(STableScanBase* pTableScanInfo, SSDataBlock* pBlock) {
+  SJoinRuntimeFilter* pFilter = pTableScanInfo->pRuntimeFilter;
+  SBloomFilter*       pBloom = pFilter->pBloom;
+  int32_t             rows = pBlock->info.rows;
+  if (rows == 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (rows > pFilter->capacity) {
+    bool* p = taosMemoryRealloc(pFilter->pQualified, rows * sizeof(bool));
+    if (p == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    pFilter->pQualified = p;
+    pFilter->capacity = rows;
+  }
+
+  int32_t numOfQualified = 0;
+  for (int32_t i = 0; i < rows; ++i) {
+    char*   pKey = pFilter->keyBuf;
+    int32_t len = 0;
+    bool    isNull = false;
+
+    for (int32_t k = 0; k < pFilter->keyNum; ++k) {
+      SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, pFilter->keySlots[k]);
+      if (colDataIsNull_s(pCol, i)) {
+        isNull = true;
+        break;
+      }
+
+      char*   pData = colDataGetData(pCol, i);
+      int32_t bytes = IS_VAR_DATA_TYPE(pCol->info.type) ? varDataTLen(pData) : pCol->info.bytes;
+      if (pFilter->keyNum == 1) {
+        pKey = pData;
+        len = bytes;
+      } else {
+        memcpy(pFilter->keyBuf + len, pData, bytes);
+        len += bytes;
+      }
+    }
+
+    pFilter->pQualified[i] =
+        !isNull && tBloomFilterNoContain(pBloom, pBloom->hashFn1(pKey, len), pBloom->hashFn2(pKey, len)) !=
+                       TSDB_CODE_SUCCESS;
+    numOfQualified += pFilter->pQualified[i];
+  }
+
+  if (numOfQualified == rows) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pTableScanInfo->readRecorder.runtimeFilterRows += rows - numOfQualified;
+  if (numOfQualified == 0) {
+    trimDataBlock(pBlock, rows, NULL);
+    pBlock->info.rows = 0;
+  } else {
+    trimDataBlock(pBlock, rows, pFilter->pQualified);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// Retrieve the columns referenced by the filter only and evaluate the filter on them, so that the other columns of the
+// data block are read and decoded only if any rows are qualified. The data block is released if no rows are qualified.
+static int32_t doLoadFilterColumns(SOperatorInfo* pOperator, STableScanBase* pTableScanInfo, SSDataBlock* pBlock,
+                                   SColumnInfoData** pFilterRes, int32_t* filterStatus) {
+  SExecTaskInfo*          pTaskInfo = pOperator->pTaskInfo;
+  SStorageAPI*            pAPI = &pTaskInfo->storageAPI;
+  SFileBlockLoadRecorder* pCost = &pTableScanInfo->readRecorder;
+
+  SSDataBlock* p = pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, pTableScanInfo->pFilterColIds);
+  if (p == NULL) {
+    return terrno;
+  }
+
+  ASSERT(p == pBlock);
+  doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, pBlock->info.rows);
+
+  *filterStatus = FILTER_RESULT_ALL_QUALIFIED;
+  if (pBlock->info.rows > 0) {
+    int64_t st = taosGetTimestampUs();
+    int32_t code = doFilterExecute(pBlock, pOperator->exprSupp.pFilterInfo, pFilterRes, filterStatus);
+    pCost->filterTime += (taosGetTimestampUs() - st) / 1000.0;
+    if (code != TSDB_CODE_SUCCESS) {
+      pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+      return code;
+    }
+  }
+
+  if (*filterStatus == FILTER_RESULT_NONE_QUALIFIED) {
+    qDebug("%s data block filter out by filter columns, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64,
+           GET_TASKID(pTaskInfo), pBlock->info.window.skey, pBlock->info.window.ekey, pBlock->info.rows);
+    pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+
+    pCost->filterOutBlocks += 1;
+    pCost->totalRows -= pBlock->info.rows;
+    trimDataBlock(pBlock, pBlock->info.rows, NULL);
+    pBlock->info.rows = 0;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableScanInfo, SSDataBlock* pBlock,
                              uint32_t* status) {
   SExecTaskInfo* pTaskInfo = pOperator->pTaskInfo;
@@ -304,7 +445,7 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
 
   bool loadSMA = false;
   *status = pTableScanInfo->dataBlockLoadFlag;
-  if (pOperator->exprSupp.pFilterInfo != NULL ||
+  if (pOperator->exprSupp.pFilterInfo != NULL || pTableScanInfo->pRuntimeFilter != NULL ||
       overlapWithTimeWindow(&pTableScanInfo->pdInfo.interval, &pBlock->info, pTableScanInfo->cond.order)) {
     (*status) = FUNC_DATA_REQUIRED_DATA_LOAD;
   }
@@ -387,19 +528,43 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   pCost->totalCheckedRows += pBlock->info.rows;
   pCost->loadBlocks += 1;
 
+  SColumnInfoData* pFilterRes = NULL;
+  int32_t          filterStatus = 0;
+  if (pTableScanInfo->pFilterColIds != NULL) {
+    int32_t code = doLoadFilterColumns(pOperator, pTableScanInfo, pBlock, &pFilterRes, &filterStatus);
+    if (code != TSDB_CODE_SUCCESS || filterStatus == FILTER_RESULT_NONE_QUALIFIED) {
+      colDataDestroy(pFilterRes);
+      taosMemoryFree(pFilterRes);
+      return code;
+    }
+  }
+
   SSDataBlock* p = pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, NULL);
   if (p == NULL) {
+    colDataDestroy(pFilterRes);
+    taosMemoryFree(pFilterRes);
     return terrno;
   }
 
   ASSERT(p == pBlock);
-  doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, pBlock->info.rows);
+  if (pTableScanInfo->pFilterColIds == NULL) {
+    doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, pBlock->info.rows);
+  }
 
   // restore the previous value
   pCost->totalRows -= pBlock->info.rows;
 
   if (pOperator->exprSupp.pFilterInfo != NULL) {
-    int32_t code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pTableScanInfo->matchInfo);
+    int32_t code = TSDB_CODE_SUCCESS;
+    if (pTableScanInfo->pFilterColIds != NULL) {
+      if (pBlock->info.rows > 0) {
+        applyFilterResult(pBlock, pFilterRes, filterStatus, &pTableScanInfo->matchInfo);
+      }
+      colDataDestroy(pFilterRes);
+      taosMemoryFree(pFilterRes);
+    } else {
+      code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pTableScanInfo->matchInfo);
+    }
     if (code != TSDB_CODE_SUCCESS) return code;
 
     int64_t st = taosGetTimestampUs();
@@ -415,6 +580,17 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
     }
   }
 
+  if (pTableScanInfo->pRuntimeFilter != NULL && pBlock->info.rows > 0) {
+    int32_t code = doApplyJoinRuntimeFilter(pTableScanInfo, pBlock);
+    if (code != TSDB_CODE_SUCCESS) return code;
+
+    if (pBlock->info.rows == 0) {
+      pCost->filterOutBlocks += 1;
+      qDebug("%s data block filter out by join runtime filter, brange:%" PRId64 "-%" PRId64, GET_TASKID(pTaskInfo),
+             pBlockInfo->window.skey, pBlockInfo->window.ekey);
+    }
+  }
+
   bool limitReached = applyLimitOffset(&pTableScanInfo->limitInfo, pBlock, pTaskInfo);
   if (limitReached) {  // set operator flag is done
     setOperatorCompleted(pOperator);
@@ -1144,9 +1320,75 @@ static void destroyTableScanBase(STableScanBase* pBase, TsdReader* pAPI) {
 
   tableListDestroy(pBase->pTableListInfo);
   taosLRUCacheCleanup(pBase->metaCache.pTableMetaEntryCache);
+  destroyJoinRuntimeFilter(pBase->pRuntimeFilter);
+  pBase->pRuntimeFilter = NULL;
+  taosArrayDestroy(pBase->pFilterColIds);
+  pBase->pFilterColIds = NULL;
   cleanupExprSupp(&pBase->pseudoSup);
 }
 
+// The data columns referenced by the filter are loaded before the others, if there are other data columns to scan.
+static int32_t initFilterColIdList(STableScanBase* pBase, SNode* pConditions) {
+  if (pConditions == NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SNodeList* pCols = NULL;
+  int32_t    code = nodesCollectColumnsFromNode(pConditions, NULL, COLLECT_COL_TYPE_COL, &pCols);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  SArray* pList = taosArrayInit(LIST_LENGTH(pCols), sizeof(col_id_t));
+  if (pList == NULL) {
+    nodesDestroyList(pCols);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t numOfCols = taosArrayGetSize(pBase->matchInfo.pList);
+  int32_t numOfDataCols = 0;
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColMatchItem* pItem = taosArrayGet(pBase->matchInfo.pList, i);
+    numOfDataCols += (pItem->colId != PRIMARYKEY_TIMESTAMP_COL_ID) ? 1 : 0;
+  }
+
+  SNode* pNode = NULL;
+  FOREACH(pNode, pCols) {
+    SColumnNode*   pCol = (SColumnNode*)pNode;
+    SColMatchItem* pItem = NULL;
+    for (int32_t i = 0; i < numOfCols; ++i) {
+      SColMatchItem* p = taosArrayGet(pBase->matchInfo.pList, i);
+      if (p->dstSlotId == pCol->slotId) {
+        pItem = p;
+        break;
+      }
+    }
+
+    if (pItem == NULL) {  // not a column loaded by the scan, give up loading the filter columns first
+      taosArrayClear(pList);
+      numOfDataCols = 0;
+      break;
+    }
+
+    col_id_t colId = pItem->colId;
+    if (colId != PRIMARYKEY_TIMESTAMP_COL_ID) {
+      taosArrayPush(pList, &colId);
+    }
+  }
+
+  nodesDestroyList(pCols);
+  taosArraySort(pList, compareInt16Val);
+  taosArrayRemoveDuplicate(pList, compareInt16Val, NULL);
+
+  if (taosArrayGetSize(pList) < numOfDataCols) {
+    pBase->pFilterColIds = pList;
+  } else {
+    taosArrayDestroy(pList);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 static void destroyTableScanOperatorInfo(void* param) {
   STableScanInfo* pTableScanInfo = (STableScanInfo*)param;
   blockDataDestroy(pTableScanInfo->pResBlock);
@@ -1206,6 +1448,11 @@ SOperatorInfo* createTableScanOperatorInfo(STableScanPhysiNode* pTableScanNode,
   if (code != TSDB_CODE_SUCCESS) {
     goto _error;
   }
+
+  code = initFilterColIdList(&pInfo->base, pTableScanNode->scan.node.pConditions);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _error;
+  }
   
   pInfo->currentGroupId = -1;
 
@@ -1220,7 +1467,7 @@ SOperatorInfo* createTableScanOperatorInfo(STableScanPhysiNode* pTableScanNode,
   pInfo->needCountEmptyTable = tsCountAlwaysReturnValue && pTableScanNode->needCountEmptyTable;
 
   pInfo->base.pTableListInfo = pTableListInfo;
-  pInfo->base.metaCache.pTableMetaEntryCache = taosLRUCacheInit(1024 * 128, -1, .5);
+  pInfo->base.metaCache.pTableMetaEntryCache = taosLRUCacheInit(1024 * 128, -1, .5, TAOS_LRU_POLICY_LRU);
   if (pInfo->base.metaCache.pTableMetaEntryCache == NULL) {
     code = terrno;
     goto _error;
@@ -4372,6 +4619,7 @@ void stopDurationForGroupTableMergeScan(SOperatorInfo* pOperator) {
   pInfo->sortExecInfo.loops += sortExecInfo.loops;
   pInfo->sortExecInfo.readBytes += sortExecInfo.readBytes;
   pInfo->sortExecInfo.writeBytes += sortExecInfo.writeBytes;
+  pInfo->sortExecInfo.stallTime += sortExecInfo.stallTime;
 
   tsortDestroySortHandle(pInfo->pSortHandle);
   pInfo->pSortHandle = NULL;
@@ -4633,7 +4881,7 @@ SOperatorInfo* createTableMergeScanOperatorInfo(STableScanPhysiNode* pTableScanN
 
   pInfo->scanInfo = (SScanInfo){.numOfAsc = pTableScanNode->scanSeq[0], .numOfDesc = pTableScanNode->scanSeq[1]};
 
-  pInfo->base.metaCache.pTableMetaEntryCache = taosLRUCacheInit(1024 * 128, -1, .5);
+  pInfo->base.metaCache.pTableMetaEntryCache = taosLRUCacheInit(1024 * 128, -1, .5, TAOS_LRU_POLICY_LRU);
   if (pInfo->base.metaCache.pTableMetaEntryCache == NULL) {
     code = terrno;
     goto _error;
@@ -4658,6 +4906,11 @@ SOperatorInfo* createTableMergeScanOperatorInfo(STableScanPhysiNode* pTableScanN
     goto _error;
   }
 
+  code = initFilterColIdList(&pInfo->base, pTableScanNode->scan.node.pConditions);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _error;
+  }
+
   initLimitInfo(pTableScanNode->scan.node.pLimit, pTableScanNode->scan.node.pSlimit, &pInfo->limitInfo);
 
   pInfo->mergeLimit = -1;
@@ -299,6 +299,7 @@ int32_t doOpenSortOperator(SOperatorInfo* pOperator) {
                                              pInfo->maxRows, pInfo->maxTupleLength, tsPQSortMemThreshold * 1024 * 1024);
 
   tsortSetFetchRawDataFp(pInfo->pSortHandle, loadNextDataBlock, applyScalarFunction, pOperator);
+  tsortSetSortThreads(pInfo->pSortHandle, tsQuerySortThreads);
 
   SSortSource* ps = taosMemoryCalloc(1, sizeof(SSortSource));
   ps->param = pOperator->pDownstream[0];
@@ -511,6 +512,7 @@ int32_t beginSortGroup(SOperatorInfo* pOperator) {
       tsortCreateSortHandle(pInfo->pSortInfo, SORT_SINGLESOURCE_SORT, -1, -1, NULL, pTaskInfo->id.str, 0, 0, 0);
 
   tsortSetFetchRawDataFp(pInfo->pCurrSortHandle, fetchNextGroupSortDataBlock, applyScalarFunction, pOperator);
+  tsortSetSortThreads(pInfo->pCurrSortHandle, tsQuerySortThreads);
 
   SSortSource*           ps = taosMemoryCalloc(1, sizeof(SSortSource));
   SGroupSortSourceParam* param = taosMemoryCalloc(1, sizeof(SGroupSortSourceParam));
@@ -539,6 +541,8 @@ int32_t finishSortGroup(SOperatorInfo* pOperator) {
   pInfo->sortExecInfo.loops += sortExecInfo.loops;
   pInfo->sortExecInfo.readBytes += sortExecInfo.readBytes;
   pInfo->sortExecInfo.writeBytes += sortExecInfo.writeBytes;
+  pInfo->sortExecInfo.stallTime += sortExecInfo.stallTime;
+  pInfo->sortExecInfo.sortThreads = TMAX(pInfo->sortExecInfo.sortThreads, sortExecInfo.sortThreads);
 
   tsortDestroySortHandle(pInfo->pCurrSortHandle);
   pInfo->pCurrSortHandle = NULL;
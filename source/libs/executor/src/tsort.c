@@ -25,6 +25,7 @@
 #include "tsort.h"
 #include "tutil.h"
 #include "tsimplehash.h"
+#include "tworker.h"
 #include "executil.h"
 
 struct STupleHandle {
@@ -112,8 +113,24 @@ struct SSortHandle {
   bool            bSortPk;
   void (*mergeLimitReachedFn)(uint64_t tableUid, void* param);
   void* mergeLimitReachedParam;
+
+  int32_t numOfSortThreads;  // max blocks of rows sorted or buffered at the same time, 1 to sort them in the query thread
+  int32_t numOfBgSortRuns;
 };
 
+typedef struct SSortRun {
+  SSDataBlock* pBlock;
+  SArray*      pOrderInfo;  // own copy, since the columns are cached in it by blockDataSort
+  uint64_t     pqMaxRows;
+  int64_t      elapsed;
+  int32_t      code;
+  bool         queued;
+  tsem_t       done;
+} SSortRun;
+
+// the runs of all the sort handles of the process are sorted by this pool, so that the threads are bounded
+static SSingleWorker sortRunWorker = {0};
+
 static int32_t destroySortMemFile(SSortHandle* pHandle);
 static int32_t getRowBufFromExtMemFile(SSortHandle* pHandle, int32_t regionId, int32_t tupleOffset, int32_t rowLen,
                                        char** ppRow, bool* pFreeRow);
@@ -326,6 +343,7 @@ void tsortClearOrderdSource(SArray* pOrderedSource, int64_t *fetchUs, int64_t *f
       (*pSource)->src.pBlock = NULL;
     }
 
+    taosMemoryFreeClear((*pSource)->pSortKeys);
     taosMemoryFreeClear(*pSource);
   }
 
@@ -389,6 +407,27 @@ static int32_t doAddNewExternalMemSource(SDiskbasedBuf* pBuf, SArray* pAllSource
   return blockDataEnsureCapacity(pSource->src.pBlock, numOfRows);
 }
 
+// Spilled pages are compressed and flushed in background if enabled, so the sort is not blocked by the disk writes.
+static void setSortSpillBuf(SSortHandle* pHandle) {
+  if (!tsQuerySpillWriteBehind) {
+    return;
+  }
+
+  dBufSetPageCodec(pHandle->pBuf, PAGE_CODEC_LZ4);
+  int32_t code = dBufSetWriteBehind(pHandle->pBuf, DBUF_WRITE_BEHIND_PAGES);
+  if (code != TSDB_CODE_SUCCESS) {
+    qWarn("failed to enable write-behind of sort buf since %s, %s", tstrerror(code), pHandle->idStr);
+  }
+}
+
+// The pages of a source are scanned in order during the external merge, so start loading the next one in background.
+static void prefetchSourceNextPage(SSortHandle* pHandle, SSortSource* pSource) {
+  if (pSource->pageIndex + 1 < taosArrayGetSize(pSource->pageIdList)) {
+    int32_t* pNextPgId = taosArrayGet(pSource->pageIdList, pSource->pageIndex + 1);
+    dBufPrefetchPage(pHandle->pBuf, *pNextPgId);
+  }
+}
+
 static int32_t doAddToBuf(SSDataBlock* pDataBlock, SSortHandle* pHandle) {
   int32_t start = 0;
 
@@ -405,6 +444,7 @@ static int32_t doAddToBuf(SSDataBlock* pDataBlock, SSortHandle* pHandle) {
     if (code != TSDB_CODE_SUCCESS) {
       return code;
     }
+    setSortSpillBuf(pHandle);
   }
 
   SArray* pPageIdList = taosArrayInit(4, sizeof(int32_t));
@@ -450,6 +490,36 @@ static void setCurrentSourceDone(SSortSource* pSource, SSortHandle* pHandle) {
   ++pHandle->numOfCompletedSources;
 }
 
+// Build the prefix of the first sort key for the rows of the block just loaded into the source, so that most of the
+// comparisons in the merge tree are done by one integer comparison. It is an optimization only, so the rows are compared
+// by the sort keys if the prefix can not be built.
+static void buildSourceSortKeys(SSortHandle* pHandle, SSortSource* pSource) {
+  pSource->sortKeyValid = false;
+
+  SSDataBlock* pBlock = pSource->src.pBlock;
+  if (pBlock == NULL || pBlock->info.rows == 0 || pBlock->pBlockAgg != NULL) {
+    return;
+  }
+
+  SMsortComparParam* pParam = &pHandle->cmpParam;
+  if (pHandle->comparFn != msortComparFn || pParam->sortType == SORT_BLOCK_TS_MERGE ||
+      taosArrayGetSize(pParam->orderInfo) == 0) {
+    return;
+  }
+
+  if (pSource->sortKeyCap < pBlock->info.rows) {
+    uint64_t* p = taosMemoryRealloc(pSource->pSortKeys, pBlock->info.rows * sizeof(uint64_t));
+    if (p == NULL) {
+      return;
+    }
+    pSource->pSortKeys = p;
+    pSource->sortKeyCap = pBlock->info.rows;
+  }
+
+  pSource->sortKeyValid =
+      blockDataBuildSortKeyPrefix(pBlock, taosArrayGet(pParam->orderInfo, 0), pSource->pSortKeys);
+}
+
 static int32_t sortComparInit(SMsortComparParam* pParam, SArray* pSources, int32_t startIndex, int32_t endIndex,
                               SSortHandle* pHandle) {
   pParam->pSources = taosArrayGet(pSources, startIndex);
@@ -472,6 +542,7 @@ static int32_t sortComparInit(SMsortComparParam* pParam, SArray* pSources, int32
       terrno = code;
       return code;
     }
+    setSortSpillBuf(pHandle);
   }
 
   if (pHandle->type == SORT_SINGLESOURCE_SORT) {
@@ -485,6 +556,7 @@ static int32_t sortComparInit(SMsortComparParam* pParam, SArray* pSources, int32
       }
 
       int32_t* pPgId = taosArrayGet(pSource->pageIdList, pSource->pageIndex);
+      prefetchSourceNextPage(pHandle, pSource);
 
       void* pPage = getBufPage(pHandle->pBuf, *pPgId);
       if (NULL == pPage) {
@@ -498,6 +570,7 @@ static int32_t sortComparInit(SMsortComparParam* pParam, SArray* pSources, int32
       }
 
       releaseBufPage(pHandle->pBuf, pPage);
+      buildSourceSortKeys(pHandle, pSource);
     }
   } else {
     qDebug("start init for the multiway merge sort, %s", pHandle->idStr);
@@ -510,6 +583,8 @@ static int32_t sortComparInit(SMsortComparParam* pParam, SArray* pSources, int32
       // set current source is done
       if (pSource->src.pBlock == NULL) {
         setCurrentSourceDone(pSource, pHandle);
+      } else {
+        buildSourceSortKeys(pHandle, pSource);
       }
     }
 
@@ -562,6 +637,7 @@ static int32_t adjustMergeTreeForNextTuple(SSortSource* pSource, SMultiwayMergeT
         }
 
         int32_t* pPgId = taosArrayGet(pSource->pageIdList, pSource->pageIndex);
+        prefetchSourceNextPage(pHandle, pSource);
 
         void*   pPage = getBufPage(pHandle->pBuf, *pPgId);
         if (pPage == NULL) {
@@ -574,6 +650,7 @@ static int32_t adjustMergeTreeForNextTuple(SSortSource* pSource, SMultiwayMergeT
           return code;
         }
         releaseBufPage(pHandle->pBuf, pPage);
+        buildSourceSortKeys(pHandle, pSource);
       }
     } else {
       int64_t st = taosGetTimestampUs();      
@@ -584,6 +661,8 @@ static int32_t adjustMergeTreeForNextTuple(SSortSource* pSource, SMultiwayMergeT
         (*numOfCompleted) += 1;
         pSource->src.rowIndex = -1;
         qDebug("adjust merge tree. %d source completed", *numOfCompleted);
+      } else {
+        buildSourceSortKeys(pHandle, pSource);
       }
     }
   }
@@ -728,6 +807,14 @@ int32_t msortComparFn(const void* pLeft, const void* pRight, void* param) {
     }
     return ret;
   } else {
+    if (pLeftSource->sortKeyValid && pRightSource->sortKeyValid) {
+      uint64_t leftKey = pLeftSource->pSortKeys[pLeftSource->src.rowIndex];
+      uint64_t rightKey = pRightSource->pSortKeys[pRightSource->src.rowIndex];
+      if (leftKey != rightKey) {
+        return leftKey < rightKey ? -1 : 1;
+      }
+    }
+
     bool isVarType;
     for (int32_t i = 0; i < pInfo->size; ++i) {
       SBlockOrderInfo* pOrder = TARRAY_GET_ELEM(pInfo, i);
@@ -955,6 +1042,7 @@ static int32_t createPageBuf(SSortHandle* pHandle) {
     if (code != TSDB_CODE_SUCCESS) {
       return code;
     }
+    setSortSpillBuf(pHandle);
   }
   return 0;
 }
@@ -1886,9 +1974,118 @@ static void freeSSortSource(SSortSource* source) {
     blockDataDestroy(source->src.pBlock);
     source->src.pBlock = NULL;
   }
+  taosMemoryFree(source->pSortKeys);
   taosMemoryFree(source);
 }
 
+static void doSortRun(SSortRun* pRun) {
+  int64_t st = taosGetTimestampUs();
+  pRun->code = blockDataSort(pRun->pBlock, pRun->pOrderInfo);
+  if (pRun->code == TSDB_CODE_SUCCESS && pRun->pqMaxRows > 0) {
+    blockDataKeepFirstNRows(pRun->pBlock, pRun->pqMaxRows);
+  }
+  pRun->elapsed = taosGetTimestampUs() - st;
+}
+
+static void sortRunWorkerFp(SQueueInfo* pInfo, void* pItem) {
+  SSortRun* pRun = *(SSortRun**)pItem;
+  taosFreeQitem(pItem);
+
+  doSortRun(pRun);
+  (void)tsem_post(&pRun->done);
+}
+
+int32_t tsortInitRunWorker() {
+  int32_t          numOfThreads = TMAX((int32_t)tsNumOfCores / 2, 1);
+  SSingleWorkerCfg cfg = {.min = numOfThreads, .max = numOfThreads, .name = "sort-run", .fp = sortRunWorkerFp};
+  if (tSingleWorkerInit(&sortRunWorker, &cfg) != 0) {
+    qError("failed to init sort run worker since %s, sort runs in query threads", terrstr());
+    sortRunWorker.queue = NULL;
+    return terrno;
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+void tsortCleanupRunWorker() {
+  tSingleWorkerCleanup(&sortRunWorker);
+  memset(&sortRunWorker, 0, sizeof(SSingleWorker));  // so that it can be started again
+}
+
+static void destroySortRun(SSortRun* pRun) {
+  blockDataDestroy(pRun->pBlock);
+  taosArrayDestroy(pRun->pOrderInfo);
+  (void)tsem_destroy(&pRun->done);
+  taosMemoryFree(pRun);
+}
+
+// Sort the buffered rows in the sort run worker, and buffer the following rows into a new block in the meanwhile.
+// The rows are sorted in the query thread if the run can not be queued.
+static int32_t startSortRun(SSortHandle* pHandle, SArray* pRuns) {
+  SSortRun* pRun = taosMemoryCalloc(1, sizeof(SSortRun));
+  if (pRun == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  (void)tsem_init(&pRun->done, 0, 0);
+
+  pRun->pqMaxRows = pHandle->pqMaxRows;
+  pRun->pOrderInfo = taosArrayDup(pHandle->pSortInfo, NULL);
+  SSDataBlock* pBlock = createOneDataBlock(pHandle->pDataBlock, false);
+  if (pRun->pOrderInfo == NULL || pBlock == NULL || taosArrayPush(pRuns, &pRun) == NULL) {
+    blockDataDestroy(pBlock);
+    destroySortRun(pRun);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pRun->pBlock = pHandle->pDataBlock;
+  pHandle->pDataBlock = pBlock;
+
+  SSortRun** pItem = NULL;
+  if (sortRunWorker.queue != NULL) {
+    pItem = taosAllocateQitem(sizeof(SSortRun*), DEF_QITEM, 0);
+  }
+  if (pItem != NULL) {
+    *pItem = pRun;
+    pRun->queued = true;
+    if (taosWriteQitem(sortRunWorker.queue, pItem) != 0) {
+      taosFreeQitem(pItem);
+      pRun->queued = false;
+    }
+  }
+
+  if (pRun->queued) {
+    pHandle->numOfBgSortRuns += 1;
+  } else {
+    qWarn("failed to queue sort run since %s, sort in query thread, %s", terrstr(), pHandle->idStr);
+    doSortRun(pRun);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// Wait for the sort runs in the order they are started and add them into the buffer, until at most maxRuns of them
+// are left. All the runs are waited for once an error occurs, so that none of them is left running.
+static int32_t finishSortRuns(SSortHandle* pHandle, SArray* pRuns, int32_t maxRuns, int32_t code) {
+  while (taosArrayGetSize(pRuns) > ((code == TSDB_CODE_SUCCESS) ? maxRuns : 0)) {
+    SSortRun* pRun = *(SSortRun**)taosArrayGet(pRuns, 0);
+    taosArrayRemove(pRuns, 0);
+
+    if (pRun->queued) {
+      (void)tsem_wait(&pRun->done);
+    }
+    pHandle->sortElapsed += pRun->elapsed;
+
+    if (code == TSDB_CODE_SUCCESS) {
+      code = pRun->code;
+    }
+    if (code == TSDB_CODE_SUCCESS) {
+      code = doAddToBuf(pRun->pBlock, pHandle);
+    }
+    destroySortRun(pRun);
+  }
+
+  return code;
+}
+
 static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
   int32_t code = 0;
   size_t  sortBufSize = pHandle->numOfPages * pHandle->pageSize;
@@ -1899,6 +2096,12 @@ static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
 
   tsortClearOrderdSource(pHandle->pOrderedSource, NULL, NULL);
 
+  SArray* pRuns = taosArrayInit(pHandle->numOfSortThreads, POINTER_BYTES);
+  if (pRuns == NULL) {
+    freeSSortSource(source);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
   while (1) {
     SSDataBlock* pBlock = pHandle->fetchfp(source->param);
     if (pBlock == NULL) {
@@ -1921,18 +2124,30 @@ static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
 
     code = blockDataMerge(pHandle->pDataBlock, pBlock);
     if (code != TSDB_CODE_SUCCESS) {
-      freeSSortSource(source);
-      return code;
+      goto _end;
     }
 
     size_t size = blockDataGetSize(pHandle->pDataBlock);
+    if (pHandle->numOfSortThreads > 1 && size > sortBufSize / pHandle->numOfSortThreads) {
+      // The blocks of the runs in flight count against the sort buffer, so each run gets its share of it, and at most
+      // numOfSortThreads - 1 runs are in flight while the next block is buffered. They are added into the buffer in
+      // the order they are started.
+      code = finishSortRuns(pHandle, pRuns, pHandle->numOfSortThreads - 2, code);
+      if (code == TSDB_CODE_SUCCESS) {
+        code = startSortRun(pHandle, pRuns);
+      }
+      if (code != TSDB_CODE_SUCCESS) {
+        goto _end;
+      }
+      continue;
+    }
+
     if (size > sortBufSize) {
       // Perform the in-memory sort and then flush data in the buffer into disk.
       int64_t p = taosGetTimestampUs();
       code = blockDataSort(pHandle->pDataBlock, pHandle->pSortInfo);
       if (code != 0) {
-        freeSSortSource(source);
-        return code;
+        goto _end;
       }
 
       int64_t el = taosGetTimestampUs() - p;
@@ -1940,13 +2155,13 @@ static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
       if (pHandle->pqMaxRows > 0) blockDataKeepFirstNRows(pHandle->pDataBlock, pHandle->pqMaxRows);
       code = doAddToBuf(pHandle->pDataBlock, pHandle);
       if (code != TSDB_CODE_SUCCESS) {
-        freeSSortSource(source);
-        return code;
+        goto _end;
       }
     }
   }
 
   freeSSortSource(source);
+  source = NULL;
 
   if (pHandle->pDataBlock != NULL && pHandle->pDataBlock->info.rows > 0) {
     size_t size = blockDataGetSize(pHandle->pDataBlock);
@@ -1956,13 +2171,19 @@ static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
 
     code = blockDataSort(pHandle->pDataBlock, pHandle->pSortInfo);
     if (code != 0) {
-      return code;
+      goto _end;
     }
 
     if (pHandle->pqMaxRows > 0) blockDataKeepFirstNRows(pHandle->pDataBlock, pHandle->pqMaxRows);
     int64_t el = taosGetTimestampUs() - p;
     pHandle->sortElapsed += el;
 
+    // the last run is sorted in the query thread while the previous ones are still running
+    code = finishSortRuns(pHandle, pRuns, 0, code);
+    if (code != TSDB_CODE_SUCCESS) {
+      goto _end;
+    }
+
     // All sorted data can fit in memory, external memory sort is not needed. Return to directly
     if (size <= sortBufSize && pHandle->pBuf == NULL) {
       pHandle->cmpParam.numOfSources = 1;
@@ -1971,11 +2192,15 @@ static int32_t createBlocksQuickSortInitialSources(SSortHandle* pHandle) {
       pHandle->loops = 1;
       pHandle->tupleHandle.rowIndex = -1;
       pHandle->tupleHandle.pBlock = pHandle->pDataBlock;
-      return 0;
     } else {
       code = doAddToBuf(pHandle->pDataBlock, pHandle);
     }
   }
+
+_end:
+  code = finishSortRuns(pHandle, pRuns, 0, code);
+  taosArrayDestroy(pRuns);
+  freeSSortSource(source);
   return code;
 }
 
@@ -2113,6 +2338,10 @@ void tsortSetForceUsePQSort(SSortHandle* pHandle) {
   pHandle->forceUsePQSort = true;
 }
 
+void tsortSetSortThreads(SSortHandle* pHandle, int32_t numOfThreads) {
+  pHandle->numOfSortThreads = TMAX(numOfThreads, 1);
+}
+
 static bool tsortIsPQSortApplicable(SSortHandle* pHandle) {
   if (pHandle->type != SORT_SINGLESOURCE_SORT) return false;
   if (tsortIsForceUsePQSort(pHandle)) return true;
@@ -2322,11 +2551,13 @@ SSortExecInfo tsortGetSortExecInfo(SSortHandle* pHandle) {
     info.sortBuffer = pHandle->pageSize * pHandle->numOfPages;
     info.sortMethod = pHandle->inMemSort ? SORT_QSORT_T : SORT_SPILLED_MERGE_SORT_T;
     info.loops = pHandle->loops;
+    info.sortThreads = (pHandle->numOfBgSortRuns > 0) ? pHandle->numOfSortThreads : 1;
 
     if (pHandle->pBuf != NULL) {
       SDiskbasedBufStatis st = getDBufStatis(pHandle->pBuf);
       info.writeBytes = st.flushBytes;
       info.readBytes = st.loadBytes;
+      info.stallTime = st.stallTime;
     }
   }
 
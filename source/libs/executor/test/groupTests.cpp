@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <functional>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "executorInt.h"
+#include "functionMgt.h"
+#include "operator.h"
+#include "querytask.h"
+#include "tdatablock.h"
+
+namespace {
+
+// the slots of the input blocks
+#define GT_TS_SLOT   0
+#define GT_K1_SLOT   1  // int, the first group key
+#define GT_K2_SLOT   2  // bigint, the second group key
+#define GT_VAL_SLOT  3  // bigint, the aggregated value
+#define GT_VC_SLOT   4  // varchar of the same value in all rows
+#define GT_SLOT_NUM  5
+#define GT_VC_BYTES  (8 + VARSTR_HEADER_SIZE)
+
+#define GT_INPUT_BLK_ID 0
+#define GT_RES_BLK_ID   1
+
+int32_t gtInputColType[GT_SLOT_NUM] = {TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT,
+                                       TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_VARCHAR};
+
+// group key of a row: null flag and value of k1, and of k2 if it is a group key
+typedef std::tuple<bool, int64_t, bool, int64_t> SGroupTestRowKey;
+
+typedef struct {
+  int64_t count;
+  int64_t sum;
+} SGroupTestRes;
+
+typedef std::map<SGroupTestRowKey, SGroupTestRes> SGroupTestResMap;
+
+typedef std::function<bool(int32_t, int64_t*)> FGroupTestKey;  // get the key of a row, false for null
+
+typedef struct {
+  int32_t       totalRows;
+  int32_t       blkRows;
+  int32_t       readRows;
+  FGroupTestKey k1;
+  FGroupTestKey k2;
+  SSDataBlock*  pBlock;
+} SGroupTestInput;
+
+int64_t gtValue(int32_t row) { return (int64_t)row * 3 + 1; }
+
+SColumnNode* gtMakeColumnNode(int32_t slotId) {
+  SColumnNode* pCol = (SColumnNode*)nodesMakeNode(QUERY_NODE_COLUMN);
+  pCol->dataBlockId = GT_INPUT_BLK_ID;
+  pCol->slotId = slotId;
+  pCol->colId = slotId + 1;
+  pCol->colType = COLUMN_TYPE_COLUMN;
+  pCol->node.resType.type = gtInputColType[slotId];
+  pCol->node.resType.bytes =
+      (gtInputColType[slotId] == TSDB_DATA_TYPE_VARCHAR) ? GT_VC_BYTES : tDataTypes[gtInputColType[slotId]].bytes;
+  snprintf(pCol->colName, sizeof(pCol->colName), "c%d", slotId);
+  return pCol;
+}
+
+void gtAppendSlot(SDataBlockDescNode* pDesc, SDataType* pType) {
+  SSlotDescNode* pSlot = (SSlotDescNode*)nodesMakeNode(QUERY_NODE_SLOT_DESC);
+  pSlot->slotId = LIST_LENGTH(pDesc->pSlots);
+  pSlot->dataType = *pType;
+  pSlot->output = true;
+  nodesListMakeStrictAppend(&pDesc->pSlots, (SNode*)pSlot);
+}
+
+void gtAppendTarget(SNodeList** ppList, SDataBlockDescNode* pDesc, SNode* pExpr, SDataType* pType) {
+  STargetNode* pTarget = (STargetNode*)nodesMakeNode(QUERY_NODE_TARGET);
+  pTarget->dataBlockId = GT_RES_BLK_ID;
+  pTarget->slotId = LIST_LENGTH(pDesc->pSlots);
+  pTarget->pExpr = pExpr;
+  gtAppendSlot(pDesc, pType);
+  nodesListMakeStrictAppend(ppList, (SNode*)pTarget);
+}
+
+SNode* gtMakeAggFunc(const char* name) {
+  SFunctionNode* pFunc = (SFunctionNode*)nodesMakeNode(QUERY_NODE_FUNCTION);
+  tstrncpy(pFunc->functionName, name, sizeof(pFunc->functionName));
+  nodesListMakeStrictAppend(&pFunc->pParameterList, (SNode*)gtMakeColumnNode(GT_VAL_SLOT));
+
+  char msg[128] = {0};
+  EXPECT_EQ(fmGetFuncInfo(pFunc, msg, sizeof(msg)), TSDB_CODE_SUCCESS) << msg;
+  return (SNode*)pFunc;
+}
+
+// select k1[, k2][, vc], count(v), sum(v) from t group by k1[, k2][, vc]
+SAggPhysiNode* gtCreateAggPhysiNode(const std::vector<int32_t>& groupSlots) {
+  SAggPhysiNode* p = (SAggPhysiNode*)nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_HASH_AGG);
+  SDataBlockDescNode* pDesc = (SDataBlockDescNode*)nodesMakeNode(QUERY_NODE_DATABLOCK_DESC);
+  pDesc->dataBlockId = GT_RES_BLK_ID;
+
+  for (int32_t slotId : groupSlots) {
+    SColumnNode* pCol = gtMakeColumnNode(slotId);
+    gtAppendTarget(&p->pGroupKeys, pDesc, (SNode*)pCol, &pCol->node.resType);
+  }
+
+  const char* funcs[] = {"count", "sum"};
+  for (const char* name : funcs) {
+    SNode* pFunc = gtMakeAggFunc(name);
+    gtAppendTarget(&p->pAggFuncs, pDesc, pFunc, &((SFunctionNode*)pFunc)->node.resType);
+  }
+
+  p->mergeDataBlock = true;
+  p->node.inputTsOrder = ORDER_ASC;
+  p->node.outputTsOrder = ORDER_ASC;
+  p->node.pOutputDataBlockDesc = pDesc;
+  return p;
+}
+
+SSDataBlock* gtCreateInputBlock(SGroupTestInput* pInput, int32_t start, int32_t rows) {
+  SSDataBlock* pBlock = createDataBlock();
+  pBlock->info.id.blockId = GT_INPUT_BLK_ID;
+  pBlock->info.scanFlag = MAIN_SCAN;
+
+  for (int32_t i = 0; i < GT_SLOT_NUM; ++i) {
+    int32_t bytes = (gtInputColType[i] == TSDB_DATA_TYPE_VARCHAR) ? GT_VC_BYTES : tDataTypes[gtInputColType[i]].bytes;
+    SColumnInfoData idata = createColumnInfoData(gtInputColType[i], bytes, i + 1);
+    blockDataAppendColInfo(pBlock, &idata);
+  }
+  blockDataEnsureCapacity(pBlock, rows);
+
+  char vc[GT_VC_BYTES] = {0};
+  STR_TO_VARSTR(vc, "const");
+
+  for (int32_t r = 0; r < rows; ++r) {
+    int32_t row = start + r;
+    int64_t ts = 1700000000000 + row;
+    int64_t val = gtValue(row);
+    int64_t k = 0;
+
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, GT_TS_SLOT), r, (const char*)&ts, false);
+    if (pInput->k1(row, &k)) {
+      int32_t k1 = (int32_t)k;
+      colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, GT_K1_SLOT), r, (const char*)&k1, false);
+    } else {
+      colDataSetNULL((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, GT_K1_SLOT), r);
+    }
+    if (pInput->k2(row, &k)) {
+      colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, GT_K2_SLOT), r, (const char*)&k, false);
+    } else {
+      colDataSetNULL((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, GT_K2_SLOT), r);
+    }
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, GT_VAL_SLOT), r, (const char*)&val, false);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, GT_VC_SLOT), r, vc, false);
+  }
+
+  pBlock->info.rows = rows;
+  return pBlock;
+}
+
+// the blocks are built on reading, as the group operator may reorder the rows of them
+SSDataBlock* gtGetNextInputBlock(struct SOperatorInfo* pOperator) {
+  SGroupTestInput* pInput = (SGroupTestInput*)pOperator->info;
+
+  blockDataDestroy(pInput->pBlock);
+  pInput->pBlock = NULL;
+  if (pInput->readRows >= pInput->totalRows) {
+    return NULL;
+  }
+
+  int32_t rows = TMIN(pInput->blkRows, pInput->totalRows - pInput->readRows);
+  pInput->pBlock = gtCreateInputBlock(pInput, pInput->readRows, rows);
+  pInput->readRows += rows;
+  return pInput->pBlock;
+}
+
+SGroupTestResMap gtExpectedRes(SGroupTestInput* pInput, bool withK2) {
+  SGroupTestResMap res;
+  for (int32_t row = 0; row < pInput->totalRows; ++row) {
+    int64_t k1 = 0, k2 = 0;
+    bool    k1Null = !pInput->k1(row, &k1);
+    bool    k2Null = withK2 ? !pInput->k2(row, &k2) : false;
+    if (!withK2) k2 = 0;
+    if (k1Null) k1 = 0;
+    if (k2Null) k2 = 0;
+
+    SGroupTestRes& r = res[std::make_tuple(k1Null, k1, k2Null, k2)];
+    r.count++;
+    r.sum += gtValue(row);
+  }
+  return res;
+}
+
+// run the group operator on the input, with the group keys of the given slots
+SGroupTestResMap gtRunGroupOperator(SGroupTestInput* pInput, const std::vector<int32_t>& groupSlots) {
+  SGroupTestResMap res;
+  SAggPhysiNode*   pNode = gtCreateAggPhysiNode(groupSlots);
+  SExecTaskInfo*   pTask = (SExecTaskInfo*)taosMemoryCalloc(1, sizeof(SExecTaskInfo));
+  pTask->id.str = "groupTest";
+
+  SOperatorInfo* pDownstream = (SOperatorInfo*)taosMemoryCalloc(1, sizeof(SOperatorInfo));
+  pDownstream->resultDataBlockId = GT_INPUT_BLK_ID;
+  pDownstream->info = pInput;
+  pDownstream->fpSet.getNextFn = gtGetNextInputBlock;
+  pInput->readRows = 0;
+
+  SOperatorInfo* pOperator = createGroupOperatorInfo(pDownstream, pNode, pTask);
+  EXPECT_NE(pOperator, nullptr) << tstrerror(pTask->code);
+  if (pOperator == NULL) {
+    return res;
+  }
+
+  bool    withK2 = (groupSlots.size() > 1 && groupSlots[1] == GT_K2_SLOT);
+  int32_t numOfKeys = groupSlots.size();
+  while (true) {
+    SSDataBlock* pBlock = pOperator->fpSet.getNextFn(pOperator);
+    if (pBlock == NULL) {
+      break;
+    }
+
+    SColumnInfoData* pK1 = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    SColumnInfoData* pK2 = withK2 ? (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1) : NULL;
+    SColumnInfoData* pCount = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, numOfKeys);
+    SColumnInfoData* pSum = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, numOfKeys + 1);
+    for (int32_t r = 0; r < pBlock->info.rows; ++r) {
+      bool    k1Null = colDataIsNull_s(pK1, r);
+      int64_t k1 = k1Null ? 0 : *(int32_t*)colDataGetData(pK1, r);
+      bool    k2Null = withK2 ? colDataIsNull_s(pK2, r) : false;
+      int64_t k2 = (withK2 && !k2Null) ? *(int64_t*)colDataGetData(pK2, r) : 0;
+
+      SGroupTestRowKey key = std::make_tuple(k1Null, k1, k2Null, k2);
+      EXPECT_EQ(res.count(key), 0) << "duplicated group k1:" << k1 << " k2:" << k2;
+      res[key] = {*(int64_t*)colDataGetData(pCount, r), *(int64_t*)colDataGetData(pSum, r)};
+    }
+  }
+
+  destroyOperator(pOperator);
+  nodesDestroyNode((SNode*)pNode);
+  taosMemoryFree(pTask);
+  return res;
+}
+
+void gtCheckRes(const SGroupTestResMap& res, const SGroupTestResMap& expected) {
+  ASSERT_EQ(res.size(), expected.size());
+  for (const auto& e : expected) {
+    auto it = res.find(e.first);
+    ASSERT_NE(it, res.end()) << "missing group k1:" << std::get<1>(e.first) << " k2:" << std::get<3>(e.first);
+    EXPECT_EQ(it->second.count, e.second.count);
+    EXPECT_EQ(it->second.sum, e.second.sum);
+  }
+}
+
+// The fixed-width keys go the batch way, while a varchar key of the same value in all rows makes the same groups in
+// the row by row way. Both of them are checked against the groups counted here.
+void gtRunGroupTest(SGroupTestInput* pInput, bool withK2) {
+  std::vector<int32_t> batchKeys = {GT_K1_SLOT};
+  if (withK2) batchKeys.push_back(GT_K2_SLOT);
+  std::vector<int32_t> rowKeys = batchKeys;
+  rowKeys.push_back(GT_VC_SLOT);
+
+  SGroupTestResMap expected = gtExpectedRes(pInput, withK2);
+  SGroupTestResMap batchRes = gtRunGroupOperator(pInput, batchKeys);
+  SGroupTestResMap rowRes = gtRunGroupOperator(pInput, rowKeys);
+
+  gtCheckRes(batchRes, expected);
+  gtCheckRes(rowRes, expected);
+}
+
+class GroupTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    // the results of the groups are kept in the disk based buffer
+    strcpy(tsTempDir, "/tmp/");
+    tsTempSpace.size.avail = 1;
+    ASSERT_EQ(fmFuncMgtInit(), TSDB_CODE_SUCCESS);
+  }
+  static void TearDownTestSuite() { fmFuncMgtDestroy(); }
+};
+
+}  // namespace
+
+// the rows of each group are adjacent, so that the aggregate functions are applied on each run of rows
+TEST_F(GroupTest, adjacentGroups) {
+  SGroupTestInput input = {0};
+  input.totalRows = 10000;
+  input.blkRows = 1024;
+  input.k1 = [](int32_t row, int64_t* k) { *k = row / 37; return true; };
+  input.k2 = [](int32_t row, int64_t* k) { *k = row / 100; return true; };
+  gtRunGroupTest(&input, false);
+  gtRunGroupTest(&input, true);
+}
+
+// the rows of the groups are scattered in the blocks, so that the blocks are reordered by group
+TEST_F(GroupTest, scatteredGroups) {
+  SGroupTestInput input = {0};
+  input.totalRows = 10000;
+  input.blkRows = 4096;
+  input.k1 = [](int32_t row, int64_t* k) { *k = ((int64_t)row * 7919) % 53 - 20; return true; };
+  input.k2 = [](int32_t row, int64_t* k) { *k = (row % 3) * 1000000007ll; return true; };
+  gtRunGroupTest(&input, false);
+  gtRunGroupTest(&input, true);
+
+  // the groups of a block are numbered in their first appearance, and a group in many blocks takes the same result
+  input.blkRows = 7;
+  gtRunGroupTest(&input, true);
+}
+
+// a null key is a group of its own, other than the zero value, and so is each combination of null keys
+TEST_F(GroupTest, nullKeys) {
+  SGroupTestInput input = {0};
+  input.totalRows = 8000;
+  input.blkRows = 1000;
+  input.k1 = [](int32_t row, int64_t* k) {
+    *k = row % 11;
+    return row % 5 != 0;
+  };
+  input.k2 = [](int32_t row, int64_t* k) {
+    *k = (row % 4 == 1) ? 0 : -(row % 7);
+    return row % 3 != 0;
+  };
+  gtRunGroupTest(&input, false);
+  gtRunGroupTest(&input, true);
+
+  // all the keys are null in the blocks
+  input.k1 = [](int32_t row, int64_t* k) { return false; };
+  input.k2 = [](int32_t row, int64_t* k) { return false; };
+  gtRunGroupTest(&input, true);
+}
+
+// a group for each row, so that no rows of a block share a group
+TEST_F(GroupTest, distinctKeys) {
+  SGroupTestInput input = {0};
+  input.totalRows = 3000;
+  input.blkRows = 3000;
+  input.k1 = [](int32_t row, int64_t* k) { *k = (row * 2654435761ll) % 1000003; return true; };
+  input.k2 = [](int32_t row, int64_t* k) { *k = row & 1; return true; };
+  gtRunGroupTest(&input, false);
+  gtRunGroupTest(&input, true);
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,405 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "executorInt.h"
+#include "operator.h"
+#include "querytask.h"
+#include "tdatablock.h"
+
+namespace {
+
+// the slots of the input blocks of both sides
+#define HJT_TS_SLOT  0
+#define HJT_K1_SLOT  1  // int, the first join key
+#define HJT_K2_SLOT  2  // varchar, the second join key
+#define HJT_VAL_SLOT 3  // bigint, the row number in the side
+#define HJT_SLOT_NUM 4
+#define HJT_K2_BYTES (16 + VARSTR_HEADER_SIZE)
+
+#define HJT_LEFT_BLK_ID  0
+#define HJT_RIGHT_BLK_ID 1
+#define HJT_RES_BLK_ID   2
+
+int32_t hjtInputColType[HJT_SLOT_NUM] = {TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_VARCHAR,
+                                         TSDB_DATA_TYPE_BIGINT};
+
+int32_t hjtInputColBytes(int32_t slotId) {
+  return (hjtInputColType[slotId] == TSDB_DATA_TYPE_VARCHAR) ? HJT_K2_BYTES : tDataTypes[hjtInputColType[slotId]].bytes;
+}
+
+typedef std::function<bool(int32_t, int64_t*)> FHJoinTestKey;  // get the key of a row, false for null
+
+// The scan info comes first, so that the dummy downstream of the probe side is taken as a table scan by the join.
+typedef struct {
+  STableScanInfo scanInfo;
+  int32_t        blkId;
+  int32_t        totalRows;
+  int32_t        blkRows;
+  int32_t        readRows;
+  FHJoinTestKey  k1;
+  FHJoinTestKey  k2;
+  SSDataBlock*   pBlock;
+} SHJoinTestInput;
+
+typedef std::vector<std::pair<int64_t, int64_t>> SHJoinTestRes;  // the row numbers of the left and right rows joined
+
+SSDataBlock* hjtCreateInputBlock(SHJoinTestInput* pInput, int32_t start, int32_t rows) {
+  SSDataBlock* pBlock = createDataBlock();
+  pBlock->info.id.blockId = pInput->blkId;
+  pBlock->info.scanFlag = MAIN_SCAN;
+
+  for (int32_t i = 0; i < HJT_SLOT_NUM; ++i) {
+    SColumnInfoData idata = createColumnInfoData(hjtInputColType[i], hjtInputColBytes(i), i + 1);
+    blockDataAppendColInfo(pBlock, &idata);
+  }
+  blockDataEnsureCapacity(pBlock, TMAX(rows, 1));
+
+  for (int32_t r = 0; r < rows; ++r) {
+    int64_t row = start + r;
+    int64_t ts = 1700000000000 + row;
+    int64_t k = 0;
+
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, HJT_TS_SLOT), r, (const char*)&ts, false);
+    if (pInput->k1(row, &k)) {
+      int32_t k1 = (int32_t)k;
+      colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, HJT_K1_SLOT), r, (const char*)&k1, false);
+    } else {
+      colDataSetNULL((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, HJT_K1_SLOT), r);
+    }
+    if (pInput->k2(row, &k)) {
+      // the keys of different lengths
+      char k2[HJT_K2_BYTES] = {0};
+      STR_TO_VARSTR(k2, std::string(k % 3 + 1, 'k').append(std::to_string(k)).c_str());
+      colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, HJT_K2_SLOT), r, k2, false);
+    } else {
+      colDataSetNULL((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, HJT_K2_SLOT), r);
+    }
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, HJT_VAL_SLOT), r, (const char*)&row, false);
+  }
+
+  pBlock->info.rows = rows;
+  return pBlock;
+}
+
+// The probe blocks go through the runtime filter pushed down by the join, as the table scan does on loading them, and
+// the blocks of which all the rows are filtered out are skipped.
+SSDataBlock* hjtGetNextInputBlock(struct SOperatorInfo* pOperator) {
+  SHJoinTestInput* pInput = (SHJoinTestInput*)pOperator->info;
+
+  while (true) {
+    blockDataDestroy(pInput->pBlock);
+    pInput->pBlock = NULL;
+    if (pInput->readRows >= pInput->totalRows) {
+      return NULL;
+    }
+
+    int32_t rows = TMIN(pInput->blkRows, pInput->totalRows - pInput->readRows);
+    pInput->pBlock = hjtCreateInputBlock(pInput, pInput->readRows, rows);
+    pInput->readRows += rows;
+
+    if (pInput->scanInfo.base.pRuntimeFilter != NULL) {
+      EXPECT_EQ(doApplyJoinRuntimeFilter(&pInput->scanInfo.base, pInput->pBlock), TSDB_CODE_SUCCESS);
+    }
+    if (pInput->pBlock->info.rows > 0) {
+      return pInput->pBlock;
+    }
+  }
+}
+
+SOperatorInfo* hjtCreateDownstream(SHJoinTestInput* pInput, int32_t blkId, int32_t operatorType) {
+  pInput->blkId = blkId;
+  pInput->readRows = 0;
+  pInput->scanInfo.pResBlock = hjtCreateInputBlock(pInput, 0, 0);
+  pInput->scanInfo.base.limitInfo.limit.limit = -1;
+  pInput->scanInfo.base.limitInfo.slimit.limit = -1;
+  pInput->scanInfo.base.readRecorder.runtimeFilterRows = 0;
+
+  SOperatorInfo* pDownstream = (SOperatorInfo*)taosMemoryCalloc(1, sizeof(SOperatorInfo));
+  pDownstream->operatorType = operatorType;
+  pDownstream->resultDataBlockId = blkId;
+  pDownstream->info = pInput;
+  pDownstream->fpSet.getNextFn = hjtGetNextInputBlock;
+  return pDownstream;
+}
+
+void hjtDestroyInput(SHJoinTestInput* pInput) {
+  destroyJoinRuntimeFilter(pInput->scanInfo.base.pRuntimeFilter);
+  pInput->scanInfo.base.pRuntimeFilter = NULL;
+  blockDataDestroy(pInput->scanInfo.pResBlock);
+  pInput->scanInfo.pResBlock = NULL;
+  blockDataDestroy(pInput->pBlock);
+  pInput->pBlock = NULL;
+}
+
+SColumnNode* hjtMakeColumnNode(int32_t blkId, int32_t slotId) {
+  SColumnNode* pCol = (SColumnNode*)nodesMakeNode(QUERY_NODE_COLUMN);
+  pCol->dataBlockId = blkId;
+  pCol->slotId = slotId;
+  pCol->colId = slotId + 1;
+  pCol->colType = COLUMN_TYPE_COLUMN;
+  pCol->node.resType.type = hjtInputColType[slotId];
+  pCol->node.resType.bytes = hjtInputColBytes(slotId);
+  snprintf(pCol->colName, sizeof(pCol->colName), "c%d", slotId);
+  return pCol;
+}
+
+void hjtAppendTarget(SHashJoinPhysiNode* p, int32_t blkId, int32_t slotId) {
+  SDataBlockDescNode* pDesc = p->node.pOutputDataBlockDesc;
+  SColumnNode*        pCol = hjtMakeColumnNode(blkId, slotId);
+
+  SSlotDescNode* pSlot = (SSlotDescNode*)nodesMakeNode(QUERY_NODE_SLOT_DESC);
+  pSlot->slotId = LIST_LENGTH(pDesc->pSlots);
+  pSlot->dataType = pCol->node.resType;
+  pSlot->output = true;
+  pDesc->totalRowSize += pCol->node.resType.bytes;
+  pDesc->outputRowSize += pCol->node.resType.bytes;
+
+  STargetNode* pTarget = (STargetNode*)nodesMakeNode(QUERY_NODE_TARGET);
+  pTarget->dataBlockId = HJT_RES_BLK_ID;
+  pTarget->slotId = pSlot->slotId;
+  pTarget->pExpr = (SNode*)pCol;
+
+  nodesListMakeStrictAppend(&pDesc->pSlots, (SNode*)pSlot);
+  nodesListMakeStrictAppend(&p->pTargets, (SNode*)pTarget);
+}
+
+// select l.v, r.v from l join r on l.k1 = r.k1 [and l.k2 = r.k2]
+SHashJoinPhysiNode* hjtCreateJoinPhysiNode(bool withK2, SHJoinTestInput* pLeft, SHJoinTestInput* pRight) {
+  SHashJoinPhysiNode* p = (SHashJoinPhysiNode*)nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_HASH_JOIN);
+  p->joinType = JOIN_TYPE_INNER;
+  p->subType = JOIN_STYPE_NONE;
+
+  nodesListMakeStrictAppend(&p->pOnLeft, (SNode*)hjtMakeColumnNode(HJT_LEFT_BLK_ID, HJT_K1_SLOT));
+  nodesListMakeStrictAppend(&p->pOnRight, (SNode*)hjtMakeColumnNode(HJT_RIGHT_BLK_ID, HJT_K1_SLOT));
+  if (withK2) {
+    nodesListMakeStrictAppend(&p->pOnLeft, (SNode*)hjtMakeColumnNode(HJT_LEFT_BLK_ID, HJT_K2_SLOT));
+    nodesListMakeStrictAppend(&p->pOnRight, (SNode*)hjtMakeColumnNode(HJT_RIGHT_BLK_ID, HJT_K2_SLOT));
+  }
+  p->leftPrimSlotId = HJT_TS_SLOT;
+  p->rightPrimSlotId = HJT_TS_SLOT;
+
+  SDataBlockDescNode* pDesc = (SDataBlockDescNode*)nodesMakeNode(QUERY_NODE_DATABLOCK_DESC);
+  pDesc->dataBlockId = HJT_RES_BLK_ID;
+  p->node.pOutputDataBlockDesc = pDesc;
+  hjtAppendTarget(p, HJT_LEFT_BLK_ID, HJT_VAL_SLOT);
+  hjtAppendTarget(p, HJT_RIGHT_BLK_ID, HJT_VAL_SLOT);
+
+  // the smaller side is the build side of inner join
+  p->inputStat[0].inputRowNum = pLeft->totalRows;
+  p->inputStat[1].inputRowNum = pRight->totalRows;
+  return p;
+}
+
+SHJoinTestRes hjtExpectedRes(SHJoinTestInput* pLeft, SHJoinTestInput* pRight, bool withK2) {
+  std::multimap<std::pair<int32_t, int64_t>, int32_t> leftRows;
+  for (int32_t l = 0; l < pLeft->totalRows; ++l) {
+    int64_t lk1 = 0, lk2 = 0;
+    if (!pLeft->k1(l, &lk1) || (withK2 && !pLeft->k2(l, &lk2))) {
+      continue;
+    }
+    leftRows.insert(std::make_pair(std::make_pair((int32_t)lk1, withK2 ? lk2 : 0), l));
+  }
+
+  SHJoinTestRes res;
+  for (int32_t r = 0; r < pRight->totalRows; ++r) {
+    int64_t rk1 = 0, rk2 = 0;
+    if (!pRight->k1(r, &rk1) || (withK2 && !pRight->k2(r, &rk2))) {
+      continue;
+    }
+    auto range = leftRows.equal_range(std::make_pair((int32_t)rk1, withK2 ? rk2 : 0));
+    for (auto it = range.first; it != range.second; ++it) {
+      res.push_back(std::make_pair(it->second, r));
+    }
+  }
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+// Run the join on the inputs, with the right side taken as a table scan or not. The rows dropped by the runtime filter
+// pushed down to the right side are returned in pFilterRows.
+SHJoinTestRes hjtRunJoinOperator(SHJoinTestInput* pLeft, SHJoinTestInput* pRight, bool withK2, bool rightIsScan,
+                                 uint64_t* pFilterRows) {
+  SHJoinTestRes       res;
+  SHashJoinPhysiNode* pNode = hjtCreateJoinPhysiNode(withK2, pLeft, pRight);
+  SExecTaskInfo*      pTask = (SExecTaskInfo*)taosMemoryCalloc(1, sizeof(SExecTaskInfo));
+  pTask->id.str = "hashJoinTest";
+
+  SOperatorInfo* pDownstream[2] = {
+      hjtCreateDownstream(pLeft, HJT_LEFT_BLK_ID, QUERY_NODE_PHYSICAL_PLAN_EXCHANGE),
+      hjtCreateDownstream(pRight, HJT_RIGHT_BLK_ID,
+                          rightIsScan ? QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN : QUERY_NODE_PHYSICAL_PLAN_EXCHANGE)};
+
+  SOperatorInfo* pOperator = createHashJoinOperatorInfo(pDownstream, 2, pNode, pTask);
+  EXPECT_NE(pOperator, nullptr) << tstrerror(pTask->code);
+  if (pOperator != NULL) {
+    while (true) {
+      SSDataBlock* pBlock = pOperator->fpSet.getNextFn(pOperator);
+      if (pBlock == NULL) {
+        break;
+      }
+
+      SColumnInfoData* pLeftVal = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+      SColumnInfoData* pRightVal = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+      for (int32_t r = 0; r < pBlock->info.rows; ++r) {
+        res.push_back(std::make_pair(*(int64_t*)colDataGetData(pLeftVal, r), *(int64_t*)colDataGetData(pRightVal, r)));
+      }
+    }
+    destroyOperator(pOperator);
+  }
+
+  *pFilterRows = pRight->scanInfo.base.readRecorder.runtimeFilterRows;
+  hjtDestroyInput(pLeft);
+  hjtDestroyInput(pRight);
+  nodesDestroyNode((SNode*)pNode);
+  taosMemoryFree(pTask);
+
+  std::sort(res.begin(), res.end());
+  return res;
+}
+
+// The left side is the smaller one, so that the bloom filter of its keys is pushed down to the right side if it is a
+// table scan. The results with and without the runtime filter are both checked against the rows joined here.
+void hjtRunJoinTest(SHJoinTestInput* pLeft, SHJoinTestInput* pRight, bool withK2, bool expectFiltered) {
+  SHJoinTestRes expected = hjtExpectedRes(pLeft, pRight, withK2);
+  uint64_t      filterRows = 0;
+
+  SHJoinTestRes res = hjtRunJoinOperator(pLeft, pRight, withK2, false, &filterRows);
+  EXPECT_EQ(filterRows, 0);
+  EXPECT_TRUE(res == expected) << "rows:" << res.size() << " expected:" << expected.size();
+
+  res = hjtRunJoinOperator(pLeft, pRight, withK2, true, &filterRows);
+  EXPECT_TRUE(res == expected) << "rows:" << res.size() << " expected:" << expected.size();
+  if (expectFiltered) {
+    EXPECT_GT(filterRows, 0);
+  }
+}
+
+}  // namespace
+
+// most of the right rows do not match any left row, and are dropped by the runtime filter
+TEST(hashJoinTest, singleKey) {
+  SHJoinTestInput left = {0};
+  left.totalRows = 300;
+  left.blkRows = 128;
+  left.k1 = [](int32_t row, int64_t* k) { *k = row % 97; return true; };
+  left.k2 = [](int32_t row, int64_t* k) { *k = row; return true; };
+
+  SHJoinTestInput right = {0};
+  right.totalRows = 6000;
+  right.blkRows = 1000;
+  right.k1 = [](int32_t row, int64_t* k) { *k = ((int64_t)row * 7919) % 1000 - 100; return true; };
+  right.k2 = [](int32_t row, int64_t* k) { *k = row; return true; };
+  hjtRunJoinTest(&left, &right, false, true);
+
+  // all the right rows match, and none of them is dropped
+  right.k1 = [](int32_t row, int64_t* k) { *k = row % 97; return true; };
+  hjtRunJoinTest(&left, &right, false, false);
+}
+
+// the keys of the bloom filter are the int key and the varchar key put together, as the keys of the hash table
+TEST(hashJoinTest, multiKeys) {
+  SHJoinTestInput left = {0};
+  left.totalRows = 500;
+  left.blkRows = 200;
+  left.k1 = [](int32_t row, int64_t* k) { *k = row % 50; return true; };
+  left.k2 = [](int32_t row, int64_t* k) { *k = row % 20; return true; };
+
+  // the right rows of which either key matches but not both are dropped as well
+  SHJoinTestInput right = {0};
+  right.totalRows = 8000;
+  right.blkRows = 1024;
+  right.k1 = [](int32_t row, int64_t* k) { *k = row % 50; return true; };
+  right.k2 = [](int32_t row, int64_t* k) { *k = (row / 50) % 40; return true; };
+  hjtRunJoinTest(&left, &right, true, true);
+
+  // the varchar keys of different lengths
+  right.k2 = [](int32_t row, int64_t* k) { *k = ((int64_t)row * 31) % 1000; return true; };
+  hjtRunJoinTest(&left, &right, true, true);
+}
+
+// a null key never matches, on either side, and the right rows of null keys are dropped by the runtime filter
+TEST(hashJoinTest, nullKeys) {
+  SHJoinTestInput left = {0};
+  left.totalRows = 400;
+  left.blkRows = 100;
+  left.k1 = [](int32_t row, int64_t* k) {
+    *k = row % 30;
+    return row % 7 != 0;
+  };
+  left.k2 = [](int32_t row, int64_t* k) {
+    *k = row % 6;
+    return row % 5 != 0;
+  };
+
+  SHJoinTestInput right = {0};
+  right.totalRows = 5000;
+  right.blkRows = 1000;
+  right.k1 = [](int32_t row, int64_t* k) {
+    *k = row % 30;
+    return row % 3 != 0;
+  };
+  right.k2 = [](int32_t row, int64_t* k) {
+    *k = row % 6;
+    return row % 4 != 0;
+  };
+  hjtRunJoinTest(&left, &right, false, true);
+  hjtRunJoinTest(&left, &right, true, true);
+
+  // all the keys of the right side are null, so that no rows are joined
+  right.k1 = [](int32_t row, int64_t* k) { return false; };
+  hjtRunJoinTest(&left, &right, false, true);
+  hjtRunJoinTest(&left, &right, true, true);
+}
+
+#pragma GCC diagnostic pop
+
+// the build side is large enough for the hash tables of its partitions to be built in the build worker
+TEST(hashJoinTest, parallelBuild) {
+  SHJoinTestInput left = {0};
+  left.totalRows = 70000;
+  left.blkRows = 4096;
+  left.k1 = [](int32_t row, int64_t* k) { *k = row % 20000; return true; };
+  left.k2 = [](int32_t row, int64_t* k) { *k = row % 3; return true; };
+
+  SHJoinTestInput right = {0};
+  right.totalRows = 100000;
+  right.blkRows = 4096;
+  right.k1 = [](int32_t row, int64_t* k) { *k = ((int64_t)row * 7) % 100000; return true; };
+  right.k2 = [](int32_t row, int64_t* k) { *k = row % 3; return true; };
+
+  // the partitions are built in the query thread if the worker is not started
+  hjtRunJoinTest(&left, &right, false, true);
+
+  ASSERT_EQ(qInitExecWorkers(), 0);
+  hjtRunJoinTest(&left, &right, false, true);
+  hjtRunJoinTest(&left, &right, true, true);
+  qCleanupExecWorkers();
+}
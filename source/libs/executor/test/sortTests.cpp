@@ -14,6 +14,8 @@
  */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
 #include <tglobal.h>
 #include <tsort.h>
 #include <iostream>
@@ -393,4 +395,156 @@ TEST(testCase, ordered_merge_sort_Test) {
 
 #endif
 
+namespace {
+typedef struct {
+  int32_t      numOfBlocks;
+  int32_t      rows;
+  uint32_t     seed;
+  SSDataBlock* pBlock;
+} SSortThreadsSource;
+
+// the bigint values are repeatable for the same seed, with a null every 97 rows
+SSDataBlock* fetchSortThreadsBlock(void* param) {
+  SSortThreadsSource* pSource = (SSortThreadsSource*)param;
+  if (pSource->numOfBlocks-- <= 0) {
+    return NULL;
+  }
+
+  if (pSource->pBlock == NULL) {
+    pSource->pBlock = createDataBlock();
+    SColumnInfoData colInfo = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), 1);
+    blockDataAppendColInfo(pSource->pBlock, &colInfo);
+  }
+
+  SSDataBlock* pBlock = pSource->pBlock;
+  blockDataCleanup(pBlock);
+  blockDataEnsureCapacity(pBlock, pSource->rows);
+  SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+  for (int32_t i = 0; i < pSource->rows; ++i) {
+    pSource->seed = pSource->seed * 1103515245 + 12345;
+    if (pSource->seed % 97 == 0) {
+      colDataSetNULL(pCol, i);
+    } else {
+      int64_t v = (pSource->seed >> 8) % 1000000;
+      colDataSetVal(pCol, i, (const char*)&v, false);
+    }
+  }
+  pBlock->info.rows = pSource->rows;
+  return pBlock;
+}
+
+// sorts the blocks of the source with numOfThreads, and returns the values in the order they are got, INT64_MIN for
+// the nulls
+int32_t sortWithThreads(int32_t numOfThreads, int32_t numOfBlocks, std::vector<int64_t>* pValues) {
+  SSortThreadsSource source = {numOfBlocks, 4096, 7, NULL};
+
+  SBlockOrderInfo oi = {0};
+  oi.order = TSDB_ORDER_ASC;
+  oi.slotId = 0;
+  oi.nullFirst = true;
+  SArray* pOrderInfo = taosArrayInit(1, sizeof(SBlockOrderInfo));
+  taosArrayPush(pOrderInfo, &oi);
+
+  SSortHandle* pHandle =
+      tsortCreateSortHandle(pOrderInfo, SORT_SINGLESOURCE_SORT, -1, -1, NULL, "sortThreadsTest", 0, 0, 0);
+  tsortSetFetchRawDataFp(pHandle, fetchSortThreadsBlock, NULL, NULL);
+  tsortSetSortThreads(pHandle, numOfThreads);
+
+  SSortSource* ps = static_cast<SSortSource*>(taosMemoryCalloc(1, sizeof(SSortSource)));
+  ps->param = &source;
+  ps->onlyRef = true;
+  tsortAddSource(pHandle, ps);
+
+  int32_t code = tsortOpen(pHandle);
+  while (code == TSDB_CODE_SUCCESS) {
+    STupleHandle* pTuple = tsortNextTuple(pHandle);
+    if (pTuple == NULL) {
+      break;
+    }
+    pValues->push_back(tsortIsNullVal(pTuple, 0) ? INT64_MIN : *(int64_t*)tsortGetValue(pTuple, 0));
+  }
+
+  tsortDestroySortHandle(pHandle);
+  taosArrayDestroy(pOrderInfo);
+  blockDataDestroy(source.pBlock);
+  return code;
+}
+
+void setSortTempSpace(bool available) {
+  strcpy(tsTempDir, "/tmp/");
+  tsTempSpace.size.avail = available ? 1 : 0;
+}
+
+std::vector<int64_t> expectedSortResult(int32_t numOfBlocks) {
+  SSortThreadsSource   source = {numOfBlocks, 4096, 7, NULL};
+  std::vector<int64_t> values;
+  for (SSDataBlock* pBlock = fetchSortThreadsBlock(&source); pBlock != NULL; pBlock = fetchSortThreadsBlock(&source)) {
+    SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+      values.push_back(colDataIsNull_s(pCol, i) ? INT64_MIN : *(int64_t*)colDataGetData(pCol, i));
+    }
+  }
+  blockDataDestroy(source.pBlock);
+  std::sort(values.begin(), values.end());
+  return values;
+}
+}  // namespace
+
+// the runs are sorted in the query thread unless the sort run worker is started
+class sortThreadsTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() { ASSERT_EQ(qInitExecWorkers(), TSDB_CODE_SUCCESS); }
+  static void TearDownTestSuite() { qCleanupExecWorkers(); }
+};
+
+// The blocks of 4096 bigint rows take 33280 bytes each, and the sort buffer is 1024 pages of 4096 bytes, so that 32
+// blocks make one run for 4 threads, and up to 126 blocks are sorted in memory for 1 thread.
+TEST_F(sortThreadsTest, sameResult) {
+  setSortTempSpace(true);
+
+  int32_t numOfBlocks[] = {10, 64, 100, 400};
+  int32_t numOfThreads[] = {2, 3, 4, 8};
+  for (int32_t b = 0; b < sizeof(numOfBlocks) / sizeof(numOfBlocks[0]); ++b) {
+    std::vector<int64_t> expected = expectedSortResult(numOfBlocks[b]);
+
+    std::vector<int64_t> single;
+    ASSERT_EQ(sortWithThreads(1, numOfBlocks[b], &single), TSDB_CODE_SUCCESS);
+    ASSERT_EQ(single, expected);
+
+    for (int32_t t = 0; t < sizeof(numOfThreads) / sizeof(numOfThreads[0]); ++t) {
+      std::vector<int64_t> parallel;
+      ASSERT_EQ(sortWithThreads(numOfThreads[t], numOfBlocks[b], &parallel), TSDB_CODE_SUCCESS);
+      ASSERT_EQ(parallel, expected) << "blocks:" << numOfBlocks[b] << " threads:" << numOfThreads[t];
+    }
+  }
+}
+
+// The source ends right after the second run is started, so that no rows are left to sort in the query thread.
+TEST_F(sortThreadsTest, endAfterRunStarted) {
+  setSortTempSpace(true);
+
+  std::vector<int64_t> single, parallel;
+  ASSERT_EQ(sortWithThreads(1, 64, &single), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(sortWithThreads(4, 64, &parallel), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(parallel, single);
+  ASSERT_EQ(single.size(), 64 * 4096);
+}
+
+// The first run can not be spilled, so the runs still in flight are waited for before the error is returned.
+TEST_F(sortThreadsTest, spillError) {
+  setSortTempSpace(false);
+
+  std::vector<int64_t> single, parallel;
+  int32_t              numOfThreads[] = {1, 2, 4, 8};
+  for (int32_t t = 0; t < sizeof(numOfThreads) / sizeof(numOfThreads[0]); ++t) {
+    terrno = 0;
+    ASSERT_NE(sortWithThreads(numOfThreads[t], 400, &parallel), TSDB_CODE_SUCCESS);
+    ASSERT_EQ(terrno, TSDB_CODE_NO_DISKSPACE);
+  }
+
+  // the rows fitting in the sort buffer need no spill for 1 thread
+  ASSERT_EQ(sortWithThreads(1, 10, &single), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(single.size(), 10 * 4096);
+}
+
 #pragma GCC diagnostic pop
@@ -111,7 +111,7 @@ int indexOpen(SIndexOpts* opts, const char* path, SIndex** index) {
     return TSDB_CODE_OUT_OF_MEMORY;
   }
 
-  idx->lru = taosLRUCacheInit(opts->cacheSize, -1, .5);
+  idx->lru = taosLRUCacheInit(opts->cacheSize, -1, .5, TAOS_LRU_POLICY_LRU);
   if (idx->lru == NULL) {
     ret = TSDB_CODE_OUT_OF_MEMORY;
     goto END;
@@ -390,14 +390,14 @@ class TFileObj {
     fileName_ = path;
 
     IFileCtx* ctx = idxFileCtxCreate(TFILE, path.c_str(), false, 64 * 1024 * 1024);
-    ctx->lru = taosLRUCacheInit(1024 * 1024 * 4, -1, .5);
+    ctx->lru = taosLRUCacheInit(1024 * 1024 * 4, -1, .5, TAOS_LRU_POLICY_LRU);
 
     writer_ = tfileWriterCreate(ctx, &header);
     return writer_ != NULL ? true : false;
   }
   bool InitReader() {
     IFileCtx* ctx = idxFileCtxCreate(TFILE, fileName_.c_str(), true, 64 * 1024 * 1024);
-    ctx->lru = taosLRUCacheInit(1024 * 1024 * 4, -1, .5);
+    ctx->lru = taosLRUCacheInit(1024 * 1024 * 4, -1, .5, TAOS_LRU_POLICY_LRU);
     reader_ = tfileReaderCreate(ctx);
     return reader_ != NULL ? true : false;
   }
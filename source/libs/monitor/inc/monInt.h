@@ -57,6 +57,8 @@ void monGenDataDiskTable(SMonInfo *pMonitor);
 void monGenLogDiskTable(SMonInfo *pMonitor);
 void monGenMnodeRoleTable(SMonInfo *pMonitor);
 void monGenVnodeRoleTable(SMonInfo *pMonitor);
+void monGenVnodeAsyncTable(SMonInfo *pMonitor);
+void monGenVnodeQueueTable(SMonInfo *pMonitor);
 
 void monSendPromReport();
 void monInitMonitorFW();
@@ -99,6 +99,20 @@ extern char* tsMonFwUri;
 #define MNODE_ROLE "taosd_mnodes_info:role"
 #define VNODE_ROLE "taosd_vnodes_info:role"
 
+#define VNODE_ASYNC_TABLE "taosd_vnodes_async"
+
+#define VNODE_ASYNC_TASKS VNODE_ASYNC_TABLE":tasks"
+#define VNODE_ASYNC_WAIT_TIME VNODE_ASYNC_TABLE":wait_time"
+#define VNODE_ASYNC_RUN_TIME VNODE_ASYNC_TABLE":run_time"
+#define VNODE_ASYNC_WAIT_BUCKET VNODE_ASYNC_TABLE":wait_time_bucket"
+#define VNODE_ASYNC_RUN_BUCKET VNODE_ASYNC_TABLE":run_time_bucket"
+
+#define VNODE_QUEUE_TABLE "taosd_vnodes_queue"
+
+#define VNODE_QUEUE_MEMORY VNODE_QUEUE_TABLE":memory"
+#define VNODE_QUEUE_MEMORY_PEAK VNODE_QUEUE_TABLE":memory_peak"
+#define VNODE_QUEUE_REJECTS VNODE_QUEUE_TABLE":rejects"
+
 void monInitMonitorFW(){
   taos_collector_registry_default_init();
 
@@ -733,6 +747,135 @@ void monGenVnodeRoleTable(SMonInfo *pMonitor){
   }
 }
 
+static void monGenVnodeAsyncPoolTable(const char *pool, SVAsyncStat *pStat, const char *cluster_id,
+                                      const char *dnode_id, const char *dnode_ep) {
+  const char   *priorities[VNODE_ASYNC_PRIORITIES] = {"high", "normal", "low"};
+  taos_gauge_t **metric = NULL;
+
+  for (int32_t i = 0; i < VNODE_ASYNC_PRIORITIES; i++) {
+    const char *sample_labels[] = {cluster_id, dnode_id, dnode_ep, pool, priorities[i]};
+
+    metric = taosHashGet(tsMonitor.metrics, VNODE_ASYNC_TASKS, strlen(VNODE_ASYNC_TASKS));
+    taos_gauge_set(*metric, pStat->numOfTasks[i], sample_labels);
+
+    metric = taosHashGet(tsMonitor.metrics, VNODE_ASYNC_WAIT_TIME, strlen(VNODE_ASYNC_WAIT_TIME));
+    taos_gauge_set(*metric, pStat->waitTime[i], sample_labels);
+
+    metric = taosHashGet(tsMonitor.metrics, VNODE_ASYNC_RUN_TIME, strlen(VNODE_ASYNC_RUN_TIME));
+    taos_gauge_set(*metric, pStat->runTime[i], sample_labels);
+
+    // cumulative buckets, le is the upper bound in ms
+    int64_t numOfWait = 0;
+    int64_t numOfRun = 0;
+    for (int32_t j = 0; j < VNODE_ASYNC_LATENCY_BUCKETS; j++) {
+      char le[32] = {0};
+      if (j < VNODE_ASYNC_LATENCY_BUCKETS - 1) {
+        snprintf(le, sizeof(le), "%" PRId64, ((int64_t)1) << j);
+      } else {
+        snprintf(le, sizeof(le), "+Inf");
+      }
+      const char *bucket_labels[] = {cluster_id, dnode_id, dnode_ep, pool, priorities[i], le};
+
+      numOfWait += pStat->waitBuckets[i][j];
+      metric = taosHashGet(tsMonitor.metrics, VNODE_ASYNC_WAIT_BUCKET, strlen(VNODE_ASYNC_WAIT_BUCKET));
+      taos_gauge_set(*metric, numOfWait, bucket_labels);
+
+      numOfRun += pStat->runBuckets[i][j];
+      metric = taosHashGet(tsMonitor.metrics, VNODE_ASYNC_RUN_BUCKET, strlen(VNODE_ASYNC_RUN_BUCKET));
+      taos_gauge_set(*metric, numOfRun, bucket_labels);
+    }
+  }
+}
+
+void monGenVnodeAsyncTable(SMonInfo *pMonitor) {
+  char *vnodes_async_gauges[] = {VNODE_ASYNC_TASKS, VNODE_ASYNC_WAIT_TIME, VNODE_ASYNC_RUN_TIME,
+                                 VNODE_ASYNC_WAIT_BUCKET, VNODE_ASYNC_RUN_BUCKET};
+  taos_gauge_t *gauge = NULL;
+
+  for (int32_t i = 0; i < 5; i++) {
+    if (taos_collector_registry_deregister_metric(vnodes_async_gauges[i]) != 0) {
+      uError("failed to delete metric %s", vnodes_async_gauges[i]);
+    }
+
+    taosHashRemove(tsMonitor.metrics, vnodes_async_gauges[i], strlen(vnodes_async_gauges[i]));
+  }
+
+  if (pMonitor->dmInfo.basic.cluster_id == 0) return;
+  if (pMonitor->vmInfo.vstat.totalVnodes == 0) return;
+
+  int32_t     vnodes_async_label_count = 5;
+  const char *vnodes_async_sample_labels[] = {"cluster_id", "dnode_id", "dnode_ep", "pool", "priority", "le"};
+  for (int32_t i = 0; i < 5; i++) {
+    int32_t label_count = (i < 3) ? vnodes_async_label_count : vnodes_async_label_count + 1;
+    gauge = taos_gauge_new(vnodes_async_gauges[i], "", label_count, vnodes_async_sample_labels);
+    if (taos_collector_registry_register_metric(gauge) == 1) {
+      taos_counter_destroy(gauge);
+    }
+    taosHashPut(tsMonitor.metrics, vnodes_async_gauges[i], strlen(vnodes_async_gauges[i]), &gauge,
+                sizeof(taos_gauge_t *));
+  }
+
+  char cluster_id[TSDB_CLUSTER_ID_LEN] = {0};
+  snprintf(cluster_id, TSDB_CLUSTER_ID_LEN, "%" PRId64, pMonitor->dmInfo.basic.cluster_id);
+
+  char dnode_id[TSDB_NODE_ID_LEN] = {0};
+  snprintf(dnode_id, TSDB_NODE_ID_LEN, "%" PRId32, pMonitor->dmInfo.basic.dnode_id);
+
+  SVnodesStat *pStat = &pMonitor->vmInfo.vstat;
+  monGenVnodeAsyncPoolTable("commit", &pStat->commitStat, cluster_id, dnode_id, pMonitor->dmInfo.basic.dnode_ep);
+  monGenVnodeAsyncPoolTable("merge", &pStat->mergeStat, cluster_id, dnode_id, pMonitor->dmInfo.basic.dnode_ep);
+}
+
+void monGenVnodeQueueTable(SMonInfo *pMonitor) {
+  char *vnodes_queue_gauges[] = {VNODE_QUEUE_MEMORY, VNODE_QUEUE_MEMORY_PEAK, VNODE_QUEUE_REJECTS};
+  taos_gauge_t *gauge = NULL;
+
+  for (int32_t i = 0; i < 3; i++) {
+    if (taos_collector_registry_deregister_metric(vnodes_queue_gauges[i]) != 0) {
+      uError("failed to delete metric %s", vnodes_queue_gauges[i]);
+    }
+
+    taosHashRemove(tsMonitor.metrics, vnodes_queue_gauges[i], strlen(vnodes_queue_gauges[i]));
+  }
+
+  if (pMonitor->dmInfo.basic.cluster_id == 0) return;
+  if (pMonitor->vmInfo.vstat.totalVnodes == 0) return;
+
+  int32_t     vnodes_queue_label_count = 4;
+  const char *vnodes_queue_sample_labels[] = {"cluster_id", "dnode_id", "dnode_ep", "queue"};
+  for (int32_t i = 0; i < 3; i++) {
+    gauge = taos_gauge_new(vnodes_queue_gauges[i], "", vnodes_queue_label_count, vnodes_queue_sample_labels);
+    if (taos_collector_registry_register_metric(gauge) == 1) {
+      taos_counter_destroy(gauge);
+    }
+    taosHashPut(tsMonitor.metrics, vnodes_queue_gauges[i], strlen(vnodes_queue_gauges[i]), &gauge,
+                sizeof(taos_gauge_t *));
+  }
+
+  char cluster_id[TSDB_CLUSTER_ID_LEN] = {0};
+  snprintf(cluster_id, TSDB_CLUSTER_ID_LEN, "%" PRId64, pMonitor->dmInfo.basic.cluster_id);
+
+  char dnode_id[TSDB_NODE_ID_LEN] = {0};
+  snprintf(dnode_id, TSDB_NODE_ID_LEN, "%" PRId32, pMonitor->dmInfo.basic.dnode_id);
+
+  const char    *queues[VNODE_QUEUE_TYPES] = {"write", "sync", "sync-rd", "apply", "query", "fetch", "stream"};
+  taos_gauge_t **metric = NULL;
+
+  for (int32_t i = 0; i < VNODE_QUEUE_TYPES; i++) {
+    SVQueueStat *pStat = &pMonitor->vmInfo.vstat.queueStat[i];
+    const char  *sample_labels[] = {cluster_id, dnode_id, pMonitor->dmInfo.basic.dnode_ep, queues[i]};
+
+    metric = taosHashGet(tsMonitor.metrics, VNODE_QUEUE_MEMORY, strlen(VNODE_QUEUE_MEMORY));
+    taos_gauge_set(*metric, pStat->memory, sample_labels);
+
+    metric = taosHashGet(tsMonitor.metrics, VNODE_QUEUE_MEMORY_PEAK, strlen(VNODE_QUEUE_MEMORY_PEAK));
+    taos_gauge_set(*metric, pStat->memoryPeak, sample_labels);
+
+    metric = taosHashGet(tsMonitor.metrics, VNODE_QUEUE_REJECTS, strlen(VNODE_QUEUE_REJECTS));
+    taos_gauge_set(*metric, pStat->rejects, sample_labels);
+  }
+}
+
 void monSendPromReport() {
   char ts[50] = {0};
   sprintf(ts, "%" PRId64, taosGetTimestamp(TSDB_TIME_PRECISION_MILLI));
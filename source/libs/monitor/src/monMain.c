@@ -592,6 +592,8 @@ void monGenAndSendReport() {
     monGenLogDiskTable(pMonitor);
     monGenMnodeRoleTable(pMonitor);
     monGenVnodeRoleTable(pMonitor);
+    monGenVnodeAsyncTable(pMonitor);
+    monGenVnodeQueueTable(pMonitor);
 
     monSendPromReport();
   }
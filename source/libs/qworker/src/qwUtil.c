@@ -535,6 +535,7 @@ void qwCloseRef(void) {
   if (atomic_load_32(&gQwMgmt.qwNum) <= 0 && gQwMgmt.qwRef >= 0) {
     taosCloseRef(gQwMgmt.qwRef);
     gQwMgmt.qwRef = -1;
+    qCleanupExecWorkers();
   }
   taosWUnLockLatch(&gQwMgmt.lock);
 }
@@ -601,6 +602,9 @@ int32_t qwOpenRef(void) {
       qError("init qworker ref failed");
       QW_RET(TSDB_CODE_OUT_OF_MEMORY);
     }
+    if (qInitExecWorkers() != TSDB_CODE_SUCCESS) {
+      qWarn("init query exec workers failed, error:%s, run the jobs in query threads", tstrerror(terrno));
+    }
   }
   taosWUnLockLatch(&gQwMgmt.lock);
 
@@ -1145,6 +1145,188 @@ static void doReleaseVec(SColumnInfoData *pCol, int32_t type) {
   }
 }
 
+// Type-specialized kernels of the arithmetic on fixed-width numeric params. The values are loaded from the typed
+// arrays and converted to double inline, so the results are the same as the per-row conversion by
+// getVectorDoubleValueFn, and the output stays DOUBLE which is the result type of the operators.
+#define VECTOR_MATH_LOOP(_num, _out, _expr) \
+  for (int32_t i = 0; i < (_num); ++i) {    \
+    (_out)[i] = (_expr);                    \
+  }
+
+#define DEFINE_VECTOR_MATH_KERNEL(_name, _type)                                                                \
+  static void vectorMath##_name##Const(const _type *pData, double val, int32_t optr, double factor,           \
+                                       double *pOut, int32_t num) {                                          \
+    switch (optr) {                                                                                          \
+      case OP_TYPE_ADD:                                                                                      \
+        VECTOR_MATH_LOOP(num, pOut, (double)pData[i] + val);                                                 \
+        break;                                                                                               \
+      case OP_TYPE_SUB:                                                                                      \
+        VECTOR_MATH_LOOP(num, pOut, ((double)pData[i] - val) * factor);                                      \
+        break;                                                                                               \
+      case OP_TYPE_MULTI:                                                                                    \
+        VECTOR_MATH_LOOP(num, pOut, (double)pData[i] * val);                                                 \
+        break;                                                                                               \
+      default:                                                                                               \
+        break;                                                                                               \
+    }                                                                                                        \
+  }                                                                                                          \
+  static void vectorMath##_name##Col(const _type *pLeft, const _type *pRight, int32_t optr, double *pOut,     \
+                                     int32_t num) {                                                          \
+    switch (optr) {                                                                                          \
+      case OP_TYPE_ADD:                                                                                      \
+        VECTOR_MATH_LOOP(num, pOut, (double)pLeft[i] + (double)pRight[i]);                                   \
+        break;                                                                                               \
+      case OP_TYPE_SUB:                                                                                      \
+        VECTOR_MATH_LOOP(num, pOut, (double)pLeft[i] - (double)pRight[i]);                                   \
+        break;                                                                                               \
+      case OP_TYPE_MULTI:                                                                                    \
+        VECTOR_MATH_LOOP(num, pOut, (double)pLeft[i] * (double)pRight[i]);                                   \
+        break;                                                                                               \
+      default:                                                                                               \
+        break;                                                                                               \
+    }                                                                                                        \
+  }
+
+DEFINE_VECTOR_MATH_KERNEL(Int8, int8_t)
+DEFINE_VECTOR_MATH_KERNEL(Int16, int16_t)
+DEFINE_VECTOR_MATH_KERNEL(Int32, int32_t)
+DEFINE_VECTOR_MATH_KERNEL(Int64, int64_t)
+DEFINE_VECTOR_MATH_KERNEL(Uint8, uint8_t)
+DEFINE_VECTOR_MATH_KERNEL(Uint16, uint16_t)
+DEFINE_VECTOR_MATH_KERNEL(Uint32, uint32_t)
+DEFINE_VECTOR_MATH_KERNEL(Uint64, uint64_t)
+DEFINE_VECTOR_MATH_KERNEL(Float, float)
+DEFINE_VECTOR_MATH_KERNEL(Double, double)
+
+#define VECTOR_MATH_CONST_CASE(_t, _name, _type)                                                 \
+  case _t:                                                                                       \
+    vectorMath##_name##Const((const _type *)pCol->pData, val, optr, factor, output, numOfRows); \
+    break;
+
+#define VECTOR_MATH_COL_CASE(_t, _name, _type)                                                                    \
+  case _t:                                                                                                        \
+    vectorMath##_name##Col((const _type *)pLeftCol->pData, (const _type *)pRightCol->pData, optr, output,         \
+                           numOfRows);                                                                            \
+    break;
+
+static void vectorMathColConst(SColumnInfoData *pCol, SColumnInfoData *pConst, double *output, int32_t numOfRows,
+                               int32_t optr, double factor) {
+  double val = getVectorDoubleValueFn(pConst->info.type)(pConst->pData, 0);
+  switch (pCol->info.type) {
+    VECTOR_MATH_CONST_CASE(TSDB_DATA_TYPE_TINYINT, Int8, int8_t)
+    VECTOR_MATH_CONST_CASE(TSDB_DATA_TYPE_SMALLINT, Int16, int16_t)
+    VECTOR_MATH_CONST_CASE(TSDB_DATA_TYPE_INT, Int32, int32_t)
+    VECTOR_MATH_CONST_CASE(TSDB_DATA_TYPE_BIGINT, Int64, int64_t)
+    VECTOR_MATH_CONST_CASE(TSDB_DATA_TYPE_UTINYINT, Uint8, uint8_t)
+    VECTOR_MATH_CONST_CASE(TSDB_DATA_TYPE_USMALLINT, Uint16, uint16_t)
+    VECTOR_MATH_CONST_CASE(TSDB_DATA_TYPE_UINT, Uint32, uint32_t)
+    VECTOR_MATH_CONST_CASE(TSDB_DATA_TYPE_UBIGINT, Uint64, uint64_t)
+    VECTOR_MATH_CONST_CASE(TSDB_DATA_TYPE_FLOAT, Float, float)
+    VECTOR_MATH_CONST_CASE(TSDB_DATA_TYPE_DOUBLE, Double, double)
+    default:
+      break;
+  }
+}
+
+static void vectorMathColCol(SColumnInfoData *pLeftCol, SColumnInfoData *pRightCol, double *output, int32_t numOfRows,
+                             int32_t optr) {
+  switch (pLeftCol->info.type) {
+    VECTOR_MATH_COL_CASE(TSDB_DATA_TYPE_TINYINT, Int8, int8_t)
+    VECTOR_MATH_COL_CASE(TSDB_DATA_TYPE_SMALLINT, Int16, int16_t)
+    VECTOR_MATH_COL_CASE(TSDB_DATA_TYPE_INT, Int32, int32_t)
+    VECTOR_MATH_COL_CASE(TSDB_DATA_TYPE_BIGINT, Int64, int64_t)
+    VECTOR_MATH_COL_CASE(TSDB_DATA_TYPE_UTINYINT, Uint8, uint8_t)
+    VECTOR_MATH_COL_CASE(TSDB_DATA_TYPE_USMALLINT, Uint16, uint16_t)
+    VECTOR_MATH_COL_CASE(TSDB_DATA_TYPE_UINT, Uint32, uint32_t)
+    VECTOR_MATH_COL_CASE(TSDB_DATA_TYPE_UBIGINT, Uint64, uint64_t)
+    VECTOR_MATH_COL_CASE(TSDB_DATA_TYPE_FLOAT, Float, float)
+    VECTOR_MATH_COL_CASE(TSDB_DATA_TYPE_DOUBLE, Double, double)
+    default:
+      break;
+  }
+}
+
+// copy the null rows of the input column to the output, 64 rows a time, and the word without null is skipped
+static void vectorMathSetNullRows(SColumnInfoData *pCol, SColumnInfoData *pOutputCol, int32_t numOfRows) {
+  const char *pBits = pCol->nullbitmap;
+  double     *output = (double *)pOutputCol->pData;
+  bool        hasNull = false;
+
+  int32_t i = 0;
+  for (; i + 64 <= numOfRows; i += 64) {
+    uint64_t word = 0;
+    memcpy(&word, pBits + (i >> NBIT), sizeof(word));
+    if (word == 0) {
+      continue;
+    }
+
+    uint64_t outWord = 0;
+    memcpy(&outWord, pOutputCol->nullbitmap + (i >> NBIT), sizeof(outWord));
+    outWord |= word;
+    memcpy(pOutputCol->nullbitmap + (i >> NBIT), &outWord, sizeof(outWord));
+
+    for (int32_t j = 0; j < 64; ++j) {
+      output[i + j] = colDataIsNull_f(pBits, i + j) ? 0 : output[i + j];
+    }
+    hasNull = true;
+  }
+
+  for (; i < numOfRows; ++i) {
+    if (colDataIsNull_f(pBits, i)) {
+      colDataSetNull_f(pOutputCol->nullbitmap, i);
+      output[i] = 0;
+      hasNull = true;
+    }
+  }
+
+  if (hasNull) {
+    pOutputCol->hasNull = true;
+  }
+}
+
+// Add, subtract or multiply the numeric params with the typed kernels, return false if no kernel is applicable.
+static bool vectorMathByKernel(SScalarParam *pLeft, SScalarParam *pRight, SColumnInfoData *pOutputCol, int32_t _ord,
+                               int32_t optr) {
+  SColumnInfoData *pLeftCol = pLeft->columnData;
+  SColumnInfoData *pRightCol = pRight->columnData;
+
+  if (_ord != TSDB_ORDER_ASC || pOutputCol->info.type != TSDB_DATA_TYPE_DOUBLE ||
+      !IS_NUMERIC_TYPE(GET_PARAM_TYPE(pLeft)) || !IS_NUMERIC_TYPE(GET_PARAM_TYPE(pRight))) {
+    return false;
+  }
+
+  double *output = (double *)pOutputCol->pData;
+  if (pLeft->numOfRows == pRight->numOfRows && pLeft->numOfRows > 1) {
+    if (pLeftCol->info.type != pRightCol->info.type) {
+      return false;
+    }
+    vectorMathColCol(pLeftCol, pRightCol, output, pLeft->numOfRows, optr);
+  } else if (pRight->numOfRows == 1) {
+    if (IS_HELPER_NULL(pRightCol, 0)) {
+      return false;
+    }
+    vectorMathColConst(pLeftCol, pRightCol, output, pLeft->numOfRows, optr, 1);
+    pRightCol = NULL;
+  } else if (pLeft->numOfRows == 1) {
+    if (IS_HELPER_NULL(pLeftCol, 0)) {
+      return false;
+    }
+    vectorMathColConst(pRightCol, pLeftCol, output, pRight->numOfRows, optr, -1);
+    pLeftCol = NULL;
+  } else {
+    return false;
+  }
+
+  int32_t numOfRows = TMAX(pLeft->numOfRows, pRight->numOfRows);
+  if (pLeftCol != NULL && pLeftCol->hasNull) {
+    vectorMathSetNullRows(pLeftCol, pOutputCol, numOfRows);
+  }
+  if (pRightCol != NULL && pRightCol->hasNull) {
+    vectorMathSetNullRows(pRightCol, pOutputCol, numOfRows);
+  }
+  return true;
+}
+
 void vectorMathAdd(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut, int32_t _ord) {
   SColumnInfoData *pOutputCol = pOut->columnData;
 
@@ -1185,6 +1367,8 @@ void vectorMathAdd(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut
         *output = getVectorBigintValueFnLeft(pLeftCol->pData, i) + getVectorBigintValueFnRight(pRightCol->pData, i);
       }
     }
+  } else if (vectorMathByKernel(pLeft, pRight, pOutputCol, _ord, OP_TYPE_ADD)) {
+    // done by the typed kernels
   } else {
     double              *output = (double *)pOutputCol->pData;
     _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
@@ -1286,6 +1470,8 @@ void vectorMathSub(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut
         *output = getVectorBigintValueFnLeft(pLeftCol->pData, i) - getVectorBigintValueFnRight(pRightCol->pData, i);
       }
     }
+  } else if (vectorMathByKernel(pLeft, pRight, pOutputCol, _ord, OP_TYPE_SUB)) {
+    // done by the typed kernels
   } else {
     double              *output = (double *)pOutputCol->pData;
     _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
@@ -1346,7 +1532,9 @@ void vectorMathMultiply(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam
   _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
 
   double *output = (double *)pOutputCol->pData;
-  if (pLeft->numOfRows == pRight->numOfRows) {
+  if (vectorMathByKernel(pLeft, pRight, pOutputCol, _ord, OP_TYPE_MULTI)) {
+    // done by the typed kernels
+  } else if (pLeft->numOfRows == pRight->numOfRows) {
     for (; i < pRight->numOfRows && i >= 0; i += step, output += 1) {
       if (IS_NULL) {
         colDataSetNULL(pOutputCol, i);
@@ -1646,12 +1834,328 @@ void vectorBitOr(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut,
   doReleaseVec(pRightCol, rightConvert);
 }
 
+// Type-specialized kernels of the comparisons between fixed-width numeric columns. They run over the raw column data
+// without the per-row compare function call, and produce exactly the same result as the compare functions in
+// tcompare.c, i.e. integers are compared after widening, and floats with the tolerance of FLT_EQUAL.
+#define VECTOR_COMPARE_LOOP(_num, _res, _expr) \
+  for (int32_t i = 0; i < (_num); ++i) {       \
+    (_res)[i] = (_expr);                       \
+  }
+
+#define VECTOR_COMPARE_OPTR(_optr, _num, _res, _l, _r)             \
+  switch (_optr) {                                                  \
+    case OP_TYPE_GREATER_THAN:                                      \
+      VECTOR_COMPARE_LOOP(_num, _res, (_l) > (_r));                 \
+      break;                                                        \
+    case OP_TYPE_GREATER_EQUAL:                                     \
+      VECTOR_COMPARE_LOOP(_num, _res, (_l) >= (_r));                \
+      break;                                                        \
+    case OP_TYPE_LOWER_THAN:                                        \
+      VECTOR_COMPARE_LOOP(_num, _res, (_l) < (_r));                 \
+      break;                                                        \
+    case OP_TYPE_LOWER_EQUAL:                                       \
+      VECTOR_COMPARE_LOOP(_num, _res, (_l) <= (_r));                \
+      break;                                                        \
+    case OP_TYPE_EQUAL:                                             \
+      VECTOR_COMPARE_LOOP(_num, _res, (_l) == (_r));                \
+      break;                                                        \
+    case OP_TYPE_NOT_EQUAL:                                         \
+      VECTOR_COMPARE_LOOP(_num, _res, (_l) != (_r));                \
+      break;                                                        \
+    default:                                                        \
+      break;                                                        \
+  }
+
+// the NaN is lower than any other value, which is the same as compareFloatVal/compareDoubleVal
+#define VECTOR_COMPARE_FLOAT_OPTR(_optr, _num, _res, _l, _r)                              \
+  switch (_optr) {                                                                         \
+    case OP_TYPE_GREATER_THAN:                                                             \
+      VECTOR_COMPARE_LOOP(_num, _res, ((_l) > (_r)) & !FLT_EQUAL(_l, _r));                 \
+      break;                                                                               \
+    case OP_TYPE_GREATER_EQUAL:                                                            \
+      VECTOR_COMPARE_LOOP(_num, _res, ((_l) > (_r)) | FLT_EQUAL(_l, _r));                  \
+      break;                                                                               \
+    case OP_TYPE_LOWER_THAN:                                                               \
+      VECTOR_COMPARE_LOOP(_num, _res, !((_l) > (_r)) & !FLT_EQUAL(_l, _r));                \
+      break;                                                                               \
+    case OP_TYPE_LOWER_EQUAL:                                                              \
+      VECTOR_COMPARE_LOOP(_num, _res, !((_l) > (_r)) | FLT_EQUAL(_l, _r));                 \
+      break;                                                                               \
+    case OP_TYPE_EQUAL:                                                                    \
+      VECTOR_COMPARE_LOOP(_num, _res, FLT_EQUAL(_l, _r));                                  \
+      break;                                                                               \
+    case OP_TYPE_NOT_EQUAL:                                                                \
+      VECTOR_COMPARE_LOOP(_num, _res, !FLT_EQUAL(_l, _r));                                 \
+      break;                                                                               \
+    default:                                                                               \
+      break;                                                                               \
+  }
+
+#define DEFINE_VECTOR_COMPARE_KERNEL(_name, _type, _ctype)                                                      \
+  static void vectorCompare##_name##Const(const _type *pData, _ctype val, int32_t optr, bool *pRes, int32_t num) { \
+    VECTOR_COMPARE_OPTR(optr, num, pRes, (_ctype)pData[i], val);                                                \
+  }                                                                                                             \
+  static void vectorCompare##_name##Col(const _type *pLeft, const _type *pRight, int32_t optr, bool *pRes,      \
+                                        int32_t num) {                                                          \
+    VECTOR_COMPARE_OPTR(optr, num, pRes, pLeft[i], pRight[i]);                                                  \
+  }
+
+DEFINE_VECTOR_COMPARE_KERNEL(Int8, int8_t, int64_t)
+DEFINE_VECTOR_COMPARE_KERNEL(Int16, int16_t, int64_t)
+DEFINE_VECTOR_COMPARE_KERNEL(Int32, int32_t, int64_t)
+DEFINE_VECTOR_COMPARE_KERNEL(Int64, int64_t, int64_t)
+DEFINE_VECTOR_COMPARE_KERNEL(Uint8, uint8_t, uint64_t)
+DEFINE_VECTOR_COMPARE_KERNEL(Uint16, uint16_t, uint64_t)
+DEFINE_VECTOR_COMPARE_KERNEL(Uint32, uint32_t, uint64_t)
+DEFINE_VECTOR_COMPARE_KERNEL(Uint64, uint64_t, uint64_t)
+
+static void vectorCompareFloatConst(const float *pData, float val, int32_t optr, bool *pRes, int32_t num) {
+  VECTOR_COMPARE_FLOAT_OPTR(optr, num, pRes, pData[i], val);
+}
+
+static void vectorCompareDoubleConst(const double *pData, double val, int32_t optr, bool *pRes, int32_t num) {
+  VECTOR_COMPARE_FLOAT_OPTR(optr, num, pRes, pData[i], val);
+}
+
+static int32_t vectorReverseCompareOptr(int32_t optr) {
+  switch (optr) {
+    case OP_TYPE_GREATER_THAN:
+      return OP_TYPE_LOWER_THAN;
+    case OP_TYPE_GREATER_EQUAL:
+      return OP_TYPE_LOWER_EQUAL;
+    case OP_TYPE_LOWER_THAN:
+      return OP_TYPE_GREATER_THAN;
+    case OP_TYPE_LOWER_EQUAL:
+      return OP_TYPE_GREATER_EQUAL;
+    default:
+      return optr;
+  }
+}
+
+static bool vectorCompareColConst(SColumnInfoData *pCol, SColumnInfoData *pConst, int32_t optr, bool *pRes,
+                                  int32_t start, int32_t num) {
+  int32_t type = pCol->info.type;
+  int32_t cType = pConst->info.type;
+  char   *pData = pCol->pData;
+  char   *pVal = pConst->pData;
+
+  if (type == TSDB_DATA_TYPE_FLOAT || type == TSDB_DATA_TYPE_DOUBLE) {
+    // the NaN constant and the mixed float types are left to the compare functions
+    if (type != cType) {
+      return false;
+    }
+    if (type == TSDB_DATA_TYPE_FLOAT) {
+      float val = GET_FLOAT_VAL(pVal);
+      if (isnan(val)) return false;
+      vectorCompareFloatConst((float *)pData + start, val, optr, pRes + start, num);
+    } else {
+      double val = GET_DOUBLE_VAL(pVal);
+      if (isnan(val)) return false;
+      vectorCompareDoubleConst((double *)pData + start, val, optr, pRes + start, num);
+    }
+    return true;
+  }
+
+  bool signedCol = IS_SIGNED_NUMERIC_TYPE(type) || type == TSDB_DATA_TYPE_TIMESTAMP;
+  if (signedCol) {
+    int64_t val = 0;
+    if (IS_SIGNED_NUMERIC_TYPE(cType) || cType == TSDB_DATA_TYPE_TIMESTAMP) {
+      GET_TYPED_DATA(val, int64_t, cType, pVal);
+    } else if (IS_UNSIGNED_NUMERIC_TYPE(cType)) {
+      uint64_t uval = 0;
+      GET_TYPED_DATA(uval, uint64_t, cType, pVal);
+      if (uval > INT64_MAX) return false;
+      val = (int64_t)uval;
+    } else {
+      return false;
+    }
+
+    switch (type) {
+      case TSDB_DATA_TYPE_TINYINT:
+        vectorCompareInt8Const((int8_t *)pData + start, val, optr, pRes + start, num);
+        break;
+      case TSDB_DATA_TYPE_SMALLINT:
+        vectorCompareInt16Const((int16_t *)pData + start, val, optr, pRes + start, num);
+        break;
+      case TSDB_DATA_TYPE_INT:
+        vectorCompareInt32Const((int32_t *)pData + start, val, optr, pRes + start, num);
+        break;
+      default:
+        vectorCompareInt64Const((int64_t *)pData + start, val, optr, pRes + start, num);
+        break;
+    }
+    return true;
+  }
+
+  if (IS_UNSIGNED_NUMERIC_TYPE(type)) {
+    uint64_t val = 0;
+    if (IS_UNSIGNED_NUMERIC_TYPE(cType)) {
+      GET_TYPED_DATA(val, uint64_t, cType, pVal);
+    } else if (IS_SIGNED_NUMERIC_TYPE(cType) || cType == TSDB_DATA_TYPE_TIMESTAMP) {
+      int64_t sval = 0;
+      GET_TYPED_DATA(sval, int64_t, cType, pVal);
+      if (sval < 0) return false;
+      val = (uint64_t)sval;
+    } else {
+      return false;
+    }
+
+    switch (type) {
+      case TSDB_DATA_TYPE_UTINYINT:
+        vectorCompareUint8Const((uint8_t *)pData + start, val, optr, pRes + start, num);
+        break;
+      case TSDB_DATA_TYPE_USMALLINT:
+        vectorCompareUint16Const((uint16_t *)pData + start, val, optr, pRes + start, num);
+        break;
+      case TSDB_DATA_TYPE_UINT:
+        vectorCompareUint32Const((uint32_t *)pData + start, val, optr, pRes + start, num);
+        break;
+      default:
+        vectorCompareUint64Const((uint64_t *)pData + start, val, optr, pRes + start, num);
+        break;
+    }
+    return true;
+  }
+
+  return false;
+}
+
+static bool vectorCompareColCol(SColumnInfoData *pLeftCol, SColumnInfoData *pRightCol, int32_t optr, bool *pRes,
+                                int32_t start, int32_t num) {
+  // only the integer columns of the same type, the float columns may hold NaN on both sides
+  if (pLeftCol->info.type != pRightCol->info.type) {
+    return false;
+  }
+
+  char *pl = pLeftCol->pData;
+  char *pr = pRightCol->pData;
+  switch (pLeftCol->info.type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      vectorCompareInt8Col((int8_t *)pl + start, (int8_t *)pr + start, optr, pRes + start, num);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      vectorCompareInt16Col((int16_t *)pl + start, (int16_t *)pr + start, optr, pRes + start, num);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      vectorCompareInt32Col((int32_t *)pl + start, (int32_t *)pr + start, optr, pRes + start, num);
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      vectorCompareInt64Col((int64_t *)pl + start, (int64_t *)pr + start, optr, pRes + start, num);
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      vectorCompareUint8Col((uint8_t *)pl + start, (uint8_t *)pr + start, optr, pRes + start, num);
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      vectorCompareUint16Col((uint16_t *)pl + start, (uint16_t *)pr + start, optr, pRes + start, num);
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      vectorCompareUint32Col((uint32_t *)pl + start, (uint32_t *)pr + start, optr, pRes + start, num);
+      break;
+    case TSDB_DATA_TYPE_UBIGINT:
+      vectorCompareUint64Col((uint64_t *)pl + start, (uint64_t *)pr + start, optr, pRes + start, num);
+      break;
+    default:
+      return false;
+  }
+  return true;
+}
+
+// clear the result of null rows, 64 rows a time, and the word of the bitmap without null is skipped
+static void vectorClearNullRows(const char *nullbitmap, bool *pRes, int32_t start, int32_t end) {
+  int32_t i = start;
+  for (; i < end && BitPos(i) != 0; ++i) {
+    pRes[i] &= !colDataIsNull_f(nullbitmap, i);
+  }
+
+  for (; i + 64 <= end; i += 64) {
+    uint64_t word = 0;
+    memcpy(&word, nullbitmap + (i >> NBIT), sizeof(word));
+    if (word == 0) {
+      continue;
+    }
+
+    const uint8_t *pBits = (const uint8_t *)nullbitmap + (i >> NBIT);
+    bool          *pDst = pRes + i;
+    for (int32_t j = 0; j < 64; ++j) {
+      pDst[j] &= !((pBits[j >> NBIT] >> (7 - BitPos(j))) & 1);
+    }
+  }
+
+  for (; i < end; ++i) {
+    pRes[i] &= !colDataIsNull_f(nullbitmap, i);
+  }
+}
+
+// Compare the rows in [start, end) with the type-specialized kernels, return -1 if no kernel is applicable.
+static int32_t vectorCompareByKernel(SScalarParam *pLeft, SScalarParam *pRight, bool *pRes, int32_t start,
+                                     int32_t end, int32_t optr) {
+  if (optr < OP_TYPE_GREATER_THAN || optr > OP_TYPE_NOT_EQUAL || start >= end) {
+    return -1;
+  }
+
+  SColumnInfoData *pLeftCol = pLeft->columnData;
+  SColumnInfoData *pRightCol = pRight->columnData;
+
+  // a param with less rows than the range is a constant, i.e. its first row is compared with all rows
+  bool leftConst = pLeft->numOfRows < end;
+  bool rightConst = pRight->numOfRows < end;
+  if ((leftConst && pLeft->numOfRows != 1) || (rightConst && pRight->numOfRows != 1) || (leftConst && rightConst)) {
+    return -1;
+  }
+
+  if (leftConst && pLeftCol->hasNull && colDataIsNull_f(pLeftCol->nullbitmap, 0)) {
+    memset(pRes + start, 0, end - start);
+    return 0;
+  }
+  if (rightConst && pRightCol->hasNull && colDataIsNull_f(pRightCol->nullbitmap, 0)) {
+    memset(pRes + start, 0, end - start);
+    return 0;
+  }
+
+  bool done = false;
+  if (rightConst) {
+    done = vectorCompareColConst(pLeftCol, pRightCol, optr, pRes, start, end - start);
+  } else if (leftConst) {
+    done = vectorCompareColConst(pRightCol, pLeftCol, vectorReverseCompareOptr(optr), pRes, start, end - start);
+  } else {
+    done = vectorCompareColCol(pLeftCol, pRightCol, optr, pRes, start, end - start);
+  }
+  if (!done) {
+    return -1;
+  }
+
+  if (!leftConst && pLeftCol->hasNull) {
+    vectorClearNullRows(pLeftCol->nullbitmap, pRes, start, end);
+  }
+  if (!rightConst && pRightCol->hasNull) {
+    vectorClearNullRows(pRightCol->nullbitmap, pRes, start, end);
+  }
+
+  int32_t num = 0;
+  for (int32_t i = start; i < end; ++i) {
+    num += pRes[i];
+  }
+  return num;
+}
+
 int32_t doVectorCompareImpl(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut, int32_t startIndex,
                             int32_t numOfRows, int32_t step, __compar_fn_t fp, int32_t optr) {
   int32_t num = 0;
   bool   *pRes = (bool *)pOut->columnData->pData;
 
   if (IS_MATHABLE_TYPE(GET_PARAM_TYPE(pLeft)) && IS_MATHABLE_TYPE(GET_PARAM_TYPE(pRight))) {
+    // the result of a row does not depend on the order, so the rows are compared in ascending order by the kernels
+    int32_t start = (step > 0) ? startIndex : 0;
+    int32_t end = (step > 0) ? numOfRows : ((startIndex < numOfRows) ? startIndex + 1 : 0);
+    if (start >= 0 && start < end) {
+      num = vectorCompareByKernel(pLeft, pRight, pRes, start, end, optr);
+      if (num >= 0) {
+        return num;
+      }
+      num = 0;
+    }
+
     if (!(pLeft->columnData->hasNull || pRight->columnData->hasNull)) {
       for (int32_t i = startIndex; i < numOfRows && i >= 0; i += step) {
         int32_t leftIndex = (i >= pLeft->numOfRows) ? 0 : i;
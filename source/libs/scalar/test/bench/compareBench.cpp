@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Rows per second of the column-vs-constant comparisons, by the compare function per row and by the typed kernels, e.g.
+//   compareBench [numOfRows] [loops]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "os.h"
+
+#include "filterInt.h"
+#include "sclInt.h"
+#include "tdatablock.h"
+#include "ttypes.h"
+
+typedef struct {
+  int8_t type;
+  int8_t valType;
+} SBenchType;
+
+static SBenchType benchTypes[] = {
+    {TSDB_DATA_TYPE_TINYINT, TSDB_DATA_TYPE_BIGINT}, {TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT},
+    {TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_BIGINT},  {TSDB_DATA_TYPE_UINT, TSDB_DATA_TYPE_BIGINT},
+    {TSDB_DATA_TYPE_DOUBLE, TSDB_DATA_TYPE_DOUBLE},
+};
+
+static int32_t benchOptrs[] = {OP_TYPE_GREATER_THAN, OP_TYPE_EQUAL, OP_TYPE_LOWER_EQUAL};
+
+static void genBenchColumn(SColumnInfoData *pCol, int32_t num, int32_t nullPercent) {
+  uint32_t seed = 100;
+  for (int32_t i = 0; i < num; ++i) {
+    int64_t v = taosRandR(&seed) % 100;
+    if (IS_FLOAT_TYPE(pCol->info.type)) {
+      double d = v;
+      colDataSetVal(pCol, i, (const char *)&d, false);
+    } else {
+      colDataSetVal(pCol, i, (const char *)&v, false);
+    }
+    if (taosRandR(&seed) % 100 < nullPercent) {
+      colDataSetNULL(pCol, i);
+    }
+  }
+}
+
+// the compare function is called for every row, which is what doVectorCompareImpl did for all numeric types
+static int32_t benchComparePerRow(SScalarParam *pLeft, SScalarParam *pRight, bool *pRes, int32_t optr) {
+  __compar_fn_t fp = filterGetCompFuncEx(GET_PARAM_TYPE(pLeft), GET_PARAM_TYPE(pRight), optr);
+  if (GET_PARAM_TYPE(pLeft) == GET_PARAM_TYPE(pRight)) {
+    fp = filterGetCompFunc(GET_PARAM_TYPE(pLeft), optr);
+  }
+
+  int32_t num = 0;
+  char   *pRightData = colDataGetData(pRight->columnData, 0);
+  for (int32_t i = 0; i < pLeft->numOfRows; ++i) {
+    if (colDataIsNull_f(pLeft->columnData->nullbitmap, i)) {
+      pRes[i] = false;
+      continue;
+    }
+    pRes[i] = filterDoCompare(fp, optr, colDataGetData(pLeft->columnData, i), pRightData);
+    num += pRes[i];
+  }
+  return num;
+}
+
+int main(int argc, char *argv[]) {
+  int32_t num = (argc > 1) ? atoi(argv[1]) : 4096;
+  int32_t loops = (argc > 2) ? atoi(argv[2]) : 20000;
+
+  SColumnInfoData res = createColumnInfoData(TSDB_DATA_TYPE_BOOL, sizeof(bool), 0);
+  (void)colInfoDataEnsureCapacity(&res, num, true);
+  bool *pExpect = (bool *)taosMemoryMalloc(num);
+
+  printf("%-10s %-4s %6s %-8s %12s %12s\n", "type", "optr", "null%", "path", "elapsed(us)", "Mrows/s");
+  for (int32_t t = 0; t < sizeof(benchTypes) / sizeof(benchTypes[0]); ++t) {
+    SBenchType *pType = &benchTypes[t];
+    for (int32_t nullPercent = 0; nullPercent <= 10; nullPercent += 10) {
+      SColumnInfoData col = createColumnInfoData(pType->type, tDataTypes[pType->type].bytes, 0);
+      SColumnInfoData val = createColumnInfoData(pType->valType, tDataTypes[pType->valType].bytes, 0);
+      (void)colInfoDataEnsureCapacity(&col, num, true);
+      (void)colInfoDataEnsureCapacity(&val, 1, true);
+      genBenchColumn(&col, num, nullPercent);
+      genBenchColumn(&val, 1, 0);
+
+      SScalarParam left = {0}, right = {0}, out = {0};
+      left.columnData = &col;
+      left.numOfRows = num;
+      right.columnData = &val;
+      right.numOfRows = 1;
+      out.columnData = &res;
+      out.numOfRows = num;
+
+      for (int32_t o = 0; o < sizeof(benchOptrs) / sizeof(benchOptrs[0]); ++o) {
+        int32_t optr = benchOptrs[o];
+        int32_t expect = 0;
+
+        int64_t st = taosGetTimestampUs();
+        for (int32_t j = 0; j < loops; ++j) {
+          expect = benchComparePerRow(&left, &right, pExpect, optr);
+        }
+        int64_t el = taosGetTimestampUs() - st;
+        printf("%-10s %-4d %6d %-8s %12" PRId64 " %12.1f\n", tDataTypes[pType->type].name, optr, nullPercent, "per-row",
+               el, (el > 0) ? (double)num * loops / el : 0);
+
+        st = taosGetTimestampUs();
+        for (int32_t j = 0; j < loops; ++j) {
+          out.numOfQualified = 0;
+          doVectorCompare(&left, &right, &out, -1, -1, TSDB_ORDER_ASC, optr);
+        }
+        el = taosGetTimestampUs() - st;
+
+        if (out.numOfQualified != expect || memcmp(pExpect, res.pData, num) != 0) {
+          printf("%-10s %-4d result mismatch\n", tDataTypes[pType->type].name, optr);
+          continue;
+        }
+        printf("%-10s %-4d %6d %-8s %12" PRId64 " %12.1f\n", tDataTypes[pType->type].name, optr, nullPercent, "kernel",
+               el, (el > 0) ? (double)num * loops / el : 0);
+      }
+
+      colDataDestroy(&col);
+      colDataDestroy(&val);
+    }
+  }
+
+  colDataDestroy(&res);
+  taosMemoryFree(pExpect);
+  return 0;
+}
@@ -36,6 +36,8 @@
 #include "nodes.h"
 #include "parUtil.h"
 #include "scalar.h"
+#include "sclInt.h"
+#include "sclvector.h"
 #include "stub.h"
 #include "taos.h"
 #include "tdatablock.h"
@@ -1992,6 +1994,126 @@ TEST(columnTest, greater_and_lower) {
   nodesDestroyNode(logicNode);
 }
 
+TEST(columnTest, typed_compare_with_null) {
+  int32_t rowNum = 200;
+  int32_t types[][2] = {{TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT},
+                        {TSDB_DATA_TYPE_UINT, TSDB_DATA_TYPE_BIGINT},
+                        {TSDB_DATA_TYPE_SMALLINT, TSDB_DATA_TYPE_SMALLINT},
+                        {TSDB_DATA_TYPE_DOUBLE, TSDB_DATA_TYPE_DOUBLE}};
+  int32_t optrs[] = {OP_TYPE_GREATER_THAN, OP_TYPE_GREATER_EQUAL, OP_TYPE_LOWER_THAN,
+                     OP_TYPE_LOWER_EQUAL,  OP_TYPE_EQUAL,         OP_TYPE_NOT_EQUAL};
+
+  for (int32_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t) {
+    SColumnInfoData left = createColumnInfoData(types[t][0], tDataTypes[types[t][0]].bytes, 1);
+    SColumnInfoData right = createColumnInfoData(types[t][1], tDataTypes[types[t][1]].bytes, 2);
+    SColumnInfoData res = createColumnInfoData(TSDB_DATA_TYPE_BOOL, sizeof(bool), 3);
+    ASSERT_EQ(colInfoDataEnsureCapacity(&left, rowNum, true), 0);
+    ASSERT_EQ(colInfoDataEnsureCapacity(&right, rowNum, true), 0);
+    ASSERT_EQ(colInfoDataEnsureCapacity(&res, rowNum, true), 0);
+
+    for (int32_t i = 0; i < rowNum; ++i) {
+      int64_t lv = i % 7 - 3, rv = i % 5 - 2;
+      double  ld = lv / 2.0, rd = rv / 2.0;
+      colDataSetVal(&left, i, IS_FLOAT_TYPE(types[t][0]) ? (const char *)&ld : (const char *)&lv, false);
+      colDataSetVal(&right, i, IS_FLOAT_TYPE(types[t][1]) ? (const char *)&rd : (const char *)&rv, false);
+      if (i % 11 == 0 || (i >= 128 && i < 136)) {
+        colDataSetNULL(&left, i);
+      }
+    }
+
+    __compar_fn_t fp = (types[t][0] == types[t][1]) ? filterGetCompFunc(types[t][0], OP_TYPE_EQUAL)
+                                                    : filterGetCompFuncEx(types[t][0], types[t][1], OP_TYPE_EQUAL);
+    for (int32_t o = 0; o < sizeof(optrs) / sizeof(optrs[0]); ++o) {
+      // column vs constant from the middle of the block, then column vs column
+      for (int32_t rightRows = 1; rightRows <= rowNum; rightRows += rowNum - 1) {
+        SScalarParam pLeft = {0}, pRight = {0}, pOut = {0};
+        pLeft.columnData = &left;
+        pLeft.numOfRows = rowNum;
+        pRight.columnData = &right;
+        pRight.numOfRows = rightRows;
+        pOut.columnData = &res;
+        pOut.numOfRows = rowNum;
+
+        int32_t startIndex = (rightRows == 1) ? 3 : 0;
+        vectorCompareImpl(&pLeft, &pRight, &pOut, startIndex, rowNum - startIndex, TSDB_ORDER_ASC, optrs[o]);
+
+        int32_t num = 0;
+        for (int32_t i = startIndex; i < rowNum; ++i) {
+          int32_t rightIndex = (rightRows == 1) ? 0 : i;
+          bool    expect = !colDataIsNull_s(&left, i) &&
+                        filterDoCompare(fp, optrs[o], colDataGetData(&left, i), colDataGetData(&right, rightIndex));
+          ASSERT_EQ(*(bool *)colDataGetData(&res, i), expect);
+          num += expect;
+        }
+        ASSERT_EQ(pOut.numOfQualified, num);
+      }
+    }
+
+    colDataDestroy(&left);
+    colDataDestroy(&right);
+    colDataDestroy(&res);
+  }
+}
+
+TEST(columnTest, typed_arith_with_null) {
+  int32_t rowNum = 200;
+  int32_t types[] = {TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_UBIGINT, TSDB_DATA_TYPE_FLOAT};
+  int32_t optrs[] = {OP_TYPE_ADD, OP_TYPE_SUB, OP_TYPE_MULTI};
+
+  for (int32_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t) {
+    SColumnInfoData left = createColumnInfoData(types[t], tDataTypes[types[t]].bytes, 1);
+    SColumnInfoData right = createColumnInfoData(types[t], tDataTypes[types[t]].bytes, 2);
+    ASSERT_EQ(colInfoDataEnsureCapacity(&left, rowNum, true), 0);
+    ASSERT_EQ(colInfoDataEnsureCapacity(&right, rowNum, true), 0);
+
+    for (int32_t i = 0; i < rowNum; ++i) {
+      int64_t lv = i * 3 + 1, rv = 7 - i % 5;
+      float   lf = lv / 4.0f, rf = rv / 3.0f;
+      colDataSetVal(&left, i, IS_FLOAT_TYPE(types[t]) ? (const char *)&lf : (const char *)&lv, false);
+      colDataSetVal(&right, i, IS_FLOAT_TYPE(types[t]) ? (const char *)&rf : (const char *)&rv, false);
+      if (i % 13 == 0 || (i >= 64 && i < 72)) {
+        colDataSetNULL(&left, i);
+      }
+      if (i % 17 == 5) {
+        colDataSetNULL(&right, i);
+      }
+    }
+
+    _getDoubleValue_fn_t getValueFn = getVectorDoubleValueFn(types[t]);
+    for (int32_t o = 0; o < sizeof(optrs) / sizeof(optrs[0]); ++o) {
+      // column with column, column with constant and constant with column
+      for (int32_t form = 0; form < 3; ++form) {
+        SScalarParam pLeft = {0}, pRight = {0}, pOut = {0};
+        pLeft.columnData = &left;
+        pLeft.numOfRows = (form == 2) ? 1 : rowNum;
+        pRight.columnData = &right;
+        pRight.numOfRows = (form == 1) ? 1 : rowNum;
+        SDataType outType = {.type = TSDB_DATA_TYPE_DOUBLE, .bytes = sizeof(double)};
+        ASSERT_EQ(sclCreateColumnInfoData(&outType, rowNum, &pOut), 0);
+
+        getBinScalarOperatorFn(optrs[o])(&pLeft, &pRight, &pOut, TSDB_ORDER_ASC);
+        for (int32_t i = 0; i < rowNum; ++i) {
+          int32_t leftIndex = (pLeft.numOfRows == 1) ? 0 : i;
+          int32_t rightIndex = (pRight.numOfRows == 1) ? 0 : i;
+          if (colDataIsNull_s(&left, leftIndex) || colDataIsNull_s(&right, rightIndex)) {
+            ASSERT_TRUE(colDataIsNull_s(pOut.columnData, i));
+            continue;
+          }
+
+          double l = getValueFn(left.pData, leftIndex), r = getValueFn(right.pData, rightIndex);
+          double expect = (optrs[o] == OP_TYPE_ADD) ? l + r : ((optrs[o] == OP_TYPE_SUB) ? l - r : l * r);
+          ASSERT_FALSE(colDataIsNull_s(pOut.columnData, i));
+          ASSERT_EQ(*(double *)colDataGetData(pOut.columnData, i), expect);
+        }
+        sclFreeParam(&pOut);
+      }
+    }
+
+    colDataDestroy(&left);
+    colDataDestroy(&right);
+  }
+}
+
 void scltMakeDataBlock(SScalarParam **pInput, int32_t type, void *pVal, int32_t num, bool setVal) {
   SScalarParam *input = (SScalarParam *)taosMemoryCalloc(1, sizeof(SScalarParam));
   int32_t       bytes;
@@ -542,3 +542,146 @@ int SM4_CBC_Decrypt(unsigned char *pKey,
     *pOutDataLen = inDataLen;
     return 0;
 }
+
+
+/*
+ * Block cipher with a key schedule expanded once, for encrypting many units under the same key.
+ * SM4_T0[x] = L(Sbox[x]), so the round function T(a) of a word a = (a3,a2,a1,a0) is
+ * SM4_T0[a0] ^ ROL(SM4_T0[a1],8) ^ ROL(SM4_T0[a2],16) ^ ROL(SM4_T0[a3],24).
+ */
+static const unsigned int SM4_T0[256]={
+    0xd55b5b8e, 0x924242d0, 0xeaa7a74d, 0xfdfbfb06, 0xcf3333fc, 0xe2878765, 0x3df4f4c9, 0xb5dede6b,
+    0x1658584e, 0xb4dada6e, 0x14505044, 0xc10b0bca, 0x28a0a088, 0xf8efef17, 0x2cb0b09c, 0x05141411,
+    0x2bacac87, 0x669d9dfb, 0x986a6af2, 0x77d9d9ae, 0x2aa8a882, 0xbcfafa46, 0x04101014, 0xc00f0fcf,
+    0xa8aaaa02, 0x45111154, 0x134c4c5f, 0x269898be, 0x4825256d, 0x841a1a9e, 0x0618181e, 0x9b6666fd,
+    0x9e7272ec, 0x4309094a, 0x51414110, 0xf7d3d324, 0x934646d5, 0xecbfbf53, 0x9a6262f8, 0x7be9e992,
+    0x33ccccff, 0x55515104, 0x0b2c2c27, 0x420d0d4f, 0xeeb7b759, 0xcc3f3ff3, 0xaeb2b21c, 0x638989ea,
+    0xe7939374, 0xb1cece7f, 0x1c70706c, 0xaba6a60d, 0xca2727ed, 0x08202028, 0xeba3a348, 0x975656c1,
+    0x82020280, 0xdc7f7fa3, 0x965252c4, 0xf9ebeb12, 0x74d5d5a1, 0x8d3e3eb3, 0x3ffcfcc3, 0xa49a9a3e,
+    0x461d1d5b, 0x071c1c1b, 0xa59e9e3b, 0xfff3f30c, 0xf0cfcf3f, 0x72cdcdbf, 0x175c5c4b, 0xb8eaea52,
+    0x810e0e8f, 0x5865653d, 0x3cf0f0cc, 0x1964647d, 0xe59b9b7e, 0x87161691, 0x4e3d3d73, 0xaaa2a208,
+    0x69a1a1c8, 0x6aadadc7, 0x83060685, 0xb0caca7a, 0x70c5c5b5, 0x659191f4, 0xd96b6bb2, 0x892e2ea7,
+    0xfbe3e318, 0xe8afaf47, 0x0f3c3c33, 0x4a2d2d67, 0x71c1c1b0, 0x5759590e, 0x9f7676e9, 0x35d4d4e1,
+    0x1e787866, 0x249090b4, 0x0e383836, 0x5f797926, 0x628d8def, 0x59616138, 0xd2474795, 0xa08a8a2a,
+    0x259494b1, 0x228888aa, 0x7df1f18c, 0x3bececd7, 0x01040405, 0x218484a5, 0x79e1e198, 0x851e1e9b,
+    0xd7535384, 0x00000000, 0x4719195e, 0x565d5d0b, 0x9d7e7ee3, 0xd04f4f9f, 0x279c9cbb, 0x5349491a,
+    0x4d31317c, 0x36d8d8ee, 0x0208080a, 0xe49f9f7b, 0xa2828220, 0xc71313d4, 0xcb2323e8, 0x9c7a7ae6,
+    0xe9abab42, 0xbdfefe43, 0x882a2aa2, 0xd14b4b9a, 0x41010140, 0xc41f1fdb, 0x38e0e0d8, 0xb7d6d661,
+    0xa18e8e2f, 0xf4dfdf2b, 0xf1cbcb3a, 0xcd3b3bf6, 0xfae7e71d, 0x608585e5, 0x15545441, 0xa3868625,
+    0xe3838360, 0xacbaba16, 0x5c757529, 0xa6929234, 0x996e6ef7, 0x34d0d0e4, 0x1a686872, 0x54555501,
+    0xafb6b619, 0x914e4edf, 0x32c8c8fa, 0x30c0c0f0, 0xf6d7d721, 0x8e3232bc, 0xb3c6c675, 0xe08f8f6f,
+    0x1d747469, 0xf5dbdb2e, 0xe18b8b6a, 0x2eb8b896, 0x800a0a8a, 0x679999fe, 0xc92b2be2, 0x618181e0,
+    0xc30303c0, 0x29a4a48d, 0x238c8caf, 0xa9aeae07, 0x0d343439, 0x524d4d1f, 0x4f393976, 0x6ebdbdd3,
+    0xd6575781, 0xd86f6fb7, 0x37dcdceb, 0x44151551, 0xdd7b7ba6, 0xfef7f709, 0x8c3a3ab6, 0x2fbcbc93,
+    0x030c0c0f, 0xfcffff03, 0x6ba9a9c2, 0x73c9c9ba, 0x6cb5b5d9, 0x6db1b1dc, 0x5a6d6d37, 0x50454515,
+    0x8f3636b9, 0x1b6c6c77, 0xadbebe13, 0x904a4ada, 0xb9eeee57, 0xde7777a9, 0xbef2f24c, 0x7efdfd83,
+    0x11444455, 0xda6767bd, 0x5d71712c, 0x40050545, 0x1f7c7c63, 0x10404050, 0x5b696932, 0xdb6363b8,
+    0x0a282822, 0xc20707c5, 0x31c4c4f5, 0x8a2222a8, 0xa7969631, 0xce3737f9, 0x7aeded97, 0xbff6f649,
+    0x2db4b499, 0x75d1d1a4, 0xd3434390, 0x1248485a, 0xbae2e258, 0xe6979771, 0xb6d2d264, 0xb2c2c270,
+    0x8b2626ad, 0x68a5a5cd, 0x955e5ecb, 0x4b292962, 0x0c30303c, 0x945a5ace, 0x76ddddab, 0x7ff9f986,
+    0x649595f1, 0xbbe6e65d, 0xf2c7c735, 0x0924242d, 0xc61717d1, 0x6fb9b9d6, 0xc51b1bde, 0x86121294,
+    0x18606078, 0xf3c3c330, 0x7cf5f589, 0xefb3b35c, 0x3ae8e8d2, 0xdf7373ac, 0x4c353579, 0x208080a0,
+    0x78e5e59d, 0xedbbbb56, 0x5e7d7d23, 0x3ef8f8c6, 0xd45f5f8b, 0xc82f2fe7, 0x39e4e4dd, 0x49212168,
+};
+
+#define SM4_GET_U32(p)    (((unsigned int)(p)[0]<<24) | ((unsigned int)(p)[1]<<16) | ((unsigned int)(p)[2]<<8) | (unsigned int)(p)[3])
+#define SM4_PUT_U32(p, v)                     \
+    do {                                      \
+        (p)[0] = (unsigned char)((v) >> 24);  \
+        (p)[1] = (unsigned char)((v) >> 16);  \
+        (p)[2] = (unsigned char)((v) >> 8);   \
+        (p)[3] = (unsigned char)(v);          \
+    } while (0)
+
+#define SM4_T(x)    (SM4_T0[(x)&0xff] ^ ROL(SM4_T0[((x)>>8)&0xff],8) ^ ROL(SM4_T0[((x)>>16)&0xff],16) ^ ROL(SM4_T0[(x)>>24],24))
+
+void SM4_Set_Key(SM4_KEY *pCtx, const unsigned char *pKey)
+{
+    unsigned int MK[4];
+
+    MK[0] = SM4_GET_U32(pKey);
+    MK[1] = SM4_GET_U32(pKey + 4);
+    MK[2] = SM4_GET_U32(pKey + 8);
+    MK[3] = SM4_GET_U32(pKey + 12);
+    SMS4_Key_Expansion(MK, pCtx->rk);
+}
+
+static void SM4_Crypt_Block(const unsigned int rk[SM4_ROUND], int decrypt, const unsigned char in[16], unsigned char out[16])
+{
+    unsigned int x0 = SM4_GET_U32(in);
+    unsigned int x1 = SM4_GET_U32(in + 4);
+    unsigned int x2 = SM4_GET_U32(in + 8);
+    unsigned int x3 = SM4_GET_U32(in + 12);
+    unsigned int t  = 0;
+    int          i  = 0;
+
+#define SM4_RK(i)    (decrypt ? rk[SM4_ROUND - 1 - (i)] : rk[(i)])
+    for (i = 0; i < SM4_ROUND; i += 4)
+    {
+        t = x1 ^ x2 ^ x3 ^ SM4_RK(i);
+        x0 ^= SM4_T(t);
+        t = x2 ^ x3 ^ x0 ^ SM4_RK(i + 1);
+        x1 ^= SM4_T(t);
+        t = x3 ^ x0 ^ x1 ^ SM4_RK(i + 2);
+        x2 ^= SM4_T(t);
+        t = x0 ^ x1 ^ x2 ^ SM4_RK(i + 3);
+        x3 ^= SM4_T(t);
+    }
+#undef SM4_RK
+
+    SM4_PUT_U32(out, x3);
+    SM4_PUT_U32(out + 4, x2);
+    SM4_PUT_U32(out + 8, x1);
+    SM4_PUT_U32(out + 12, x0);
+}
+
+int SM4_CBC_Encrypt_Ex(const SM4_KEY *pCtx, const unsigned char *pIV, unsigned char *pData, unsigned int dataLen)
+{
+    const unsigned char *pIVTemp = pIV;
+    unsigned char        block[16];
+    unsigned int         i = 0;
+    int                  j = 0;
+
+    if (dataLen % 16 != 0)
+    {
+        return 1;
+    }
+
+    for (i = 0; i < dataLen; i += 16)
+    {
+        for (j = 0; j < 16; j ++)
+        {
+            block[j] = pData[i + j] ^ pIVTemp[j];
+        }
+        SM4_Crypt_Block(pCtx->rk, 0, block, pData + i);
+        pIVTemp = pData + i;
+    }
+    return 0;
+}
+
+int SM4_CBC_Decrypt_Ex(const SM4_KEY *pCtx, const unsigned char *pIV, unsigned char *pData, unsigned int dataLen)
+{
+    unsigned char iv[16];
+    unsigned char cipher[16];
+    unsigned int  i = 0;
+    int           j = 0;
+
+    if (dataLen % 16 != 0)
+    {
+        return 1;
+    }
+
+    memcpy(iv, pIV, 16);
+    for (i = 0; i < dataLen; i += 16)
+    {
+        // the cipher text is the iv of the next block, keep it before it is overwritten in place
+        memcpy(cipher, pData + i, 16);
+        SM4_Crypt_Block(pCtx->rk, 1, cipher, pData + i);
+        for (j = 0; j < 16; j ++)
+        {
+            pData[i + j] ^= iv[j];
+        }
+        memcpy(iv, cipher, 16);
+    }
+    return 0;
+}
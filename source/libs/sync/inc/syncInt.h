@@ -50,6 +50,7 @@ typedef struct SyncHeartbeat          SyncHeartbeat;
 typedef struct SyncPreSnapshot        SyncPreSnapshot;
 typedef struct SSyncLogBuffer         SSyncLogBuffer;
 typedef struct SSyncLogReplMgr        SSyncLogReplMgr;
+typedef struct SSyncLogPersister      SSyncLogPersister;
 
 #define MAX_CONFIG_INDEX_COUNT 256
 
@@ -157,8 +158,9 @@ typedef struct SSyncNode {
   SSyncIndexMgr* pMatchIndex;
 
   // tla+ log vars
-  SSyncLogStore* pLogStore;
-  SyncIndex      commitIndex;
+  SSyncLogStore*     pLogStore;
+  SSyncLogPersister* pLogPersister;  // persists the entries of the leader in background
+  SyncIndex          commitIndex;
 
   // assigned leader log vars
   SyncIndex assignedCommitIndex;
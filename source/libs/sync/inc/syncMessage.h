@@ -100,7 +100,7 @@ typedef struct SyncAppendEntries {
   SyncTerm  privateTerm;
   int16_t   reserved;
   uint32_t  dataLen;
-  char      data[];
+  char      data[];  // consecutive raft entries from prevLogIndex + 1, each of its own bytes
 } SyncAppendEntries;
 
 typedef struct SyncAppendEntriesReply {
@@ -147,9 +147,12 @@ typedef struct SyncHeartbeatReply {
   SyncTerm privateTerm;
   int64_t  startTime;
   int64_t  timeStamp;
-  int16_t  reserved;
+  int16_t  features;  // SYNC_FEATURE_*, which is reserved and 0 in the older versions
 } SyncHeartbeatReply;
 
+// the features of a peer, announced in its heartbeat replies
+#define SYNC_FEATURE_BATCH_APPEND 0x1  // accepts append entries msgs of more than one raft entry
+
 typedef struct SyncPreSnapshot {
   uint32_t bytes;
   int32_t  vgId;
@@ -239,6 +242,7 @@ typedef enum {
   SYNC_LOCAL_CMD_STEP_DOWN = 100,
   SYNC_LOCAL_CMD_FOLLOWER_CMT,
   SYNC_LOCAL_CMD_LEARNER_CMT,
+  SYNC_LOCAL_CMD_LEADER_PERSIST,
 } ESyncLocalCmd;
 
 typedef struct SyncLocalCmd {
@@ -260,8 +264,8 @@ int32_t syncBuildRequestVote(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildRequestVoteReply(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildAppendEntries(SRpcMsg* pMsg, int32_t dataLen, int32_t vgId);
 int32_t syncBuildAppendEntriesReply(SRpcMsg* pMsg, int32_t vgId);
-int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevLogTerm,
-                                            SRpcMsg* pRpcMsg);
+int32_t syncBuildAppendEntriesFromRaftEntries(SSyncNode* pNode, SSyncRaftEntry** ppEntries, int32_t num,
+                                              SyncTerm prevLogTerm, SRpcMsg* pRpcMsg);
 int32_t syncBuildHeartbeat(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildHeartbeatReply(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildPreSnapshot(SRpcMsg* pMsg, int32_t vgId);
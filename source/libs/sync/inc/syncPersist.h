@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TD_LIBS_SYNC_PERSIST_H
+#define _TD_LIBS_SYNC_PERSIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "syncInt.h"
+
+// a failed write is retried with backoff, and the leader steps down once the retries are used up
+#define SYNC_PERSIST_MAX_RETRIES    12
+#define SYNC_PERSIST_MAX_BACKOFF_MS 1000
+
+// Persists the raft entries of the leader in a background thread, so that they are replicated to the followers
+// while being written to the wal. The entries are owned by the log buffer, which must wait for the queued ones to be
+// persisted before it frees or truncates any of them.
+typedef struct SSyncLogPersister {
+  SSyncNode*      pNode;
+  SSyncRaftEntry* entries[TSDB_SYNC_LOG_BUFFER_SIZE];
+  int64_t         size;
+  SyncIndex       queueIndex;    // the last index queued
+  SyncIndex       persistIndex;  // the last index persisted, entries in (persistIndex, queueIndex] are in flight
+  SyncTerm        term;          // the term of the leader that queued the entries
+  bool            stop;
+  bool            failed;  // gave up on a write, the entries in flight are dropped and the leader is to step down
+  TdThreadMutex   mutex;
+  TdThreadCond    cond;      // signaled when entries are queued or the thread is to stop
+  TdThreadCond    idleCond;  // signaled when all the queued entries are persisted
+  TdThread        thread;
+} SSyncLogPersister;
+
+SSyncLogPersister* syncLogPersisterCreate(SSyncNode* pNode);
+void               syncLogPersisterDestroy(SSyncLogPersister* pPersister);
+
+// queue a run of consecutive entries following the ones queued before
+int32_t syncLogPersisterPush(SSyncLogPersister* pPersister, SSyncRaftEntry** ppEntries, int32_t num, SyncTerm term);
+
+// wait until all the queued entries are persisted
+void syncLogPersisterWait(SSyncLogPersister* pPersister);
+
+// whether the entries matched in the log buffer are persisted in the background, i.e. by the leader of replicas
+bool syncLogPersisterEnabled(SSyncNode* pNode);
+
+// whether the persister gave up on a write, and clear it once the log buffer is reset to the wal
+bool syncLogPersisterFailed(SSyncLogPersister* pPersister);
+void syncLogPersisterRecover(SSyncLogPersister* pPersister);
+
+// the last index of the wal among the entries matched up to matchIndex, i.e. the upper bound of the leader to commit
+SyncIndex syncLogPersisterLastIndex(SSyncLogPersister* pPersister, SyncIndex matchIndex);
+
+// update the match index of the leader itself once its own write completes, and commit on quorum
+int32_t syncNodeOnLogPersisted(SSyncNode* ths, SyncTerm term, SyncIndex persistIndex);
+
+// catch up with the persister on each heartbeat reply, in case its notification is lost, and step down if it failed
+void syncNodeCheckLogPersisted(SSyncNode* ths);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_TD_LIBS_SYNC_PERSIST_H*/
@@ -89,12 +89,45 @@
 //       /\ UNCHANGED <<candidateVars, leaderVars>>
 //
 
+// check that the msg carries consecutive raft entries from prevLogIndex + 1, and get the index of the last one
+static int32_t syncNodeCheckAppendEntries(SSyncNode* ths, const SyncAppendEntries* pMsg, SyncIndex* pLastIndex) {
+  SyncIndex index = pMsg->prevLogIndex + 1;
+  uint32_t  offset = 0;
+
+  while (offset < pMsg->dataLen) {
+    SSyncRaftEntry head;
+    if (pMsg->dataLen - offset < sizeof(SSyncRaftEntry)) {
+      sError("vgId:%d, incomplete raft entry in append entries. index:%" PRId64 ", offset:%u, datalen:%u", ths->vgId,
+             index, offset, pMsg->dataLen);
+      return -1;
+    }
+    memcpy(&head, pMsg->data + offset, sizeof(SSyncRaftEntry));
+    if (head.bytes < sizeof(SSyncRaftEntry) || head.bytes > pMsg->dataLen - offset) {
+      sError("vgId:%d, invalid raft entry size in append entries. index:%" PRId64 ", bytes:%u, offset:%u, datalen:%u",
+             ths->vgId, index, head.bytes, offset, pMsg->dataLen);
+      return -1;
+    }
+    if (head.index != index || head.term < 0) {
+      sError("vgId:%d, invalid log index in msg. index:%" PRId64 ", expected:%" PRId64 ", term:%" PRId64
+             ", prevLogIndex:%" PRId64 ", prevLogTerm:%" PRId64,
+             ths->vgId, head.index, index, head.term, pMsg->prevLogIndex, pMsg->prevLogTerm);
+      return -1;
+    }
+    offset += head.bytes;
+    index++;
+  }
+
+  *pLastIndex = index - 1;
+  return 0;
+}
+
 int32_t syncNodeOnAppendEntries(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
   SyncAppendEntries* pMsg = pRpcMsg->pCont;
   SRpcMsg            rpcRsp = {0};
   bool               accepted = false;
   SSyncRaftEntry*    pEntry = NULL;
   bool               resetElect = false;
+  SyncIndex          lastIndex = -1;
 
   // if already drop replica, do not process
   if (!syncNodeInRaftGroup(ths, &(pMsg->srcId))) {
@@ -137,34 +170,41 @@ int32_t syncNodeOnAppendEntries(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
     goto _IGNORE;
   }
 
-  pEntry = syncEntryBuildFromAppendEntries(pMsg);
-  if (pEntry == NULL) {
-    sError("vgId:%d, failed to get raft entry from append entries since %s", ths->vgId, terrstr());
+  if (syncNodeCheckAppendEntries(ths, pMsg, &lastIndex) < 0) {
     goto _IGNORE;
   }
+  pReply->lastSendIndex = lastIndex;
 
-  if (pMsg->prevLogIndex + 1 != pEntry->index || pEntry->term < 0) {
-    sError("vgId:%d, invalid previous log index in msg. index:%" PRId64 ",  term:%" PRId64 ", prevLogIndex:%" PRId64
-           ", prevLogTerm:%" PRId64,
-           ths->vgId, pEntry->index, pEntry->term, pMsg->prevLogIndex, pMsg->prevLogTerm);
-    goto _IGNORE;
-  }
-
-  sTrace("vgId:%d, recv append entries msg. index:%" PRId64 ", term:%" PRId64 ", preLogIndex:%" PRId64
-         ", prevLogTerm:%" PRId64 " commitIndex:%" PRId64 " entryterm:%" PRId64,
-         pMsg->vgId, pMsg->prevLogIndex + 1, pMsg->term, pMsg->prevLogIndex, pMsg->prevLogTerm, pMsg->commitIndex,
-         pEntry->term);
+  sTrace("vgId:%d, recv append entries msg. index:%" PRId64 ", last index:%" PRId64 ", term:%" PRId64
+         ", preLogIndex:%" PRId64 ", prevLogTerm:%" PRId64 " commitIndex:%" PRId64,
+         pMsg->vgId, pMsg->prevLogIndex + 1, lastIndex, pMsg->term, pMsg->prevLogIndex, pMsg->prevLogTerm,
+         pMsg->commitIndex);
 
   if (ths->fsmState == SYNC_FSM_STATE_INCOMPLETE) {
     pReply->fsmState = ths->fsmState;
-    sWarn("vgId:%d, unable to accept, due to incomplete fsm state. index:%" PRId64, ths->vgId, pEntry->index);
-    syncEntryDestroy(pEntry);
+    sWarn("vgId:%d, unable to accept, due to incomplete fsm state. index:%" PRId64, ths->vgId, pMsg->prevLogIndex + 1);
     goto _SEND_RESPONSE;
   }
 
-  // accept
-  if (syncLogBufferAccept(ths->pLogBuf, ths, pEntry, pMsg->prevLogTerm) < 0) {
-    goto _SEND_RESPONSE;
+  // accept the entries one by one, and they are persisted together when proceeding
+  SyncTerm prevLogTerm = pMsg->prevLogTerm;
+  uint32_t offset = 0;
+  while (offset < pMsg->dataLen) {
+    pEntry = syncEntryBuildFromAppendEntries(pMsg, offset);
+    if (pEntry == NULL) {
+      sError("vgId:%d, failed to get raft entry from append entries since %s", ths->vgId, terrstr());
+      goto _SEND_RESPONSE;
+    }
+    offset += pEntry->bytes;
+
+    // the entry is owned by the log buffer once accepted, and freed otherwise
+    SyncTerm term = pEntry->term;
+    int32_t  ret = syncLogBufferAccept(ths->pLogBuf, ths, pEntry, prevLogTerm);
+    pEntry = NULL;
+    if (ret < 0) {
+      goto _SEND_RESPONSE;
+    }
+    prevLogTerm = term;
   }
   accepted = true;
 
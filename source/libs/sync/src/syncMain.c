@@ -23,6 +23,7 @@
 #include "syncIndexMgr.h"
 #include "syncInt.h"
 #include "syncMessage.h"
+#include "syncPersist.h"
 #include "syncPipeline.h"
 #include "syncRaftCfg.h"
 #include "syncRaftLog.h"
@@ -1277,6 +1278,15 @@ SSyncNode* syncNodeOpen(SSyncInfo* pSyncInfo, int32_t vnodeVersion) {
     goto _error;
   }
 
+  // persist the entries of the leader in background
+  if (tsSyncAsyncPersist) {
+    pSyncNode->pLogPersister = syncLogPersisterCreate(pSyncNode);
+    if (pSyncNode->pLogPersister == NULL) {
+      sError("vgId:%d, failed to create sync log persister since %s", pSyncNode->vgId, terrstr());
+      goto _error;
+    }
+  }
+
   pSyncNode->isStart = true;
   pSyncNode->electNum = 0;
   pSyncNode->becomeLeaderNum = 0;
@@ -1431,6 +1441,8 @@ void syncNodeClose(SSyncNode* pSyncNode) {
   syncNodeStopPingTimer(pSyncNode);
   syncNodeStopElectTimer(pSyncNode);
   syncNodeStopHeartbeatTimer(pSyncNode);
+  syncLogPersisterDestroy(pSyncNode->pLogPersister);
+  pSyncNode->pLogPersister = NULL;
   syncNodeLogReplDestroy(pSyncNode);
 
   syncRespMgrDestroy(pSyncNode->pSyncRespMgr);
@@ -3263,6 +3275,7 @@ int32_t syncNodeOnHeartbeat(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
   pMsgReply->privateTerm = 8864;  // magic number
   pMsgReply->startTime = ths->startTime;
   pMsgReply->timeStamp = tsMs;
+  pMsgReply->features = SYNC_FEATURE_BATCH_APPEND;
 
   sTrace("vgId:%d, heartbeat msg from dnode:%d, cluster:%d, Msgterm:%" PRId64 " currentTerm:%" PRId64, ths->vgId,
          DID(&(pMsg->srcId)), CID(&(pMsg->srcId)), pMsg->term, currentTerm);
@@ -3347,7 +3360,9 @@ int32_t syncNodeOnHeartbeatReply(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
 
   syncIndexMgrSetRecvTime(ths->pMatchIndex, &pMsg->srcId, tsMs);
 
-  return syncLogReplProcessHeartbeatReply(pMgr, ths, pMsg);
+  int32_t code = syncLogReplProcessHeartbeatReply(pMgr, ths, pMsg);
+  syncNodeCheckLogPersisted(ths);
+  return code;
 }
 
 #ifdef BUILD_NO_CALL
@@ -3388,6 +3403,8 @@ int32_t syncNodeOnLocalCmd(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
       sError("vgId:%d, failed to commit raft log since %s. commit index:%" PRId64 "", ths->vgId, terrstr(),
              ths->commitIndex);
     }
+  } else if (pMsg->cmd == SYNC_LOCAL_CMD_LEADER_PERSIST) {
+    (void)syncNodeOnLogPersisted(ths, pMsg->currentTerm, pMsg->commitIndex);
   } else {
     sError("error local cmd");
   }
@@ -154,9 +154,12 @@ int32_t syncBuildAppendEntriesReply(SRpcMsg* pMsg, int32_t vgId) {
   return 0;
 }
 
-int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevLogTerm,
-                                            SRpcMsg* pRpcMsg) {
-  uint32_t dataLen = pEntry->bytes;
+int32_t syncBuildAppendEntriesFromRaftEntries(SSyncNode* pNode, SSyncRaftEntry** ppEntries, int32_t num,
+                                              SyncTerm prevLogTerm, SRpcMsg* pRpcMsg) {
+  uint32_t dataLen = 0;
+  for (int32_t i = 0; i < num; ++i) {
+    dataLen += ppEntries[i]->bytes;
+  }
   uint32_t bytes = sizeof(SyncAppendEntries) + dataLen;
   pRpcMsg->contLen = bytes;
   pRpcMsg->pCont = rpcMallocCont(pRpcMsg->contLen);
@@ -170,9 +173,13 @@ int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pE
   pMsg->msgType = pRpcMsg->msgType = TDMT_SYNC_APPEND_ENTRIES;
   pMsg->dataLen = dataLen;
 
-  (void)memcpy(pMsg->data, pEntry, dataLen);
+  uint32_t offset = 0;
+  for (int32_t i = 0; i < num; ++i) {
+    (void)memcpy(pMsg->data + offset, ppEntries[i], ppEntries[i]->bytes);
+    offset += ppEntries[i]->bytes;
+  }
 
-  pMsg->prevLogIndex = pEntry->index - 1;
+  pMsg->prevLogIndex = ppEntries[0]->index - 1;
   pMsg->prevLogTerm = prevLogTerm;
   pMsg->vgId = pNode->vgId;
   pMsg->srcId = pNode->myRaftId;
@@ -304,6 +311,8 @@ const char* syncLocalCmdGetStr(ESyncLocalCmd cmd) {
       return "step-down";
     case SYNC_LOCAL_CMD_FOLLOWER_CMT:
       return "follower-commit";
+    case SYNC_LOCAL_CMD_LEADER_PERSIST:
+      return "leader-persist";
     default:
       return "unknown-local-cmd";
   }
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _DEFAULT_SOURCE
+#include "syncPersist.h"
+#include "syncCommit.h"
+#include "syncIndexMgr.h"
+#include "syncMessage.h"
+#include "syncPipeline.h"
+#include "syncRaftEntry.h"
+#include "syncRaftStore.h"
+#include "syncUtil.h"
+#include "tglobal.h"
+
+// a lost notification is made up for by syncNodeCheckLogPersisted on the next heartbeat reply
+static void syncLogPersisterNotify(SSyncLogPersister* pPersister, ESyncLocalCmd cmd, SyncTerm term,
+                                   SyncIndex persistIndex) {
+  SSyncNode* pNode = pPersister->pNode;
+  if (pNode->syncEqMsg == NULL || pNode->msgcb == NULL) {
+    return;
+  }
+
+  SRpcMsg rpcMsgLocalCmd = {0};
+  if (syncBuildLocalCmd(&rpcMsgLocalCmd, pNode->vgId) != 0) {
+    sWarn("vgId:%d, failed to build %s msg since %s", pNode->vgId, syncLocalCmdGetStr(cmd), terrstr());
+    return;
+  }
+
+  SyncLocalCmd* pSyncMsg = rpcMsgLocalCmd.pCont;
+  pSyncMsg->cmd = cmd;
+  pSyncMsg->currentTerm = term;
+  pSyncMsg->commitIndex = persistIndex;
+
+  int32_t code = pNode->syncEqMsg(pNode->msgcb, &rpcMsgLocalCmd);
+  if (code != 0) {
+    sWarn("vgId:%d, failed to enqueue %s msg since %s, code:%d", pNode->vgId, syncLocalCmdGetStr(cmd), terrstr(),
+          code);
+    rpcFreeCont(rpcMsgLocalCmd.pCont);
+  }
+}
+
+static void* syncLogPersisterThreadFp(void* param) {
+  SSyncLogPersister* pPersister = param;
+  SSyncNode*         pNode = pPersister->pNode;
+  SSyncLogStore*     pLogStore = pNode->pLogStore;
+  SSyncRaftEntry*    pEntries[SYNC_MAX_BATCH_SIZE];
+  int32_t            retries = 0;
+
+  setThreadName("sync-persist");
+
+  taosThreadMutexLock(&pPersister->mutex);
+  while (true) {
+    while (!pPersister->stop && pPersister->persistIndex == pPersister->queueIndex) {
+      taosThreadCondWait(&pPersister->cond, &pPersister->mutex);
+    }
+    if (pPersister->persistIndex == pPersister->queueIndex) {
+      break;
+    }
+
+    // the queued entries are written in groups of one wal write each
+    SyncIndex firstIndex = pPersister->persistIndex + 1;
+    int32_t   num = TMIN(pPersister->queueIndex - pPersister->persistIndex, SYNC_MAX_BATCH_SIZE);
+    SyncTerm  term = pPersister->term;
+    bool      doFsync = false;
+    for (int32_t i = 0; i < num; ++i) {
+      pEntries[i] = pPersister->entries[(firstIndex + i) % pPersister->size];
+      doFsync = doFsync || (pEntries[i]->originalRpcType == TDMT_VND_COMMIT);
+    }
+    taosThreadMutexUnlock(&pPersister->mutex);
+
+    SyncIndex lastVer = pLogStore->syncLogLastIndex(pLogStore);
+    ASSERT(firstIndex == lastVer + 1);
+
+    int64_t st = taosGetTimestampUs();
+    int32_t code = pLogStore->syncLogAppendEntries(pLogStore, pEntries, num, doFsync);
+    int64_t el = taosGetTimestampUs() - st;
+
+    taosThreadMutexLock(&pPersister->mutex);
+    if (code < 0 && !pPersister->stop && retries < SYNC_PERSIST_MAX_RETRIES) {
+      int32_t backoffMs = TMIN(1 << retries, SYNC_PERSIST_MAX_BACKOFF_MS);
+      retries++;
+      sWarn("vgId:%d, failed to persist sync log entries since %s, retry in %dms. index:%" PRId64 ", num:%d, retries:%d",
+            pNode->vgId, terrstr(), backoffMs, firstIndex, num, retries);
+      taosThreadMutexUnlock(&pPersister->mutex);
+      taosMsleep(backoffMs);
+      taosThreadMutexLock(&pPersister->mutex);
+      continue;
+    }
+
+    if (code < 0) {
+      // the entries in flight are dropped, and the leader steps down to be matched with the wal again
+      sError("vgId:%d, failed to persist sync log entries since %s, give up after %d retries. index:%" PRId64
+             ", num:%d",
+             pNode->vgId, terrstr(), retries, firstIndex, num);
+      retries = 0;
+      pPersister->failed = true;
+      pPersister->queueIndex = pPersister->persistIndex;
+      taosThreadCondBroadcast(&pPersister->idleCond);
+      if (pPersister->stop) break;
+      taosThreadMutexUnlock(&pPersister->mutex);
+
+      syncLogPersisterNotify(pPersister, SYNC_LOCAL_CMD_STEP_DOWN, term, SYNC_INDEX_INVALID);
+      taosThreadMutexLock(&pPersister->mutex);
+      continue;
+    }
+
+    retries = 0;
+    pPersister->persistIndex = firstIndex + num - 1;
+    SyncIndex persistIndex = pPersister->persistIndex;
+    if (pPersister->persistIndex == pPersister->queueIndex) {
+      taosThreadCondBroadcast(&pPersister->idleCond);
+    }
+    taosThreadMutexUnlock(&pPersister->mutex);
+
+    sTrace("vgId:%d, persisted sync log entries in background. index:%" PRId64 ", num:%d, elapsed:%" PRId64 "us",
+           pNode->vgId, firstIndex, num, el);
+    syncLogPersisterNotify(pPersister, SYNC_LOCAL_CMD_LEADER_PERSIST, term, persistIndex);
+
+    taosThreadMutexLock(&pPersister->mutex);
+  }
+
+  // the entries left are dropped, which are neither persisted nor counted by the leader
+  pPersister->queueIndex = pPersister->persistIndex;
+  taosThreadCondBroadcast(&pPersister->idleCond);
+  taosThreadMutexUnlock(&pPersister->mutex);
+  return NULL;
+}
+
+SSyncLogPersister* syncLogPersisterCreate(SSyncNode* pNode) {
+  SSyncLogPersister* pPersister = taosMemoryCalloc(1, sizeof(SSyncLogPersister));
+  if (pPersister == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  pPersister->pNode = pNode;
+  pPersister->size = sizeof(pPersister->entries) / sizeof(pPersister->entries[0]);
+  pPersister->queueIndex = SYNC_INDEX_INVALID;
+  pPersister->persistIndex = SYNC_INDEX_INVALID;
+  taosThreadMutexInit(&pPersister->mutex, NULL);
+  taosThreadCondInit(&pPersister->cond, NULL);
+  taosThreadCondInit(&pPersister->idleCond, NULL);
+
+  TdThreadAttr thAttr;
+  taosThreadAttrInit(&thAttr);
+  taosThreadAttrSetDetachState(&thAttr, PTHREAD_CREATE_JOINABLE);
+  if (taosThreadCreate(&pPersister->thread, &thAttr, syncLogPersisterThreadFp, pPersister) != 0) {
+    sError("vgId:%d, failed to create sync persist thread since %s", pNode->vgId, strerror(errno));
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    taosThreadAttrDestroy(&thAttr);
+    taosThreadCondDestroy(&pPersister->idleCond);
+    taosThreadCondDestroy(&pPersister->cond);
+    taosThreadMutexDestroy(&pPersister->mutex);
+    taosMemoryFree(pPersister);
+    return NULL;
+  }
+  taosThreadAttrDestroy(&thAttr);
+
+  return pPersister;
+}
+
+void syncLogPersisterDestroy(SSyncLogPersister* pPersister) {
+  if (pPersister == NULL) {
+    return;
+  }
+
+  taosThreadMutexLock(&pPersister->mutex);
+  pPersister->stop = true;
+  taosThreadCondSignal(&pPersister->cond);
+  taosThreadMutexUnlock(&pPersister->mutex);
+
+  taosThreadJoin(pPersister->thread, NULL);
+  taosThreadCondDestroy(&pPersister->idleCond);
+  taosThreadCondDestroy(&pPersister->cond);
+  taosThreadMutexDestroy(&pPersister->mutex);
+  taosMemoryFree(pPersister);
+}
+
+int32_t syncLogPersisterPush(SSyncLogPersister* pPersister, SSyncRaftEntry** ppEntries, int32_t num, SyncTerm term) {
+  taosThreadMutexLock(&pPersister->mutex);
+  ASSERT(!pPersister->failed);
+  if (pPersister->persistIndex == pPersister->queueIndex) {
+    // idle, start over from the given entries, e.g. after the log buffer is reset
+    pPersister->queueIndex = pPersister->persistIndex = ppEntries[0]->index - 1;
+  }
+  ASSERT(ppEntries[0]->index == pPersister->queueIndex + 1);
+  ASSERT(pPersister->queueIndex + num - pPersister->persistIndex <= pPersister->size);
+
+  for (int32_t i = 0; i < num; ++i) {
+    pPersister->entries[ppEntries[i]->index % pPersister->size] = ppEntries[i];
+  }
+  pPersister->queueIndex += num;
+  pPersister->term = term;
+  taosThreadCondSignal(&pPersister->cond);
+  taosThreadMutexUnlock(&pPersister->mutex);
+  return 0;
+}
+
+void syncLogPersisterWait(SSyncLogPersister* pPersister) {
+  if (pPersister == NULL) {
+    return;
+  }
+
+  taosThreadMutexLock(&pPersister->mutex);
+  while (pPersister->persistIndex != pPersister->queueIndex) {
+    taosThreadCondWait(&pPersister->idleCond, &pPersister->mutex);
+  }
+  taosThreadMutexUnlock(&pPersister->mutex);
+}
+
+bool syncLogPersisterEnabled(SSyncNode* pNode) {
+  return pNode->pLogPersister != NULL && pNode->state == TAOS_SYNC_STATE_LEADER && pNode->replicaNum > 1;
+}
+
+bool syncLogPersisterFailed(SSyncLogPersister* pPersister) {
+  if (pPersister == NULL) {
+    return false;
+  }
+
+  taosThreadMutexLock(&pPersister->mutex);
+  bool failed = pPersister->failed;
+  taosThreadMutexUnlock(&pPersister->mutex);
+  return failed;
+}
+
+void syncLogPersisterRecover(SSyncLogPersister* pPersister) {
+  if (pPersister == NULL) {
+    return;
+  }
+
+  taosThreadMutexLock(&pPersister->mutex);
+  ASSERT(pPersister->persistIndex == pPersister->queueIndex);
+  pPersister->failed = false;
+  taosThreadMutexUnlock(&pPersister->mutex);
+}
+
+SyncIndex syncLogPersisterLastIndex(SSyncLogPersister* pPersister, SyncIndex matchIndex) {
+  if (pPersister == NULL) {
+    return matchIndex;
+  }
+
+  // the entries not queued are persisted by the log buffer itself
+  taosThreadMutexLock(&pPersister->mutex);
+  SyncIndex lastIndex = matchIndex;
+  if (pPersister->failed || pPersister->persistIndex != pPersister->queueIndex) {
+    lastIndex = TMIN(matchIndex, pPersister->persistIndex);
+  }
+  taosThreadMutexUnlock(&pPersister->mutex);
+  return lastIndex;
+}
+
+int32_t syncNodeOnLogPersisted(SSyncNode* ths, SyncTerm term, SyncIndex persistIndex) {
+  if (ths->state != TAOS_SYNC_STATE_LEADER || term != raftStoreGetTerm(ths)) {
+    return 0;
+  }
+
+  SyncIndex matchIndex = syncIndexMgrGetIndex(ths->pMatchIndex, &ths->myRaftId);
+  if (persistIndex > matchIndex) {
+    syncIndexMgrSetIndex(ths->pMatchIndex, &ths->myRaftId, persistIndex);
+  }
+
+  // the entries agreed upon by the followers may be waiting for the write of the leader only
+  for (int32_t i = 0; i < ths->totalReplicaNum; ++i) {
+    SyncIndex index = TMIN(syncIndexMgrGetIndex(ths->pMatchIndex, &ths->replicasId[i]), persistIndex);
+    (void)syncNodeCheckCommitIndex(ths, index);
+  }
+
+  if (ths->fsmState != SYNC_FSM_STATE_INCOMPLETE && syncLogBufferCommit(ths->pLogBuf, ths, ths->commitIndex) < 0) {
+    sError("vgId:%d, failed to commit raft log since %s. commit index:%" PRId64 "", ths->vgId, terrstr(),
+           ths->commitIndex);
+  }
+  return 0;
+}
+
+void syncNodeCheckLogPersisted(SSyncNode* ths) {
+  SSyncLogPersister* pPersister = ths->pLogPersister;
+  if (pPersister == NULL || ths->state != TAOS_SYNC_STATE_LEADER) {
+    return;
+  }
+
+  taosThreadMutexLock(&pPersister->mutex);
+  bool      failed = pPersister->failed;
+  SyncTerm  term = pPersister->term;
+  SyncIndex persistIndex = pPersister->persistIndex;
+  taosThreadMutexUnlock(&pPersister->mutex);
+
+  SyncTerm currentTerm = raftStoreGetTerm(ths);
+  if (failed) {
+    sError("vgId:%d, step down since the sync log entries failed to persist. term:%" PRId64, ths->vgId, currentTerm);
+    syncNodeStepDown(ths, currentTerm);
+    return;
+  }
+
+  SyncIndex matchIndex = syncIndexMgrGetIndex(ths->pMatchIndex, &ths->myRaftId);
+  if (term == currentTerm && persistIndex > matchIndex) {
+    sInfo("vgId:%d, catch up with the persisted sync log entries. persist index:%" PRId64 ", match index:%" PRId64,
+          ths->vgId, persistIndex, matchIndex);
+    (void)syncNodeOnLogPersisted(ths, term, persistIndex);
+  }
+}
@@ -16,6 +16,7 @@
 #define _DEFAULT_SOURCE
 
 #include "syncPipeline.h"
+#include "syncPersist.h"
 #include "syncCommit.h"
 #include "syncIndexMgr.h"
 #include "syncInt.h"
@@ -275,6 +276,7 @@ int32_t syncLogBufferInit(SSyncLogBuffer* pBuf, SSyncNode* pNode) {
 int32_t syncLogBufferReInit(SSyncLogBuffer* pBuf, SSyncNode* pNode) {
   taosThreadMutexLock(&pBuf->mutex);
   syncLogBufferValidate(pBuf);
+  syncLogPersisterWait(pNode->pLogPersister);
   for (SyncIndex index = pBuf->startIndex; index < pBuf->endIndex; index++) {
     SSyncRaftEntry* pEntry = pBuf->entries[(index + pBuf->size) % pBuf->size].pItem;
     if (pEntry == NULL) continue;
@@ -408,25 +410,30 @@ static inline bool syncLogStoreNeedFlush(SSyncRaftEntry* pEntry, int32_t replica
   return (replicaNum > 1) && (pEntry->originalRpcType == TDMT_VND_COMMIT);
 }
 
-int32_t syncLogStorePersist(SSyncLogStore* pLogStore, SSyncNode* pNode, SSyncRaftEntry* pEntry) {
-  ASSERT(pEntry->index >= 0);
+int32_t syncLogStorePersist(SSyncLogStore* pLogStore, SSyncNode* pNode, SSyncRaftEntry** ppEntries, int32_t num) {
+  SSyncRaftEntry* pFirst = ppEntries[0];
+  SSyncRaftEntry* pLast = ppEntries[num - 1];
+  ASSERT(pFirst->index >= 0);
   SyncIndex lastVer = pLogStore->syncLogLastIndex(pLogStore);
-  if (lastVer >= pEntry->index && pLogStore->syncLogTruncate(pLogStore, pEntry->index) < 0) {
-    sError("failed to truncate log store since %s. from index:%" PRId64 "", terrstr(), pEntry->index);
+  if (lastVer >= pFirst->index && pLogStore->syncLogTruncate(pLogStore, pFirst->index) < 0) {
+    sError("failed to truncate log store since %s. from index:%" PRId64 "", terrstr(), pFirst->index);
     return -1;
   }
   lastVer = pLogStore->syncLogLastIndex(pLogStore);
-  ASSERT(pEntry->index == lastVer + 1);
+  ASSERT(pFirst->index == lastVer + 1);
 
-  bool doFsync = syncLogStoreNeedFlush(pEntry, pNode->replicaNum);
-  if (pLogStore->syncLogAppendEntry(pLogStore, pEntry, doFsync) < 0) {
-    sError("failed to append sync log entry since %s. index:%" PRId64 ", term:%" PRId64 "", terrstr(), pEntry->index,
-           pEntry->term);
+  bool doFsync = false;
+  for (int32_t i = 0; i < num; ++i) {
+    doFsync = doFsync || syncLogStoreNeedFlush(ppEntries[i], pNode->replicaNum);
+  }
+  if (pLogStore->syncLogAppendEntries(pLogStore, ppEntries, num, doFsync) < 0) {
+    sError("failed to append sync log entries since %s. index:%" PRId64 ", num:%d, term:%" PRId64 "", terrstr(),
+           pFirst->index, num, pFirst->term);
     return -1;
   }
 
   lastVer = pLogStore->syncLogLastIndex(pLogStore);
-  ASSERT(pEntry->index == lastVer);
+  ASSERT(pLast->index == lastVer);
   return 0;
 }
 
@@ -437,50 +444,84 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
   SSyncLogStore* pLogStore = pNode->pLogStore;
   int64_t        matchIndex = pBuf->matchIndex;
 
-  while (pBuf->matchIndex + 1 < pBuf->endIndex) {
-    int64_t index = pBuf->matchIndex + 1;
-    ASSERT(index >= 0);
-
-    // try to proceed
-    SSyncLogBufEntry* pBufEntry = &pBuf->entries[index % pBuf->size];
-    SyncIndex         prevLogIndex = pBufEntry->prevLogIndex;
-    SyncTerm          prevLogTerm = pBufEntry->prevLogTerm;
-    SSyncRaftEntry*   pEntry = pBufEntry->pItem;
-    if (pEntry == NULL) {
-      sTrace("vgId:%d, cannot proceed match index in log buffer. no raft entry at next pos of matchIndex:%" PRId64,
-             pNode->vgId, pBuf->matchIndex);
-      goto _out;
-    }
-
-    ASSERT(index == pEntry->index);
+  // the entries dropped by a failed persister are matched again from the wal, once the leader steps down
+  if (syncLogPersisterFailed(pNode->pLogPersister)) {
+    goto _out;
+  }
 
-    // match
+  while (pBuf->matchIndex + 1 < pBuf->endIndex) {
+    // collect a run of matching entries, which is persisted in one write
+    SSyncRaftEntry* pEntries[SYNC_MAX_BATCH_SIZE];
+    int32_t         num = 0;
     SSyncRaftEntry* pMatch = pBuf->entries[(pBuf->matchIndex + pBuf->size) % pBuf->size].pItem;
     ASSERT(pMatch != NULL);
     ASSERT(pMatch->index == pBuf->matchIndex);
-    ASSERT(pMatch->index + 1 == pEntry->index);
-    ASSERT(prevLogIndex == pMatch->index);
-
-    if (pMatch->term != prevLogTerm) {
-      sInfo(
-          "vgId:%d, mismatching sync log entries encountered. "
-          "{ index:%" PRId64 ", term:%" PRId64
-          " } "
-          "{ index:%" PRId64 ", term:%" PRId64 ", prevLogIndex:%" PRId64 ", prevLogTerm:%" PRId64 " } ",
-          pNode->vgId, pMatch->index, pMatch->term, pEntry->index, pEntry->term, prevLogIndex, prevLogTerm);
+
+    for (int64_t index = pBuf->matchIndex + 1; index < pBuf->endIndex && num < SYNC_MAX_BATCH_SIZE; index++) {
+      ASSERT(index >= 0);
+
+      // try to proceed
+      SSyncLogBufEntry* pBufEntry = &pBuf->entries[index % pBuf->size];
+      SyncIndex         prevLogIndex = pBufEntry->prevLogIndex;
+      SyncTerm          prevLogTerm = pBufEntry->prevLogTerm;
+      SSyncRaftEntry*   pEntry = pBufEntry->pItem;
+      if (pEntry == NULL) {
+        sTrace("vgId:%d, cannot proceed match index in log buffer. no raft entry at next pos of matchIndex:%" PRId64,
+               pNode->vgId, index - 1);
+        break;
+      }
+
+      ASSERT(index == pEntry->index);
+
+      // match
+      ASSERT(pMatch->index + 1 == pEntry->index);
+      ASSERT(prevLogIndex == pMatch->index);
+
+      if (pMatch->term != prevLogTerm) {
+        sInfo(
+            "vgId:%d, mismatching sync log entries encountered. "
+            "{ index:%" PRId64 ", term:%" PRId64
+            " } "
+            "{ index:%" PRId64 ", term:%" PRId64 ", prevLogIndex:%" PRId64 ", prevLogTerm:%" PRId64 " } ",
+            pNode->vgId, pMatch->index, pMatch->term, pEntry->index, pEntry->term, prevLogIndex, prevLogTerm);
+        break;
+      }
+
+      pEntries[num++] = pEntry;
+      pMatch = pEntry;
+
+      // the config is changed right after the entry is persisted, so it ends the run
+      if (pEntry->originalRpcType == TDMT_SYNC_CONFIG_CHANGE) {
+        break;
+      }
+    }
+
+    if (num == 0) {
       goto _out;
     }
+    SSyncRaftEntry* pEntry = pEntries[num - 1];
 
     // increase match index
-    pBuf->matchIndex = index;
-
-    sTrace("vgId:%d, log buffer proceed. start index:%" PRId64 ", match index:%" PRId64 ", end index:%" PRId64,
-           pNode->vgId, pBuf->startIndex, pBuf->matchIndex, pBuf->endIndex);
+    pBuf->matchIndex = pEntry->index;
+
+    sTrace("vgId:%d, log buffer proceed. start index:%" PRId64 ", match index:%" PRId64 ", end index:%" PRId64
+           ", num:%d",
+           pNode->vgId, pBuf->startIndex, pBuf->matchIndex, pBuf->endIndex, num);
+
+    // the leader replicates the entries while they are persisted in background, and counts itself in the quorum
+    // only once they are written
+    if (syncLogPersisterEnabled(pNode) && pEntry->originalRpcType != TDMT_SYNC_CONFIG_CHANGE) {
+      (void)syncLogPersisterPush(pNode->pLogPersister, pEntries, num, raftStoreGetTerm(pNode));
+      (void)syncNodeReplicateWithoutLock(pNode);
+      matchIndex = pBuf->matchIndex;
+      continue;
+    }
 
     // persist
-    if (syncLogStorePersist(pLogStore, pNode, pEntry) < 0) {
-      sError("vgId:%d, failed to persist sync log entry from buffer since %s. index:%" PRId64, pNode->vgId, terrstr(),
-             pEntry->index);
+    syncLogPersisterWait(pNode->pLogPersister);
+    if (syncLogStorePersist(pLogStore, pNode, pEntries, num) < 0) {
+      sError("vgId:%d, failed to persist sync log entries from buffer since %s. index:%" PRId64 ", num:%d",
+             pNode->vgId, terrstr(), pEntries[0]->index, num);
       taosMsleep(1);
       goto _out;
     }
@@ -605,7 +646,7 @@ int32_t syncLogBufferCommit(SSyncLogBuffer* pBuf, SSyncNode* pNode, int64_t comm
   SyncTerm        currentTerm = raftStoreGetTerm(pNode);
   SyncGroupId     vgId = pNode->vgId;
   int32_t         ret = -1;
-  int64_t         upperIndex = TMIN(commitIndex, pBuf->matchIndex);
+  int64_t         upperIndex = TMIN(commitIndex, syncLogPersisterLastIndex(pNode->pLogPersister, pBuf->matchIndex));
   SSyncRaftEntry* pEntry = NULL;
   bool            inBuf = false;
   SSyncRaftEntry* pNextEntry = NULL;
@@ -781,21 +822,30 @@ int32_t syncLogReplRetryOnNeed(SSyncLogReplMgr* pMgr, SSyncNode* pNode) {
       continue;
     }
 
-    bool barrier = false;
-    if (syncLogReplSendTo(pMgr, pNode, index, &term, pDestId, &barrier) < 0) {
+    // resend the following entries which are not acked and timed out either in one msg
+    SyncIndex lastIndex = index;
+    while (lastIndex + 1 < pMgr->endIndex && lastIndex - index + 1 < batchSize - count) {
+      int64_t nextPos = (lastIndex + 1) % pMgr->size;
+      if (pMgr->states[nextPos].acked || nowMs < pMgr->states[nextPos].timeMs + retryWaitMs) {
+        break;
+      }
+      lastIndex++;
+    }
+
+    bool    barrier = false;
+    int32_t num = syncLogReplSendTo(pMgr, pNode, index, lastIndex, &term, pDestId, &barrier);
+    if (num < 0) {
       sError("vgId:%d, failed to replicate sync log entry since %s. index:%" PRId64 ", dest:%" PRIx64 "", pNode->vgId,
              terrstr(), index, pDestId->addr);
       goto _out;
     }
-    ASSERT(barrier == pMgr->states[pos].barrier);
-    pMgr->states[pos].timeMs = nowMs;
-    pMgr->states[pos].term = term;
-    pMgr->states[pos].acked = false;
 
     retried = true;
     if (firstIndex == -1) firstIndex = index;
 
-    if (batchSize <= count++) {
+    index += num - 1;
+    count += num;
+    if (batchSize <= count) {
       break;
     }
   }
@@ -909,6 +959,7 @@ int32_t syncLogReplProcessHeartbeatReply(SSyncLogReplMgr* pMgr, SSyncNode* pNode
     syncLogReplReset(pMgr);
     pMgr->peerStartTime = pMsg->startTime;
   }
+  pMgr->peerFeatures = pMsg->features;
   taosThreadMutexUnlock(&pBuf->mutex);
   return 0;
 }
@@ -921,6 +972,8 @@ int32_t syncLogReplProcessReply(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncApp
           pNode->vgId, pMsg->srcId.addr, pMsg->startTime, pMgr->peerStartTime);
     syncLogReplReset(pMgr);
     pMgr->peerStartTime = pMsg->startTime;
+    // the restarted peer may be of another version, which is known by its next heartbeat reply
+    pMgr->peerFeatures = 0;
   }
 
   if (pMgr->restored) {
@@ -956,18 +1009,13 @@ int32_t syncLogReplProbe(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex inde
   SRaftId* pDestId = &pNode->replicasId[pMgr->peerId];
   bool     barrier = false;
   SyncTerm term = -1;
-  if (syncLogReplSendTo(pMgr, pNode, index, &term, pDestId, &barrier) < 0) {
+  ASSERT(index >= 0);
+  if (syncLogReplSendTo(pMgr, pNode, index, index, &term, pDestId, &barrier) < 0) {
     sError("vgId:%d, failed to replicate log entry since %s. index:%" PRId64 ", dest: 0x%016" PRIx64 "", pNode->vgId,
            terrstr(), index, pDestId->addr);
     return -1;
   }
 
-  ASSERT(index >= 0);
-  pMgr->states[index % pMgr->size].barrier = barrier;
-  pMgr->states[index % pMgr->size].timeMs = nowMs;
-  pMgr->states[index % pMgr->size].term = term;
-  pMgr->states[index % pMgr->size].acked = false;
-
   pMgr->startIndex = index;
   pMgr->endIndex = index + 1;
 
@@ -985,40 +1033,38 @@ int32_t syncLogReplAttempt(SSyncLogReplMgr* pMgr, SSyncNode* pNode) {
   SRaftId*  pDestId = &pNode->replicasId[pMgr->peerId];
   int32_t   batchSize = TMAX(1, pMgr->size >> (4 + pMgr->retryBackoff));
   int32_t   count = 0;
-  int64_t   nowMs = taosGetMonoTimestampMs();
   int64_t   limit = pMgr->size >> 1;
   SyncTerm  term = -1;
   SyncIndex firstIndex = -1;
 
-  for (SyncIndex index = pMgr->endIndex; index <= pNode->pLogBuf->matchIndex; index++) {
+  for (SyncIndex index = pMgr->endIndex; index <= pNode->pLogBuf->matchIndex;) {
     if (batchSize < count || limit <= index - pMgr->startIndex) {
       break;
     }
     if (pMgr->startIndex + 1 < index && pMgr->states[(index - 1) % pMgr->size].barrier) {
       break;
     }
-    int64_t  pos = index % pMgr->size;
-    SRaftId* pDestId = &pNode->replicasId[pMgr->peerId];
-    bool     barrier = false;
-    SyncTerm term = -1;
-    if (syncLogReplSendTo(pMgr, pNode, index, &term, pDestId, &barrier) < 0) {
+
+    // send a run of entries in one msg, within the window and the batch size of this attempt
+    SyncIndex lastIndex = TMIN(pNode->pLogBuf->matchIndex, pMgr->startIndex + limit - 1);
+    lastIndex = TMIN(lastIndex, index + batchSize - count);
+    bool    barrier = false;
+    int32_t num = syncLogReplSendTo(pMgr, pNode, index, lastIndex, &term, pDestId, &barrier);
+    if (num < 0) {
       sError("vgId:%d, failed to replicate log entry since %s. index:%" PRId64 ", dest: 0x%016" PRIx64 "", pNode->vgId,
              terrstr(), index, pDestId->addr);
       return -1;
     }
-    pMgr->states[pos].barrier = barrier;
-    pMgr->states[pos].timeMs = nowMs;
-    pMgr->states[pos].term = term;
-    pMgr->states[pos].acked = false;
 
     if (firstIndex == -1) firstIndex = index;
-    count++;
+    count += num;
+    index += num;
 
-    pMgr->endIndex = index + 1;
+    pMgr->endIndex = index;
     if (barrier) {
       sInfo("vgId:%d, replicated sync barrier to dnode:%d. index:%" PRId64 ", term:%" PRId64 ", repl-mgr:[%" PRId64
             " %" PRId64 ", %" PRId64 ")",
-            pNode->vgId, DID(pDestId), index, term, pMgr->startIndex, pMgr->matchIndex, pMgr->endIndex);
+            pNode->vgId, DID(pDestId), index - 1, term, pMgr->startIndex, pMgr->matchIndex, pMgr->endIndex);
       break;
     }
   }
@@ -1026,7 +1072,7 @@ int32_t syncLogReplAttempt(SSyncLogReplMgr* pMgr, SSyncNode* pNode) {
   syncLogReplRetryOnNeed(pMgr, pNode);
 
   SSyncLogBuffer* pBuf = pNode->pLogBuf;
-  sTrace("vgId:%d, replicated %d msgs to peer:%" PRIx64 ". indexes:%" PRId64 "..., terms: ...%" PRId64
+  sTrace("vgId:%d, replicated %d entries to peer:%" PRIx64 ". indexes:%" PRId64 "..., terms: ...%" PRId64
          ", repl-mgr:[%" PRId64 " %" PRId64 ", %" PRId64 "), buffer: [%" PRId64 " %" PRId64 " %" PRId64 ", %" PRId64
          ")",
          pNode->vgId, count, pDestId->addr, firstIndex, term, pMgr->startIndex, pMgr->matchIndex, pMgr->endIndex,
@@ -1165,6 +1211,9 @@ int32_t syncLogBufferRollback(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncIndex
     return 0;
   }
 
+  // the entries to be freed may be in flight of the persister
+  syncLogPersisterWait(pNode->pLogPersister);
+
   sInfo("vgId:%d, rollback sync log buffer. toindex:%" PRId64 ", buffer: [%" PRId64 " %" PRId64 " %" PRId64
         ", %" PRId64 ")",
         pNode->vgId, toIndex, pBuf->startIndex, pBuf->commitIndex, pBuf->matchIndex, pBuf->endIndex);
@@ -1210,7 +1259,14 @@ int32_t syncLogBufferRollback(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncIndex
 int32_t syncLogBufferReset(SSyncLogBuffer* pBuf, SSyncNode* pNode) {
   taosThreadMutexLock(&pBuf->mutex);
   syncLogBufferValidate(pBuf);
+  syncLogPersisterWait(pNode->pLogPersister);
   SyncIndex lastVer = pNode->pLogStore->syncLogLastIndex(pNode->pLogStore);
+  if (syncLogPersisterFailed(pNode->pLogPersister)) {
+    // the entries dropped by the persister are not in the wal, and never committed
+    ASSERT(pBuf->commitIndex <= lastVer && lastVer <= pBuf->matchIndex);
+    pBuf->matchIndex = lastVer;
+    syncLogPersisterRecover(pNode->pLogPersister);
+  }
   ASSERT(lastVer == pBuf->matchIndex);
   SyncIndex index = pBuf->endIndex - 1;
 
@@ -1248,59 +1304,89 @@ SSyncRaftEntry* syncLogBufferGetOneEntry(SSyncLogBuffer* pBuf, SSyncNode* pNode,
   return pEntry;
 }
 
-int32_t syncLogReplSendTo(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex index, SyncTerm* pTerm, SRaftId* pDestId,
-                          bool* pBarrier) {
-  SSyncRaftEntry* pEntry = NULL;
+// send the entries from index to at most lastIndex in one msg, bounded by SYNC_MAX_BATCH_SIZE and
+// SYNC_MAX_BATCH_BYTES, and a barrier ends the msg. return the number of entries sent, or -1 on error.
+int32_t syncLogReplSendTo(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex index, SyncIndex lastIndex,
+                          SyncTerm* pTerm, SRaftId* pDestId, bool* pBarrier) {
+  SSyncRaftEntry* pEntries[SYNC_MAX_BATCH_SIZE] = {0};
+  bool            inBufs[SYNC_MAX_BATCH_SIZE] = {0};
+  int32_t         num = 0;
+  int64_t         bytes = 0;
   SRpcMsg         msgOut = {0};
-  bool            inBuf = false;
   SyncTerm        prevLogTerm = -1;
   SSyncLogBuffer* pBuf = pNode->pLogBuf;
 
-  pEntry = syncLogBufferGetOneEntry(pBuf, pNode, index, &inBuf);
-  if (pEntry == NULL) {
-    sWarn("vgId:%d, failed to get raft entry for index:%" PRId64 "", pNode->vgId, index);
-    if (terrno == TSDB_CODE_WAL_LOG_NOT_EXIST) {
-      SSyncLogReplMgr* pMgr = syncNodeGetLogReplMgr(pNode, pDestId);
-      if (pMgr) {
-        sInfo("vgId:%d, reset sync log repl of peer:%" PRIx64 " since %s. index:%" PRId64, pNode->vgId, pDestId->addr,
-              terrstr(), index);
-        (void)syncLogReplReset(pMgr);
+  ASSERT(index <= lastIndex);
+  // a peer of an older version parses one entry per msg only
+  int32_t maxNum = (pMgr->peerFeatures & SYNC_FEATURE_BATCH_APPEND) ? SYNC_MAX_BATCH_SIZE : 1;
+  lastIndex = TMIN(lastIndex, index + maxNum - 1);
+
+  for (SyncIndex i = index; i <= lastIndex; i++) {
+    SSyncRaftEntry* pEntry = syncLogBufferGetOneEntry(pBuf, pNode, i, &inBufs[num]);
+    if (pEntry == NULL) {
+      sWarn("vgId:%d, failed to get raft entry for index:%" PRId64 "", pNode->vgId, i);
+      if (num > 0) {
+        break;
       }
+      if (terrno == TSDB_CODE_WAL_LOG_NOT_EXIST) {
+        SSyncLogReplMgr* pMgr = syncNodeGetLogReplMgr(pNode, pDestId);
+        if (pMgr) {
+          sInfo("vgId:%d, reset sync log repl of peer:%" PRIx64 " since %s. index:%" PRId64, pNode->vgId,
+                pDestId->addr, terrstr(), index);
+          (void)syncLogReplReset(pMgr);
+        }
+      }
+      goto _err;
+    }
+    pEntries[num++] = pEntry;
+    bytes += pEntry->bytes;
+
+    if (syncLogReplBarrier(pEntry) || bytes >= SYNC_MAX_BATCH_BYTES) {
+      break;
     }
-    goto _err;
   }
-  *pBarrier = syncLogReplBarrier(pEntry);
+  SSyncRaftEntry* pLast = pEntries[num - 1];
+  *pBarrier = syncLogReplBarrier(pLast);
 
   prevLogTerm = syncLogReplGetPrevLogTerm(pMgr, pNode, index);
   if (prevLogTerm < 0) {
     sError("vgId:%d, failed to get prev log term since %s. index:%" PRId64 "", pNode->vgId, terrstr(), index);
     goto _err;
   }
-  if (pTerm) *pTerm = pEntry->term;
+  if (pTerm) *pTerm = pLast->term;
 
-  int32_t code = syncBuildAppendEntriesFromRaftEntry(pNode, pEntry, prevLogTerm, &msgOut);
+  int32_t code = syncBuildAppendEntriesFromRaftEntries(pNode, pEntries, num, prevLogTerm, &msgOut);
   if (code < 0) {
-    sError("vgId:%d, failed to get append entries for index:%" PRId64 "", pNode->vgId, index);
+    sError("vgId:%d, failed to get append entries for index:%" PRId64 ", num:%d", pNode->vgId, index, num);
     goto _err;
   }
 
   (void)syncNodeSendAppendEntries(pNode, pDestId, &msgOut);
 
-  sTrace("vgId:%d, replicate one msg index:%" PRId64 " term:%" PRId64 " prevterm:%" PRId64 " to dest: 0x%016" PRIx64,
-         pNode->vgId, pEntry->index, pEntry->term, prevLogTerm, pDestId->addr);
+  // the terms are kept for the prev log term of the following msgs
+  int64_t nowMs = taosGetMonoTimestampMs();
+  for (int32_t i = 0; i < num; ++i) {
+    int64_t pos = pEntries[i]->index % pMgr->size;
+    pMgr->states[pos].barrier = syncLogReplBarrier(pEntries[i]);
+    pMgr->states[pos].timeMs = nowMs;
+    pMgr->states[pos].term = pEntries[i]->term;
+    pMgr->states[pos].acked = false;
+  }
 
-  if (!inBuf) {
-    syncEntryDestroy(pEntry);
-    pEntry = NULL;
+  sTrace("vgId:%d, replicate %d msgs index:%" PRId64 " ... %" PRId64 " term:%" PRId64 " prevterm:%" PRId64
+         " to dest: 0x%016" PRIx64,
+         pNode->vgId, num, index, pLast->index, pLast->term, prevLogTerm, pDestId->addr);
+
+  for (int32_t i = 0; i < num; ++i) {
+    if (!inBufs[i]) syncEntryDestroy(pEntries[i]);
   }
-  return 0;
+  return num;
 
 _err:
   rpcFreeCont(msgOut.pCont);
   msgOut.pCont = NULL;
-  if (!inBuf) {
-    syncEntryDestroy(pEntry);
-    pEntry = NULL;
+  for (int32_t i = 0; i < num; ++i) {
+    if (!inBufs[i]) syncEntryDestroy(pEntries[i]);
   }
   return -1;
 }
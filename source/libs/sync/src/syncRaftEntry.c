@@ -63,14 +63,17 @@ SSyncRaftEntry* syncEntryBuildFromRpcMsg(const SRpcMsg* pMsg, SyncTerm term, Syn
   return pEntry;
 }
 
-SSyncRaftEntry* syncEntryBuildFromAppendEntries(const SyncAppendEntries* pMsg) {
-  SSyncRaftEntry* pEntry = taosMemoryMalloc(pMsg->dataLen);
+SSyncRaftEntry* syncEntryBuildFromAppendEntries(const SyncAppendEntries* pMsg, uint32_t offset) {
+  uint32_t bytes = 0;
+  memcpy(&bytes, pMsg->data + offset + offsetof(SSyncRaftEntry, bytes), sizeof(bytes));
+  ASSERT(bytes >= sizeof(SSyncRaftEntry) && offset + bytes <= pMsg->dataLen);
+
+  SSyncRaftEntry* pEntry = taosMemoryMalloc(bytes);
   if (pEntry == NULL) {
     terrno = TSDB_CODE_OUT_OF_MEMORY;
     return NULL;
   }
-  memcpy(pEntry, pMsg->data, pMsg->dataLen);
-  ASSERT(pEntry->bytes == pMsg->dataLen);
+  memcpy(pEntry, pMsg->data + offset, bytes);
   return pEntry;
 }
 
@@ -24,6 +24,8 @@
 // public function
 static int32_t   raftLogRestoreFromSnapshot(struct SSyncLogStore* pLogStore, SyncIndex snapshotIndex);
 static int32_t   raftLogAppendEntry(struct SSyncLogStore* pLogStore, SSyncRaftEntry* pEntry, bool forceSync);
+static int32_t   raftLogAppendEntries(struct SSyncLogStore* pLogStore, SSyncRaftEntry** ppEntries, int32_t num,
+                                      bool forceSync);
 static int32_t   raftLogTruncate(struct SSyncLogStore* pLogStore, SyncIndex fromIndex);
 static bool      raftLogExist(struct SSyncLogStore* pLogStore, SyncIndex index);
 static int32_t   raftLogUpdateCommitIndex(SSyncLogStore* pLogStore, SyncIndex index);
@@ -38,7 +40,7 @@ SSyncLogStore* logStoreCreate(SSyncNode* pSyncNode) {
   }
 
   // pLogStore->pCache = taosLRUCacheInit(10 * 1024 * 1024, 1, .5);
-  pLogStore->pCache = taosLRUCacheInit(30 * 1024 * 1024, 1, .5);
+  pLogStore->pCache = taosLRUCacheInit(30 * 1024 * 1024, 1, .5, TAOS_LRU_POLICY_LRU);
   if (pLogStore->pCache == NULL) {
     taosMemoryFree(pLogStore);
     terrno = TSDB_CODE_OUT_OF_MEMORY;
@@ -73,6 +75,7 @@ SSyncLogStore* logStoreCreate(SSyncNode* pSyncNode) {
   pLogStore->syncLogIndexRetention = raftLogIndexRetention;
   pLogStore->syncLogLastTerm = raftLogLastTerm;
   pLogStore->syncLogAppendEntry = raftLogAppendEntry;
+  pLogStore->syncLogAppendEntries = raftLogAppendEntries;
   pLogStore->syncLogGetEntry = raftLogGetEntry;
   pLogStore->syncLogTruncate = raftLogTruncate;
   pLogStore->syncLogWriteIndex = raftLogWriteIndex;
@@ -203,16 +206,33 @@ SyncTerm raftLogLastTerm(struct SSyncLogStore* pLogStore) {
 }
 
 static int32_t raftLogAppendEntry(struct SSyncLogStore* pLogStore, SSyncRaftEntry* pEntry, bool forceSync) {
+  return raftLogAppendEntries(pLogStore, &pEntry, 1, forceSync);
+}
+
+static int32_t raftLogAppendEntries(struct SSyncLogStore* pLogStore, SSyncRaftEntry** ppEntries, int32_t num,
+                                    bool forceSync) {
   SSyncLogStoreData* pData = pLogStore->data;
   SWal*              pWal = pData->pWal;
 
-  SyncIndex    index = 0;
-  SWalSyncInfo syncMeta = {0};
-  syncMeta.isWeek = pEntry->isWeak;
-  syncMeta.seqNum = pEntry->seqNum;
-  syncMeta.term = pEntry->term;
+  ASSERT(num > 0 && num <= SYNC_MAX_BATCH_SIZE);
+
+  SyncIndex       index = 0;
+  SWalAppendEntry walEntries[SYNC_MAX_BATCH_SIZE];
+  for (int32_t i = 0; i < num; ++i) {
+    SSyncRaftEntry*  pEntry = ppEntries[i];
+    SWalAppendEntry* pWalEntry = &walEntries[i];
+    pWalEntry->index = pEntry->index;
+    pWalEntry->msgType = pEntry->originalRpcType;
+    pWalEntry->syncMeta.isWeek = pEntry->isWeak;
+    pWalEntry->syncMeta.seqNum = pEntry->seqNum;
+    pWalEntry->syncMeta.term = pEntry->term;
+    pWalEntry->body = pEntry->data;
+    pWalEntry->bodyLen = pEntry->dataLen;
+  }
+
+  // the entries are written and fsynced if required under one lock of the wal
   int64_t tsWriteBegin = taosGetTimestampNs();
-  index = walAppendLog(pWal, pEntry->index, pEntry->originalRpcType, syncMeta, pEntry->data, pEntry->dataLen);
+  index = walAppendLogs(pWal, walEntries, num, forceSync);
   int64_t tsWriteEnd = taosGetTimestampNs();
   int64_t tsElapsed = tsWriteEnd - tsWriteBegin;
 
@@ -222,17 +242,16 @@ static int32_t raftLogAppendEntry(struct SSyncLogStore* pLogStore, SSyncRaftEntr
     int32_t     sysErr = errno;
     const char* sysErrStr = strerror(errno);
 
-    sNError(pData->pSyncNode, "wal write error, index:%" PRId64 ", err:0x%x, msg:%s, syserr:%d, sysmsg:%s",
-            pEntry->index, err, errStr, sysErr, sysErrStr);
+    sNError(pData->pSyncNode, "wal write error, index:%" PRId64 ", num:%d, err:0x%x, msg:%s, syserr:%d, sysmsg:%s",
+            ppEntries[0]->index, num, err, errStr, sysErr, sysErrStr);
     return -1;
   }
 
-  ASSERT(pEntry->index == index);
-
-  walFsync(pWal, forceSync);
+  ASSERT(ppEntries[num - 1]->index == index);
 
-  sNTrace(pData->pSyncNode, "write index:%" PRId64 ", type:%s, origin type:%s, elapsed:%" PRId64, pEntry->index,
-          TMSG_INFO(pEntry->msgType), TMSG_INFO(pEntry->originalRpcType), tsElapsed);
+  sNTrace(pData->pSyncNode, "write index:%" PRId64 ", num:%d, type:%s, origin type:%s, elapsed:%" PRId64,
+          ppEntries[0]->index, num, TMSG_INFO(ppEntries[0]->msgType), TMSG_INFO(ppEntries[0]->originalRpcType),
+          tsElapsed);
   return 0;
 }
 
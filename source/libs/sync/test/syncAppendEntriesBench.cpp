@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Throughput of the replication of a raft group, from proposing the entries on the leader to committing them on each
+// replica, with runs of entries in one append entries msg or one entry per msg. Each replica is a process of its own:
+//   syncAppendEntriesBench replicaNum myIndex numOfEntries entrySize batch
+// e.g. run the three replicas of a group with
+//   syncAppendEntriesBench 3 0 100000 256 1 & syncAppendEntriesBench 3 1 100000 256 1 &
+//   syncAppendEntriesBench 3 2 100000 256 1
+// A replica with batch 0 hides SYNC_FEATURE_BATCH_APPEND from its heartbeat replies, like a replica of an older
+// version, so that the leader sends it one entry per msg.
+
+#include "syncTest.h"
+
+static uint16_t    benchPorts[] = {7010, 7110, 7210, 7310, 7410};
+static const char *benchDir = "./syncAppendEntriesBench";
+static int32_t     benchVgId = 1000;
+
+static bool    benchBatch = true;
+static int64_t benchNumOfCommitted = 0;
+static int64_t benchFirstCommitUs = 0;
+static int64_t benchAppliedIndex = SYNC_INDEX_INVALID;
+static int64_t benchNumOfMsgs = 0;
+static int64_t benchNumOfEntriesSent = 0;
+
+static int32_t benchCommitCb(const SSyncFSM *pFsm, SRpcMsg *pMsg, SFsmCbMeta *pMeta) {
+  if (pMsg->msgType == TDMT_VND_SUBMIT && pMeta->code == 0) {
+    (void)atomic_val_compare_exchange_64(&benchFirstCommitUs, 0, taosGetTimestampUs());
+    (void)atomic_add_fetch_64(&benchNumOfCommitted, 1);
+  }
+  atomic_store_64(&benchAppliedIndex, pMeta->index);
+  rpcFreeCont(pMsg->pCont);
+  pMsg->pCont = NULL;
+  return 0;
+}
+
+static SyncIndex benchAppliedIndexCb(const SSyncFSM *pFsm) { return atomic_load_64(&benchAppliedIndex); }
+
+static int32_t benchPreCommitCb(const SSyncFSM *pFsm, SRpcMsg *pMsg, SFsmCbMeta *pMeta) { return 0; }
+
+static void benchRollBackCb(const SSyncFSM *pFsm, SRpcMsg *pMsg, SFsmCbMeta *pMeta) {}
+
+static void benchRestoreFinishCb(const SSyncFSM *pFsm, const SyncIndex commitIdx) {}
+
+static int32_t benchApplyQueueItems(const SSyncFSM *pFsm) { return 0; }
+
+static int32_t benchGetSnapshotInfo(const SSyncFSM *pFsm, SSnapshot *pSnapshot) {
+  pSnapshot->data = NULL;
+  pSnapshot->lastApplyIndex = SYNC_INDEX_INVALID;
+  pSnapshot->lastApplyTerm = 0;
+  pSnapshot->lastConfigIndex = SYNC_INDEX_INVALID;
+  return 0;
+}
+
+static SSyncFSM *benchCreateFsm() {
+  SSyncFSM *pFsm = (SSyncFSM *)taosMemoryCalloc(1, sizeof(SSyncFSM));
+  pFsm->FpCommitCb = benchCommitCb;
+  pFsm->FpAppliedIndexCb = benchAppliedIndexCb;
+  pFsm->FpPreCommitCb = benchPreCommitCb;
+  pFsm->FpRollBackCb = benchRollBackCb;
+  pFsm->FpRestoreFinishCb = benchRestoreFinishCb;
+  pFsm->FpApplyQueueItems = benchApplyQueueItems;
+  pFsm->FpGetSnapshotInfo = benchGetSnapshotInfo;
+  return pFsm;
+}
+
+// counts the append entries msgs and their entries on the way out
+static int32_t benchSendMsg(const SEpSet *pEpSet, SRpcMsg *pMsg) {
+  if (pMsg->msgType == TDMT_SYNC_APPEND_ENTRIES) {
+    SyncAppendEntries *pAppend = (SyncAppendEntries *)pMsg->pCont;
+    for (uint32_t offset = 0; offset < pAppend->dataLen;) {
+      SSyncRaftEntry *pEntry = (SSyncRaftEntry *)(pAppend->data + offset);
+      offset += pEntry->bytes;
+      (void)atomic_add_fetch_64(&benchNumOfEntriesSent, 1);
+    }
+    (void)atomic_add_fetch_64(&benchNumOfMsgs, 1);
+  } else if (pMsg->msgType == TDMT_SYNC_HEARTBEAT_REPLY && !benchBatch) {
+    ((SyncHeartbeatReply *)pMsg->pCont)->features &= ~SYNC_FEATURE_BATCH_APPEND;
+  }
+  return syncIOSendMsg(pEpSet, pMsg);
+}
+
+static SWal *benchCreateWal(const char *path, int32_t vgId) {
+  SWalCfg walCfg = {0};
+  walCfg.vgId = vgId;
+  walCfg.fsyncPeriod = 0;
+  walCfg.retentionPeriod = 0;
+  walCfg.rollPeriod = -1;
+  walCfg.retentionSize = 0;
+  walCfg.segSize = -1;
+  walCfg.level = TAOS_WAL_WRITE;
+  SWal *pWal = walOpen(path, &walCfg);
+  assert(pWal != NULL);
+  return pWal;
+}
+
+static int64_t benchCreateSyncNode(int32_t replicaNum, int32_t myIndex, SWal *pWal) {
+  SSyncInfo syncInfo = {0};
+  syncInfo.vgId = benchVgId;
+  syncInfo.batchSize = 1;
+  syncInfo.msgcb = &gSyncIO->msgcb;
+  syncInfo.syncSendMSg = benchSendMsg;
+  syncInfo.syncEqMsg = syncIOEqMsg;
+  syncInfo.syncEqCtrlMsg = syncIOEqMsg;
+  syncInfo.pFsm = benchCreateFsm();
+  syncInfo.pWal = pWal;
+  syncInfo.pingMs = 5000;
+  syncInfo.electMs = 2000;
+  syncInfo.heartbeatMs = 100;
+  snprintf(syncInfo.path, sizeof(syncInfo.path), "%s_sync_replica%d_index%d", benchDir, replicaNum, myIndex);
+  taosRemoveDir(syncInfo.path);
+
+  SSyncCfg *pCfg = &syncInfo.syncCfg;
+  pCfg->myIndex = myIndex;
+  pCfg->replicaNum = replicaNum;
+  pCfg->totalReplicaNum = replicaNum;
+  for (int32_t i = 0; i < replicaNum; ++i) {
+    pCfg->nodeInfo[i].nodeId = i + 1;
+    pCfg->nodeInfo[i].nodePort = benchPorts[i];
+    pCfg->nodeInfo[i].nodeRole = TAOS_SYNC_ROLE_VOTER;
+    snprintf(pCfg->nodeInfo[i].nodeFqdn, sizeof(pCfg->nodeInfo[i].nodeFqdn), "%s", "127.0.0.1");
+  }
+
+  int64_t rid = syncOpen(&syncInfo, 1);
+  assert(rid > 0);
+  return rid;
+}
+
+// proposes the entries on the leader, and retries those refused while the log buffer is full
+static void benchPropose(int64_t rid, int32_t numOfEntries, int32_t entrySize) {
+  for (int32_t i = 0; i < numOfEntries;) {
+    SRpcMsg rpcMsg = {0};
+    rpcMsg.msgType = TDMT_VND_SUBMIT;
+    rpcMsg.contLen = entrySize;
+    rpcMsg.pCont = rpcMallocCont(entrySize);
+    memset(rpcMsg.pCont, 'a' + i % 26, entrySize);
+
+    int32_t code = syncPropose(rid, &rpcMsg, false, NULL);
+    rpcFreeCont(rpcMsg.pCont);
+    if (code == 0) {
+      ++i;
+    } else if (terrno == TSDB_CODE_SYN_NOT_LEADER) {
+      printf("not the leader any more\n");
+      return;
+    } else {
+      taosMsleep(1);
+    }
+  }
+}
+
+int main(int argc, char *argv[]) {
+  if (argc < 6) {
+    printf("usage: %s replicaNum myIndex numOfEntries entrySize batch\n", argv[0]);
+    return -1;
+  }
+  int32_t replicaNum = atoi(argv[1]);
+  int32_t myIndex = atoi(argv[2]);
+  int32_t numOfEntries = atoi(argv[3]);
+  int32_t entrySize = atoi(argv[4]);
+  benchBatch = atoi(argv[5]) != 0;
+  assert(replicaNum > 0 && replicaNum <= (int32_t)(sizeof(benchPorts) / sizeof(benchPorts[0])));
+  assert(myIndex >= 0 && myIndex < replicaNum);
+
+  tsAsyncLog = 0;
+  sDebugFlag = DEBUG_ERROR;
+
+  int32_t code = walInit();
+  assert(code == 0);
+  code = syncInit();
+  assert(code == 0);
+  code = syncIOStart((char *)"127.0.0.1", benchPorts[myIndex]);
+  assert(code == 0);
+
+  char walPath[128];
+  snprintf(walPath, sizeof(walPath), "%s_wal_replica%d_index%d", benchDir, replicaNum, myIndex);
+  taosRemoveDir(walPath);
+  SWal *pWal = benchCreateWal(walPath, benchVgId);
+
+  int64_t rid = benchCreateSyncNode(replicaNum, myIndex, pWal);
+  gSyncIO->rid = rid;
+  code = syncStart(rid);
+  assert(code == 0);
+
+  // the replica elected proposes the entries once it is restored, and the others time from their first commit
+  bool    isLeader = false;
+  int64_t st = 0;
+  while (atomic_load_64(&benchNumOfCommitted) < numOfEntries) {
+    SSyncState state = syncGetState(rid);
+    if (!isLeader && state.state == TAOS_SYNC_STATE_LEADER && state.restored) {
+      isLeader = true;
+      st = taosGetTimestampUs();
+      benchPropose(rid, numOfEntries, entrySize);
+    } else {
+      taosMsleep(1);
+    }
+  }
+  if (!isLeader) st = atomic_load_64(&benchFirstCommitUs);
+  int64_t el = taosGetTimestampUs() - st;
+
+  int64_t numOfMsgs = atomic_load_64(&benchNumOfMsgs);
+  int64_t numOfSent = atomic_load_64(&benchNumOfEntriesSent);
+  printf("%-8s %6s %12s %12s %12s %12s %12s\n", "role", "batch", "entries", "elapsed(us)", "entries/s", "msgs",
+         "entries/msg");
+  printf("%-8s %6d %12d %12" PRId64 " %12.1f %12" PRId64 " %12.2f\n",
+         isLeader ? "leader" : "follower", benchBatch, numOfEntries, el,
+         (el > 0) ? (double)numOfEntries * 1000000 / el : 0, numOfMsgs,
+         (numOfMsgs > 0) ? (double)numOfSent / numOfMsgs : 0);
+
+  // let the followers commit the last entries before the leader goes away
+  taosSsleep(3);
+  syncStop(rid);
+  (void)syncIOStop();
+  walClose(pWal);
+  syncCleanUp();
+  walCleanUp();
+  taosRemoveDir(walPath);
+  return 0;
+}
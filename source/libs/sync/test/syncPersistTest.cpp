@@ -0,0 +1,295 @@
+#include <gtest/gtest.h>
+#include "syncCommit.h"
+#include "syncIndexMgr.h"
+#include "syncInt.h"
+#include "syncPersist.h"
+#include "syncPipeline.h"
+#include "syncRaftEntry.h"
+#include "syncRaftStore.h"
+
+// a log store of the last index only, whose writes can be held or failed by the test
+static SyncIndex testLastIndex = SYNC_INDEX_INVALID;
+static int8_t    testGateClosed = 0;
+static int32_t   testFailures = 0;  // the number of writes to fail, or -1 for all
+
+// the last local cmd enqueued by the persister, which is dropped if testEqFail is set
+static int8_t    testEqFail = 0;
+static int32_t   testCmd = -1;
+static SyncIndex testCmdIndex = SYNC_INDEX_INVALID;
+static int32_t   testNumOfCmds = 0;
+
+static SyncIndex testLogLastIndex(SSyncLogStore *pLogStore) { return atomic_load_64(&testLastIndex); }
+
+static int32_t testLogUpdateCommitIndex(SSyncLogStore *pLogStore, SyncIndex index) { return 0; }
+
+static int32_t testLogAppendEntries(SSyncLogStore *pLogStore, SSyncRaftEntry **ppEntries, int32_t num, bool fsync) {
+  while (atomic_load_8(&testGateClosed)) {
+    taosMsleep(1);
+  }
+  int32_t failures = atomic_load_32(&testFailures);
+  if (failures != 0) {
+    if (failures > 0) (void)atomic_sub_fetch_32(&testFailures, 1);
+    terrno = TSDB_CODE_WAL_FILE_CORRUPTED;
+    return -1;
+  }
+  atomic_store_64(&testLastIndex, ppEntries[num - 1]->index);
+  return 0;
+}
+
+static int32_t testLogTruncate(SSyncLogStore *pLogStore, SyncIndex fromIndex) {
+  atomic_store_64(&testLastIndex, fromIndex - 1);
+  return 0;
+}
+
+static int32_t testEqMsg(const SMsgCb *msgcb, SRpcMsg *pMsg) {
+  if (atomic_load_8(&testEqFail)) {
+    terrno = TSDB_CODE_OUT_OF_RPC_MEMORY_QUEUE;
+    return -1;
+  }
+  SyncLocalCmd *pCmd = (SyncLocalCmd *)pMsg->pCont;
+  atomic_store_64(&testCmdIndex, pCmd->commitIndex);
+  atomic_store_32(&testCmd, pCmd->cmd);
+  (void)atomic_add_fetch_32(&testNumOfCmds, 1);
+  rpcFreeCont(pMsg->pCont);
+  return 0;
+}
+
+class SyncPersistTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    tsAsyncLog = 0;
+    sDebugFlag = DEBUG_ERROR;
+  }
+
+  void SetUp() override {
+    testLastIndex = SYNC_INDEX_INVALID;
+    testGateClosed = 0;
+    testFailures = 0;
+    testEqFail = 0;
+    testCmd = -1;
+    testCmdIndex = SYNC_INDEX_INVALID;
+    testNumOfCmds = 0;
+
+    logStore.syncLogLastIndex = testLogLastIndex;
+    logStore.syncLogUpdateCommitIndex = testLogUpdateCommitIndex;
+    logStore.syncLogAppendEntries = testLogAppendEntries;
+    logStore.syncLogTruncate = testLogTruncate;
+
+    // the leader of 3 replicas, which commits on the quorum only
+    pNode = (SSyncNode *)taosMemoryCalloc(1, sizeof(SSyncNode));
+    pNode->vgId = 2;
+    pNode->state = TAOS_SYNC_STATE_LEADER;
+    pNode->replicaNum = 3;
+    pNode->totalReplicaNum = 3;
+    pNode->quorum = 2;
+    for (int32_t i = 0; i < pNode->totalReplicaNum; ++i) {
+      pNode->replicasId[i].addr = i + 1;
+      pNode->replicasId[i].vgId = pNode->vgId;
+      pNode->raftCfg.cfg.nodeInfo[i].nodeRole = TAOS_SYNC_ROLE_VOTER;
+    }
+    pNode->myRaftId = pNode->replicasId[0];
+    pNode->commitIndex = SYNC_INDEX_INVALID;
+    pNode->fsmState = SYNC_FSM_STATE_INCOMPLETE;
+    taosThreadMutexInit(&pNode->raftStore.mutex, NULL);
+    pNode->raftStore.currentTerm = 1;
+    pNode->pLogStore = &logStore;
+    pNode->syncEqMsg = testEqMsg;
+    pNode->msgcb = &msgcb;
+    pNode->pMatchIndex = syncIndexMgrCreate(pNode);
+    for (int32_t i = 0; i < pNode->totalReplicaNum; ++i) {
+      syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->replicasId[i], SYNC_INDEX_INVALID);
+    }
+    pNode->pLogPersister = syncLogPersisterCreate(pNode);
+    ASSERT_NE(pNode->pLogPersister, nullptr);
+
+    for (int32_t i = 0; i < numOfEntries; ++i) {
+      pEntries[i] = syncEntryBuild(16);
+      pEntries[i]->msgType = TDMT_SYNC_CLIENT_REQUEST;
+      pEntries[i]->originalRpcType = TDMT_VND_SUBMIT;
+      pEntries[i]->term = 1;
+      pEntries[i]->index = i;
+    }
+  }
+
+  void TearDown() override {
+    atomic_store_8(&testGateClosed, 0);
+    syncLogPersisterDestroy(pNode->pLogPersister);
+    syncIndexMgrDestroy(pNode->pMatchIndex);
+    taosThreadMutexDestroy(&pNode->raftStore.mutex);
+    taosMemoryFree(pNode);
+    for (int32_t i = 0; i < numOfEntries; ++i) {
+      syncEntryDestroy(pEntries[i]);
+    }
+  }
+
+  // wait until the persister is writing the entries queued, i.e. held by the gate
+  void waitInFlight() {
+    for (int32_t i = 0; i < 1000; ++i) {
+      taosThreadMutexLock(&pNode->pLogPersister->mutex);
+      bool inFlight = pNode->pLogPersister->persistIndex != pNode->pLogPersister->queueIndex;
+      taosThreadMutexUnlock(&pNode->pLogPersister->mutex);
+      if (inFlight) return;
+      taosMsleep(1);
+    }
+  }
+
+  // wait until the persister has enqueued the cmd, which is done after the waiters of the entries are woken up
+  void waitCmd(int32_t cmd, SyncIndex index) {
+    for (int32_t i = 0; i < 1000; ++i) {
+      if (atomic_load_32(&testCmd) == cmd && atomic_load_64(&testCmdIndex) == index) return;
+      taosMsleep(1);
+    }
+  }
+
+  static const int32_t numOfEntries = 10;
+
+  SSyncLogStore   logStore = {0};
+  SMsgCb          msgcb = {0};
+  SSyncNode      *pNode = NULL;
+  SSyncRaftEntry *pEntries[numOfEntries] = {0};
+};
+
+TEST_F(SyncPersistTest, persistAndNotify) {
+  ASSERT_EQ(syncLogPersisterPush(pNode->pLogPersister, pEntries, 4, 1), 0);
+  ASSERT_EQ(syncLogPersisterPush(pNode->pLogPersister, pEntries + 4, 6, 1), 0);
+  syncLogPersisterWait(pNode->pLogPersister);
+  waitCmd(SYNC_LOCAL_CMD_LEADER_PERSIST, 9);
+
+  EXPECT_EQ(testLastIndex, 9);
+  EXPECT_EQ(testCmd, SYNC_LOCAL_CMD_LEADER_PERSIST);
+  EXPECT_EQ(testCmdIndex, 9);
+  EXPECT_EQ(syncLogPersisterLastIndex(pNode->pLogPersister, 9), 9);
+  EXPECT_FALSE(syncLogPersisterFailed(pNode->pLogPersister));
+}
+
+// the leader commits neither on the quorum of the followers nor in the log buffer until its own write completes
+TEST_F(SyncPersistTest, commitClampedWhileInFlight) {
+  syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->replicasId[1], 9);
+  syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->replicasId[2], 9);
+
+  atomic_store_8(&testGateClosed, 1);
+  ASSERT_EQ(syncLogPersisterPush(pNode->pLogPersister, pEntries, numOfEntries, 1), 0);
+  waitInFlight();
+
+  EXPECT_EQ(syncLogPersisterLastIndex(pNode->pLogPersister, 9), SYNC_INDEX_INVALID);
+  EXPECT_EQ(syncNodeCheckCommitIndex(pNode, 9), SYNC_INDEX_INVALID);
+
+  atomic_store_8(&testGateClosed, 0);
+  syncLogPersisterWait(pNode->pLogPersister);
+  waitCmd(SYNC_LOCAL_CMD_LEADER_PERSIST, 9);
+  EXPECT_EQ(syncLogPersisterLastIndex(pNode->pLogPersister, 9), 9);
+
+  (void)syncNodeOnLogPersisted(pNode, 1, testCmdIndex);
+  EXPECT_EQ(syncIndexMgrGetIndex(pNode->pMatchIndex, &pNode->myRaftId), 9);
+  EXPECT_EQ(pNode->commitIndex, 9);
+}
+
+// the heartbeat reply catches up with the entries persisted, whose notification is lost
+TEST_F(SyncPersistTest, lostNotificationMadeUp) {
+  syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->replicasId[1], 5);
+
+  atomic_store_8(&testEqFail, 1);
+  ASSERT_EQ(syncLogPersisterPush(pNode->pLogPersister, pEntries, 6, 1), 0);
+  syncLogPersisterWait(pNode->pLogPersister);
+  EXPECT_EQ(testNumOfCmds, 0);
+  EXPECT_EQ(syncIndexMgrGetIndex(pNode->pMatchIndex, &pNode->myRaftId), SYNC_INDEX_INVALID);
+  EXPECT_EQ(pNode->commitIndex, SYNC_INDEX_INVALID);
+
+  syncNodeCheckLogPersisted(pNode);
+  EXPECT_EQ(syncIndexMgrGetIndex(pNode->pMatchIndex, &pNode->myRaftId), 5);
+  EXPECT_EQ(pNode->commitIndex, 5);
+
+  // the entries of a former term are not counted
+  pNode->raftStore.currentTerm = 2;
+  ASSERT_EQ(syncLogPersisterPush(pNode->pLogPersister, pEntries + 6, 4, 1), 0);
+  syncLogPersisterWait(pNode->pLogPersister);
+  syncNodeCheckLogPersisted(pNode);
+  EXPECT_EQ(syncIndexMgrGetIndex(pNode->pMatchIndex, &pNode->myRaftId), 5);
+}
+
+// the entries to be rolled back are freed only after the persister has written them
+TEST_F(SyncPersistTest, rollbackWhileInFlight) {
+  SSyncLogBuffer *pBuf = syncLogBufferCreate();
+  ASSERT_NE(pBuf, nullptr);
+  for (int32_t i = 0; i < numOfEntries; ++i) {
+    pBuf->entries[i].pItem = pEntries[i];
+    pBuf->entries[i].prevLogIndex = i - 1;
+    pBuf->entries[i].prevLogTerm = (i > 0) ? 1 : 0;
+    pEntries[i] = NULL;
+  }
+  pBuf->startIndex = 0;
+  pBuf->commitIndex = 2;
+  pBuf->matchIndex = 9;
+  pBuf->endIndex = 10;
+  pNode->pLogBuf = pBuf;
+  testLastIndex = 2;
+
+  atomic_store_8(&testGateClosed, 1);
+  SSyncRaftEntry *pInFlight[7];
+  for (int32_t i = 0; i < 7; ++i) {
+    pInFlight[i] = pBuf->entries[3 + i].pItem;
+  }
+  ASSERT_EQ(syncLogPersisterPush(pNode->pLogPersister, pInFlight, 7, 1), 0);
+  waitInFlight();
+
+  static int8_t rolledBack = 0;
+  rolledBack = 0;
+  TdThread thread;
+  ASSERT_EQ(taosThreadCreate(
+                &thread, NULL,
+                [](void *param) -> void * {
+                  SSyncNode *pNode = (SSyncNode *)param;
+                  EXPECT_EQ(syncLogBufferRollback(pNode->pLogBuf, pNode, 6), 0);
+                  atomic_store_8(&rolledBack, 1);
+                  return NULL;
+                },
+                pNode),
+            0);
+
+  taosMsleep(50);
+  EXPECT_EQ(atomic_load_8(&rolledBack), 0);
+
+  atomic_store_8(&testGateClosed, 0);
+  taosThreadJoin(thread, NULL);
+  EXPECT_EQ(rolledBack, 1);
+  EXPECT_EQ(testLastIndex, 5);
+  EXPECT_EQ(pBuf->endIndex, 6);
+  EXPECT_EQ(pBuf->matchIndex, 5);
+  EXPECT_EQ(pBuf->entries[6].pItem, nullptr);
+
+  syncLogBufferDestroy(pBuf);
+  pNode->pLogBuf = NULL;
+}
+
+TEST_F(SyncPersistTest, retryOnFailure) {
+  atomic_store_32(&testFailures, 3);
+  ASSERT_EQ(syncLogPersisterPush(pNode->pLogPersister, pEntries, 5, 1), 0);
+  syncLogPersisterWait(pNode->pLogPersister);
+  waitCmd(SYNC_LOCAL_CMD_LEADER_PERSIST, 4);
+
+  EXPECT_EQ(testLastIndex, 4);
+  EXPECT_EQ(testCmd, SYNC_LOCAL_CMD_LEADER_PERSIST);
+  EXPECT_EQ(testCmdIndex, 4);
+  EXPECT_FALSE(syncLogPersisterFailed(pNode->pLogPersister));
+}
+
+// the persister gives up after its retries, drops the entries in flight and asks the leader to step down
+TEST_F(SyncPersistTest, stepDownOnFailure) {
+  atomic_store_32(&testFailures, -1);
+  ASSERT_EQ(syncLogPersisterPush(pNode->pLogPersister, pEntries, 5, 1), 0);
+  syncLogPersisterWait(pNode->pLogPersister);
+  waitCmd(SYNC_LOCAL_CMD_STEP_DOWN, SYNC_INDEX_INVALID);
+
+  EXPECT_TRUE(syncLogPersisterFailed(pNode->pLogPersister));
+  EXPECT_EQ(testCmd, SYNC_LOCAL_CMD_STEP_DOWN);
+  EXPECT_EQ(testLastIndex, SYNC_INDEX_INVALID);
+  EXPECT_EQ(syncLogPersisterLastIndex(pNode->pLogPersister, 4), SYNC_INDEX_INVALID);
+
+  // persisted again once the log buffer is reset to the wal
+  atomic_store_32(&testFailures, 0);
+  syncLogPersisterRecover(pNode->pLogPersister);
+  EXPECT_FALSE(syncLogPersisterFailed(pNode->pLogPersister));
+  ASSERT_EQ(syncLogPersisterPush(pNode->pLogPersister, pEntries, 5, 1), 0);
+  syncLogPersisterWait(pNode->pLogPersister);
+  EXPECT_EQ(testLastIndex, 4);
+}
@@ -53,7 +53,8 @@ typedef struct SSyncIO {
   int32_t pingTimerMS;
   tmr_h   timerMgr;
 
-  void *pSyncNode;
+  void   *pSyncNode;
+  int64_t rid;  // the msgs are processed by syncProcessMsg of the node if set, instead of the callbacks below
   int32_t (*FpOnSyncPing)(SSyncNode *pSyncNode, SyncPing *pMsg);
   int32_t (*FpOnSyncPingReply)(SSyncNode *pSyncNode, SyncPingReply *pMsg);
   int32_t (*FpOnSyncClientRequest)(SSyncNode *pSyncNode, SRpcMsg *pMsg, SyncIndex *pRetIndex);
@@ -42,6 +42,11 @@ extern "C" {
 
 extern void addEpIntoEpSet(SEpSet* pEpSet, const char* fqdn, uint16_t port);
 
+// the msg types of the test harness, which are no longer used by sync
+#define TDMT_SYNC_PING               TDMT_SYNC_UNUSED_CODE
+#define TDMT_SYNC_PRE_SNAPSHOT       TDMT_SYNC_PREP_SNAPSHOT
+#define TDMT_SYNC_PRE_SNAPSHOT_REPLY TDMT_SYNC_PREP_SNAPSHOT_REPLY
+
 typedef struct SyncPing      SyncPing;
 typedef struct SyncPingReply SyncPingReply;
 
@@ -66,20 +71,6 @@ void   syncEntryLog2(char* s, const SSyncRaftEntry* pObj);
 char*   syncCfg2Str(SSyncCfg* pSyncCfg);
 int32_t syncCfgFromStr(const char* s, SSyncCfg* pSyncCfg);
 
-cJSON* raftCache2Json(SRaftEntryHashCache* pObj);
-char*  raftCache2Str(SRaftEntryHashCache* pObj);
-void   raftCachePrint(SRaftEntryHashCache* pObj);
-void   raftCachePrint2(char* s, SRaftEntryHashCache* pObj);
-void   raftCacheLog(SRaftEntryHashCache* pObj);
-void   raftCacheLog2(char* s, SRaftEntryHashCache* pObj);
-
-cJSON* raftEntryCache2Json(SRaftEntryCache* pObj);
-char*  raftEntryCache2Str(SRaftEntryCache* pObj);
-void   raftEntryCachePrint(SRaftEntryCache* pObj);
-void   raftEntryCachePrint2(char* s, SRaftEntryCache* pObj);
-void   raftEntryCacheLog(SRaftEntryCache* pObj);
-void   raftEntryCacheLog2(char* s, SRaftEntryCache* pObj);
-
 int32_t raftStoreFromJson(SRaftStore* pRaftStore, cJSON* pJson);
 cJSON*  raftStore2Json(SRaftStore* pRaftStore);
 char*   raftStore2Str(SRaftStore* pRaftStore);
@@ -262,6 +262,11 @@ static void *syncIOConsumerFunc(void *param) {
       snprintf(logBuf, sizeof(logBuf), "==syncIOConsumMsg== msgType:%d", pRpcMsg->msgType);
       syncRpcMsgLog2(logBuf, pRpcMsg);
 
+      if (io->rid > 0) {
+        (void)syncProcessMsg(io->rid, pRpcMsg);
+        continue;
+      }
+
       // use switch case instead of if else
       if (pRpcMsg->msgType == TDMT_SYNC_PING) {
         if (io->FpOnSyncPing != NULL) {
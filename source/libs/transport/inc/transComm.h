@@ -170,13 +170,14 @@ typedef struct {
 #define TRANS_VER 2
 typedef struct {
   char version : 4;  // RPC version
-  char comp : 2;     // compression algorithm, 0:no compression 1:lz4
+  char comp : 2;     // compression algorithm, 0:no compression 1:lz4 2:zstd
   char noResp : 2;   // noResp bits, 0: resp, 1: resp
   char persist : 2;  // persist handle,0: no persit, 1: persist handle
   char release : 2;
   char secured : 2;
   char spi : 2;
-  char hasEpSet : 2;  // contain epset or not, 0(default): no epset, 1: contain epset
+  char hasEpSet : 2;    // contain epset or not, 0(default): no epset, 1: contain epset
+  char acceptComp : 2;  // compression algorithm the sender accepts for the msgs sent to it, 0: not told(lz4 only)
 
   uint64_t timestamp;
   char     user[TSDB_UNI_LEN];
@@ -195,6 +196,24 @@ typedef struct {
   int32_t contLen;
 } STransCompMsg;
 
+#define TRANS_COMP_NONE 0
+#define TRANS_COMP_LZ4  1
+#define TRANS_COMP_ZSTD 2
+
+// the comp bits may be read back as a negative value
+#define TRANS_MSG_COMP(pHead)        ((int8_t)((uint8_t)(pHead)->comp & 0x3))
+#define TRANS_MSG_ACCEPT_COMP(pHead) ((int8_t)((uint8_t)(pHead)->acceptComp & 0x3))
+
+// the msgs are compressed with the algorithm the peer has announced in its msgs, and with lz4 before it has announced
+// one or if the peer is too old to announce it
+#define TRANS_UPDATE_PEER_COMP(compType, pHead)                  \
+  do {                                                           \
+    int8_t accept = TRANS_MSG_ACCEPT_COMP(pHead);                \
+    if (accept == TRANS_COMP_LZ4 || accept == TRANS_COMP_ZSTD) { \
+      (compType) = accept;                                       \
+    }                                                            \
+  } while (0)
+
 typedef struct {
   uint32_t timeStamp;
   uint8_t  auth[TSDB_AUTH_LEN];
@@ -233,6 +252,8 @@ typedef struct SConnBuffer {
   int   left;
   int   total;
   int   invalid;
+  char* msg;     // right-sized buffer of a large msg, which the rest of the msg is read into and handed up as it is
+  int   copied;  // bytes of the current msg copied on receive
 } SConnBuffer;
 
 typedef void (*AsyncCB)(uv_async_t* handle);
@@ -305,6 +326,9 @@ bool transReadComplete(SConnBuffer* connBuf);
 int  transResetBuffer(SConnBuffer* connBuf, int8_t resetBuf);
 int  transDumpFromBuffer(SConnBuffer* connBuf, char** buf, int8_t resetBuf);
 
+// the number of msgs and the bytes received since start, and the bytes copied from the conn buffers among them
+void transGetRecvStat(int64_t* msgs, int64_t* bytes, int64_t* copiedBytes);
+
 int transSetConnOption(uv_tcp_t* stream, int keepalive);
 
 void transRefSrvHandle(void* handle);
@@ -438,8 +462,9 @@ void transCleanup();
 void transPrintEpSet(SEpSet* pEpSet);
 
 void    transFreeMsg(void* msg);
-int32_t transCompressMsg(char* msg, int32_t len);
+int32_t transCompressMsg(char* msg, int32_t len, int8_t compType);
 int32_t transDecompressMsg(char** msg, int32_t len);
+void    transCompCtxCleanup();
 
 int32_t transOpenRefMgt(int size, void (*func)(void*));
 void    transCloseRefMgt(int32_t refMgt);
@@ -48,6 +48,7 @@ typedef struct {
   char     user[TSDB_UNI_LEN];  // meter ID
   int32_t  compatibilityVer;
   int32_t  compressSize;  // -1: no compress, 0 : all data compressed, size: compress data if larger than size
+  int8_t   compressType;  // codec of the compressed msgs sent to this end, TRANS_COMP_LZ4 or TRANS_COMP_ZSTD
   int8_t   encryption;    // encrypt or not
 
   int32_t retryMinInterval;  // retry init interval
@@ -49,6 +49,7 @@ void* rpcOpen(const SRpcInit* pInit) {
   if (pRpc->compressSize < 0) {
     pRpc->compressSize = -1;
   }
+  pRpc->compressType = pInit->compressType == TRANS_COMP_ZSTD ? TRANS_COMP_ZSTD : TRANS_COMP_LZ4;
 
   pRpc->encryption = pInit->encryption;
   pRpc->compatibilityVer = pInit->compatibilityVer;
@@ -69,8 +69,9 @@ typedef struct SCliConn {
   SConnList* list;
 
   STransCtx  ctx;
-  bool       broken;  // link broken or not
-  ConnStatus status;  //
+  bool       broken;    // link broken or not
+  ConnStatus status;    //
+  int8_t     compType;  // codec of the compressed reqs, announced by the server in its resps
 
   SCliBatch* pBatch;
 
@@ -393,6 +394,7 @@ void cliHandleResp(SCliConn* conn) {
     tTrace("%s conn %p not reset read buf", transLabel(pTransInst), conn);
   }
 
+  TRANS_UPDATE_PEER_COMP(conn->compType, pHead);
   if (transDecompressMsg((char**)&pHead, msgLen) < 0) {
     tDebug("%s conn %p recv invalid packet, failed to decompress", CONN_GET_INST_LABEL(conn), conn);
   }
@@ -921,6 +923,7 @@ static SCliConn* cliCreateConn(SCliThrd* pThrd) {
   conn->hostThrd = pThrd;
   conn->status = ConnNormal;
   conn->broken = false;
+  conn->compType = TRANS_COMP_LZ4;
   transRefCliHandle(conn);
 
   atomic_add_fetch_32(&pThrd->connCount, 1);
@@ -1052,6 +1055,18 @@ static void cliSendCb(uv_write_t* req, int status) {
   }
   uv_read_start((uv_stream_t*)pConn->stream, cliAllocRecvBufferCb, cliRecvCb);
 }
+// a retried msg may have been compressed for the server of another conn, it is decompressed and compressed again if
+// the server of this conn has not announced the codec
+static void cliRestoreCompMsg(SCliConn* pConn, STransMsg* pMsg) {
+  STransMsgHead* pHead = transHeadFromCont(pMsg->pCont);
+  if (TRANS_MSG_COMP(pHead) != TRANS_COMP_ZSTD || pConn->compType == TRANS_COMP_ZSTD) return;
+
+  if (transDecompressMsg((char**)&pHead, (int32_t)ntohl((uint32_t)pHead->msgLen)) < 0) {
+    tError("%s conn %p failed to decompress msg to send", CONN_GET_INST_LABEL(pConn), pConn);
+  }
+  pHead->comp = TRANS_COMP_NONE;
+  pMsg->pCont = transContFromHead(pHead);
+}
 void cliSendBatch(SCliConn* pConn) {
   SCliThrd* pThrd = pConn->hostThrd;
   STrans*   pTransInst = pThrd->pTransInst;
@@ -1075,6 +1090,7 @@ void cliSendBatch(SCliConn* pConn) {
       pMsg->pCont = (void*)rpcMallocCont(0);
       pMsg->contLen = 0;
     }
+    cliRestoreCompMsg(pConn, pMsg);
 
     int            msgLen = transMsgLenFromCont(pMsg->contLen);
     STransMsgHead* pHead = transHeadFromCont(pMsg->pCont);
@@ -1091,12 +1107,13 @@ void cliSendBatch(SCliConn* pConn) {
       pHead->magicNum = htonl(TRANS_MAGIC_NUM);
       pHead->version = TRANS_VER;
       pHead->compatibilityVer = htonl(pTransInst->compatibilityVer);
+      pHead->acceptComp = pTransInst->compressType;
     }
     pHead->timestamp = taosHton64(taosGetTimestampUs());
 
     if (pHead->comp == 0) {
       if (pTransInst->compressSize != -1 && pTransInst->compressSize < pMsg->contLen) {
-        msgLen = transCompressMsg(pMsg->pCont, pMsg->contLen) + sizeof(STransMsgHead);
+        msgLen = transCompressMsg(pMsg->pCont, pMsg->contLen, pConn->compType) + sizeof(STransMsgHead);
         pHead->msgLen = (int32_t)htonl((uint32_t)msgLen);
       }
     } else {
@@ -1134,6 +1151,7 @@ void cliSend(SCliConn* pConn) {
     tDebug("malloc memory: %p", pMsg->pCont);
     pMsg->contLen = 0;
   }
+  cliRestoreCompMsg(pConn, pMsg);
 
   int            msgLen = transMsgLenFromCont(pMsg->contLen);
   STransMsgHead* pHead = transHeadFromCont(pMsg->pCont);
@@ -1150,6 +1168,7 @@ void cliSend(SCliConn* pConn) {
     pHead->magicNum = htonl(TRANS_MAGIC_NUM);
     pHead->version = TRANS_VER;
     pHead->compatibilityVer = htonl(pTransInst->compatibilityVer);
+    pHead->acceptComp = pTransInst->compressType;
   }
   pHead->timestamp = taosHton64(taosGetTimestampUs());
 
@@ -1175,7 +1194,7 @@ void cliSend(SCliConn* pConn) {
 
   if (pHead->comp == 0) {
     if (pTransInst->compressSize != -1 && pTransInst->compressSize < pMsg->contLen) {
-      msgLen = transCompressMsg(pMsg->pCont, pMsg->contLen) + sizeof(STransMsgHead);
+      msgLen = transCompressMsg(pMsg->pCont, pMsg->contLen, pConn->compType) + sizeof(STransMsgHead);
       pHead->msgLen = (int32_t)htonl((uint32_t)msgLen);
     }
   } else {
@@ -1968,6 +1987,7 @@ static void* cliWorkThread(void* arg) {
   setThreadName(threadName);
 
   uv_run(pThrd->loop, UV_RUN_DEFAULT);
+  transCompCtxCleanup();
 
   tDebug("thread quit-thread:%08" PRId64, pThrd->pid);
   return NULL;
@@ -2372,6 +2392,12 @@ bool cliGenRetryRule(SCliConn* pConn, STransMsg* pResp, SCliMsg* pMsg) {
     noDelay = cliResetEpset(pCtx, pResp, true);
     addConnToPool(pThrd->pool, pConn);
     transFreeMsg(pResp->pCont);
+  } else if (code == TSDB_CODE_OUT_OF_RPC_MEMORY_QUEUE) {
+    // the node is busy, retry it later with backoff instead of moving to other nodes
+    tTrace("code str %s, contlen:%d 0", tstrerror(code), pResp->contLen);
+    noDelay = false;
+    addConnToPool(pThrd->pool, pConn);
+    transFreeMsg(pResp->pCont);
   } else {
     tTrace("code str %s, contlen:%d 0", tstrerror(code), pResp->contLen);
     noDelay = cliResetEpset(pCtx, pResp, false);
@@ -14,63 +14,165 @@
  */
 
 #include "transComm.h"
+#include "zstd.h"
 
 #define BUFFER_CAP 4096
 
+#define COMP_BUFFER_CAP  (16 * 1024 * 1024)
+#define TRANS_ZSTD_LEVEL 1
+
 static TdThreadOnce transModuleInit = PTHREAD_ONCE_INIT;
 
 static int32_t refMgt;
 static int32_t instMgt;
 static int32_t transSyncMsgMgt;
 
+static int64_t transRecvMsgs = 0;
+static int64_t transRecvBytes = 0;
+static int64_t transRecvCopiedBytes = 0;
+
 void transDestroySyncMsg(void* msg);
 
-int32_t transCompressMsg(char* msg, int32_t len) {
-  int32_t        ret = 0;
+typedef struct {
+  void*      lz4State;
+  ZSTD_CCtx* zstdCCtx;
+  ZSTD_DCtx* zstdDCtx;
+  char*      buf;
+  int32_t    cap;
+} STransCompCtx;
+
+// the codec contexts and the buffer of compression are reused by all the msgs of a transport thread
+static threadlocal STransCompCtx transCompCtx = {0};
+
+static char* transCompCtxGetBuf(STransCompCtx* pCtx, int32_t size) {
+  if (pCtx->cap < size) {
+    char* buf = taosMemoryRealloc(pCtx->buf, size);
+    if (buf == NULL) {
+      return NULL;
+    }
+    pCtx->buf = buf;
+    pCtx->cap = size;
+  }
+  return pCtx->buf;
+}
+
+static void transCompCtxPutBuf(STransCompCtx* pCtx) {
+  // the buffer for the msgs of exceptional size is not kept
+  if (pCtx->cap > COMP_BUFFER_CAP) {
+    taosMemoryFreeClear(pCtx->buf);
+    pCtx->cap = 0;
+  }
+}
+
+void transCompCtxCleanup() {
+  STransCompCtx* pCtx = &transCompCtx;
+  taosMemoryFreeClear(pCtx->lz4State);
+  if (pCtx->zstdCCtx != NULL) {
+    ZSTD_freeCCtx(pCtx->zstdCCtx);
+    pCtx->zstdCCtx = NULL;
+  }
+  if (pCtx->zstdDCtx != NULL) {
+    ZSTD_freeDCtx(pCtx->zstdDCtx);
+    pCtx->zstdDCtx = NULL;
+  }
+  taosMemoryFreeClear(pCtx->buf);
+  pCtx->cap = 0;
+}
+
+static int32_t transCompressImpl(STransCompCtx* pCtx, int8_t compType, char* src, int32_t srcLen, char* dst,
+                                 int32_t dstCap) {
+  if (compType == TRANS_COMP_ZSTD) {
+    if (pCtx->zstdCCtx == NULL && (pCtx->zstdCCtx = ZSTD_createCCtx()) == NULL) {
+      return 0;
+    }
+    size_t clen = ZSTD_compressCCtx(pCtx->zstdCCtx, dst, dstCap, src, srcLen, TRANS_ZSTD_LEVEL);
+    return ZSTD_isError(clen) ? 0 : (int32_t)clen;
+  }
+
+  if (pCtx->lz4State == NULL && (pCtx->lz4State = taosMemoryMalloc(LZ4_sizeofState())) == NULL) {
+    return 0;
+  }
+  return LZ4_compress_fast_extState(pCtx->lz4State, src, dst, srcLen, dstCap, 1);
+}
+
+static int32_t transDecompressImpl(STransCompCtx* pCtx, int8_t compType, char* src, int32_t srcLen, char* dst,
+                                   int32_t dstCap) {
+  if (compType == TRANS_COMP_ZSTD) {
+    if (pCtx->zstdDCtx == NULL && (pCtx->zstdDCtx = ZSTD_createDCtx()) == NULL) {
+      return -1;
+    }
+    size_t len = ZSTD_decompressDCtx(pCtx->zstdDCtx, dst, dstCap, src, srcLen);
+    return ZSTD_isError(len) ? -1 : (int32_t)len;
+  }
+  return LZ4_decompress_safe(src, dst, srcLen, dstCap);
+}
+
+int32_t transCompressMsg(char* msg, int32_t len, int8_t compType) {
+  int32_t        ret = len;
   int            compHdr = sizeof(STransCompMsg);
   STransMsgHead* pHead = transHeadFromCont(msg);
 
-  char* buf = taosMemoryMalloc(len + compHdr + 8);  // 8 extra bytes
-  if (buf == NULL) {
-    tError("failed to allocate memory for rpc msg compression, contLen:%d", len);
-    ret = len;
-    return ret;
+  if (compType != TRANS_COMP_ZSTD) {
+    compType = TRANS_COMP_LZ4;
   }
 
-  int32_t clen = LZ4_compress_default(msg, buf, len, len + compHdr);
   /*
-   * only the compressed size is less than the value of contLen - overhead, the compression is applied
+   * only the compressed size is less than the value of contLen - overhead, the compression is applied, so the output
+   * is limited to that size and the codec fails fast on the msgs that are not compressible.
    * The first four bytes is set to 0, the second four bytes are utilized to keep the original length of message
    */
-  if (clen > 0 && clen < len - compHdr) {
+  int32_t cap = len - compHdr - 1;
+  if (cap <= 0) {
+    pHead->comp = TRANS_COMP_NONE;
+    return ret;
+  }
+
+  STransCompCtx* pCtx = &transCompCtx;
+  char*          buf = transCompCtxGetBuf(pCtx, cap);
+  if (buf == NULL) {
+    tError("failed to allocate memory for rpc msg compression, contLen:%d", len);
+    pHead->comp = TRANS_COMP_NONE;
+    return ret;
+  }
+
+  int32_t clen = transCompressImpl(pCtx, compType, msg, len, buf, cap);
+  if (clen > 0) {
     STransCompMsg* pComp = (STransCompMsg*)msg;
     pComp->reserved = 0;
     pComp->contLen = htonl(len);
     memcpy(msg + compHdr, buf, clen);
 
-    tDebug("compress rpc msg, before:%d, after:%d", len, clen);
+    tDebug("compress rpc msg, before:%d, after:%d, type:%d", len, clen, compType);
     ret = clen + compHdr;
-    pHead->comp = 1;
+    pHead->comp = compType;
   } else {
-    ret = len;
-    pHead->comp = 0;
+    pHead->comp = TRANS_COMP_NONE;
   }
-  taosMemoryFree(buf);
+  transCompCtxPutBuf(pCtx);
   return ret;
 }
 int32_t transDecompressMsg(char** msg, int32_t len) {
   STransMsgHead* pHead = (STransMsgHead*)(*msg);
-  if (pHead->comp == 0) return 0;
+  int8_t         compType = TRANS_MSG_COMP(pHead);
+  if (compType == TRANS_COMP_NONE) return 0;
 
   char* pCont = transContFromHead(pHead);
 
   STransCompMsg* pComp = (STransCompMsg*)pCont;
   int32_t        oriLen = htonl(pComp->contLen);
+  int32_t        compLen = len - sizeof(STransMsgHead) - sizeof(STransCompMsg);
+  if (oriLen < 0 || compLen <= 0) {
+    return -1;
+  }
 
-  char*          buf = taosMemoryCalloc(1, oriLen + sizeof(STransMsgHead));
+  // every byte of the content is written by the codec, so the new msg is not zeroed first
+  char* buf = taosMemoryMalloc(oriLen + sizeof(STransMsgHead));
+  if (buf == NULL) {
+    return -1;
+  }
   STransMsgHead* pNewHead = (STransMsgHead*)buf;
-  int32_t        decompLen = LZ4_decompress_safe(pCont + sizeof(STransCompMsg), (char*)pNewHead->content,
-                                                 len - sizeof(STransMsgHead) - sizeof(STransCompMsg), oriLen);
+  int32_t        decompLen = transDecompressImpl(&transCompCtx, compType, pCont + sizeof(STransCompMsg), compLen,
+                                                 (char*)pNewHead->content, oriLen);
   memcpy((char*)pNewHead, (char*)pHead, sizeof(STransMsgHead));
 
   pNewHead->msgLen = htonl(oriLen + sizeof(STransMsgHead));
@@ -105,11 +207,14 @@ int transInitBuffer(SConnBuffer* buf) {
   buf->len = 0;
   buf->total = 0;
   buf->invalid = 0;
+  buf->msg = NULL;
+  buf->copied = 0;
   return 0;
 }
 int transDestroyBuffer(SConnBuffer* p) {
   taosMemoryFree(p->buf);
   p->buf = NULL;
+  taosMemoryFreeClear(p->msg);
   return 0;
 }
 
@@ -123,6 +228,8 @@ int transClearBuffer(SConnBuffer* buf) {
   p->len = 0;
   p->total = 0;
   p->invalid = 0;
+  taosMemoryFreeClear(p->msg);
+  p->copied = 0;
   return 0;
 }
 
@@ -135,8 +242,19 @@ int transDumpFromBuffer(SConnBuffer* connBuf, char** buf, int8_t resetBuf) {
   }
   int total = p->total;
   if (total >= HEADSIZE && !p->invalid) {
-    *buf = taosMemoryCalloc(1, total);
-    memcpy(*buf, p->buf, total);
+    if (p->msg != NULL) {
+      // read into its own buffer, the msg is handed up without copy
+      *buf = p->msg;
+      p->msg = NULL;
+    } else {
+      *buf = taosMemoryMalloc(total);
+      memcpy(*buf, p->buf, total);
+      p->copied += total;
+    }
+    tTrace("recv msg, len:%d, copied:%d", total, p->copied);
+    atomic_add_fetch_64(&transRecvMsgs, 1);
+    atomic_add_fetch_64(&transRecvBytes, total);
+    atomic_add_fetch_64(&transRecvCopiedBytes, p->copied);
     if (transResetBuffer(connBuf, resetBuf) < 0) {
       return -1;
     }
@@ -146,8 +264,15 @@ int transDumpFromBuffer(SConnBuffer* connBuf, char** buf, int8_t resetBuf) {
   return total;
 }
 
+void transGetRecvStat(int64_t* msgs, int64_t* bytes, int64_t* copiedBytes) {
+  *msgs = atomic_load_64(&transRecvMsgs);
+  *bytes = atomic_load_64(&transRecvBytes);
+  *copiedBytes = atomic_load_64(&transRecvCopiedBytes);
+}
+
 int transResetBuffer(SConnBuffer* connBuf, int8_t resetBuf) {
   SConnBuffer* p = connBuf;
+  p->copied = 0;
   if (p->total < p->len) {
     int left = p->len - p->total;
     memmove(p->buf, p->buf + p->total, left);
@@ -178,6 +303,12 @@ int transAllocBuffer(SConnBuffer* connBuf, uv_buf_t* uvBuf) {
    * info--->|
    */
   SConnBuffer* p = connBuf;
+  if (p->msg != NULL) {
+    uvBuf->base = p->msg + p->len;
+    uvBuf->len = p->left;
+    return 0;
+  }
+
   uvBuf->base = p->buf + p->len;
   if (p->left == -1) {
     uvBuf->len = p->cap - p->len;
@@ -193,6 +324,25 @@ int transAllocBuffer(SConnBuffer* connBuf, uv_buf_t* uvBuf) {
   }
   return 0;
 }
+/*
+ * once the head of a large msg is read, the rest of it is read into a buffer of the msg size, which is handed up as the
+ * msg later, instead of being accumulated into the conn buffer and copied out. Only the bytes read along with the head
+ * are copied.
+ */
+static void transStartReadMsg(SConnBuffer* p) {
+  if (p->total <= BUFFER_CAP || p->total > TRANS_PACKET_LIMIT) {
+    return;
+  }
+
+  char* msg = taosMemoryMalloc(p->total);
+  if (msg == NULL) {
+    return;
+  }
+  memcpy(msg, p->buf, p->len);
+  p->copied += p->len;
+  p->msg = msg;
+}
+
 // check whether already read complete
 bool transReadComplete(SConnBuffer* connBuf) {
   SConnBuffer* p = connBuf;
@@ -209,6 +359,9 @@ bool transReadComplete(SConnBuffer* connBuf) {
     } else {
       p->left = 0;
     }
+    if (p->left > 0 && p->msg == NULL && !p->invalid) {
+      transStartReadMsg(p);
+    }
   }
   return (p->left == 0 || p->invalid) ? true : false;
 }
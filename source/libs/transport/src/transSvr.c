@@ -42,6 +42,7 @@ typedef struct SSvrConn {
   bool       broken;  // conn broken;
 
   ConnStatus status;
+  int8_t     compType;  // codec of the compressed resps, announced by the client in its reqs
 
   uint32_t serverIp;
   uint32_t clientIp;
@@ -352,6 +353,7 @@ static bool uvHandleReq(SSvrConn* pConn) {
     tTrace("%s conn %p not reset read buf", transLabel(pTransInst), pConn);
   }
 
+  TRANS_UPDATE_PEER_COMP(pConn->compType, pHead);
   if (transDecompressMsg((char**)&pHead, msgLen) < 0) {
     tError("%s conn %p recv invalid packet, failed to decompress", transLabel(pTransInst), pConn);
     return false;
@@ -589,6 +591,7 @@ static int uvPrepareSendData(SSvrMsg* smsg, uv_buf_t* wb) {
   pHead->ahandle = (uint64_t)pMsg->info.ahandle;
   pHead->traceId = pMsg->info.traceId;
   pHead->hasEpSet = pMsg->info.hasEpSet;
+  pHead->acceptComp = ((STrans*)pConn->pTransInst)->compressType;
   pHead->magicNum = htonl(TRANS_MAGIC_NUM);
   pHead->compatibilityVer = htonl(((STrans*)pConn->pTransInst)->compatibilityVer);
   pHead->version = TRANS_VER;
@@ -624,7 +627,7 @@ static int uvPrepareSendData(SSvrMsg* smsg, uv_buf_t* wb) {
 
   STrans* pTransInst = pConn->pTransInst;
   if (pTransInst->compressSize != -1 && pTransInst->compressSize < pMsg->contLen) {
-    len = transCompressMsg(pMsg->pCont, pMsg->contLen) + sizeof(STransMsgHead);
+    len = transCompressMsg(pMsg->pCont, pMsg->contLen, pConn->compType) + sizeof(STransMsgHead);
     pHead->msgLen = (int32_t)htonl((uint32_t)len);
   }
 
@@ -1069,6 +1072,7 @@ void* transWorkerThread(void* arg) {
   setThreadName("trans-svr-work");
   SWorkThrd* pThrd = (SWorkThrd*)arg;
   uv_run(pThrd->loop, UV_RUN_DEFAULT);
+  transCompCtxCleanup();
 
   return NULL;
 }
@@ -1088,6 +1092,7 @@ static FORCE_INLINE SSvrConn* createConn(void* hThrd) {
   memset(&pConn->regArg, 0, sizeof(pConn->regArg));
   pConn->broken = false;
   pConn->status = ConnNormal;
+  pConn->compType = TRANS_COMP_LZ4;
   transInitBuffer(&pConn->readBuf);
 
   SExHandle* exh = taosMemoryMalloc(sizeof(SExHandle));
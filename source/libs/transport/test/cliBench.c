@@ -136,6 +136,8 @@ int main(int argc, char *argv[]) {
       appThreads = atoi(argv[++i]);
     } else if (strcmp(argv[i], "-o") == 0 && i < argc - 1) {
       tsCompressMsgSize = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-z") == 0 && i < argc - 1) {
+      tsCompressMsgType = atoi(argv[++i]);
     } else if (strcmp(argv[i], "-u") == 0 && i < argc - 1) {
     } else if (strcmp(argv[i], "-k") == 0 && i < argc - 1) {
     } else if (strcmp(argv[i], "-spi") == 0 && i < argc - 1) {
@@ -148,6 +150,8 @@ int main(int argc, char *argv[]) {
       printf("  [-m msgSize]: message body size, default is:%d\n", msgSize);
       printf("  [-a threads]: number of app threads, default is:%d\n", appThreads);
       printf("  [-n requests]: number of requests per thread, default is:%d\n", numOfReqs);
+      printf("  [-o compSize]: compression message size, default is:%d\n", tsCompressMsgSize);
+      printf("  [-z compType]: compression type, 1: lz4, 2: zstd, default is:%d\n", tsCompressMsgType);
       printf("  [-u user]: user name for the connection, default is:%s\n", rpcInit.user);
       printf("  [-d debugFlag]: debug flag, default:%d\n", rpcDebugFlag);
       printf("  [-h help]: print out this help\n\n");
@@ -156,6 +160,8 @@ int main(int argc, char *argv[]) {
   }
 
   initLogEnv();
+  rpcInit.compressSize = tsCompressMsgSize;
+  rpcInit.compressType = tsCompressMsgType;
   taosVersionStrToInt(version, &(rpcInit.compatibilityVer));
   void *pRpc = rpcOpen(&rpcInit);
   if (pRpc == NULL) {
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Throughput of the fetch rsp path of the transport with the compression off, lz4 and zstd, from compressing the rsp
+// on the server to decompressing it on the client, e.g.
+//   transCompressBench [numOfMsgs] [msgSize]
+
+#include "transComm.h"
+
+typedef struct {
+  const char *name;
+  int8_t      compType;
+} SBenchCodec;
+
+static SBenchCodec benchCodecs[] = {
+    {"none", TRANS_COMP_NONE},
+    {"lz4", TRANS_COMP_LZ4},
+    {"zstd", TRANS_COMP_ZSTD},
+};
+
+// a result block like payload, i.e. columns of timestamps, ints of small deltas, doubles and repeated strings
+static void genBenchPayload(char *buf, int32_t size) {
+  int32_t  rows = size / 32;
+  int64_t *ts = (int64_t *)buf;
+  int32_t *iv = (int32_t *)(ts + rows);
+  double  *dv = (double *)(iv + rows);
+  char    *sv = (char *)(dv + rows);
+
+  for (int32_t i = 0; i < rows; ++i) {
+    ts[i] = 1700000000000 + i * 1000;
+    iv[i] = 100 + taosRand() % 16;
+    dv[i] = 20.0 + (taosRand() % 1000) / 100.0;
+    memcpy(sv + i * 12, (i % 4 == 0) ? "beijing.dc01" : "shanghai.dc2", 12);
+  }
+  memset(buf + rows * 32, 0, size - rows * 32);
+}
+
+static void benchCodec(SBenchCodec *pCodec, const char *payload, int32_t numOfMsgs, int32_t msgSize) {
+  int64_t bytes = 0;
+  int64_t compSt = 0, compEl = 0, decompEl = 0;
+  int64_t st = taosGetTimestampUs();
+
+  for (int32_t i = 0; i < numOfMsgs; ++i) {
+    char *pCont = rpcMallocCont(msgSize);
+    memcpy(pCont, payload, msgSize);
+
+    STransMsgHead *pHead = transHeadFromCont(pCont);
+    int32_t        msgLen = transMsgLenFromCont(msgSize);
+
+    compSt = taosGetTimestampUs();
+    if (pCodec->compType != TRANS_COMP_NONE) {
+      msgLen = transCompressMsg(pCont, msgSize, pCodec->compType) + sizeof(STransMsgHead);
+    }
+    compEl += taosGetTimestampUs() - compSt;
+    bytes += msgLen;
+
+    // the bytes on the wire are received into a msg of their own
+    char *pRecv = taosMemoryMalloc(msgLen);
+    memcpy(pRecv, pHead, msgLen);
+    rpcFreeCont(pCont);
+
+    int64_t decompSt = taosGetTimestampUs();
+    int32_t code = transDecompressMsg(&pRecv, msgLen);
+    decompEl += taosGetTimestampUs() - decompSt;
+    assert(code == 0);
+    assert(memcmp(((STransMsgHead *)pRecv)->content, payload, msgSize) == 0);
+    taosMemoryFree(pRecv);
+  }
+
+  int64_t el = taosGetTimestampUs() - st;
+  double  mb = (double)numOfMsgs * msgSize / (1024 * 1024);
+  printf("%-6s %10d %14" PRId64 " %8.2f %12" PRId64 " %12" PRId64 " %12" PRId64 " %10.1f\n", pCodec->name, msgSize,
+         bytes, (bytes > 0) ? (double)numOfMsgs * msgSize / bytes : 0, compEl, decompEl, el,
+         (el > 0) ? mb * 1000000 / el : 0);
+}
+
+int main(int argc, char *argv[]) {
+  int32_t numOfMsgs = (argc > 1) ? atoi(argv[1]) : 200;
+  int32_t msgSize = (argc > 2) ? atoi(argv[2]) : 1024 * 1024;
+
+  tsAsyncLog = 0;
+  rpcDebugFlag = DEBUG_ERROR;
+
+  char *payload = taosMemoryMalloc(msgSize);
+  genBenchPayload(payload, msgSize);
+
+  printf("%-6s %10s %14s %8s %12s %12s %12s %10s\n", "codec", "msgSize", "wireBytes", "ratio", "comp(us)",
+         "decomp(us)", "elapsed(us)", "MB/s");
+  for (int32_t c = 0; c < sizeof(benchCodecs) / sizeof(benchCodecs[0]); ++c) {
+    benchCodec(&benchCodecs[c], payload, numOfMsgs, msgSize);
+  }
+
+  transCompCtxCleanup();
+  taosMemoryFree(payload);
+  return 0;
+}
@@ -232,4 +232,86 @@ int32_t cloneVal(void *src, void **dst) {
 //  skey = (char *)transCtxDumpVal(ctx, 2);
 //  EXPECT_EQ(0, strcmp(skey, val.c_str()));
 //}
+// the msgs are read from a stream in chunks, like the reads of a uv stream
+static void readMsgsFromStream(SConnBuffer *pBuf, const std::vector<std::string> &msgs, int chunk) {
+  std::string stream;
+  for (auto &msg : msgs) stream += msg;
+
+  size_t off = 0, idx = 0;
+  while (off < stream.size()) {
+    uv_buf_t uvBuf;
+    transAllocBuffer(pBuf, &uvBuf);
+    size_t n = std::min(std::min((size_t)uvBuf.len, (size_t)chunk), stream.size() - off);
+    memcpy(uvBuf.base, stream.data() + off, n);
+    off += n;
+    pBuf->len += n;
+    while (transReadComplete(pBuf)) {
+      ASSERT_EQ(pBuf->invalid, 0);
+      char *msg = NULL;
+      int   len = transDumpFromBuffer(pBuf, &msg, 1);
+      ASSERT_LT(idx, msgs.size());
+      ASSERT_EQ(len, (int)msgs[idx].size());
+      ASSERT_EQ(0, memcmp(msg, msgs[idx].data(), len));
+      taosMemoryFree(msg);
+      idx++;
+    }
+  }
+  ASSERT_EQ(idx, msgs.size());
+}
+
+static std::string buildStreamMsg(int contLen) {
+  std::string    msg(sizeof(STransMsgHead) + contLen, '\0');
+  STransMsgHead *pHead = (STransMsgHead *)&msg[0];
+  pHead->version = TRANS_VER;
+  pHead->magicNum = htonl(TRANS_MAGIC_NUM);
+  pHead->msgLen = (int32_t)htonl((uint32_t)msg.size());
+  for (int i = 0; i < contLen; i++) {
+    pHead->content[i] = (uint8_t)(i % 251);
+  }
+  return msg;
+}
+
+TEST(ConnBufferTest, largeMsgReadDirectly) {
+  SConnBuffer buf;
+  transInitBuffer(&buf);
+
+  std::vector<std::string> msgs = {buildStreamMsg(100), buildStreamMsg(4 * 1024 * 1024), buildStreamMsg(10),
+                                   buildStreamMsg(64 * 1024), buildStreamMsg(0)};
+
+  int64_t msgs0, bytes0, copied0;
+  transGetRecvStat(&msgs0, &bytes0, &copied0);
+
+  readMsgsFromStream(&buf, msgs, 1460);
+
+  int64_t msgs1, bytes1, copied1;
+  transGetRecvStat(&msgs1, &bytes1, &copied1);
+  int64_t total = 0;
+  for (auto &msg : msgs) total += msg.size();
+  EXPECT_EQ(msgs1 - msgs0, (int64_t)msgs.size());
+  EXPECT_EQ(bytes1 - bytes0, total);
+  // only the small msgs and the bytes read along with the head of the large ones are copied
+  EXPECT_LT(copied1 - copied0, 4 * 4096);
+  EXPECT_EQ(buf.msg, nullptr);
+
+  transDestroyBuffer(&buf);
+}
+
+TEST(ConnBufferTest, clearPartialLargeMsg) {
+  SConnBuffer buf;
+  transInitBuffer(&buf);
+
+  std::string msg = buildStreamMsg(1024 * 1024);
+  uv_buf_t    uvBuf;
+  transAllocBuffer(&buf, &uvBuf);
+  memcpy(uvBuf.base, msg.data(), 4096);
+  buf.len += 4096;
+  EXPECT_FALSE(transReadComplete(&buf));
+  EXPECT_NE(buf.msg, nullptr);
+
+  transClearBuffer(&buf);
+  EXPECT_EQ(buf.msg, nullptr);
+  readMsgsFromStream(&buf, {buildStreamMsg(100)}, 1460);
+
+  transDestroyBuffer(&buf);
+}
 #endif
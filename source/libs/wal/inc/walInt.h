@@ -42,6 +42,15 @@ typedef struct WalIdxEntry {
   int64_t offset;
 } SWalIdxEntry;
 
+// buffers of the entries written by one group
+typedef struct SWalGroupBuf {
+  int32_t       capacity;
+  SWalCkHead   *pHeads;
+  SWalIdxEntry *pIdxEntries;
+  TdFileIovec  *pIov;
+  char        **pEncrypted;  // encrypted bodies, if encryption is enabled
+} SWalGroupBuf;
+
 static inline int tSerializeWalIdxEntry(void** buf, SWalIdxEntry* pIdxEntry) {
   int tlen = 0;
   tlen += taosEncodeFixedI64(buf, pIdxEntry->ver);
@@ -165,6 +174,7 @@ int     walInitWriteFile(SWal* pWal);
 int64_t walGetSeq();
 int     walSeekWriteVer(SWal* pWal, int64_t ver);
 int32_t walRollImpl(SWal* pWal);
+void    walDestroyGroupBuf(SWalGroupBuf* pBuf);
 
 #ifdef __cplusplus
 }
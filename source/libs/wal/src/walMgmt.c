@@ -209,8 +209,33 @@ int32_t walPersist(SWal *pWal) {
   return ret;
 }
 
+static void walPrintStatHist(const int64_t *pHist, char *buf, int32_t len) {
+  int32_t offset = 0;
+  buf[0] = 0;
+  for (int32_t i = 0; i < WAL_STAT_HIST_BUCKETS && offset < len; ++i) {
+    if (pHist[i] == 0) continue;
+    offset += snprintf(buf + offset, len - offset, " <%" PRId64 ":%" PRId64, (int64_t)1 << i, pHist[i]);
+  }
+}
+
+static void walPrintWriteStat(SWal *pWal) {
+  SWalWriteStat *pStat = &pWal->writeStat;
+  if (pStat->numOfGroups == 0) return;
+
+  char groupHist[256], fsyncHist[256];
+  walPrintStatHist(pStat->groupSizeHist, groupHist, sizeof(groupHist));
+  walPrintStatHist(pStat->fsyncLatencyHist, fsyncHist, sizeof(fsyncHist));
+  wInfo("vgId:%d, wal write groups:%" PRId64 ", entries:%" PRId64 ", group size:%s, fsyncs:%" PRId64
+        ", avg fsync:%.2f us, fsync latency(us):%s",
+        pWal->cfg.vgId, pStat->numOfGroups, pStat->numOfEntries, groupHist, pStat->numOfFsyncs,
+        pStat->numOfFsyncs > 0 ? (double)pStat->fsyncUs / pStat->numOfFsyncs : 0, fsyncHist);
+}
+
 void walClose(SWal *pWal) {
   taosThreadMutexLock(&pWal->mutex);
+  walPrintWriteStat(pWal);
+  walDestroyGroupBuf(pWal->pGroupBuf);
+  pWal->pGroupBuf = NULL;
   (void)walSaveMeta(pWal);
   taosCloseFile(&pWal->pLogFile);
   pWal->pLogFile = NULL;
@@ -463,139 +463,190 @@ END:
   return code;
 }
 
-static int32_t walWriteIndex(SWal *pWal, int64_t ver, int64_t offset) {
-  SWalIdxEntry  entry = {.ver = ver, .offset = offset};
-  SWalFileInfo *pFileInfo = walGetCurFileInfo(pWal);
+void walDestroyGroupBuf(SWalGroupBuf *pBuf) {
+  if (pBuf == NULL) return;
+  taosMemoryFree(pBuf->pHeads);
+  taosMemoryFree(pBuf->pIdxEntries);
+  taosMemoryFree(pBuf->pIov);
+  taosMemoryFree(pBuf->pEncrypted);
+  taosMemoryFree(pBuf);
+}
 
-  int64_t idxOffset = (entry.ver - pFileInfo->firstVer) * sizeof(SWalIdxEntry);
-  wDebug("vgId:%d, write index, index:%" PRId64 ", offset:%" PRId64 ", at %" PRId64, pWal->cfg.vgId, ver, offset,
-         idxOffset);
+static SWalGroupBuf *walGetGroupBuf(SWal *pWal, int32_t num) {
+  SWalGroupBuf *pBuf = pWal->pGroupBuf;
+  if (pBuf != NULL && pBuf->capacity >= num) {
+    return pBuf;
+  }
 
-  int64_t size = taosWriteFile(pWal->pIdxFile, &entry, sizeof(SWalIdxEntry));
-  if (size != sizeof(SWalIdxEntry)) {
-    wError("vgId:%d, failed to write idx entry due to %s. ver:%" PRId64, pWal->cfg.vgId, strerror(errno), ver);
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    return -1;
+  int32_t capacity = TMAX(num, (pBuf != NULL) ? pBuf->capacity * 2 : 16);
+  walDestroyGroupBuf(pBuf);
+  pWal->pGroupBuf = NULL;
+
+  pBuf = taosMemoryCalloc(1, sizeof(SWalGroupBuf));
+  if (pBuf == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
   }
 
-  // check alignment of idx entries
-  int64_t endOffset = taosLSeekFile(pWal->pIdxFile, 0, SEEK_END);
-  if (endOffset < 0) {
-    wFatal("vgId:%d, failed to seek end of WAL idxfile due to %s. ver:%" PRId64 "", pWal->cfg.vgId, strerror(errno),
-           ver);
-    taosMsleep(100);
-    exit(EXIT_FAILURE);
+  pBuf->capacity = capacity;
+  pBuf->pHeads = taosMemoryMalloc(sizeof(SWalCkHead) * capacity);
+  pBuf->pIdxEntries = taosMemoryMalloc(sizeof(SWalIdxEntry) * capacity);
+  pBuf->pIov = taosMemoryMalloc(sizeof(TdFileIovec) * capacity * 2);
+  pBuf->pEncrypted = taosMemoryCalloc(capacity, POINTER_BYTES);
+  if (pBuf->pHeads == NULL || pBuf->pIdxEntries == NULL || pBuf->pIov == NULL || pBuf->pEncrypted == NULL) {
+    walDestroyGroupBuf(pBuf);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
   }
-  return 0;
+
+  pWal->pGroupBuf = pBuf;
+  return pBuf;
 }
 
-static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta,
-                                         const void *body, int32_t bodyLen) {
-  int64_t code = 0;
-  int32_t plainBodyLen = bodyLen;
+static FORCE_INLINE int32_t walStatHistBucket(int64_t val) {
+  int32_t bucket = 0;
+  while (val > 0 && bucket < WAL_STAT_HIST_BUCKETS - 1) {
+    val >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
 
-  int64_t       offset = walGetCurFileOffset(pWal);
-  SWalFileInfo *pFileInfo = walGetCurFileInfo(pWal);
+static void walDoFsync(SWal *pWal) {
+  wTrace("vgId:%d, fileId:%" PRId64 ".log, do fsync", pWal->cfg.vgId, walGetCurFileFirstVer(pWal));
 
-  pWal->writeHead.head.version = index;
-  pWal->writeHead.head.bodyLen = plainBodyLen;
-  pWal->writeHead.head.msgType = msgType;
-  pWal->writeHead.head.ingestTs = taosGetTimestampUs();
+  int64_t st = taosGetTimestampUs();
+  if (taosFsyncFile(pWal->pLogFile) < 0) {
+    wError("vgId:%d, file:%" PRId64 ".log, fsync failed since %s", pWal->cfg.vgId, walGetCurFileFirstVer(pWal),
+           strerror(errno));
+  }
 
-  // sync info for sync module
-  pWal->writeHead.head.syncMeta = syncMeta;
+  int64_t elapsed = taosGetTimestampUs() - st;
+  pWal->writeStat.numOfFsyncs++;
+  pWal->writeStat.fsyncUs += elapsed;
+  pWal->writeStat.fsyncLatencyHist[walStatHistBucket(elapsed)]++;
+}
 
-  pWal->writeHead.cksumHead = walCalcHeadCksum(&pWal->writeHead);
-  pWal->writeHead.cksumBody = walCalcBodyCksum(body, plainBodyLen);
-  wDebug("vgId:%d, wal write log %" PRId64 ", msgType: %s, cksum head %u cksum body %u", pWal->cfg.vgId, index,
-         TMSG_INFO(msgType), pWal->writeHead.cksumHead, pWal->writeHead.cksumBody);
+// the padded body is copied to the first half of buf, and encrypted into the second half, which is returned
+static char *walEncryptBody(SWal *pWal, const void *body, int32_t plainBodyLen, char *buf) {
+  int32_t cyptedBodyLen = ENCRYPTED_LEN(plainBodyLen);
 
-  code = walWriteIndex(pWal, index, offset);
-  if (code < 0) {
-    goto END;
-  }
+  memset(buf, 0, cyptedBodyLen);
+  memcpy(buf, body, plainBodyLen);
 
-  if (taosWriteFile(pWal->pLogFile, &pWal->writeHead, sizeof(SWalCkHead)) != sizeof(SWalCkHead)) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
-           strerror(errno));
-    code = -1;
-    goto END;
-  }
+  SCryptOpts opts;
+  opts.len = cyptedBodyLen;
+  opts.source = buf;
+  opts.result = buf + cyptedBodyLen;
+  opts.unitLen = 16;
+  strncpy(opts.key, pWal->cfg.encryptKey, ENCRYPT_KEY_LEN);
+
+  (void)CBC_Encrypt(&opts);
+  return opts.result;
+}
 
-  int32_t cyptedBodyLen = plainBodyLen;
-  char* buf = (char*)body;
-  char* newBody = NULL;
-  char* newBodyEncrypted = NULL;
+static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, const SWalAppendEntry *pEntries, int32_t num) {
+  int32_t code = 0;
 
-  if(pWal->cfg.encryptAlgorithm == DND_CA_SM4){
-    cyptedBodyLen = ENCRYPTED_LEN(cyptedBodyLen);
-    
-    newBody = taosMemoryMalloc(cyptedBodyLen);
-    if(newBody == NULL){
-      wError("vgId:%d, file:%" PRId64 ".log, failed to malloc since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
-            strerror(errno));
-      code = -1;
-      goto END;
-    }
-    memset(newBody, 0, cyptedBodyLen);
-    memcpy(newBody, body, plainBodyLen);
-
-    newBodyEncrypted = taosMemoryMalloc(cyptedBodyLen);
-    if(newBodyEncrypted == NULL){
-      wError("vgId:%d, file:%" PRId64 ".log, failed to malloc since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
-            strerror(errno));
-      code = -1;
-      if(newBody != NULL) taosMemoryFreeClear(newBody);
-      goto END;
-    }
+  SWalGroupBuf *pBuf = walGetGroupBuf(pWal, num);
+  if (pBuf == NULL) {
+    return -1;
+  }
 
-    SCryptOpts opts;
-    opts.len = cyptedBodyLen;
-    opts.source = newBody;
-    opts.result = newBodyEncrypted;
-    opts.unitLen = 16;
-    strncpy(opts.key, pWal->cfg.encryptKey, ENCRYPT_KEY_LEN);
+  int64_t       offset = walGetCurFileOffset(pWal);
+  SWalFileInfo *pFileInfo = walGetCurFileInfo(pWal);
+  int64_t       idxOffset = (pEntries[0].index - pFileInfo->firstVer) * sizeof(SWalIdxEntry);
+  int64_t       logSize = 0;
+  bool          encrypt = (pWal->cfg.encryptAlgorithm == DND_CA_SM4);
+
+  // build the heads and the index entries of the group, so that each file is written with one call
+  for (int32_t i = 0; i < num; ++i) {
+    const SWalAppendEntry *pEntry = &pEntries[i];
+    SWalCkHead            *pHead = &pBuf->pHeads[i];
+
+    *pHead = pWal->writeHead;
+    pHead->head.version = pEntry->index;
+    pHead->head.bodyLen = pEntry->bodyLen;
+    pHead->head.msgType = pEntry->msgType;
+    pHead->head.ingestTs = taosGetTimestampUs();
+
+    // sync info for sync module
+    pHead->head.syncMeta = pEntry->syncMeta;
+
+    pHead->cksumHead = walCalcHeadCksum(pHead);
+    pHead->cksumBody = walCalcBodyCksum(pEntry->body, pEntry->bodyLen);
+    wDebug("vgId:%d, wal write log %" PRId64 ", msgType: %s, cksum head %u cksum body %u", pWal->cfg.vgId,
+           pEntry->index, TMSG_INFO(pEntry->msgType), pHead->cksumHead, pHead->cksumBody);
+
+    pBuf->pIdxEntries[i].ver = pEntry->index;
+    pBuf->pIdxEntries[i].offset = offset + logSize;
+
+    char   *body = (char *)pEntry->body;
+    int32_t cyptedBodyLen = pEntry->bodyLen;
+    if (encrypt) {
+      cyptedBodyLen = ENCRYPTED_LEN(cyptedBodyLen);
+      pBuf->pEncrypted[i] = taosMemoryMalloc(cyptedBodyLen * 2);
+      if (pBuf->pEncrypted[i] == NULL) {
+        wError("vgId:%d, file:%" PRId64 ".log, failed to malloc since %s", pWal->cfg.vgId,
+               walGetLastFileFirstVer(pWal), strerror(errno));
+        terrno = TSDB_CODE_OUT_OF_MEMORY;
+        code = -1;
+        goto END;
+      }
+      body = walEncryptBody(pWal, pEntry->body, pEntry->bodyLen, pBuf->pEncrypted[i]);
+    }
 
-    int32_t count = CBC_Encrypt(&opts);
+    pBuf->pIov[2 * i].base = pHead;
+    pBuf->pIov[2 * i].len = sizeof(SWalCkHead);
+    pBuf->pIov[2 * i + 1].base = body;
+    pBuf->pIov[2 * i + 1].len = cyptedBodyLen;
+    logSize += sizeof(SWalCkHead) + cyptedBodyLen;
+  }
 
-    //wDebug("vgId:%d, file:%" PRId64 ".log, index:%" PRId64 ", CBC_Encrypt cryptedBodyLen:%d, plainBodyLen:%d, %s", 
-    //      pWal->cfg.vgId, walGetLastFileFirstVer(pWal), index, count, plainBodyLen, __FUNCTION__);
+  wDebug("vgId:%d, write index, index:%" PRId64 "~%" PRId64 ", offset:%" PRId64 ", at %" PRId64, pWal->cfg.vgId,
+         pEntries[0].index, pEntries[num - 1].index, offset, idxOffset);
 
-    buf = newBodyEncrypted;
+  int64_t idxSize = sizeof(SWalIdxEntry) * num;
+  if (taosWriteFile(pWal->pIdxFile, pBuf->pIdxEntries, idxSize) != idxSize) {
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    wError("vgId:%d, failed to write idx entry due to %s. ver:%" PRId64, pWal->cfg.vgId, strerror(errno),
+           pEntries[0].index);
+    code = -1;
+    goto END;
   }
-  
-  if (taosWriteFile(pWal->pLogFile, (char *)buf, cyptedBodyLen) != cyptedBodyLen) {
+
+  if (taosWritevFile(pWal->pLogFile, pBuf->pIov, num * 2) != logSize) {
     terrno = TAOS_SYSTEM_ERROR(errno);
     wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
            strerror(errno));
     code = -1;
-    if(pWal->cfg.encryptAlgorithm == DND_CA_SM4){
-      taosMemoryFreeClear(newBody);
-      taosMemoryFreeClear(newBodyEncrypted);
-    }
     goto END;
   }
 
-  if(pWal->cfg.encryptAlgorithm == DND_CA_SM4){
-    taosMemoryFreeClear(newBody);
-    taosMemoryFreeClear(newBodyEncrypted); 
-    //wInfo("vgId:%d, free newBody newBodyEncrypted %s", 
-    //      pWal->cfg.vgId, __FUNCTION__);   
-  }
-
   // set status
   if (pWal->vers.firstVer == -1) {
     pWal->vers.firstVer = 0;
   }
-  pWal->vers.lastVer = index;
-  pWal->totSize += sizeof(SWalCkHead) + cyptedBodyLen;
-  pFileInfo->lastVer = index;
-  pFileInfo->fileSize += sizeof(SWalCkHead) + cyptedBodyLen;
+  pWal->vers.lastVer = pEntries[num - 1].index;
+  pWal->totSize += logSize;
+  pFileInfo->lastVer = pEntries[num - 1].index;
+  pFileInfo->fileSize += logSize;
 
-  return 0;
+  pWal->writeStat.numOfGroups++;
+  pWal->writeStat.numOfEntries += num;
+  pWal->writeStat.groupSizeHist[walStatHistBucket(num)]++;
 
 END:
+  if (encrypt) {
+    for (int32_t i = 0; i < num; ++i) {
+      taosMemoryFreeClear(pBuf->pEncrypted[i]);
+    }
+  }
+
+  if (code == 0) {
+    return 0;
+  }
+
   // recover in a reverse order
   if (taosFtruncateFile(pWal->pLogFile, offset) < 0) {
     terrno = TAOS_SYSTEM_ERROR(errno);
@@ -605,7 +656,6 @@ END:
     exit(EXIT_FAILURE);
   }
 
-  int64_t idxOffset = (index - pFileInfo->firstVer) * sizeof(SWalIdxEntry);
   if (taosFtruncateFile(pWal->pIdxFile, idxOffset) < 0) {
     terrno = TAOS_SYSTEM_ERROR(errno);
     wFatal("vgId:%d, failed to recover WAL idxfile from write error since %s, offset:%" PRId64, pWal->cfg.vgId,
@@ -616,29 +666,37 @@ END:
   return -1;
 }
 
-int64_t walAppendLog(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta, const void *body,
-                     int32_t bodyLen) {
-  taosThreadMutexLock(&pWal->mutex);
-
-  if (index != pWal->vers.lastVer + 1) {
-    terrno = TSDB_CODE_WAL_INVALID_VER;
-    taosThreadMutexUnlock(&pWal->mutex);
-    return -1;
+static int32_t walAppendGroup(SWal *pWal, const SWalAppendEntry *pEntries, int32_t num) {
+  // concurrency control:
+  // if logs are write with assigned index,
+  // smaller index must be write before larger one
+  for (int32_t i = 0; i < num; ++i) {
+    if (pEntries[i].index != pWal->vers.lastVer + 1 + i) {
+      terrno = TSDB_CODE_WAL_INVALID_VER;
+      return -1;
+    }
   }
 
   if (walCheckAndRoll(pWal) < 0) {
-    taosThreadMutexUnlock(&pWal->mutex);
     return -1;
   }
 
-  if (pWal->pLogFile == NULL || pWal->pIdxFile == NULL || pWal->writeCur < 0) {
+  if (pWal->pIdxFile == NULL || pWal->pLogFile == NULL || pWal->writeCur < 0) {
     if (walInitWriteFile(pWal) < 0) {
-      taosThreadMutexUnlock(&pWal->mutex);
       return -1;
     }
   }
 
-  if (walWriteImpl(pWal, index, msgType, syncMeta, body, bodyLen) < 0) {
+  return walWriteImpl(pWal, pEntries, num);
+}
+
+int64_t walAppendLog(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta, const void *body,
+                     int32_t bodyLen) {
+  SWalAppendEntry entry = {
+      .index = index, .msgType = msgType, .syncMeta = syncMeta, .body = body, .bodyLen = bodyLen};
+
+  taosThreadMutexLock(&pWal->mutex);
+  if (walAppendGroup(pWal, &entry, 1) < 0) {
     taosThreadMutexUnlock(&pWal->mutex);
     return -1;
   }
@@ -647,40 +705,38 @@ int64_t walAppendLog(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syn
   return index;
 }
 
-int32_t walWriteWithSyncInfo(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta, const void *body,
-                             int32_t bodyLen) {
-  int32_t code = 0;
+int64_t walAppendLogs(SWal *pWal, const SWalAppendEntry *pEntries, int32_t num, bool forceFsync) {
+  if (num <= 0) {
+    return walGetLastVer(pWal);
+  }
 
   taosThreadMutexLock(&pWal->mutex);
-
-  // concurrency control:
-  // if logs are write with assigned index,
-  // smaller index must be write before larger one
-  if (index != pWal->vers.lastVer + 1) {
-    terrno = TSDB_CODE_WAL_INVALID_VER;
+  if (walAppendGroup(pWal, pEntries, num) < 0) {
     taosThreadMutexUnlock(&pWal->mutex);
     return -1;
   }
 
-  if (walCheckAndRoll(pWal) < 0) {
-    taosThreadMutexUnlock(&pWal->mutex);
-    return -1;
+  if (forceFsync || (pWal->cfg.level == TAOS_WAL_FSYNC && pWal->cfg.fsyncPeriod == 0)) {
+    walDoFsync(pWal);
   }
 
-  if (pWal->pIdxFile == NULL || pWal->pLogFile == NULL || pWal->writeCur < 0) {
-    if (walInitWriteFile(pWal) < 0) {
-      taosThreadMutexUnlock(&pWal->mutex);
-      return -1;
-    }
-  }
+  taosThreadMutexUnlock(&pWal->mutex);
+  return pEntries[num - 1].index;
+}
 
-  if (walWriteImpl(pWal, index, msgType, syncMeta, body, bodyLen) < 0) {
+int32_t walWriteWithSyncInfo(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta, const void *body,
+                             int32_t bodyLen) {
+  SWalAppendEntry entry = {
+      .index = index, .msgType = msgType, .syncMeta = syncMeta, .body = body, .bodyLen = bodyLen};
+
+  taosThreadMutexLock(&pWal->mutex);
+  if (walAppendGroup(pWal, &entry, 1) < 0) {
     taosThreadMutexUnlock(&pWal->mutex);
     return -1;
   }
 
   taosThreadMutexUnlock(&pWal->mutex);
-  return code;
+  return 0;
 }
 
 int32_t walWrite(SWal *pWal, int64_t index, tmsg_t msgType, const void *body, int32_t bodyLen) {
@@ -695,11 +751,13 @@ int32_t walWrite(SWal *pWal, int64_t index, tmsg_t msgType, const void *body, in
 void walFsync(SWal *pWal, bool forceFsync) {
   taosThreadMutexLock(&pWal->mutex);
   if (forceFsync || (pWal->cfg.level == TAOS_WAL_FSYNC && pWal->cfg.fsyncPeriod == 0)) {
-    wTrace("vgId:%d, fileId:%" PRId64 ".log, do fsync", pWal->cfg.vgId, walGetCurFileFirstVer(pWal));
-    if (taosFsyncFile(pWal->pLogFile) < 0) {
-      wError("vgId:%d, file:%" PRId64 ".log, fsync failed since %s", pWal->cfg.vgId, walGetCurFileFirstVer(pWal),
-             strerror(errno));
-    }
+    walDoFsync(pWal);
   }
   taosThreadMutexUnlock(&pWal->mutex);
 }
+
+void walGetWriteStat(SWal *pWal, SWalWriteStat *pStat) {
+  taosThreadMutexLock(&pWal->mutex);
+  *pStat = pWal->writeStat;
+  taosThreadMutexUnlock(&pWal->mutex);
+}
@@ -361,6 +361,46 @@ TEST_F(WalKeepEnv, readHandleRead) {
   walCloseReader(pRead);
 }
 
+TEST_F(WalKeepEnv, appendLogsRead) {
+  walResetEnv();
+  int         code;
+  SWalReader* pRead = walOpenReader(pWal, NULL, 0);
+  ASSERT(pRead != NULL);
+
+  // groups of 1 to 9 entries
+  char            bodies[100][100];
+  SWalAppendEntry entries[10];
+  SWalSyncInfo    syncMeta = {.isWeek = -1, .seqNum = UINT64_MAX, .term = UINT64_MAX};
+  int             i = 0;
+  for (int num = 1; i < 100; num = num % 9 + 1) {
+    int n = 0;
+    for (; n < num && i < 100; n++, i++) {
+      sprintf(bodies[i], "%s-%d", ranStr, i);
+      entries[n] = {i, 0, syncMeta, bodies[i], (int32_t)strlen(bodies[i])};
+    }
+    ASSERT_EQ(walAppendLogs(pWal, entries, n, false), i - 1);
+  }
+  ASSERT_EQ(pWal->vers.lastVer, 99);
+
+  // the next group must start from the next version
+  entries[0].index = 101;
+  ASSERT_EQ(walAppendLogs(pWal, entries, 1, false), -1);
+
+  for (int ver = 0; ver < 100; ver++) {
+    code = walReadVer(pRead, ver);
+    ASSERT_EQ(code, 0);
+    ASSERT_EQ(pRead->pHead->head.version, ver);
+    int len = strlen(bodies[ver]);
+    ASSERT_EQ(pRead->pHead->head.bodyLen, len);
+    ASSERT_EQ(memcmp(bodies[ver], pRead->pHead->head.body, len), 0);
+  }
+  walCloseReader(pRead);
+
+  SWalWriteStat stat = {0};
+  walGetWriteStat(pWal, &stat);
+  ASSERT_EQ(stat.numOfEntries, 100);
+}
+
 TEST_F(WalRetentionEnv, repairMeta1) {
   walResetEnv();
   int code;
@@ -36,6 +36,7 @@
 #include <sys/sendfile.h>
 #endif
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #define LINUX_FILE_NO_TEXT_OPTION 0
 #define O_TEXT                    LINUX_FILE_NO_TEXT_OPTION
@@ -1174,6 +1175,168 @@ int64_t taosPReadFile(TdFilePtr pFile, void *buf, int64_t count, int64_t offset)
   return ret;
 }
 
+int64_t taosPReadvFile(TdFilePtr pFile, const TdFileIovec *iov, int32_t iovcnt, int64_t offset) {
+  if (pFile == NULL) {
+    return 0;
+  }
+
+  int64_t total = 0;
+#ifdef WINDOWS
+  for (int32_t i = 0; i < iovcnt; ++i) {
+    int64_t ret = taosPReadFile(pFile, iov[i].base, iov[i].len, offset + total);
+    if (ret < 0) {
+      return -1;
+    }
+    total += ret;
+    if (ret < iov[i].len) {
+      break;
+    }
+  }
+#else
+#if FILE_WITH_LOCK
+  taosThreadRwlockRdlock(&(pFile->rwlock));
+#endif
+  ASSERT(pFile->fd >= 0);  // Please check if you have closed the file.
+  if (pFile->fd < 0) {
+#if FILE_WITH_LOCK
+    taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+    return -1;
+  }
+
+  struct iovec vec[TD_FILE_IOV_MAX];
+  bool         eof = false;
+  for (int32_t i = 0; i < iovcnt && !eof;) {
+    int32_t cnt = TMIN(iovcnt - i, TD_FILE_IOV_MAX);
+    for (int32_t j = 0; j < cnt; ++j) {
+      vec[j].iov_base = iov[i + j].base;
+      vec[j].iov_len = iov[i + j].len;
+    }
+
+    int32_t first = 0;
+    while (first < cnt) {
+      int64_t ret = preadv(pFile->fd, vec + first, cnt - first, offset + total);
+      if (ret < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+#if FILE_WITH_LOCK
+        taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+        return -1;
+      }
+      if (ret == 0) {  // end of file
+        eof = true;
+        break;
+      }
+      total += ret;
+
+      // skip the buffers read completely, and continue from the rest of the one read partially
+      while (first < cnt && ret >= (int64_t)vec[first].iov_len) {
+        ret -= vec[first].iov_len;
+        first++;
+      }
+      if (first < cnt) {
+        vec[first].iov_base = (char *)vec[first].iov_base + ret;
+        vec[first].iov_len -= ret;
+      }
+    }
+    i += cnt;
+  }
+#if FILE_WITH_LOCK
+  taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+#endif
+  return total;
+}
+
+int64_t taosWritevFile(TdFilePtr pFile, const TdFileIovec *iov, int32_t iovcnt) {
+  if (pFile == NULL) {
+    return 0;
+  }
+
+  int64_t total = 0;
+#ifdef WINDOWS
+  for (int32_t i = 0; i < iovcnt; ++i) {
+    int64_t ret = taosWriteFile(pFile, iov[i].base, iov[i].len);
+    if (ret != iov[i].len) {
+      return -1;
+    }
+    total += ret;
+  }
+#else
+#if FILE_WITH_LOCK
+  taosThreadRwlockWrlock(&(pFile->rwlock));
+#endif
+  if (pFile->fd < 0) {
+#if FILE_WITH_LOCK
+    taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+    return 0;
+  }
+
+  struct iovec vec[TD_FILE_IOV_MAX];
+  for (int32_t i = 0; i < iovcnt;) {
+    int32_t cnt = TMIN(iovcnt - i, TD_FILE_IOV_MAX);
+    for (int32_t j = 0; j < cnt; ++j) {
+      vec[j].iov_base = iov[i + j].base;
+      vec[j].iov_len = iov[i + j].len;
+    }
+
+    int32_t first = 0;
+    while (first < cnt) {
+      int64_t ret = writev(pFile->fd, vec + first, cnt - first);
+      if (ret < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+#if FILE_WITH_LOCK
+        taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+        return -1;
+      }
+      total += ret;
+
+      // skip the buffers written completely, and continue from the rest of the one written partially
+      while (first < cnt && ret >= (int64_t)vec[first].iov_len) {
+        ret -= vec[first].iov_len;
+        first++;
+      }
+      if (first < cnt) {
+        vec[first].iov_base = (char *)vec[first].iov_base + ret;
+        vec[first].iov_len -= ret;
+      }
+    }
+    i += cnt;
+  }
+#if FILE_WITH_LOCK
+  taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+#endif
+  return total;
+}
+
+int32_t taosPrefetchFile(TdFilePtr pFile, int64_t offset, int64_t count) {
+  if (pFile == NULL || count <= 0) {
+    return 0;
+  }
+
+#if defined(WINDOWS) || defined(_TD_DARWIN_64)
+  return 0;
+#else
+  if (pFile->fd < 0) {
+    return 0;
+  }
+  // start the kernel readahead of the range in background, it does not wait for the io to complete
+  int32_t code = posix_fadvise(pFile->fd, offset, count, POSIX_FADV_WILLNEED);
+  if (code != 0) {
+    errno = code;
+    return -1;
+  }
+  return 0;
+#endif
+}
+
 int32_t taosFsyncFile(TdFilePtr pFile) {
   if (pFile == NULL) {
     return 0;
@@ -168,6 +168,49 @@ TEST(osTest, osFile) {
   //printf("remove file success");
 }
 
+// scatter a file into more buffers than one vectored read takes, with the offset and the sizes not aligned
+TEST(osTest, osPReadvFile) {
+  char   *fname = "./osfiletest2.txt";
+  int32_t size = 1024 * 1024 + 7;
+  char   *data = (char *)taosMemoryMalloc(size);
+  for (int32_t i = 0; i < size; ++i) {
+    data[i] = (char)(i % 251);
+  }
+
+  TdFilePtr pFile = taosOpenFile(fname, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_READ | TD_FILE_TRUNC);
+  ASSERT_NE(pFile, nullptr);
+  ASSERT_EQ(taosPWriteFile(pFile, data, size, 0), size);
+
+  int32_t     offset = 13;
+  int32_t     numOfBufs = TD_FILE_IOV_MAX * 3 + 5;
+  TdFileIovec iov[TD_FILE_IOV_MAX * 3 + 5];
+  char       *buf = (char *)taosMemoryCalloc(1, size);
+  int64_t     len = 0;
+  for (int32_t i = 0; i < numOfBufs; ++i) {
+    iov[i].base = buf + len;
+    iov[i].len = (i % 7) * 97 + 1;
+    len += iov[i].len;
+  }
+  ASSERT_LT(offset + len, size);
+
+  ASSERT_EQ(taosPReadvFile(pFile, iov, numOfBufs, offset), len);
+  ASSERT_EQ(memcmp(buf, data + offset, len), 0);
+
+  // read across the end of file
+  memset(buf, 0, size);
+  int64_t start = size - len / 2;
+  ASSERT_EQ(taosPReadvFile(pFile, iov, numOfBufs, start), size - start);
+  ASSERT_EQ(memcmp(buf, data + start, size - start), 0);
+
+  // read from the end of file
+  ASSERT_EQ(taosPReadvFile(pFile, iov, numOfBufs, size), 0);
+
+  taosCloseFile(&pFile);
+  taosRemoveFile(fname);
+  taosMemoryFree(buf);
+  taosMemoryFree(data);
+}
+
 #ifndef OSFILE_PERFORMANCE_TEST
 
 #define MAX_WORDS          100
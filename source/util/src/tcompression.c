@@ -323,6 +323,19 @@ static const int32_t TEST_NUMBER = 1;
 bool lossyFloat = false;
 bool lossyDouble = false;
 
+static TdThreadOnce compressKernelInit = PTHREAD_ONCE_INIT;
+
+static void doSelectCompressKernels() {
+  ECompressKernel kernel = tsSelectDecompressKernel();
+  uInfo("decompress kernel:%s is selected", tsGetDecompressKernel(kernel)->name);
+  kernel = tsSelectCompressKernel();
+  uInfo("compress kernel:%s is selected", tsGetCompressKernel(kernel)->name);
+}
+
+// Called on each entry of the kernels, so that the client picks the SIMD kernels as well as the dnode, whether the
+// lossy compression is initialized or not.
+void tsInitCompressKernels() { (void)taosThreadOnce(&compressKernelInit, doSelectCompressKernels); }
+
 // init call
 int32_t tsCompressInit(char *lossyColumns, float fPrecision, double dPrecision, uint32_t maxIntervals,
                        uint32_t intervals, int32_t ifAdtFse, const char *compressor) {
@@ -333,6 +346,8 @@ int32_t tsCompressInit(char *lossyColumns, float fPrecision, double dPrecision,
   tdszInit(fPrecision, dPrecision, maxIntervals, intervals, ifAdtFse, compressor);
   if (lossyFloat) uTrace("lossy compression float  is opened. ");
   if (lossyDouble) uTrace("lossy compression double is opened. ");
+
+  tsInitCompressKernels();
   return 1;
 }
 // exit call
@@ -342,6 +357,12 @@ void tsCompressExit() { tdszExit(); }
  * Compress Integer (Simple8B).
  */
 int32_t tsCompressINTImp(const char *const input, const int32_t nelements, char *const output, const char type) {
+  tsInitCompressKernels();
+  return tsCompressKernel->compressInt(input, nelements, output, type);
+}
+
+int32_t tsCompressIntImpl_Scalar(const char *const input, const int32_t nelements, char *const output,
+                                 const char type) {
   // Selector value:              0    1   2   3   4   5   6   7   8  9  10  11
   // 12  13  14  15
   char    bit_per_integer[] = {0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 15, 20, 30, 60};
@@ -467,10 +488,14 @@ int32_t tsDecompressINTImp(const char *const input, const int32_t nelements, cha
     return nelements * word_length;
   }
 
-#if __AVX2__
-  tsDecompressIntImpl_Hw(input, nelements, output, type);
-  return nelements * word_length;
-#else
+  tsInitCompressKernels();
+  return tsDecompressKernel->decompressInt(input, nelements, output, type);
+}
+
+int32_t tsDecompressIntImpl_Scalar(const char *const input, const int32_t nelements, char *const output,
+                                   const char type) {
+  int32_t word_length = getWordLength(type);
+
   // Selector value: 0    1   2   3   4   5   6   7   8  9  10  11 12  13  14  15
   char    bit_per_integer[] = {0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 15, 20, 30, 60};
   int32_t selector_to_elems[] = {240, 120, 60, 30, 20, 15, 12, 10, 8, 7, 6, 5, 4, 3, 2, 1};
@@ -530,7 +555,6 @@ int32_t tsDecompressINTImp(const char *const input, const int32_t nelements, cha
   }
 
   return nelements * word_length;
-#endif
 }
 
 /* ----------------------------------------------Bool Compression ---------------------------------------------- */
@@ -715,6 +739,11 @@ int32_t tsDecompressStringImp(const char *const input, int32_t compressedSize, c
 // TODO: Take care here, we assumes little endian encoding.
 //
 int32_t tsCompressTimestampImp(const char *const input, const int32_t nelements, char *const output) {
+  tsInitCompressKernels();
+  return tsCompressKernel->compressTimestamp(input, nelements, output);
+}
+
+int32_t tsCompressTimestampImpl_Scalar(const char *const input, const int32_t nelements, char *const output) {
   int32_t _pos = 1;
   int32_t longBytes = LONG_BYTES;
 
@@ -822,68 +851,72 @@ int32_t tsDecompressTimestampImp(const char *const input, const int32_t nelement
     memcpy(output, input + 1, nelements * longBytes);
     return nelements * longBytes;
   } else if (input[0] == 1) {  // Decompress
-    if (tsSIMDEnable && tsAVX512Enable) {
-      tsDecompressTimestampAvx512(input, nelements, output, false);
-    } else if (tsSIMDEnable && tsAVX2Enable) {
-      tsDecompressTimestampAvx2(input, nelements, output, false);
+    tsInitCompressKernels();
+    tsDecompressKernel->decompressTimestamp(input, nelements, output, false);
+  }
+
+  return nelements * longBytes;
+}
+
+int32_t tsDecompressTimestampImpl_Scalar(const char *const input, const int32_t nelements, char *const output,
+                                         bool UNUSED_PARAM(bigEndian)) {
+  int64_t longBytes = LONG_BYTES;
+
+  int64_t *ostream = (int64_t *)output;
+
+  int32_t ipos = 1, opos = 0;
+  int8_t  nbytes = 0;
+  int64_t prev_value = 0;
+  int64_t prev_delta = 0;
+  int64_t delta_of_delta = 0;
+
+  while (1) {
+    uint8_t flags = input[ipos++];
+    // Decode dd1
+    uint64_t dd1 = 0;
+    nbytes = flags & INT8MASK(4);
+    if (nbytes == 0) {
+      delta_of_delta = 0;
     } else {
-      int64_t *ostream = (int64_t *)output;
-
-      int32_t ipos = 1, opos = 0;
-      int8_t  nbytes = 0;
-      int64_t prev_value = 0;
-      int64_t prev_delta = 0;
-      int64_t delta_of_delta = 0;
-
-      while (1) {
-        uint8_t flags = input[ipos++];
-        // Decode dd1
-        uint64_t dd1 = 0;
-        nbytes = flags & INT8MASK(4);
-        if (nbytes == 0) {
-          delta_of_delta = 0;
-        } else {
-          if (is_bigendian()) {
-            memcpy(((char *)(&dd1)) + longBytes - nbytes, input + ipos, nbytes);
-          } else {
-            memcpy(&dd1, input + ipos, nbytes);
-          }
-          delta_of_delta = ZIGZAG_DECODE(int64_t, dd1);
-        }
+      if (is_bigendian()) {
+        memcpy(((char *)(&dd1)) + longBytes - nbytes, input + ipos, nbytes);
+      } else {
+        memcpy(&dd1, input + ipos, nbytes);
+      }
+      delta_of_delta = ZIGZAG_DECODE(int64_t, dd1);
+    }
 
-        ipos += nbytes;
-        if (opos == 0) {
-          prev_value = delta_of_delta;
-          prev_delta = 0;
-          ostream[opos++] = delta_of_delta;
-        } else {
-          prev_delta = delta_of_delta + prev_delta;
-          prev_value = prev_value + prev_delta;
-          ostream[opos++] = prev_value;
-        }
-        if (opos == nelements) return nelements * longBytes;
+    ipos += nbytes;
+    if (opos == 0) {
+      prev_value = delta_of_delta;
+      prev_delta = 0;
+      ostream[opos++] = delta_of_delta;
+    } else {
+      prev_delta = delta_of_delta + prev_delta;
+      prev_value = prev_value + prev_delta;
+      ostream[opos++] = prev_value;
+    }
+    if (opos == nelements) return nelements * longBytes;
 
-        // Decode dd2
-        uint64_t dd2 = 0;
-        nbytes = (flags >> 4) & INT8MASK(4);
-        if (nbytes == 0) {
-          delta_of_delta = 0;
-        } else {
-          if (is_bigendian()) {
-            memcpy(((char *)(&dd2)) + longBytes - nbytes, input + ipos, nbytes);
-          } else {
-            memcpy(&dd2, input + ipos, nbytes);
-          }
-          // zigzag_decoding
-          delta_of_delta = ZIGZAG_DECODE(int64_t, dd2);
-        }
-        ipos += nbytes;
-        prev_delta = delta_of_delta + prev_delta;
-        prev_value = prev_value + prev_delta;
-        ostream[opos++] = prev_value;
-        if (opos == nelements) return nelements * longBytes;
+    // Decode dd2
+    uint64_t dd2 = 0;
+    nbytes = (flags >> 4) & INT8MASK(4);
+    if (nbytes == 0) {
+      delta_of_delta = 0;
+    } else {
+      if (is_bigendian()) {
+        memcpy(((char *)(&dd2)) + longBytes - nbytes, input + ipos, nbytes);
+      } else {
+        memcpy(&dd2, input + ipos, nbytes);
       }
+      // zigzag_decoding
+      delta_of_delta = ZIGZAG_DECODE(int64_t, dd2);
     }
+    ipos += nbytes;
+    prev_delta = delta_of_delta + prev_delta;
+    prev_value = prev_value + prev_delta;
+    ostream[opos++] = prev_value;
+    if (opos == nelements) return nelements * longBytes;
   }
 
   return nelements * longBytes;
@@ -924,6 +957,11 @@ void encodeDoubleValue(uint64_t diff, uint8_t flag, char *const output, int32_t
 }
 
 int32_t tsCompressDoubleImp(const char *const input, const int32_t nelements, char *const output) {
+  tsInitCompressKernels();
+  return tsCompressKernel->compressDouble(input, nelements, output);
+}
+
+int32_t tsCompressDoubleImpl_Scalar(const char *const input, const int32_t nelements, char *const output) {
   int32_t byte_limit = nelements * DOUBLE_BYTES + 1;
   int32_t opos = 1;
 
@@ -1070,6 +1108,11 @@ void encodeFloatValue(uint32_t diff, uint8_t flag, char *const output, int32_t *
 }
 
 int32_t tsCompressFloatImp(const char *const input, const int32_t nelements, char *const output) {
+  tsInitCompressKernels();
+  return tsCompressKernel->compressFloat(input, nelements, output);
+}
+
+int32_t tsCompressFloatImpl_Scalar(const char *const input, const int32_t nelements, char *const output) {
   float  *istream = (float *)input;
   int32_t byte_limit = nelements * FLOAT_BYTES + 1;
   int32_t opos = 1;
@@ -1198,14 +1241,12 @@ int32_t tsDecompressFloatImp(const char *const input, const int32_t nelements, c
     return nelements * FLOAT_BYTES;
   }
 
-  if (tsSIMDEnable && tsAVX2Enable) {
-    tsDecompressFloatImplAvx2(input, nelements, output);
-  } else if (tsSIMDEnable && tsAVX512Enable) {
-    tsDecompressFloatImplAvx512(input, nelements, output);
-  } else {  // alternative implementation without SIMD instructions.
-    tsDecompressFloatHelper(input, nelements, (float *)output);
-  }
+  tsInitCompressKernels();
+  return tsDecompressKernel->decompressFloat(input, nelements, output);
+}
 
+int32_t tsDecompressFloatImpl_Scalar(const char *const input, const int32_t nelements, char *const output) {
+  tsDecompressFloatHelper(input, nelements, (float *)output);
   return nelements * FLOAT_BYTES;
 }
 
@@ -40,449 +40,341 @@ int32_t getWordLength(char type) {
   return wordLength;
 }
 
-int32_t tsDecompressIntImpl_Hw(const char *const input, const int32_t nelements, char *const output, const char type) {
-  int32_t word_length = getWordLength(type);
+#if defined(_TD_X86_) && !defined(WINDOWS) && (defined(__GNUC__) || defined(__clang__))
+// Each SIMD kernel carries its own target attribute, so the whole file builds for the baseline instruction set and
+// the kernel actually executed is chosen at runtime, see tsSelectDecompressKernel.
+#define DECOMPRESS_MULTIVERSION
+#define DECOMPRESS_TARGET(_t) __attribute__((target(_t)))
+#include <immintrin.h>
+#else
+#define DECOMPRESS_TARGET(_t)
+#endif
+
+// Selector value:                          0    1    2   3   4   5   6   7   8  9  10 11 12 13 14 15
+static const char    BIT_PER_INTEGER[] = {0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 15, 20, 30, 60};
+static const int32_t SELECTOR_TO_ELEMS[] = {240, 120, 60, 30, 20, 15, 12, 10, 8, 7, 6, 5, 4, 3, 2, 1};
 
-  // Selector value:           0  1   2   3   4   5   6   7   8  9  10  11 12  13  14  15
-  char    bit_per_integer[] = {0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 15, 20, 30, 60};
-  int32_t selector_to_elems[] = {240, 120, 60, 30, 20, 15, 12, 10, 8, 7, 6, 5, 4, 3, 2, 1};
+DECOMPRESS_TARGET("avx2")
+int32_t tsDecompressIntImplAvx2(const char *const input, const int32_t nelements, char *const output, const char type) {
+#ifdef DECOMPRESS_MULTIVERSION
+  // only the 64bit integer is vectorized, the narrower types are not worth it.
+  if (type != TSDB_DATA_TYPE_BIGINT) {
+    return tsDecompressIntImpl_Scalar(input, nelements, output, type);
+  }
 
   const char *ip = input + 1;
-  int32_t     count = 0;
+  int64_t    *p = (int64_t *)output;
   int32_t     _pos = 0;
   int64_t     prevValue = 0;
 
-#if __AVX2__ || __AVX512F__
   while (_pos < nelements) {
-    uint64_t w = *(uint64_t*) ip;
+    uint64_t w = 0;
+    memcpy(&w, ip, LONG_BYTES);
 
     char    selector = (char)(w & INT64MASK(4));       // selector = 4
-    char    bit = bit_per_integer[(int32_t)selector];  // bit = 3
-    int32_t elems = selector_to_elems[(int32_t)selector];
+    char    bit = BIT_PER_INTEGER[(int32_t)selector];  // bit = 3
+    int32_t elems = SELECTOR_TO_ELEMS[(int32_t)selector];
 
-    // Optimize the performance, by remove the constantly switch operation.
     int32_t  v = 4;
     uint64_t zigzag_value = 0;
     uint64_t mask = INT64MASK(bit);
 
-    switch (type) {
-      case TSDB_DATA_TYPE_BIGINT: {
-        int64_t* p = (int64_t*) output;
-
-        int32_t gRemainder = (nelements - _pos);
-        int32_t num = (gRemainder > elems)? elems:gRemainder;
-
-        int32_t batch = 0;
-        int32_t remain = 0;
-        if (tsSIMDEnable && tsAVX512Enable) {
-#if __AVX512F__
-        batch = num >> 3;
-        remain = num & 0x07;
-#endif
-        } else if (tsSIMDEnable && tsAVX2Enable) {
-#if __AVX2__
-        batch = num >> 2;
-        remain = num & 0x03;
-#endif
-        }
-
-        if (selector == 0 || selector == 1) {
-          if (tsSIMDEnable && tsAVX512Enable) {
-#if __AVX512F__
-            for (int32_t i = 0; i < batch; ++i) {
-            __m512i prev = _mm512_set1_epi64(prevValue);
-            _mm512_storeu_si512((__m512i *)&p[_pos], prev);
-            _pos += 8;	//handle 64bit x 8 = 512bit
-            }
-            for (int32_t i = 0; i < remain; ++i) {
-            p[_pos++] = prevValue;
-            }
-#endif
-          } else if (tsSIMDEnable && tsAVX2Enable) {
-            for (int32_t i = 0; i < batch; ++i) {
-              __m256i prev = _mm256_set1_epi64x(prevValue);
-              _mm256_storeu_si256((__m256i *)&p[_pos], prev);
-              _pos += 4;
-            }
-
-            for (int32_t i = 0; i < remain; ++i) {
-              p[_pos++] = prevValue;
-            }
-
-          } else { // alternative implementation without SIMD instructions.
-            for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-              p[_pos++] = prevValue;
-              v += bit;
-            }
-          }
-        } else {
-          if (tsSIMDEnable && tsAVX512Enable) {
- #if __AVX512F__
-            __m512i sum_mask1 = _mm512_set_epi64(6, 6, 4, 4, 2, 2, 0, 0);
-            __m512i sum_mask2 = _mm512_set_epi64(5, 5, 5, 5, 1, 1, 1, 1);
-            __m512i sum_mask3 = _mm512_set_epi64(3, 3, 3, 3, 3, 3, 3, 3);
-            __m512i base = _mm512_set1_epi64(w);
-            __m512i maskVal = _mm512_set1_epi64(mask);
-            __m512i shiftBits = _mm512_set_epi64(bit * 7 + 4, bit * 6 + 4, bit * 5 + 4, bit * 4 + 4, bit * 3 + 4, bit * 2 + 4, bit + 4, 4);
-            __m512i inc = _mm512_set1_epi64(bit << 3);
-
-            for (int32_t i = 0; i < batch; ++i) {
-
-            __m512i after = _mm512_srlv_epi64(base, shiftBits);
-            __m512i zigzagVal = _mm512_and_si512(after, maskVal);
-
-            // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
-            __m512i signmask = _mm512_and_si512(_mm512_set1_epi64(1), zigzagVal);
-            signmask = _mm512_sub_epi64(_mm512_setzero_si512(), signmask);
-            __m512i delta = _mm512_xor_si512(_mm512_srli_epi64(zigzagVal, 1), signmask);
-
-            // calculate the cumulative sum (prefix sum) for each number
-            // decode[0] =  prevValue + final[0]
-            // decode[1] = decode[0] + final[1]   -----> prevValue + final[0] + final[1]
-            // decode[2] = decode[1] + final[2]   -----> prevValue + final[0] + final[1] + final[2]
-            // decode[3] = decode[2] + final[3]   -----> prevValue + final[0] + final[1] + final[2] + final[3]
-
-
-            //7		6		5		4		3		2		1		0
-            //D7		D6		D5		D4		D3		D2		D1		D0
-            //D6		0		D4		0		D2		0		D0		0
-            //D7+D6		D6		D5+D4		D4		D3+D2		D2		D1+D0		D0
-            //13		6		9		4		5		2		1		0
-            __m512i prev = _mm512_set1_epi64(prevValue);
-            __m512i cum_sum = _mm512_add_epi64(delta, _mm512_maskz_permutexvar_epi64(0xaa, sum_mask1, delta));
-            cum_sum = _mm512_add_epi64(cum_sum, _mm512_maskz_permutexvar_epi64(0xcc, sum_mask2, cum_sum));
-            cum_sum = _mm512_add_epi64(cum_sum, _mm512_maskz_permutexvar_epi64(0xf0, sum_mask3, cum_sum));
-
-
-
-            //13		6		9		4		5		2		1		0
-            //D7,D6		D6		D5,D4		D4		D3,D2		D2		D1,D0		D0
-            //+D5,D4	D5,D4,		0		0		D1,D0		D1,D0		0		0
-            //D7~D4		D6~D4		D5~D4		D4		D3~D0		D2~D0		D1~D0		D0
-            //22		15		9		4		6		3		1		0
-            //
-            //D3~D0		D3~D0		D3~D0		D3~D0		0		0		0		0
-            //28		21		15		10		6		3		1		0
-
-
-            cum_sum = _mm512_add_epi64(cum_sum, prev);
-            _mm512_storeu_si512((__m512i *)&p[_pos], cum_sum);
-
-            shiftBits = _mm512_add_epi64(shiftBits, inc);
-            prevValue = p[_pos + 7];
-            _pos += 8;
-
-            }
-            // handle the remain value
-            for (int32_t i = 0; i < remain; i++) {
-            zigzag_value = ((w >> (v + (batch * bit * 8))) & mask);
-            prevValue += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-            p[_pos++] = prevValue;
-            v += bit;
-            }
-#endif
-          } else if (tsSIMDEnable && tsAVX2Enable) {
-            __m256i base = _mm256_set1_epi64x(w);
-            __m256i maskVal = _mm256_set1_epi64x(mask);
-
-            __m256i shiftBits = _mm256_set_epi64x(bit * 3 + 4, bit * 2 + 4, bit + 4, 4);
-            __m256i inc = _mm256_set1_epi64x(bit << 2);
-
-            for (int32_t i = 0; i < batch; ++i) {
-              __m256i after = _mm256_srlv_epi64(base, shiftBits);
-              __m256i zigzagVal = _mm256_and_si256(after, maskVal);
-
-              // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
-              __m256i signmask = _mm256_and_si256(_mm256_set1_epi64x(1), zigzagVal);
-              signmask = _mm256_sub_epi64(_mm256_setzero_si256(), signmask);
-
-              // get four zigzag values here
-              __m256i delta = _mm256_xor_si256(_mm256_srli_epi64(zigzagVal, 1), signmask);
-
-              // calculate the cumulative sum (prefix sum) for each number
-              // decode[0] = prevValue + final[0]
-              // decode[1] = decode[0] + final[1]   -----> prevValue + final[0] + final[1]
-              // decode[2] = decode[1] + final[2]   -----> prevValue + final[0] + final[1] + final[2]
-              // decode[3] = decode[2] + final[3]   -----> prevValue + final[0] + final[1] + final[2] + final[3]
-
-              //  1, 2, 3, 4
-              //+ 0, 1, 0, 3
-              //  1, 3, 3, 7
-              // shift and add for the first round
-              __m128i prev = _mm_set1_epi64x(prevValue);
-              __m256i x = _mm256_slli_si256(delta, 8);
-
-              delta = _mm256_add_epi64(delta, x);
-              _mm256_storeu_si256((__m256i *)&p[_pos], delta);
-
-              //  1, 3, 3, 7
-              //+ 0, 0, 3, 3
-              //  1, 3, 6, 10
-              // shift and add operation for the second round
-              __m128i firstPart = _mm_loadu_si128((__m128i *)&p[_pos]);
-              __m128i secondItem = _mm_set1_epi64x(p[_pos + 1]);
-              __m128i secPart = _mm_add_epi64(_mm_loadu_si128((__m128i *)&p[_pos + 2]), secondItem);
-              firstPart = _mm_add_epi64(firstPart, prev);
-              secPart = _mm_add_epi64(secPart, prev);
-
-              // save it in the memory
-              _mm_storeu_si128((__m128i *)&p[_pos], firstPart);
-              _mm_storeu_si128((__m128i *)&p[_pos + 2], secPart);
-
-              shiftBits = _mm256_add_epi64(shiftBits, inc);
-              prevValue = p[_pos + 3];
-              _pos += 4;
-            }
-
-            // handle the remain value
-            for (int32_t i = 0; i < remain; i++) {
-              zigzag_value = ((w >> (v + (batch * bit * 4))) & mask);
-              prevValue += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-              p[_pos++] = prevValue;
-              v += bit;
-            }
-          } else {  // alternative implementation without SIMD instructions.
-            for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-              zigzag_value = ((w >> v) & mask);
-              prevValue += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-              p[_pos++] = prevValue;
-              v += bit;
-            }
-          }
-        }
-      } break;
-      case TSDB_DATA_TYPE_INT: {
-        int32_t* p = (int32_t*) output;
-
-        if (selector == 0 || selector == 1) {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            p[_pos++] = (int32_t)prevValue;
-          }
-        } else {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            zigzag_value = ((w >> v) & mask);
-            prevValue += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-            p[_pos++] = (int32_t)prevValue;
-            v += bit;
-          }
-        }
-      } break;
-      case TSDB_DATA_TYPE_SMALLINT: {
-        int16_t* p = (int16_t*) output;
-
-        if (selector == 0 || selector == 1) {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            p[_pos++] = (int16_t)prevValue;
-          }
-        } else {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            zigzag_value = ((w >> v) & mask);
-            prevValue += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-            p[_pos++] = (int16_t)prevValue;
-            v += bit;
-          }
-        }
-      } break;
-
-      case TSDB_DATA_TYPE_TINYINT: {
-        int8_t *p = (int8_t *)output;
-
-        if (selector == 0 || selector == 1) {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            p[_pos++] = (int8_t)prevValue;
-          }
-        } else {
-          for (int32_t i = 0; i < elems && count < nelements; i++, count++) {
-            zigzag_value = ((w >> v) & mask);
-            prevValue += ZIGZAG_DECODE(int64_t, zigzag_value);
-
-            p[_pos++] = (int8_t)prevValue;
-            v += bit;
-          }
-        }
-      } break;
+    int32_t gRemainder = (nelements - _pos);
+    int32_t num = (gRemainder > elems) ? elems : gRemainder;
+    int32_t batch = num >> 2;
+    int32_t remain = num & 0x03;
+
+    if (selector == 0 || selector == 1) {
+      for (int32_t i = 0; i < batch; ++i) {
+        __m256i prev = _mm256_set1_epi64x(prevValue);
+        _mm256_storeu_si256((__m256i *)&p[_pos], prev);
+        _pos += 4;
+      }
+
+      for (int32_t i = 0; i < remain; ++i) {
+        p[_pos++] = prevValue;
+      }
+    } else {
+      __m256i base = _mm256_set1_epi64x(w);
+      __m256i maskVal = _mm256_set1_epi64x(mask);
+
+      __m256i shiftBits = _mm256_set_epi64x(bit * 3 + 4, bit * 2 + 4, bit + 4, 4);
+      __m256i inc = _mm256_set1_epi64x(bit << 2);
+
+      for (int32_t i = 0; i < batch; ++i) {
+        __m256i after = _mm256_srlv_epi64(base, shiftBits);
+        __m256i zigzagVal = _mm256_and_si256(after, maskVal);
+
+        // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
+        __m256i signmask = _mm256_and_si256(_mm256_set1_epi64x(1), zigzagVal);
+        signmask = _mm256_sub_epi64(_mm256_setzero_si256(), signmask);
+
+        // get four zigzag values here
+        __m256i delta = _mm256_xor_si256(_mm256_srli_epi64(zigzagVal, 1), signmask);
+
+        // calculate the cumulative sum (prefix sum) for each number
+        // decode[0] = prevValue + final[0]
+        // decode[1] = decode[0] + final[1]   -----> prevValue + final[0] + final[1]
+        // decode[2] = decode[1] + final[2]   -----> prevValue + final[0] + final[1] + final[2]
+        // decode[3] = decode[2] + final[3]   -----> prevValue + final[0] + final[1] + final[2] + final[3]
+
+        //  1, 2, 3, 4
+        //+ 0, 1, 0, 3
+        //  1, 3, 3, 7
+        // shift and add for the first round
+        __m128i prev = _mm_set1_epi64x(prevValue);
+        __m256i x = _mm256_slli_si256(delta, 8);
+
+        delta = _mm256_add_epi64(delta, x);
+        _mm256_storeu_si256((__m256i *)&p[_pos], delta);
+
+        //  1, 3, 3, 7
+        //+ 0, 0, 3, 3
+        //  1, 3, 6, 10
+        // shift and add operation for the second round
+        __m128i firstPart = _mm_loadu_si128((__m128i *)&p[_pos]);
+        __m128i secondItem = _mm_set1_epi64x(p[_pos + 1]);
+        __m128i secPart = _mm_add_epi64(_mm_loadu_si128((__m128i *)&p[_pos + 2]), secondItem);
+        firstPart = _mm_add_epi64(firstPart, prev);
+        secPart = _mm_add_epi64(secPart, prev);
+
+        // save it in the memory
+        _mm_storeu_si128((__m128i *)&p[_pos], firstPart);
+        _mm_storeu_si128((__m128i *)&p[_pos + 2], secPart);
+
+        shiftBits = _mm256_add_epi64(shiftBits, inc);
+        prevValue = p[_pos + 3];
+        _pos += 4;
+      }
+
+      // handle the remain value
+      for (int32_t i = 0; i < remain; i++) {
+        zigzag_value = ((w >> (v + (batch * bit * 4))) & mask);
+        prevValue += ZIGZAG_DECODE(int64_t, zigzag_value);
+
+        p[_pos++] = prevValue;
+        v += bit;
+      }
     }
 
     ip += LONG_BYTES;
   }
 
+  return nelements * LONG_BYTES;
+#else
+  return tsDecompressIntImpl_Scalar(input, nelements, output, type);
 #endif
-  return nelements * word_length;
 }
 
-int32_t tsDecompressFloatImplAvx512(const char *const input, const int32_t nelements, char *const output) {
-#if __AVX512F__
-    // todo add it
-#endif
-  return 0;
-}
-
-// todo add later
-int32_t tsDecompressFloatImplAvx2(const char *const input, const int32_t nelements, char *const output) {
-#if __AVX2__
-#endif
-  return 0;
-}
+DECOMPRESS_TARGET("avx512f")
+int32_t tsDecompressIntImplAvx512(const char *const input, const int32_t nelements, char *const output,
+                                  const char type) {
+#ifdef DECOMPRESS_MULTIVERSION
+  if (type != TSDB_DATA_TYPE_BIGINT) {
+    return tsDecompressIntImpl_Scalar(input, nelements, output, type);
+  }
 
-int32_t tsDecompressTimestampAvx2(const char *const input, const int32_t nelements, char *const output,
-                                  bool bigEndian) {
-#if 0
-  int64_t *ostream = (int64_t *)output;
-  int32_t  ipos = 1, opos = 0;
-  __m128i  prevVal = _mm_setzero_si128();
-  __m128i  prevDelta = _mm_setzero_si128();
+  const char *ip = input + 1;
+  int64_t    *p = (int64_t *)output;
+  int32_t     _pos = 0;
+  int64_t     prevValue = 0;
 
-#if __AVX2__
-  int32_t batch = nelements >> 1;
-  int32_t remainder = nelements & 0x01;
-  __mmask16 mask2[16] = {0, 0x0001, 0x0003, 0x0007, 0x000f, 0x001f, 0x003f, 0x007f, 0x00ff};
+  while (_pos < nelements) {
+    uint64_t w = 0;
+    memcpy(&w, ip, LONG_BYTES);
 
-  int32_t i = 0;
-  if (batch > 1) {
-    // first loop
-    uint8_t flags = input[ipos++];
+    char    selector = (char)(w & INT64MASK(4));       // selector = 4
+    char    bit = BIT_PER_INTEGER[(int32_t)selector];  // bit = 3
+    int32_t elems = SELECTOR_TO_ELEMS[(int32_t)selector];
 
-    int8_t nbytes1 = flags & INT8MASK(4);  // range of nbytes starts from 0 to 7
-    int8_t nbytes2 = (flags >> 4) & INT8MASK(4);
+    int32_t  v = 4;
+    uint64_t zigzag_value = 0;
+    uint64_t mask = INT64MASK(bit);
 
-    __m128i data1;
-    if (nbytes1 == 0) {
-      data1 = _mm_setzero_si128();
+    int32_t gRemainder = (nelements - _pos);
+    int32_t num = (gRemainder > elems) ? elems : gRemainder;
+    int32_t batch = num >> 3;
+    int32_t remain = num & 0x07;
+
+    if (selector == 0 || selector == 1) {
+      for (int32_t i = 0; i < batch; ++i) {
+        __m512i prev = _mm512_set1_epi64(prevValue);
+        _mm512_storeu_si512((__m512i *)&p[_pos], prev);
+        _pos += 8;  // handle 64bit x 8 = 512bit
+      }
+      for (int32_t i = 0; i < remain; ++i) {
+        p[_pos++] = prevValue;
+      }
     } else {
-      memcpy(&data1, (const void*) (input + ipos), nbytes1);
+      __m512i sum_mask1 = _mm512_set_epi64(6, 6, 4, 4, 2, 2, 0, 0);
+      __m512i sum_mask2 = _mm512_set_epi64(5, 5, 5, 5, 1, 1, 1, 1);
+      __m512i sum_mask3 = _mm512_set_epi64(3, 3, 3, 3, 3, 3, 3, 3);
+      __m512i base = _mm512_set1_epi64(w);
+      __m512i maskVal = _mm512_set1_epi64(mask);
+      __m512i shiftBits = _mm512_set_epi64(bit * 7 + 4, bit * 6 + 4, bit * 5 + 4, bit * 4 + 4, bit * 3 + 4,
+                                           bit * 2 + 4, bit + 4, 4);
+      __m512i inc = _mm512_set1_epi64(bit << 3);
+
+      for (int32_t i = 0; i < batch; ++i) {
+        __m512i after = _mm512_srlv_epi64(base, shiftBits);
+        __m512i zigzagVal = _mm512_and_si512(after, maskVal);
+
+        // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
+        __m512i signmask = _mm512_and_si512(_mm512_set1_epi64(1), zigzagVal);
+        signmask = _mm512_sub_epi64(_mm512_setzero_si512(), signmask);
+        __m512i delta = _mm512_xor_si512(_mm512_srli_epi64(zigzagVal, 1), signmask);
+
+        // calculate the cumulative sum (prefix sum) for each number
+        // decode[0] =  prevValue + final[0]
+        // decode[1] = decode[0] + final[1]   -----> prevValue + final[0] + final[1]
+        // decode[2] = decode[1] + final[2]   -----> prevValue + final[0] + final[1] + final[2]
+        // decode[3] = decode[2] + final[3]   -----> prevValue + final[0] + final[1] + final[2] + final[3]
+
+        // 7       6       5       4       3       2       1       0
+        // D7      D6      D5      D4      D3      D2      D1      D0
+        // D6      0       D4      0       D2      0       D0      0
+        // D7+D6   D6      D5+D4   D4      D3+D2   D2      D1+D0   D0
+        // 13      6       9       4       5       2       1       0
+        __m512i prev = _mm512_set1_epi64(prevValue);
+        __m512i cum_sum = _mm512_add_epi64(delta, _mm512_maskz_permutexvar_epi64(0xaa, sum_mask1, delta));
+        cum_sum = _mm512_add_epi64(cum_sum, _mm512_maskz_permutexvar_epi64(0xcc, sum_mask2, cum_sum));
+        cum_sum = _mm512_add_epi64(cum_sum, _mm512_maskz_permutexvar_epi64(0xf0, sum_mask3, cum_sum));
+
+        // 13      6       9       4       5       2       1       0
+        // D7,D6   D6      D5,D4   D4      D3,D2   D2      D1,D0   D0
+        // +D5,D4  D5,D4,  0       0       D1,D0   D1,D0   0       0
+        // D7~D4   D6~D4   D5~D4   D4      D3~D0   D2~D0   D1~D0   D0
+        // 22      15      9       4       6       3       1       0
+        //
+        // D3~D0   D3~D0   D3~D0   D3~D0   0       0       0       0
+        // 28      21      15      10      6       3       1       0
+        cum_sum = _mm512_add_epi64(cum_sum, prev);
+        _mm512_storeu_si512((__m512i *)&p[_pos], cum_sum);
+
+        shiftBits = _mm512_add_epi64(shiftBits, inc);
+        prevValue = p[_pos + 7];
+        _pos += 8;
+      }
+
+      // handle the remain value
+      for (int32_t i = 0; i < remain; i++) {
+        zigzag_value = ((w >> (v + (batch * bit * 8))) & mask);
+        prevValue += ZIGZAG_DECODE(int64_t, zigzag_value);
+
+        p[_pos++] = prevValue;
+        v += bit;
+      }
     }
 
-    __m128i data2;
-    if (nbytes2 == 0) {
-      data2 = _mm_setzero_si128();
-    } else {
-      memcpy(&data2, (const void*) (input + ipos + nbytes1), nbytes2);
-    }
+    ip += LONG_BYTES;
+  }
 
-    data2 = _mm_broadcastq_epi64(data2);
-    __m128i zzVal = _mm_blend_epi32(data2, data1, 0x03);
+  return nelements * LONG_BYTES;
+#else
+  return tsDecompressIntImpl_Scalar(input, nelements, output, type);
+#endif
+}
 
-    // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
-    __m128i signmask = _mm_and_si128(_mm_set1_epi64x(1), zzVal);
-    signmask = _mm_sub_epi64(_mm_setzero_si128(), signmask);
+#ifdef DECOMPRESS_MULTIVERSION
+// Decode two delta-of-delta values of the timestamp stream at a time.
+//   delta[k] = delta[k-1] + dod[k]
+//   val[k]   = val[k-1] + delta[k]
+// The first value in the stream is the raw timestamp, and the delta before it is regarded as 0.
+DECOMPRESS_TARGET("sse4.2")
+static FORCE_INLINE void decompressTimestampPair(__m128i zzVal, bool first, __m128i *prevVal, __m128i *prevDelta,
+                                                 int64_t *ostream) {
+  // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
+  __m128i signmask = _mm_and_si128(_mm_set1_epi64x(1), zzVal);
+  signmask = _mm_sub_epi64(_mm_setzero_si128(), signmask);
+
+  // get two delta of delta values here
+  __m128i deltaOfDelta = _mm_xor_si128(_mm_srli_epi64(zzVal, 1), signmask);
+
+  __m128i val;
+  __m128i delta;
+  if (first) {
+    val = _mm_add_epi64(_mm_slli_si128(deltaOfDelta, 8), deltaOfDelta);
+    delta = deltaOfDelta;
+  } else {
+    delta = _mm_add_epi64(_mm_add_epi64(_mm_slli_si128(deltaOfDelta, 8), deltaOfDelta), *prevDelta);
+    val = _mm_add_epi64(_mm_add_epi64(_mm_slli_si128(delta, 8), delta), *prevVal);
+  }
 
-    // get two zigzag values here
-    __m128i deltaOfDelta = _mm_xor_si128(_mm_srli_epi64(zzVal, 1), signmask);
+  _mm_storeu_si128((__m128i *)ostream, val);
 
-    __m128i deltaCurrent = _mm_add_epi64(deltaOfDelta, prevDelta);
-    deltaCurrent = _mm_add_epi64(_mm_slli_si128(deltaCurrent, 8), deltaCurrent);
+  // keep the previous value and delta in both lanes
+  *prevVal = _mm_unpackhi_epi64(val, val);
+  *prevDelta = _mm_unpackhi_epi64(delta, delta);
+}
 
-    __m128i val = _mm_add_epi64(deltaCurrent, prevVal);
-    _mm_storeu_si128((__m128i *)&ostream[opos], val);
+DECOMPRESS_TARGET("sse4.2")
+static void decompressTimestampRemain(const char *const input, int32_t ipos, int32_t opos, __m128i prevVal,
+                                      __m128i prevDelta, int64_t *ostream) {
+  uint64_t dd = 0;
+  uint8_t  flags = input[ipos++];
+
+  int32_t nbytes = flags & INT8MASK(4);
+  int64_t deltaOfDelta = 0;
+  if (nbytes != 0) {
+    memcpy(&dd, input + ipos, nbytes);
+    deltaOfDelta = ZIGZAG_DECODE(int64_t, dd);
+  }
 
-    // keep the previous value
-    prevVal = _mm_shuffle_epi32 (val, 0xEE);
+  if (opos == 0) {
+    ostream[opos] = deltaOfDelta;
+  } else {
+    int64_t val[2], delta[2];
+    _mm_storeu_si128((__m128i *)val, prevVal);
+    _mm_storeu_si128((__m128i *)delta, prevDelta);
+    ostream[opos] = val[0] + delta[0] + deltaOfDelta;
+  }
+}
+#endif
 
-    // keep the previous delta of delta, for the first item
-    prevDelta = _mm_shuffle_epi32(deltaOfDelta, 0xEE);
+DECOMPRESS_TARGET("sse4.2")
+int32_t tsDecompressTimestampSse42(const char *const input, const int32_t nelements, char *const output,
+                                   bool bigEndian) {
+#ifdef DECOMPRESS_MULTIVERSION
+  int64_t *ostream = (int64_t *)output;
+  int32_t  ipos = 1, opos = 0;
+  __m128i  prevVal = _mm_setzero_si128();
+  __m128i  prevDelta = _mm_setzero_si128();
 
-    opos += 2;
-    ipos += nbytes1 + nbytes2;
-    i += 1;
-  }
+  int32_t numOfBatch = nelements >> 1;
+  int32_t remainder = nelements & 0x01;
 
-  // the remain
-  for(; i < batch; ++i) {
+  for (int32_t i = 0; i < numOfBatch; ++i) {
     uint8_t flags = input[ipos++];
 
     int8_t nbytes1 = flags & INT8MASK(4);  // range of nbytes starts from 0 to 7
     int8_t nbytes2 = (flags >> 4) & INT8MASK(4);
 
-//    __m128i data1 = _mm_maskz_loadu_epi8(mask2[nbytes1], (const void*)(input + ipos));
-//    __m128i data2 = _mm_maskz_loadu_epi8(mask2[nbytes2], (const void*)(input + ipos + nbytes1));
-    __m128i data1;
-    if (nbytes1 == 0) {
-      data1 = _mm_setzero_si128();
-    } else {
-      int64_t dd = 0;
-      memcpy(&dd, (const void*) (input + ipos), nbytes1);
-      data1 = _mm_loadu_si64(&dd);
-    }
+    int64_t dd1 = 0, dd2 = 0;
+    memcpy(&dd1, input + ipos, nbytes1);
+    memcpy(&dd2, input + ipos + nbytes1, nbytes2);
 
-    __m128i data2;
-    if (nbytes2 == 0) {
-      data2 = _mm_setzero_si128();
-    } else {
-      int64_t dd = 0;
-      memcpy(&dd, (const void*) (input + ipos + nbytes1), nbytes2);
-      data2 = _mm_loadu_si64(&dd);
-    }
-
-    data2 = _mm_broadcastq_epi64(data2);
-
-    __m128i zzVal = _mm_blend_epi32(data2, data1, 0x03);
-
-    // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
-    __m128i signmask = _mm_and_si128(_mm_set1_epi64x(1), zzVal);
-    signmask = _mm_sub_epi64(_mm_setzero_si128(), signmask);
-
-    // get two zigzag values here
-    __m128i deltaOfDelta = _mm_xor_si128(_mm_srli_epi64(zzVal, 1), signmask);
-
-    __m128i deltaCurrent = _mm_add_epi64(deltaOfDelta, prevDelta);
-    deltaCurrent = _mm_add_epi64(_mm_slli_si128(deltaCurrent, 8), deltaCurrent);
-
-    __m128i val = _mm_add_epi64(deltaCurrent, prevVal);
-    _mm_storeu_si128((__m128i *)&ostream[opos], val);
-
-    // keep the previous value
-    prevVal = _mm_shuffle_epi32 (val, 0xEE);
-
-    // keep the previous delta of delta
-    __m128i delta = _mm_add_epi64(_mm_slli_si128(deltaOfDelta, 8), deltaOfDelta);
-    prevDelta = _mm_shuffle_epi32(_mm_add_epi64(delta, prevDelta), 0xEE);
+    decompressTimestampPair(_mm_set_epi64x(dd2, dd1), i == 0, &prevVal, &prevDelta, &ostream[opos]);
 
     opos += 2;
     ipos += nbytes1 + nbytes2;
   }
 
   if (remainder > 0) {
-    uint64_t dd = 0;
-    uint8_t  flags = input[ipos++];
-
-    int32_t nbytes = flags & INT8MASK(4);
-    int64_t deltaOfDelta = 0;
-    if (nbytes == 0) {
-      deltaOfDelta = 0;
-    } else {
-      //      if (is_bigendian()) {
-      //        memcpy(((char *)(&dd1)) + longBytes - nbytes, input + ipos, nbytes);
-      //      } else {
-      memcpy(&dd, input + ipos, nbytes);
-      //      }
-      deltaOfDelta = ZIGZAG_DECODE(int64_t, dd);
-    }
-
-    ipos += nbytes;
-    if (opos == 0) {
-      ostream[opos++] = deltaOfDelta;
-    } else {
-      int64_t prevDeltaX = deltaOfDelta + prevDelta[1];
-      ostream[opos++] = prevVal[1] + prevDeltaX;
-    }
+    decompressTimestampRemain(input, ipos, opos, prevVal, prevDelta, ostream);
   }
+
+  return nelements * LONG_BYTES;
+#else
+  return tsDecompressTimestampImpl_Scalar(input, nelements, output, bigEndian);
 #endif
-#endif
-  return 0;
 }
 
+DECOMPRESS_TARGET("avx512f,avx512bw,avx512vl")
 int32_t tsDecompressTimestampAvx512(const char *const input, const int32_t nelements, char *const output,
-                                    bool UNUSED_PARAM(bigEndian)) {
+                                    bool bigEndian) {
+#ifdef DECOMPRESS_MULTIVERSION
   int64_t *ostream = (int64_t *)output;
   int32_t  ipos = 1, opos = 0;
-
-#if __AVX512VL__
-
   __m128i  prevVal = _mm_setzero_si128();
   __m128i  prevDelta = _mm_setzero_si128();
 
@@ -490,103 +382,90 @@ int32_t tsDecompressTimestampAvx512(const char *const input, const int32_t nelem
   int32_t   remainder = nelements & 0x01;
   __mmask16 mask2[16] = {0, 0x0001, 0x0003, 0x0007, 0x000f, 0x001f, 0x003f, 0x007f, 0x00ff};
 
-  int32_t i = 0;
-  if (numOfBatch > 1) {
-    // first loop
+  for (int32_t i = 0; i < numOfBatch; ++i) {
     uint8_t flags = input[ipos++];
 
     int8_t nbytes1 = flags & INT8MASK(4);  // range of nbytes starts from 0 to 7
     int8_t nbytes2 = (flags >> 4) & INT8MASK(4);
 
-    __m128i data1 = _mm_maskz_loadu_epi8(mask2[nbytes1], (const void*)(input + ipos));
-    __m128i data2 = _mm_maskz_loadu_epi8(mask2[nbytes2], (const void*)(input + ipos + nbytes1));
-    data2 = _mm_broadcastq_epi64(data2);
-
-    __m128i zzVal = _mm_blend_epi32(data2, data1, 0x03);
+    __m128i data1 = _mm_maskz_loadu_epi8(mask2[nbytes1], (const void *)(input + ipos));
+    __m128i data2 = _mm_maskz_loadu_epi8(mask2[nbytes2], (const void *)(input + ipos + nbytes1));
 
-    // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
-    __m128i signmask = _mm_and_si128(_mm_set1_epi64x(1), zzVal);
-    signmask = _mm_sub_epi64(_mm_setzero_si128(), signmask);
-
-    // get two zigzag values here
-    __m128i deltaOfDelta = _mm_xor_si128(_mm_srli_epi64(zzVal, 1), signmask);
-
-    __m128i deltaCurrent = _mm_add_epi64(deltaOfDelta, prevDelta);
-    deltaCurrent = _mm_add_epi64(_mm_slli_si128(deltaCurrent, 8), deltaCurrent);
-
-    __m128i val = _mm_add_epi64(deltaCurrent, prevVal);
-    _mm_storeu_si128((__m128i *)&ostream[opos], val);
-
-    // keep the previous value
-    prevVal = _mm_shuffle_epi32 (val, 0xEE);
-
-    // keep the previous delta of delta, for the first item
-    prevDelta = _mm_shuffle_epi32(deltaOfDelta, 0xEE);
+    decompressTimestampPair(_mm_unpacklo_epi64(data1, data2), i == 0, &prevVal, &prevDelta, &ostream[opos]);
 
     opos += 2;
     ipos += nbytes1 + nbytes2;
-    i += 1;
   }
 
-  // the remain
-  for(; i < numOfBatch; ++i) {
-    uint8_t flags = input[ipos++];
-
-    int8_t nbytes1 = flags & INT8MASK(4);  // range of nbytes starts from 0 to 7
-    int8_t nbytes2 = (flags >> 4) & INT8MASK(4);
-
-    __m128i data1 = _mm_maskz_loadu_epi8(mask2[nbytes1], (const void*)(input + ipos));
-    __m128i data2 = _mm_maskz_loadu_epi8(mask2[nbytes2], (const void*)(input + ipos + nbytes1));
-    data2 = _mm_broadcastq_epi64(data2);
-
-    __m128i zzVal = _mm_blend_epi32(data2, data1, 0x03);
-
-    // ZIGZAG_DECODE(T, v) (((v) >> 1) ^ -((T)((v)&1)))
-    __m128i signmask = _mm_and_si128(_mm_set1_epi64x(1), zzVal);
-    signmask = _mm_sub_epi64(_mm_setzero_si128(), signmask);
-
-    // get two zigzag values here
-    __m128i deltaOfDelta = _mm_xor_si128(_mm_srli_epi64(zzVal, 1), signmask);
-
-    __m128i deltaCurrent = _mm_add_epi64(deltaOfDelta, prevDelta);
-    deltaCurrent = _mm_add_epi64(_mm_slli_si128(deltaCurrent, 8), deltaCurrent);
-
-    __m128i val = _mm_add_epi64(deltaCurrent, prevVal);
-    _mm_storeu_si128((__m128i *)&ostream[opos], val);
+  if (remainder > 0) {
+    decompressTimestampRemain(input, ipos, opos, prevVal, prevDelta, ostream);
+  }
 
-    // keep the previous value
-    prevVal = _mm_shuffle_epi32 (val, 0xEE);
+  return nelements * LONG_BYTES;
+#else
+  return tsDecompressTimestampImpl_Scalar(input, nelements, output, bigEndian);
+#endif
+}
 
-    // keep the previous delta of delta
-    __m128i delta = _mm_add_epi64(_mm_slli_si128(deltaOfDelta, 8), deltaOfDelta);
-    prevDelta = _mm_shuffle_epi32(_mm_add_epi64(delta, prevDelta), 0xEE);
+static const SDecompressKernel decompressKernels[COMPRESS_KERNEL_MAX] = {
+    [COMPRESS_KERNEL_SCALAR] = {"scalar", tsDecompressIntImpl_Scalar, tsDecompressTimestampImpl_Scalar,
+                                tsDecompressFloatImpl_Scalar},
+    [COMPRESS_KERNEL_SSE42] = {"sse4.2", tsDecompressIntImpl_Scalar, tsDecompressTimestampSse42,
+                               tsDecompressFloatImpl_Scalar},
+    [COMPRESS_KERNEL_AVX2] = {"avx2", tsDecompressIntImplAvx2, tsDecompressTimestampSse42,
+                              tsDecompressFloatImpl_Scalar},
+    [COMPRESS_KERNEL_AVX512] = {"avx512", tsDecompressIntImplAvx512, tsDecompressTimestampAvx512,
+                                tsDecompressFloatImpl_Scalar},
+};
+
+const SDecompressKernel *tsDecompressKernel = &decompressKernels[COMPRESS_KERNEL_SCALAR];
+
+bool tsCompressKernelSupported(ECompressKernel kernel) {
+  switch (kernel) {
+    case COMPRESS_KERNEL_SCALAR:
+      return true;
+#ifdef DECOMPRESS_MULTIVERSION
+    case COMPRESS_KERNEL_SSE42:
+      return tsSSE42Enable;
+    case COMPRESS_KERNEL_AVX2:
+      return tsAVX2Enable;
+    case COMPRESS_KERNEL_AVX512:
+      // the timestamp kernel relies on the byte masked load of avx512bw/avx512vl.
+      return tsAVX512Enable && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl");
+#endif
+    default:
+      return false;
+  }
+}
 
-    opos += 2;
-    ipos += nbytes1 + nbytes2;
+const SDecompressKernel *tsGetDecompressKernel(ECompressKernel kernel) {
+  if (kernel < COMPRESS_KERNEL_SCALAR || kernel >= COMPRESS_KERNEL_MAX) {
+    return NULL;
   }
+  return &decompressKernels[kernel];
+}
 
-  if (remainder > 0) {
-    uint64_t dd = 0;
-    uint8_t  flags = input[ipos++];
+int32_t tsSetDecompressKernel(ECompressKernel kernel) {
+  tsInitCompressKernels();  // so that the kernel set here is not replaced on the first use
+  if (!tsCompressKernelSupported(kernel)) {
+    return TSDB_CODE_INVALID_PARA;
+  }
 
-    int32_t nbytes = flags & INT8MASK(4);
-    int64_t deltaOfDelta = 0;
-    if (nbytes == 0) {
-      deltaOfDelta = 0;
-    } else {
-      memcpy(&dd, input + ipos, nbytes);
-      deltaOfDelta = ZIGZAG_DECODE(int64_t, dd);
-    }
+  tsDecompressKernel = &decompressKernels[kernel];
+  return TSDB_CODE_SUCCESS;
+}
 
-    ipos += nbytes;
-    if (opos == 0) {
-      ostream[opos++] = deltaOfDelta;
-    } else {
-      int64_t prevDeltaX = deltaOfDelta + prevDelta[1];
-      ostream[opos++] = prevVal[1] + prevDeltaX;
+ECompressKernel tsSelectDecompressKernel() {
+  ECompressKernel kernel = COMPRESS_KERNEL_SCALAR;
+  if (tsSIMDEnable) {
+    for (int32_t i = COMPRESS_KERNEL_MAX - 1; i > COMPRESS_KERNEL_SCALAR; --i) {
+      if (tsCompressKernelSupported(i)) {
+        kernel = i;
+        break;
+      }
     }
   }
 
-#endif
-  return 0;
+  tsDecompressKernel = &decompressKernels[kernel];
+  return kernel;
 }
@@ -47,7 +47,9 @@ struct SLRUEntry {
   size_t              keyLength;
   uint32_t            hash;
   uint32_t            refs;
+  volatile int32_t    state;  // refs and in-cache bit of clock entries, see TAOS_CLOCK_IN_CACHE
   uint8_t             flags;
+  volatile int8_t     visited;  // clock bit, set by lookups and cleared by the eviction sweep
   char                keyData[1];
 };
 
@@ -241,18 +243,28 @@ static SLRUEntry *taosLRUEntryTableRemove(SLRUEntryTable *table, const void *key
   return result;
 }
 
+typedef struct {
+  int8_t *table;  // (TAOS_LRU_SKETCH_DEPTH << bits) saturating counters, in blocks of 64
+  int32_t bits;
+  int32_t samples;
+} SLRUFreqSketch;
+
 struct SLRUCacheShard {
   size_t         capacity;
   size_t         highPriPoolUsage;
   bool           strictCapacity;
   double         highPriPoolRatio;
   double         highPriPoolCapacity;
-  SLRUEntry      lru;
+  SLRUEntry      lru;  // LRU list, or the clock ring of TAOS_LRU_POLICY_CLOCK
   SLRUEntry     *lruLowPri;
   SLRUEntryTable table;
   size_t         usage;     // Memory size for entries residing in the cache.
   size_t         lruUsage;  // Memory size for entries residing only in the LRU list.
   TdThreadMutex  mutex;
+  // TAOS_LRU_POLICY_CLOCK only
+  TdThreadRwlock rwlock;
+  SLRUEntry     *clockHand;
+  SLRUFreqSketch sketch;
 };
 
 #define TAOS_LRU_CACHE_SHARD_HASH32(key, len) (MurmurHash3_32((key), (len)))
@@ -642,6 +654,473 @@ static void taosLRUCacheShardSetStrictCapacity(SLRUCacheShard *shard, bool stric
   taosThreadMutexUnlock(&shard->mutex);
 }
 
+/*
+ * CLOCK shard of TAOS_LRU_POLICY_CLOCK.
+ *
+ * All entries stay in the clock ring as long as they are in the hash table, no matter referenced or not, so a hit
+ * only needs the read lock of the shard: it adds a reference and sets the clock bit of the entry with atomics, and
+ * bumps the frequency sketch. Inserting, erasing and evicting take the write lock.
+ *
+ * The refs and the in-cache bit of an entry are packed into SLRUEntry.state, so that exactly one of the evictor (or
+ * the eraser) and the last releaser sees the entry unreferenced and out of cache, and frees it.
+ *
+ * A new entry is admitted only if its frequency estimated by the TinyLFU sketch is higher than the one of the entry
+ * chosen by the clock hand to be evicted, which keeps one-off scans from flushing the hot entries. The rejected entry
+ * is returned as a detached handle if a handle is required, and freed on its last release.
+ */
+#define TAOS_CLOCK_IN_CACHE ((int32_t)0x40000000)
+
+#define TAOS_LRU_SKETCH_DEPTH     4
+#define TAOS_LRU_SKETCH_MIN_BITS  8
+#define TAOS_LRU_SKETCH_MAX_BITS  22
+#define TAOS_LRU_SKETCH_MAX_FREQ  15
+#define TAOS_LRU_SKETCH_SLOT_BITS 2   // (DEPTH << 2) counters per entry, to keep the collisions rare
+#define TAOS_LRU_SKETCH_SAMPLES   10  // halve all counters every 10 inserts per entry
+
+#define TAOS_LRU_SKETCH_BLOCK_SEED 0x97cb3127
+#define TAOS_LRU_SKETCH_SLOT_SEED  0xb492b66f
+
+static int taosLRUFreqSketchInit(SLRUFreqSketch *sketch, int32_t bits) {
+  int8_t *table = taosMemoryCalloc(TAOS_LRU_SKETCH_DEPTH, (size_t)1 << bits);
+  if (!table) {
+    return -1;
+  }
+
+  taosMemoryFree(sketch->table);
+  sketch->table = table;
+  sketch->bits = bits;
+  sketch->samples = 0;
+
+  return 0;
+}
+
+static void taosLRUFreqSketchCleanup(SLRUFreqSketch *sketch) {
+  taosMemoryFree(sketch->table);
+  sketch->table = NULL;
+}
+
+// the counters of a key are in the same cache line, one in each quarter of it
+static FORCE_INLINE uint32_t taosLRUFreqSketchIndex(SLRUFreqSketch *sketch, uint32_t hash, int i) {
+  uint32_t block = (hash * TAOS_LRU_SKETCH_BLOCK_SEED) >> (32 - sketch->bits + 4);
+  uint32_t slot = ((hash * TAOS_LRU_SKETCH_SLOT_SEED) >> (i * 4)) & 15;
+  return (block << 6) + (i << 4) + slot;
+}
+
+static int8_t taosLRUFreqSketchEstimate(SLRUFreqSketch *sketch, uint32_t hash) {
+  int8_t freq = INT8_MAX;
+  for (int i = 0; i < TAOS_LRU_SKETCH_DEPTH; ++i) {
+    int8_t counter = atomic_load_8(&sketch->table[taosLRUFreqSketchIndex(sketch, hash, i)]);
+    if (counter < freq) {
+      freq = counter;
+    }
+  }
+
+  return freq;
+}
+
+// may be called concurrently with the read lock of the shard, an increment lost in the race does no harm
+static void taosLRUFreqSketchIncrease(SLRUFreqSketch *sketch, uint32_t hash) {
+  // conservative update, only the smallest counters are increased
+  int8_t freq = taosLRUFreqSketchEstimate(sketch, hash);
+  if (freq >= TAOS_LRU_SKETCH_MAX_FREQ) {
+    return;
+  }
+  for (int i = 0; i < TAOS_LRU_SKETCH_DEPTH; ++i) {
+    int8_t volatile *counter = &sketch->table[taosLRUFreqSketchIndex(sketch, hash, i)];
+    if (atomic_load_8(counter) == freq) {
+      atomic_store_8(counter, freq + 1);
+    }
+  }
+}
+
+// called with the write lock of the shard on each insert, so the sketch is aged by the number of misses
+static void taosLRUFreqSketchMaintain(SLRUFreqSketch *sketch, uint32_t elems) {
+  sketch->samples++;
+
+  int32_t entryBits = sketch->bits - TAOS_LRU_SKETCH_SLOT_BITS;
+  if (elems > ((uint32_t)1 << entryBits) && sketch->bits < TAOS_LRU_SKETCH_MAX_BITS) {
+    (void)taosLRUFreqSketchInit(sketch, sketch->bits + 1);
+    return;
+  }
+
+  if (sketch->samples >= (TAOS_LRU_SKETCH_SAMPLES << entryBits)) {
+    size_t size = (size_t)TAOS_LRU_SKETCH_DEPTH << sketch->bits;
+    for (size_t i = 0; i < size; ++i) {
+      sketch->table[i] >>= 1;
+    }
+    sketch->samples /= 2;
+  }
+}
+
+static void taosClockCacheShardRingInsert(SLRUCacheShard *shard, SLRUEntry *e) {
+  // insert behind the hand, so that the new entry is the last to be swept
+  e->next = shard->clockHand;
+  e->prev = shard->clockHand->prev;
+
+  e->prev->next = e;
+  e->next->prev = e;
+}
+
+static void taosClockCacheShardRingRemove(SLRUCacheShard *shard, SLRUEntry *e) {
+  if (shard->clockHand == e) {
+    shard->clockHand = e->next;
+  }
+
+  e->next->prev = e->prev;
+  e->prev->next = e->next;
+  e->prev = e->next = NULL;
+}
+
+static SLRUEntry *taosClockCacheShardNextVictim(SLRUCacheShard *shard) {
+  // every entry is visited at most twice: once to clear the clock bit, then to be chosen
+  uint32_t steps = 2 * (shard->table.elems + 1);
+  while (steps-- > 0) {
+    SLRUEntry *e = shard->clockHand;
+    shard->clockHand = e->next;
+
+    if (e == &shard->lru || atomic_load_32(&e->state) != TAOS_CLOCK_IN_CACHE) {
+      continue;
+    }
+
+    if (atomic_load_8(&e->visited)) {
+      atomic_store_8(&e->visited, 0);
+      continue;
+    }
+
+    return e;
+  }
+
+  return NULL;
+}
+
+static void taosClockCacheShardEvictEntry(SLRUCacheShard *shard, SLRUEntry *e, SArray *deleted) {
+  // no lookup can race with the write lock, and nobody else holds a reference of the entry
+  atomic_store_32(&e->state, 0);
+
+  taosClockCacheShardRingRemove(shard, e);
+  taosLRUEntryTableRemove(&shard->table, e->keyData, e->keyLength, e->hash);
+
+  ASSERT(shard->usage >= e->totalCharge);
+  shard->usage -= e->totalCharge;
+
+  taosArrayPush(deleted, &e);
+}
+
+static void taosClockCacheShardEvict(SLRUCacheShard *shard, size_t charge, SArray *deleted) {
+  while (shard->usage + charge > shard->capacity) {
+    SLRUEntry *victim = taosClockCacheShardNextVictim(shard);
+    if (victim == NULL) {
+      break;
+    }
+
+    taosClockCacheShardEvictEntry(shard, victim, deleted);
+  }
+}
+
+static void taosClockCacheShardFreeList(SArray *deleted) {
+  for (int i = 0; i < taosArrayGetSize(deleted); ++i) {
+    SLRUEntry *entry = taosArrayGetP(deleted, i);
+
+    taosLRUEntryFree(entry);
+  }
+  taosArrayDestroy(deleted);
+}
+
+static int taosClockCacheShardInit(SLRUCacheShard *shard, size_t capacity, bool strict, int maxUpperHashBits) {
+  if (taosLRUEntryTableInit(&shard->table, maxUpperHashBits) < 0) {
+    return -1;
+  }
+
+  if (taosLRUFreqSketchInit(&shard->sketch, TAOS_LRU_SKETCH_MIN_BITS) < 0) {
+    taosMemoryFree(shard->table.list);
+    return -1;
+  }
+
+  taosThreadRwlockInit(&shard->rwlock, NULL);
+
+  shard->capacity = capacity;
+  shard->strictCapacity = strict;
+  shard->usage = 0;
+  shard->lru.next = &shard->lru;
+  shard->lru.prev = &shard->lru;
+  shard->clockHand = &shard->lru;
+
+  return 0;
+}
+
+static void taosClockCacheShardCleanup(SLRUCacheShard *shard) {
+  taosThreadRwlockDestroy(&shard->rwlock);
+
+  // entries still referenced are left to their holders, as the LRU shard does
+  SLRUEntry *e = shard->lru.next;
+  while (e != &shard->lru) {
+    SLRUEntry *next = e->next;
+    if (atomic_load_32(&e->state) == TAOS_CLOCK_IN_CACHE) {
+      e->state = 0;
+      taosLRUEntryFree(e);
+    }
+    e = next;
+  }
+
+  taosMemoryFree(shard->table.list);
+  taosLRUFreqSketchCleanup(&shard->sketch);
+}
+
+static void taosClockCacheShardSetCapacity(SLRUCacheShard *shard, size_t capacity) {
+  SArray *lastReferenceList = taosArrayInit(16, POINTER_BYTES);
+
+  taosThreadRwlockWrlock(&shard->rwlock);
+
+  shard->capacity = capacity;
+  taosClockCacheShardEvict(shard, 0, lastReferenceList);
+
+  taosThreadRwlockUnlock(&shard->rwlock);
+
+  taosClockCacheShardFreeList(lastReferenceList);
+}
+
+static LRUStatus taosClockCacheShardInsert(SLRUCacheShard *shard, const void *key, size_t keyLen, uint32_t hash,
+                                           void *value, size_t charge, _taos_lru_deleter_t deleter,
+                                           LRUHandle **handle, LRUPriority priority, void *ud) {
+  SLRUEntry *e = taosMemoryCalloc(1, sizeof(SLRUEntry) - 1 + keyLen);
+  if (!e) {
+    return TAOS_LRU_STATUS_FAIL;
+  }
+
+  e->value = value;
+  e->deleter = deleter;
+  e->ud = ud;
+  e->keyLength = keyLen;
+  e->hash = hash;
+  e->totalCharge = charge;
+  e->visited = (priority == TAOS_LRU_PRIORITY_HIGH) ? 1 : 0;
+  TAOS_LRU_ENTRY_SET_PRIORITY(e, priority);
+  memcpy(e->keyData, key, keyLen);
+
+  LRUStatus status = TAOS_LRU_STATUS_OK;
+  bool      admit = true;
+  SArray   *lastReferenceList = taosArrayInit(16, POINTER_BYTES);
+
+  taosThreadRwlockWrlock(&shard->rwlock);
+
+  taosLRUFreqSketchMaintain(&shard->sketch, shard->table.elems);
+
+  if (shard->usage + charge > shard->capacity) {
+    SLRUEntry *victim = taosClockCacheShardNextVictim(shard);
+    if (victim != NULL) {
+      if (!TAOS_LRU_ENTRY_IS_HIGH_PRI(e) && 
+          taosLRUFreqSketchEstimate(&shard->sketch, hash) <= taosLRUFreqSketchEstimate(&shard->sketch, victim->hash)) {
+        admit = false;
+      } else {
+        taosClockCacheShardEvictEntry(shard, victim, lastReferenceList);
+        taosClockCacheShardEvict(shard, charge, lastReferenceList);
+      }
+    }
+  }
+
+  if (!admit || (shard->usage + charge > shard->capacity && (shard->strictCapacity || handle == NULL))) {
+    if (handle == NULL) {
+      taosArrayPush(lastReferenceList, &e);
+    } else if (!admit) {
+      e->state = 1;
+      *handle = (LRUHandle *)e;
+    } else {
+      taosMemoryFree(e);
+
+      *handle = NULL;
+      status = TAOS_LRU_STATUS_INCOMPLETE;
+    }
+  } else {
+    e->state = TAOS_CLOCK_IN_CACHE | (handle ? 1 : 0);
+
+    SLRUEntry *old = taosLRUEntryTableInsert(&shard->table, e);
+    shard->usage += charge;
+    if (old != NULL) {
+      status = TAOS_LRU_STATUS_OK_OVERWRITTEN;
+
+      taosClockCacheShardRingRemove(shard, old);
+      ASSERT(shard->usage >= old->totalCharge);
+      shard->usage -= old->totalCharge;
+
+      if (atomic_and_fetch_32(&old->state, ~TAOS_CLOCK_IN_CACHE) == 0) {
+        taosArrayPush(lastReferenceList, &old);
+      }
+    }
+    taosClockCacheShardRingInsert(shard, e);
+
+    if (handle != NULL) {
+      *handle = (LRUHandle *)e;
+    }
+  }
+
+  taosThreadRwlockUnlock(&shard->rwlock);
+
+  taosClockCacheShardFreeList(lastReferenceList);
+
+  return status;
+}
+
+static LRUHandle *taosClockCacheShardLookup(SLRUCacheShard *shard, const void *key, size_t keyLen, uint32_t hash) {
+  taosThreadRwlockRdlock(&shard->rwlock);
+
+  SLRUEntry *e = taosLRUEntryTableLookup(&shard->table, key, keyLen, hash);
+  if (e != NULL) {
+    atomic_add_fetch_32(&e->state, 1);
+    if (!atomic_load_8(&e->visited)) {
+      atomic_store_8(&e->visited, 1);
+    }
+  }
+  taosLRUFreqSketchIncrease(&shard->sketch, hash);
+
+  taosThreadRwlockUnlock(&shard->rwlock);
+
+  return (LRUHandle *)e;
+}
+
+static void taosClockCacheShardErase(SLRUCacheShard *shard, const void *key, size_t keyLen, uint32_t hash) {
+  bool lastReference = false;
+
+  taosThreadRwlockWrlock(&shard->rwlock);
+
+  SLRUEntry *e = taosLRUEntryTableRemove(&shard->table, key, keyLen, hash);
+  if (e != NULL) {
+    taosClockCacheShardRingRemove(shard, e);
+    ASSERT(shard->usage >= e->totalCharge);
+    shard->usage -= e->totalCharge;
+
+    lastReference = (atomic_and_fetch_32(&e->state, ~TAOS_CLOCK_IN_CACHE) == 0);
+  }
+
+  taosThreadRwlockUnlock(&shard->rwlock);
+
+  if (lastReference) {
+    taosLRUEntryFree(e);
+  }
+}
+
+static int taosClockCacheShardApply(SLRUCacheShard *shard, _taos_lru_functor_t functor, void *ud) {
+  int ret;
+
+  taosThreadRwlockWrlock(&shard->rwlock);
+
+  ret = taosLRUEntryTableApplyF(&shard->table, functor, ud);
+
+  taosThreadRwlockUnlock(&shard->rwlock);
+
+  return ret;
+}
+
+static void taosClockCacheShardEraseUnrefEntries(SLRUCacheShard *shard) {
+  SArray *lastReferenceList = taosArrayInit(16, POINTER_BYTES);
+
+  taosThreadRwlockWrlock(&shard->rwlock);
+
+  SLRUEntry *e = shard->lru.next;
+  while (e != &shard->lru) {
+    SLRUEntry *next = e->next;
+    if (atomic_load_32(&e->state) == TAOS_CLOCK_IN_CACHE) {
+      taosClockCacheShardEvictEntry(shard, e, lastReferenceList);
+    }
+    e = next;
+  }
+
+  taosThreadRwlockUnlock(&shard->rwlock);
+
+  taosClockCacheShardFreeList(lastReferenceList);
+}
+
+static bool taosClockCacheShardRef(SLRUCacheShard *shard, LRUHandle *handle) {
+  SLRUEntry *e = (SLRUEntry *)handle;
+
+  ASSERT((atomic_load_32(&e->state) & ~TAOS_CLOCK_IN_CACHE) > 0);
+  atomic_add_fetch_32(&e->state, 1);
+
+  return true;
+}
+
+static bool taosClockCacheShardRelease(SLRUCacheShard *shard, LRUHandle *handle, bool eraseIfLastRef) {
+  if (handle == NULL) {
+    return false;
+  }
+
+  SLRUEntry *e = (SLRUEntry *)handle;
+  bool       lastReference = false;
+
+  if (!eraseIfLastRef) {
+    // an entry left over capacity is reclaimed by the sweep of next insert
+    lastReference = (atomic_sub_fetch_32(&e->state, 1) == 0);
+  } else {
+    // hold the reference until the write lock is got, so the entry can not be evicted under us
+    taosThreadRwlockWrlock(&shard->rwlock);
+
+    int32_t state = atomic_sub_fetch_32(&e->state, 1);
+    if (state == TAOS_CLOCK_IN_CACHE) {
+      atomic_store_32(&e->state, 0);
+
+      taosClockCacheShardRingRemove(shard, e);
+      taosLRUEntryTableRemove(&shard->table, e->keyData, e->keyLength, e->hash);
+      ASSERT(shard->usage >= e->totalCharge);
+      shard->usage -= e->totalCharge;
+
+      lastReference = true;
+    } else {
+      lastReference = (state == 0);
+    }
+
+    taosThreadRwlockUnlock(&shard->rwlock);
+  }
+
+  if (lastReference) {
+    taosLRUEntryFree(e);
+  }
+
+  return lastReference;
+}
+
+static size_t taosClockCacheShardGetUsage(SLRUCacheShard *shard) {
+  size_t usage = 0;
+
+  taosThreadRwlockRdlock(&shard->rwlock);
+  usage = shard->usage;
+  taosThreadRwlockUnlock(&shard->rwlock);
+
+  return usage;
+}
+
+static int32_t taosClockCacheShardGetElems(SLRUCacheShard *shard) {
+  int32_t elems = 0;
+
+  taosThreadRwlockRdlock(&shard->rwlock);
+  elems = shard->table.elems;
+  taosThreadRwlockUnlock(&shard->rwlock);
+
+  return elems;
+}
+
+static size_t taosClockCacheShardGetPinnedUsage(SLRUCacheShard *shard) {
+  size_t usage = 0;
+
+  taosThreadRwlockRdlock(&shard->rwlock);
+
+  for (SLRUEntry *e = shard->lru.next; e != &shard->lru; e = e->next) {
+    if (atomic_load_32(&e->state) != TAOS_CLOCK_IN_CACHE) {
+      usage += e->totalCharge;
+    }
+  }
+
+  taosThreadRwlockUnlock(&shard->rwlock);
+
+  return usage;
+}
+
+static void taosClockCacheShardSetStrictCapacity(SLRUCacheShard *shard, bool strict) {
+  taosThreadRwlockWrlock(&shard->rwlock);
+
+  shard->strictCapacity = strict;
+
+  taosThreadRwlockUnlock(&shard->rwlock);
+}
+
 struct SShardedCache {
   uint32_t      shardMask;
   TdThreadMutex capacityMutex;
@@ -654,6 +1133,7 @@ struct SLRUCache {
   SShardedCache   shardedCache;
   SLRUCacheShard *shards;
   int             numShards;
+  LRUPolicy       policy;
 };
 
 static int getDefaultCacheShardBits(size_t capacity) {
@@ -669,7 +1149,7 @@ static int getDefaultCacheShardBits(size_t capacity) {
   return numShardBits;
 }
 
-SLRUCache *taosLRUCacheInit(size_t capacity, int numShardBits, double highPriPoolRatio) {
+SLRUCache *taosLRUCacheInit(size_t capacity, int numShardBits, double highPriPoolRatio, LRUPolicy policy) {
   if (numShardBits >= 20) {
     terrno = TSDB_CODE_INVALID_PARA;
     return NULL;
@@ -678,6 +1158,10 @@ SLRUCache *taosLRUCacheInit(size_t capacity, int numShardBits, double highPriPoo
     terrno = TSDB_CODE_INVALID_PARA;
     return NULL;
   }
+  if (policy != TAOS_LRU_POLICY_LRU && policy != TAOS_LRU_POLICY_CLOCK) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return NULL;
+  }
   SLRUCache *cache = taosMemoryCalloc(1, sizeof(SLRUCache));
   if (!cache) {
     terrno = TSDB_CODE_OUT_OF_MEMORY;
@@ -699,10 +1183,24 @@ SLRUCache *taosLRUCacheInit(size_t capacity, int numShardBits, double highPriPoo
   bool   strictCapacity = 1;
   size_t perShard = (capacity + (numShards - 1)) / numShards;
   for (int i = 0; i < numShards; ++i) {
-    taosLRUCacheShardInit(&cache->shards[i], perShard, strictCapacity, highPriPoolRatio, 32 - numShardBits);
+    int ret = 0;
+    if (policy == TAOS_LRU_POLICY_CLOCK) {
+      ret = taosClockCacheShardInit(&cache->shards[i], perShard, strictCapacity, 32 - numShardBits);
+    } else {
+      ret = taosLRUCacheShardInit(&cache->shards[i], perShard, strictCapacity, highPriPoolRatio, 32 - numShardBits);
+    }
+    if (ret < 0) {
+      cache->numShards = i;
+      cache->policy = policy;
+      taosThreadMutexInit(&cache->shardedCache.capacityMutex, NULL);
+      taosLRUCacheCleanup(cache);
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return NULL;
+    }
   }
 
   cache->numShards = numShards;
+  cache->policy = policy;
 
   cache->shardedCache.shardMask = (1 << numShardBits) - 1;
   cache->shardedCache.strictCapacity = strictCapacity;
@@ -718,9 +1216,12 @@ void taosLRUCacheCleanup(SLRUCache *cache) {
   if (cache) {
     if (cache->shards) {
       int numShards = cache->numShards;
-      ASSERT(numShards > 0);
       for (int i = 0; i < numShards; ++i) {
-        taosLRUCacheShardCleanup(&cache->shards[i]);
+        if (cache->policy == TAOS_LRU_POLICY_CLOCK) {
+          taosClockCacheShardCleanup(&cache->shards[i]);
+        } else {
+          taosLRUCacheShardCleanup(&cache->shards[i]);
+        }
       }
       taosMemoryFree(cache->shards);
       cache->shards = 0;
@@ -737,6 +1238,11 @@ LRUStatus taosLRUCacheInsert(SLRUCache *cache, const void *key, size_t keyLen, v
   uint32_t hash = TAOS_LRU_CACHE_SHARD_HASH32(key, keyLen);
   uint32_t shardIndex = hash & cache->shardedCache.shardMask;
 
+  if (cache->policy == TAOS_LRU_POLICY_CLOCK) {
+    return taosClockCacheShardInsert(&cache->shards[shardIndex], key, keyLen, hash, value, charge, deleter, handle,
+                                     priority, ud);
+  }
+
   return taosLRUCacheShardInsert(&cache->shards[shardIndex], key, keyLen, hash, value, charge, deleter, handle,
                                  priority, ud);
 }
@@ -745,6 +1251,10 @@ LRUHandle *taosLRUCacheLookup(SLRUCache *cache, const void *key, size_t keyLen)
   uint32_t hash = TAOS_LRU_CACHE_SHARD_HASH32(key, keyLen);
   uint32_t shardIndex = hash & cache->shardedCache.shardMask;
 
+  if (cache->policy == TAOS_LRU_POLICY_CLOCK) {
+    return taosClockCacheShardLookup(&cache->shards[shardIndex], key, keyLen, hash);
+  }
+
   return taosLRUCacheShardLookup(&cache->shards[shardIndex], key, keyLen, hash);
 }
 
@@ -752,13 +1262,19 @@ void taosLRUCacheErase(SLRUCache *cache, const void *key, size_t keyLen) {
   uint32_t hash = TAOS_LRU_CACHE_SHARD_HASH32(key, keyLen);
   uint32_t shardIndex = hash & cache->shardedCache.shardMask;
 
+  if (cache->policy == TAOS_LRU_POLICY_CLOCK) {
+    return taosClockCacheShardErase(&cache->shards[shardIndex], key, keyLen, hash);
+  }
+
   return taosLRUCacheShardErase(&cache->shards[shardIndex], key, keyLen, hash);
 }
 
 void taosLRUCacheApply(SLRUCache *cache, _taos_lru_functor_t functor, void *ud) {
   int numShards = cache->numShards;
   for (int i = 0; i < numShards; ++i) {
-    if (taosLRUCacheShardApply(&cache->shards[i], functor, ud)) {
+    int ret = (cache->policy == TAOS_LRU_POLICY_CLOCK) ? taosClockCacheShardApply(&cache->shards[i], functor, ud)
+                                                         : taosLRUCacheShardApply(&cache->shards[i], functor, ud);
+    if (ret) {
       break;
     }
   }
@@ -767,7 +1283,11 @@ void taosLRUCacheApply(SLRUCache *cache, _taos_lru_functor_t functor, void *ud)
 void taosLRUCacheEraseUnrefEntries(SLRUCache *cache) {
   int numShards = cache->numShards;
   for (int i = 0; i < numShards; ++i) {
-    taosLRUCacheShardEraseUnrefEntries(&cache->shards[i]);
+    if (cache->policy == TAOS_LRU_POLICY_CLOCK) {
+      taosClockCacheShardEraseUnrefEntries(&cache->shards[i]);
+    } else {
+      taosLRUCacheShardEraseUnrefEntries(&cache->shards[i]);
+    }
   }
 }
 
@@ -779,6 +1299,10 @@ bool taosLRUCacheRef(SLRUCache *cache, LRUHandle *handle) {
   uint32_t hash = ((SLRUEntry *)handle)->hash;
   uint32_t shardIndex = hash & cache->shardedCache.shardMask;
 
+  if (cache->policy == TAOS_LRU_POLICY_CLOCK) {
+    return taosClockCacheShardRef(&cache->shards[shardIndex], handle);
+  }
+
   return taosLRUCacheShardRef(&cache->shards[shardIndex], handle);
 }
 
@@ -790,6 +1314,10 @@ bool taosLRUCacheRelease(SLRUCache *cache, LRUHandle *handle, bool eraseIfLastRe
   uint32_t hash = ((SLRUEntry *)handle)->hash;
   uint32_t shardIndex = hash & cache->shardedCache.shardMask;
 
+  if (cache->policy == TAOS_LRU_POLICY_CLOCK) {
+    return taosClockCacheShardRelease(&cache->shards[shardIndex], handle, eraseIfLastRef);
+  }
+
   return taosLRUCacheShardRelease(&cache->shards[shardIndex], handle, eraseIfLastRef);
 }
 
@@ -799,7 +1327,8 @@ size_t taosLRUCacheGetUsage(SLRUCache *cache) {
   size_t usage = 0;
 
   for (int i = 0; i < cache->numShards; ++i) {
-    usage += taosLRUCacheShardGetUsage(&cache->shards[i]);
+    usage += (cache->policy == TAOS_LRU_POLICY_CLOCK) ? taosClockCacheShardGetUsage(&cache->shards[i])
+                                                     : taosLRUCacheShardGetUsage(&cache->shards[i]);
   }
 
   return usage;
@@ -809,7 +1338,8 @@ int32_t taosLRUCacheGetElems(SLRUCache *cache) {
   int32_t elems = 0;
 
   for (int i = 0; i < cache->numShards; ++i) {
-    elems += taosLRUCacheShardGetElems(&cache->shards[i]);
+    elems += (cache->policy == TAOS_LRU_POLICY_CLOCK) ? taosClockCacheShardGetElems(&cache->shards[i])
+                                                     : taosLRUCacheShardGetElems(&cache->shards[i]);
   }
 
   return elems;
@@ -819,7 +1349,8 @@ size_t taosLRUCacheGetPinnedUsage(SLRUCache *cache) {
   size_t usage = 0;
 
   for (int i = 0; i < cache->numShards; ++i) {
-    usage += taosLRUCacheShardGetPinnedUsage(&cache->shards[i]);
+    usage += (cache->policy == TAOS_LRU_POLICY_CLOCK) ? taosClockCacheShardGetPinnedUsage(&cache->shards[i])
+                                                     : taosLRUCacheShardGetPinnedUsage(&cache->shards[i]);
   }
 
   return usage;
@@ -832,7 +1363,11 @@ void taosLRUCacheSetCapacity(SLRUCache *cache, size_t capacity) {
   taosThreadMutexLock(&cache->shardedCache.capacityMutex);
 
   for (int i = 0; i < numShards; ++i) {
-    taosLRUCacheShardSetCapacity(&cache->shards[i], perShard);
+    if (cache->policy == TAOS_LRU_POLICY_CLOCK) {
+      taosClockCacheShardSetCapacity(&cache->shards[i], perShard);
+    } else {
+      taosLRUCacheShardSetCapacity(&cache->shards[i], perShard);
+    }
   }
 
   cache->shardedCache.capacity = capacity;
@@ -858,7 +1393,11 @@ void taosLRUCacheSetStrictCapacity(SLRUCache *cache, bool strict) {
   taosThreadMutexLock(&cache->shardedCache.capacityMutex);
 
   for (int i = 0; i < numShards; ++i) {
-    taosLRUCacheShardSetStrictCapacity(&cache->shards[i], strict);
+    if (cache->policy == TAOS_LRU_POLICY_CLOCK) {
+      taosClockCacheShardSetStrictCapacity(&cache->shards[i], strict);
+    } else {
+      taosLRUCacheShardSetStrictCapacity(&cache->shards[i], strict);
+    }
   }
 
   cache->shardedCache.strictCapacity = strict;
@@ -4,21 +4,41 @@
 #include "tcompression.h"
 #include "tsimplehash.h"
 #include "tlog.h"
+#include "tworker.h"
+#include "lz4.h"
+#include "zstd.h"
 
 #define GET_PAYLOAD_DATA(_p)           ((char*)(_p)->pData + POINTER_BYTES)
 #define BUF_PAGE_IN_MEM(_p)            ((_p)->pData != NULL)
 #define CLEAR_BUF_PAGE_IN_MEM_FLAG(_p) ((_p)->pData = NULL)
 #define HAS_DATA_IN_DISK(_p)           ((_p)->offset >= 0)
 #define NO_IN_MEM_AVAILABLE_PAGES(_b)  (listNEles((_b)->lruList) >= (_b)->inMemPages)
+#define GET_RAW_PAGE_SIZE(_b)          ((_b)->pageSize + (int32_t)sizeof(SFilePage))
+#define PAGE_ZSTD_LEVEL                1
+#define DBUF_IO_LANES                  4  // io threads shared by all the paged buffers
 
 typedef struct SPageDiskInfo {
   int64_t offset;
   int32_t length;
 } SPageDiskInfo, SFreeListItem;
 
+// A disk io request handled by the io lane of the buffer. The io lane only touches the request itself, while the page
+// info and the request buffer are owned by the caller thread.
+typedef struct SPageIoReq {
+  SDiskbasedBuf* pBuf;
+  SPageInfo* pg;
+  char*      pData;  // page image on disk
+  int64_t    offset;
+  int32_t    size;
+  int32_t    code;
+  bool       write;  // write-behind or read-ahead
+  bool       done;   // guarded by ioMutex
+} SPageIoReq;
+
 struct SPageInfo {
-  SListNode* pn;  // point to list node struct. it is NULL when the page is evicted from the in-memory buffer
-  void*      pData;
+  SListNode*  pn;  // point to list node struct. it is NULL when the page is evicted from the in-memory buffer
+  void*       pData;
+  SPageIoReq* pIoReq;  // the pending io of the page, the page image in it is newer than the one on disk
   int64_t    offset;
   int32_t    pageId;
   int32_t    length : 29;
@@ -43,9 +63,21 @@ struct SDiskbasedBuf {
   void*     emptyDummyIdList;  // dummy id list
   void*     assistBuf;         // assistant buffer for compress/decompress data
   SArray*   pFree;             // free area in file
-  bool      comp;              // compressed before flushed to disk
+  EPageCodec codec;            // compressed before flushed to disk
+  ZSTD_CCtx* zstdCCtx;
+  ZSTD_DCtx* zstdDCtx;
   uint64_t  nextPos;           // next page flush position
 
+  // write-behind and read-ahead
+  int32_t       maxIoPages;  // max in flight write-behind or read-ahead pages, 0 means synchronous io
+  int32_t       numOfAhead;  // read-ahead pages not consumed yet
+  int32_t       ioCode;      // the first error of write-behind
+  SArray*       pWriting;    // submitted write-behind requests, in the order of submission
+  int32_t       ioLane;      // the io lane that handles all the requests of this buffer
+  int32_t       numOfIoReqs; // requests not done yet, guarded by ioMutex
+  TdThreadMutex ioMutex;
+  TdThreadCond  ioCond;
+
   char*               id;           // for debug purpose
   bool                printStatis;  // Print statistics info when closing this buffer.
   SDiskbasedBufStatis statis;
@@ -70,29 +102,186 @@ static int32_t createDiskFile(SDiskbasedBuf* pBuf) {
   return TSDB_CODE_SUCCESS;
 }
 
-static char* doCompressData(void* data, int32_t srcSize, int32_t* dst, SDiskbasedBuf* pBuf) {  // do nothing
-  if (!pBuf->comp) {
-    *dst = srcSize;
+// The page is kept as it is if it can not be compressed to a smaller size, so the page image on disk is compressed if
+// and only if its length is less than the raw page size.
+static char* doCompressData(void* data, int32_t srcSize, int32_t* dst, SDiskbasedBuf* pBuf) {
+  *dst = srcSize;
+
+  int32_t len = 0;
+  if (pBuf->codec == PAGE_CODEC_LZ4) {
+    len = LZ4_compress_default(data, pBuf->assistBuf, srcSize, srcSize - 1);
+  } else if (pBuf->codec == PAGE_CODEC_ZSTD) {
+    size_t ret = ZSTD_compressCCtx(pBuf->zstdCCtx, pBuf->assistBuf, srcSize - 1, data, srcSize, PAGE_ZSTD_LEVEL);
+    len = ZSTD_isError(ret) ? 0 : (int32_t)ret;
+  }
+
+  if (len <= 0) {
     return data;
   }
 
-  *dst = tsCompressString(data, srcSize, 1, pBuf->assistBuf, srcSize, ONE_STAGE_COMP, NULL, 0);
+  *dst = len;
+  return pBuf->assistBuf;
+}
+
+static int32_t doDecompressData(const char* data, int32_t srcSize, char* pPage, SDiskbasedBuf* pBuf) {
+  int32_t rawSize = GET_RAW_PAGE_SIZE(pBuf);
+  if (srcSize == rawSize) {
+    if (data != pPage) {
+      memcpy(pPage, data, rawSize);
+    }
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t len = -1;
+  if (pBuf->codec == PAGE_CODEC_LZ4) {
+    len = LZ4_decompress_safe(data, pPage, srcSize, rawSize);
+  } else if (pBuf->codec == PAGE_CODEC_ZSTD) {
+    size_t ret = ZSTD_decompressDCtx(pBuf->zstdDCtx, pPage, rawSize, data, srcSize);
+    len = ZSTD_isError(ret) ? -1 : (int32_t)ret;
+  }
+
+  if (len != rawSize) {
+    uError("failed to decompress buf page, length:%d, codec:%d, %s", srcSize, pBuf->codec, pBuf->id);
+    return TSDB_CODE_FILE_CORRUPTED;
+  }
 
-  memcpy(data, pBuf->assistBuf, *dst);
-  return data;
+  return TSDB_CODE_SUCCESS;
 }
 
-static char* doDecompressData(void* data, int32_t srcSize, int32_t* dst, SDiskbasedBuf* pBuf) {  // do nothing
-  if (!pBuf->comp) {
-    *dst = srcSize;
-    return data;
+// The io lanes shared by all the paged buffers. Each lane is a worker with a single thread, and a buffer is bound to one
+// lane, so the requests of a buffer are handled in the order of submission.
+static SSingleWorker dBufIoLanes[DBUF_IO_LANES];
+static int32_t       dBufNumOfIoLanes = 0;
+static int32_t       dBufNextIoLane = 0;
+
+static void dBufIoLaneFp(SQueueInfo* pInfo, void* pItem) {
+  SPageIoReq* pReq = *(SPageIoReq**)pItem;
+  taosFreeQitem(pItem);
+
+  SDiskbasedBuf* pBuf = pReq->pBuf;
+  int64_t        ret = pReq->write ? taosPWriteFile(pBuf->pFile, pReq->pData, pReq->size, pReq->offset)
+                                   : taosPReadFile(pBuf->pFile, pReq->pData, pReq->size, pReq->offset);
+  int32_t        code = (ret == pReq->size) ? TSDB_CODE_SUCCESS : TAOS_SYSTEM_ERROR(errno);
+
+  taosThreadMutexLock(&pBuf->ioMutex);
+  pReq->code = code;
+  pReq->done = true;
+  pBuf->numOfIoReqs -= 1;
+  taosThreadCondBroadcast(&pBuf->ioCond);
+  taosThreadMutexUnlock(&pBuf->ioMutex);
+}
+
+int32_t dBufIoPoolInit() {
+  for (int32_t i = 0; i < DBUF_IO_LANES; ++i) {
+    SSingleWorkerCfg cfg = {.min = 1, .max = 1, .name = "pagedbuf-io", .fp = dBufIoLaneFp};
+    if (tSingleWorkerInit(&dBufIoLanes[i], &cfg) != 0) {
+      uError("failed to init paged buf io lane:%d since %s", i, terrstr());
+      dBufIoLanes[i].queue = NULL;
+      dBufIoPoolCleanup();
+      return terrno;
+    }
+  }
+
+  atomic_store_32(&dBufNumOfIoLanes, DBUF_IO_LANES);
+  return TSDB_CODE_SUCCESS;
+}
+
+void dBufIoPoolCleanup() {
+  atomic_store_32(&dBufNumOfIoLanes, 0);
+  for (int32_t i = 0; i < DBUF_IO_LANES; ++i) {
+    tSingleWorkerCleanup(&dBufIoLanes[i]);
+    memset(&dBufIoLanes[i], 0, sizeof(SSingleWorker));  // so that it can be started again
+  }
+}
+
+static int32_t dBufSubmitIoReq(SDiskbasedBuf* pBuf, SPageIoReq* pReq) {
+  SPageIoReq** pItem = taosAllocateQitem(sizeof(SPageIoReq*), DEF_QITEM, 0);
+  if (pItem == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  *pItem = pReq;
+  pReq->pBuf = pBuf;
+
+  taosThreadMutexLock(&pBuf->ioMutex);
+  pBuf->numOfIoReqs += 1;
+  taosThreadMutexUnlock(&pBuf->ioMutex);
+
+  if (taosWriteQitem(dBufIoLanes[pBuf->ioLane].queue, pItem) != 0) {
+    taosThreadMutexLock(&pBuf->ioMutex);
+    pBuf->numOfIoReqs -= 1;
+    taosThreadMutexUnlock(&pBuf->ioMutex);
+
+    taosFreeQitem(pItem);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static void dBufWaitIoReq(SDiskbasedBuf* pBuf, SPageIoReq* pReq) {
+  int64_t st = taosGetTimestampUs();
+
+  taosThreadMutexLock(&pBuf->ioMutex);
+  while (!pReq->done) {
+    taosThreadCondWait(&pBuf->ioCond, &pBuf->ioMutex);
+  }
+  taosThreadMutexUnlock(&pBuf->ioMutex);
+
+  pBuf->statis.stallTime += taosGetTimestampUs() - st;
+}
+
+static void dBufFreeIoReq(SPageIoReq* pReq) {
+  if (pReq->pg->pIoReq == pReq) {
+    pReq->pg->pIoReq = NULL;
+  }
+
+  taosMemoryFree(pReq->pData);
+  taosMemoryFree(pReq);
+}
+
+// Free the finished write-behind requests. The io lane handles the requests in order, so they are always the head of
+// the list.
+static void dBufReapWriteReqs(SDiskbasedBuf* pBuf) {
+  int32_t num = 0;
+  int32_t total = taosArrayGetSize(pBuf->pWriting);
+
+  taosThreadMutexLock(&pBuf->ioMutex);
+  for (; num < total; ++num) {
+    SPageIoReq* pReq = taosArrayGetP(pBuf->pWriting, num);
+    if (!pReq->done) {
+      break;
+    }
+    if (pReq->code != TSDB_CODE_SUCCESS && pBuf->ioCode == TSDB_CODE_SUCCESS) {
+      pBuf->ioCode = pReq->code;
+    }
+  }
+  taosThreadMutexUnlock(&pBuf->ioMutex);
+
+  for (int32_t i = 0; i < num; ++i) {
+    dBufFreeIoReq(taosArrayGetP(pBuf->pWriting, i));
+  }
+  taosArrayPopFrontBatch(pBuf->pWriting, num);
+}
+
+// Wait for all the submitted requests to be done, and release all of them.
+static void dBufStopIo(SDiskbasedBuf* pBuf) {
+  taosThreadMutexLock(&pBuf->ioMutex);
+  while (pBuf->numOfIoReqs > 0) {
+    taosThreadCondWait(&pBuf->ioCond, &pBuf->ioMutex);
   }
+  taosThreadMutexUnlock(&pBuf->ioMutex);
 
-  *dst = tsDecompressString(data, srcSize, 1, pBuf->assistBuf, pBuf->pageSize, ONE_STAGE_COMP, NULL, 0);
-  if (*dst > 0) {
-    memcpy(data, pBuf->assistBuf, *dst);
+  dBufReapWriteReqs(pBuf);
+
+  size_t n = taosArrayGetSize(pBuf->pIdList);
+  for (int32_t i = 0; i < n && pBuf->numOfAhead > 0; ++i) {
+    SPageInfo* pi = taosArrayGetP(pBuf->pIdList, i);
+    if (pi->pIoReq != NULL && !pi->pIoReq->write) {
+      dBufFreeIoReq(pi->pIoReq);
+      pBuf->numOfAhead -= 1;
+    }
   }
-  return data;
 }
 
 static uint64_t allocateNewPositionInFile(SDiskbasedBuf* pBuf, size_t size) {
@@ -129,17 +318,62 @@ static uint64_t allocateNewPositionInFile(SDiskbasedBuf* pBuf, size_t size) {
 
 static FORCE_INLINE size_t getAllocPageSize(int32_t pageSize) { return pageSize + POINTER_BYTES + sizeof(SFilePage); }
 
-static int32_t doFlushBufPageImpl(SDiskbasedBuf* pBuf, int64_t offset, const char* pData, int32_t size) {
-  int32_t ret = taosLSeekFile(pBuf->pFile, offset, SEEK_SET);
-  if (ret == -1) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    return terrno;
+// Hand over a copy of the page image to the io lane, so the page can be reused at once.
+static int32_t doWriteBehind(SDiskbasedBuf* pBuf, SPageInfo* pg, int64_t offset, const char* pData, int32_t size) {
+  dBufReapWriteReqs(pBuf);
+
+  // too many pages in flight, wait for the eldest one
+  while (pBuf->ioCode == TSDB_CODE_SUCCESS && taosArrayGetSize(pBuf->pWriting) >= pBuf->maxIoPages) {
+    dBufWaitIoReq(pBuf, taosArrayGetP(pBuf->pWriting, 0));
+    dBufReapWriteReqs(pBuf);
+  }
+
+  if (pBuf->ioCode != TSDB_CODE_SUCCESS) {
+    return pBuf->ioCode;
+  }
+
+  SPageIoReq* pReq = taosMemoryCalloc(1, sizeof(SPageIoReq));
+  char*       pImage = taosMemoryMalloc(size);
+  if (pReq == NULL || pImage == NULL || taosArrayPush(pBuf->pWriting, &pReq) == NULL) {
+    taosMemoryFree(pReq);
+    taosMemoryFree(pImage);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  memcpy(pImage, pData, size);
+  pReq->pg = pg;
+  pReq->pData = pImage;
+  pReq->offset = offset;
+  pReq->size = size;
+  pReq->write = true;
+
+  int32_t code = dBufSubmitIoReq(pBuf, pReq);
+  if (code != TSDB_CODE_SUCCESS) {
+    taosArrayPop(pBuf->pWriting);
+    dBufFreeIoReq(pReq);
+    return code;
   }
 
-  ret = (int32_t)taosWriteFile(pBuf->pFile, pData, size);
-  if (ret != size) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    return terrno;
+  pg->pIoReq = pReq;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t doFlushBufPageImpl(SDiskbasedBuf* pBuf, SPageInfo* pg, int64_t offset, const char* pData,
+                                  int32_t size) {
+  if (pBuf->maxIoPages > 0) {
+    int32_t code = doWriteBehind(pBuf, pg, offset, pData, size);
+    if (code != TSDB_CODE_SUCCESS) {
+      terrno = code;
+      return terrno;
+    }
+  } else {
+    int64_t st = taosGetTimestampUs();
+    int64_t ret = taosPWriteFile(pBuf->pFile, pData, size, offset);
+    pBuf->statis.stallTime += taosGetTimestampUs() - st;
+    if (ret != size) {
+      terrno = TAOS_SYSTEM_ERROR(errno);
+      return terrno;
+    }
   }
 
   // extend the file
@@ -166,7 +400,7 @@ static char* doFlushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
   char* t = NULL;
   if ((!HAS_DATA_IN_DISK(pg)) || pg->dirty) {
     void* payload = GET_PAYLOAD_DATA(pg);
-    t = doCompressData(payload, pBuf->pageSize + sizeof(SFilePage), &size, pBuf);
+    t = doCompressData(payload, GET_RAW_PAGE_SIZE(pBuf), &size, pBuf);
     if (size < 0) {
       uError("failed to compress data when flushing data to disk, %s", pBuf->id);
       terrno = TSDB_CODE_INVALID_PARA;
@@ -180,7 +414,7 @@ static char* doFlushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
       offset = allocateNewPositionInFile(pBuf, size);
       pBuf->nextPos += size;
 
-      int32_t code = doFlushBufPageImpl(pBuf, offset, t, size);
+      int32_t code = doFlushBufPageImpl(pBuf, pg, offset, t, size);
       if (code != TSDB_CODE_SUCCESS) {
         return NULL;
       }
@@ -196,7 +430,7 @@ static char* doFlushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
         pBuf->nextPos += size;
       }
 
-      int32_t code = doFlushBufPageImpl(pBuf, offset, t, size);
+      int32_t code = doFlushBufPageImpl(pBuf, pg, offset, t, size);
       if (code != TSDB_CODE_SUCCESS) {
         return NULL;
       }
@@ -241,25 +475,48 @@ static int32_t loadPageFromDisk(SDiskbasedBuf* pBuf, SPageInfo* pg) {
     return TSDB_CODE_INVALID_PARA;
   }
 
-  int32_t ret = taosLSeekFile(pBuf->pFile, pg->offset, SEEK_SET);
-  if (ret == -1) {
-    ret = TAOS_SYSTEM_ERROR(errno);
-    return ret;
+  // the page images on disk are not reliable any more
+  if (pBuf->ioCode != TSDB_CODE_SUCCESS) {
+    return pBuf->ioCode;
+  }
+
+  char*       pPage = GET_PAYLOAD_DATA(pg);
+  SPageIoReq* pReq = pg->pIoReq;
+  if (pReq != NULL) {
+    // The page image of the write-behind request is not changed until the request is done and released, and it is
+    // the only up-to-date one before that, even if the page is evicted again without being modified.
+    if (pReq->write) {
+      return doDecompressData(pReq->pData, pg->length, pPage, pBuf);
+    }
+
+    pg->pIoReq = NULL;
+    dBufWaitIoReq(pBuf, pReq);
+    int32_t code = pReq->code;
+    if (code == TSDB_CODE_SUCCESS) {
+      pBuf->statis.loadBytes += pg->length;
+      pBuf->statis.loadPages += 1;
+      pBuf->statis.readAheadPages += 1;
+      code = doDecompressData(pReq->pData, pg->length, pPage, pBuf);
+    }
+
+    pBuf->numOfAhead -= 1;
+    dBufFreeIoReq(pReq);
+    return code;
   }
 
-  void* pPage = (void*)GET_PAYLOAD_DATA(pg);
-  ret = (int32_t)taosReadFile(pBuf->pFile, pPage, pg->length);
+  // read the compressed page into the assistant buffer, and decompress it into the page directly
+  char*   pImage = (pg->length < GET_RAW_PAGE_SIZE(pBuf)) ? pBuf->assistBuf : pPage;
+  int64_t st = taosGetTimestampUs();
+  int64_t ret = taosPReadFile(pBuf->pFile, pImage, pg->length, pg->offset);
+  pBuf->statis.stallTime += taosGetTimestampUs() - st;
   if (ret != pg->length) {
-    ret = TAOS_SYSTEM_ERROR(errno);
-    return ret;
+    return TAOS_SYSTEM_ERROR(errno);
   }
 
   pBuf->statis.loadBytes += pg->length;
   pBuf->statis.loadPages += 1;
 
-  int32_t fullSize = 0;
-  doDecompressData(pPage, pg->length, &fullSize, pBuf);
-  return 0;
+  return doDecompressData(pImage, pg->length, pPage, pBuf);
 }
 
 static SPageInfo* registerNewPageInfo(SDiskbasedBuf* pBuf, int32_t pageId) {
@@ -273,6 +530,7 @@ static SPageInfo* registerNewPageInfo(SDiskbasedBuf* pBuf, int32_t pageId) {
 
   ppi->pageId = pageId;
   ppi->pData = NULL;
+  ppi->pIoReq = NULL;
   ppi->offset = -1;
   ppi->length = -1;
   ppi->used = true;
@@ -569,6 +827,10 @@ void destroyDiskbasedBuf(SDiskbasedBuf* pBuf) {
 
   dBufPrintStatis(pBuf);
 
+  if (pBuf->pWriting != NULL) {
+    dBufStopIo(pBuf);
+  }
+
   bool needRemoveFile = false;
   if (pBuf->pFile != NULL) {
     needRemoveFile = true;
@@ -587,13 +849,15 @@ void destroyDiskbasedBuf(SDiskbasedBuf* pBuf) {
   {
     SDiskbasedBufStatis* ps = &pBuf->statis;
     if (ps->loadPages == 0) {
-      uDebug("Get/Release pages:%d/%d, flushToDisk:%.2f Kb (%d Pages), loadFromDisk:%.2f Kb (%d Pages)", ps->getPages,
-             ps->releasePages, ps->flushBytes / 1024.0f, ps->flushPages, ps->loadBytes / 1024.0f, ps->loadPages);
+      uDebug("Get/Release pages:%d/%d, flushToDisk:%.2f Kb (%d Pages), loadFromDisk:%.2f Kb (%d Pages), ioStall:%.2f ms",
+             ps->getPages, ps->releasePages, ps->flushBytes / 1024.0f, ps->flushPages, ps->loadBytes / 1024.0f,
+             ps->loadPages, ps->stallTime / 1000.0);
     } else {
       uDebug(
-          "Get/Release pages:%d/%d, flushToDisk:%.2f Kb (%d Pages), loadFromDisk:%.2f Kb (%d Pages), avgPgSize:%.2f Kb",
+          "Get/Release pages:%d/%d, flushToDisk:%.2f Kb (%d Pages), loadFromDisk:%.2f Kb (%d Pages, %d read ahead), "
+          "avgPgSize:%.2f Kb, ioStall:%.2f ms",
           ps->getPages, ps->releasePages, ps->flushBytes / 1024.0f, ps->flushPages, ps->loadBytes / 1024.0f,
-          ps->loadPages, ps->loadBytes / (1024.0 * ps->loadPages));
+          ps->loadPages, ps->readAheadPages, ps->loadBytes / (1024.0 * ps->loadPages), ps->stallTime / 1000.0);
     }
   }
 
@@ -623,6 +887,15 @@ void destroyDiskbasedBuf(SDiskbasedBuf* pBuf) {
 
   tSimpleHashCleanup(pBuf->all);
 
+  if (pBuf->pWriting != NULL) {
+    taosArrayDestroy(pBuf->pWriting);
+    taosThreadCondDestroy(&pBuf->ioCond);
+    taosThreadMutexDestroy(&pBuf->ioMutex);
+  }
+
+  ZSTD_freeCCtx(pBuf->zstdCCtx);
+  ZSTD_freeDCtx(pBuf->zstdDCtx);
+
   taosMemoryFreeClear(pBuf->id);
   taosMemoryFreeClear(pBuf->assistBuf);
   taosMemoryFreeClear(pBuf);
@@ -648,10 +921,103 @@ void setBufPageDirty(void* pPage, bool dirty) {
 }
 
 void setBufPageCompressOnDisk(SDiskbasedBuf* pBuf, bool comp) {
-  pBuf->comp = comp;
-  if (comp  && (pBuf->assistBuf == NULL)) {
-    pBuf->assistBuf = taosMemoryMalloc(pBuf->pageSize + 2);  // EXTRA BYTES
+  dBufSetPageCodec(pBuf, comp ? PAGE_CODEC_LZ4 : PAGE_CODEC_NONE);
+}
+
+void dBufSetPageCodec(SDiskbasedBuf* pBuf, EPageCodec codec) {
+  if (pBuf->codec == codec) {
+    return;
+  }
+
+  // the pages on disk are decompressed with the codec of the buffer
+  if (pBuf->pFile != NULL) {
+    uWarn("failed to change the codec of paged buffer, since pages have been flushed to disk, %s", pBuf->id);
+    return;
+  }
+
+  if (codec == PAGE_CODEC_ZSTD && pBuf->zstdCCtx == NULL) {
+    pBuf->zstdCCtx = ZSTD_createCCtx();
+    pBuf->zstdDCtx = ZSTD_createDCtx();
+    if (pBuf->zstdCCtx == NULL || pBuf->zstdDCtx == NULL) {
+      uError("failed to create zstd context for paged buffer, %s", pBuf->id);
+      codec = PAGE_CODEC_LZ4;
+    }
+  }
+
+  if (codec != PAGE_CODEC_NONE && pBuf->assistBuf == NULL) {
+    pBuf->assistBuf = taosMemoryMalloc(GET_RAW_PAGE_SIZE(pBuf));
+    if (pBuf->assistBuf == NULL) {
+      uError("failed to allocate assistant buffer for paged buffer, %s", pBuf->id);
+      codec = PAGE_CODEC_NONE;
+    }
   }
+
+  pBuf->codec = codec;
+}
+
+int32_t dBufSetWriteBehind(SDiskbasedBuf* pBuf, int32_t maxPages) {
+  // keep the synchronous io if the io lanes are not started
+  int32_t numOfLanes = atomic_load_32(&dBufNumOfIoLanes);
+  if (maxPages <= 0 || numOfLanes <= 0) {
+    if (pBuf->pWriting != NULL) {
+      dBufStopIo(pBuf);
+    }
+    pBuf->maxIoPages = 0;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (pBuf->pWriting == NULL) {
+    pBuf->pWriting = taosArrayInit(maxPages, POINTER_BYTES);
+    if (pBuf->pWriting == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+
+    taosThreadMutexInit(&pBuf->ioMutex, NULL);
+    taosThreadCondInit(&pBuf->ioCond, NULL);
+    pBuf->ioLane = (atomic_fetch_add_32(&dBufNextIoLane, 1) & INT32_MAX) % numOfLanes;
+  }
+
+  pBuf->maxIoPages = maxPages;
+  return TSDB_CODE_SUCCESS;
+}
+
+void dBufPrefetchPage(SDiskbasedBuf* pBuf, int32_t id) {
+  if (pBuf->maxIoPages <= 0 || pBuf->numOfAhead >= pBuf->maxIoPages) {
+    return;
+  }
+
+  SPageInfo** ppi = tSimpleHashGet(pBuf->all, &id, sizeof(int32_t));
+  if (ppi == NULL || *ppi == NULL) {
+    return;
+  }
+
+  // nothing to load, or the page image is already in memory
+  SPageInfo* pg = *ppi;
+  if (BUF_PAGE_IN_MEM(pg) || !HAS_DATA_IN_DISK(pg) || pg->length <= 0 || pg->pIoReq != NULL) {
+    return;
+  }
+
+  SPageIoReq* pReq = taosMemoryCalloc(1, sizeof(SPageIoReq));
+  char*       pImage = taosMemoryMalloc(pg->length);
+  if (pReq == NULL || pImage == NULL) {
+    taosMemoryFree(pReq);
+    taosMemoryFree(pImage);
+    return;
+  }
+
+  pReq->pg = pg;
+  pReq->pData = pImage;
+  pReq->offset = pg->offset;
+  pReq->size = pg->length;
+  pReq->write = false;
+
+  if (dBufSubmitIoReq(pBuf, pReq) != TSDB_CODE_SUCCESS) {
+    dBufFreeIoReq(pReq);
+    return;
+  }
+
+  pg->pIoReq = pReq;
+  pBuf->numOfAhead += 1;
 }
 
 void dBufSetBufPageRecycled(SDiskbasedBuf* pBuf, void* pPage) {
@@ -700,6 +1066,10 @@ void dBufPrintStatis(const SDiskbasedBuf* pBuf) {
 }
 
 void clearDiskbasedBuf(SDiskbasedBuf* pBuf) {
+  if (pBuf->pWriting != NULL) {
+    dBufStopIo(pBuf);
+  }
+
   size_t n = taosArrayGetSize(pBuf->pIdList);
   for (int32_t i = 0; i < n; ++i) {
     SPageInfo* pi = taosArrayGetP(pBuf->pIdList, i);
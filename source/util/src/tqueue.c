@@ -20,10 +20,17 @@
 
 int64_t tsRpcQueueMemoryAllowed = 0;
 int64_t tsRpcQueueMemoryUsed = 0;
+int32_t tsQueueMemoryWaitMs = 0;
+
+// spinning rounds of a qset reader before it goes to sleep, adapted by whether the spinning catches new items
+#define QSET_MIN_SPINS   16
+#define QSET_MAX_SPINS   8192
+#define QSET_SPIN_YIELDS 256
 
 struct STaosQueue {
-  STaosQnode   *head;
+  STaosQnode   *head;     // items collected from inbox, protected by mutex
   STaosQnode   *tail;
+  STaosQnode   *inbox;    // lock-free stack of the written items, latest first
   STaosQueue   *next;     // for queue set
   STaosQset    *qset;     // for queue set
   void         *ahandle;  // for queue set
@@ -32,9 +39,21 @@ struct STaosQueue {
   TdThreadMutex mutex;
   int64_t       memOfItems;
   int32_t       numOfItems;
+  int32_t       numOfNodes;  // items in head list
+  int64_t       memOfNodes;
+  int64_t       budgetOfNodes;  // memory of the items in head list charged to the budget
   int64_t       threadId;
   int64_t       memLimit;
   int64_t       itemLimit;
+  STaosQbudget *budget;
+  int64_t       memPeak;
+  int64_t       numOfRejects;
+};
+
+// memory shared by a group of queues, e.g. the queues of a vnode
+struct STaosQbudget {
+  int64_t memLimit;
+  int64_t memOfItems;
 };
 
 struct STaosQset {
@@ -44,6 +63,10 @@ struct STaosQset {
   tsem_t        sem;
   int32_t       numOfQueues;
   int32_t       numOfItems;
+  int32_t       numOfWrites;   // bumped on each write, readers sleep only if it is not changed
+  int32_t       numOfWaiters;  // readers sleeping on sem
+  int32_t       numOfExits;    // readers asked to exit
+  int32_t       spinRounds;
 };
 
 struct STaosQall {
@@ -57,6 +80,48 @@ struct STaosQall {
 
 void taosSetQueueMemoryCapacity(STaosQueue *queue, int64_t cap) { queue->memLimit = cap; }
 void taosSetQueueCapacity(STaosQueue *queue, int64_t size) { queue->itemLimit = size; }
+void taosSetQueueBudget(STaosQueue *queue, STaosQbudget *budget) { queue->budget = budget; }
+
+// Charge size to the used memory. If the limit is exceeded, the writer is rejected at once by default, or throttled by
+// waiting for at most tsQueueMemoryWaitMs until the memory is released by readers.
+static int32_t taosAcquireQueueMemory(int64_t *pUsed, int64_t size, int64_t limit, int64_t *pAlloced) {
+  int64_t startMs = 0;
+  while (1) {
+    *pAlloced = atomic_add_fetch_64(pUsed, size);
+    if (limit <= 0 || *pAlloced <= limit) return 0;
+
+    (void)atomic_sub_fetch_64(pUsed, size);
+    if (tsQueueMemoryWaitMs <= 0) return -1;
+
+    int64_t nowMs = taosGetTimestampMs();
+    if (startMs == 0) {
+      startMs = nowMs;
+    } else if (nowMs - startMs >= tsQueueMemoryWaitMs) {
+      return -1;
+    }
+    taosMsleep(1);
+  }
+}
+
+STaosQbudget *taosOpenQbudget(int64_t memLimit) {
+  STaosQbudget *budget = taosMemoryCalloc(1, sizeof(STaosQbudget));
+  if (budget == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  budget->memLimit = memLimit;
+  uDebug("qbudget:%p is opened, limit:%" PRId64, budget, memLimit);
+  return budget;
+}
+
+void taosCloseQbudget(STaosQbudget *budget) {
+  if (budget == NULL) return;
+  uDebug("qbudget:%p is closed, mem:%" PRId64, budget, budget->memOfItems);
+  taosMemoryFree(budget);
+}
+
+int64_t taosQbudgetMemorySize(STaosQbudget *budget) { return atomic_load_64(&budget->memOfItems); }
 
 STaosQueue *taosOpenQueue() {
   STaosQueue *queue = taosMemoryCalloc(1, sizeof(STaosQueue));
@@ -80,15 +145,83 @@ void taosSetQueueFp(STaosQueue *queue, FItem itemFp, FItems itemsFp) {
   queue->itemsFp = itemsFp;
 }
 
+// move the items written since last time from inbox to the tail of head list, queue mutex shall be locked
+static void taosCollectQitems(STaosQueue *queue) {
+  STaosQnode *pNode = atomic_exchange_ptr(&queue->inbox, NULL);
+  if (pNode == NULL) return;
+
+  STaosQnode *pLast = pNode;
+  STaosQnode *pFirst = NULL;
+  while (pNode) {
+    STaosQnode *pNext = pNode->next;
+    pNode->next = pFirst;
+    pFirst = pNode;
+    queue->numOfNodes++;
+    queue->memOfNodes += (pNode->size + pNode->dataSize);
+    if (pNode->charged) queue->budgetOfNodes += (pNode->size + pNode->dataSize);
+    pNode = pNext;
+  }
+
+  if (queue->tail) {
+    queue->tail->next = pFirst;
+  } else {
+    queue->head = pFirst;
+  }
+  queue->tail = pLast;
+}
+
+static bool taosQueueHasItems(STaosQueue *queue) {
+  return queue->head != NULL || atomic_load_ptr(&queue->inbox) != NULL;
+}
+
+// pop at most maxItems items from head list, all of them if maxItems is not positive, queue mutex shall be locked
+static STaosQnode *taosPopQitems(STaosQueue *queue, int32_t maxItems, int32_t *numOfItems, int64_t *memOfItems) {
+  taosCollectQitems(queue);
+
+  STaosQnode *pStart = queue->head;
+  if (pStart == NULL) return NULL;
+
+  int64_t memOfCharged = 0;
+  if (maxItems <= 0 || maxItems >= queue->numOfNodes) {
+    *numOfItems = queue->numOfNodes;
+    *memOfItems = queue->memOfNodes;
+    memOfCharged = queue->budgetOfNodes;
+    queue->head = NULL;
+    queue->tail = NULL;
+  } else {
+    STaosQnode *pNode = pStart;
+    *numOfItems = 0;
+    *memOfItems = 0;
+    while (1) {
+      (*numOfItems)++;
+      *memOfItems += (pNode->size + pNode->dataSize);
+      if (pNode->charged) memOfCharged += (pNode->size + pNode->dataSize);
+      if (*numOfItems >= maxItems) break;
+      pNode = pNode->next;
+    }
+    queue->head = pNode->next;
+    pNode->next = NULL;
+  }
+
+  queue->numOfNodes -= *numOfItems;
+  queue->memOfNodes -= *memOfItems;
+  queue->budgetOfNodes -= memOfCharged;
+  (void)atomic_sub_fetch_64(&queue->memOfItems, *memOfItems);
+  if (memOfCharged > 0) (void)atomic_sub_fetch_64(&queue->budget->memOfItems, memOfCharged);
+  return pStart;
+}
+
 void taosCloseQueue(STaosQueue *queue) {
   if (queue == NULL) return;
   STaosQnode *pTemp;
   STaosQset  *qset;
 
   taosThreadMutexLock(&queue->mutex);
+  taosCollectQitems(queue);
   STaosQnode *pNode = queue->head;
   queue->head = NULL;
   qset = queue->qset;
+  if (queue->budgetOfNodes > 0) (void)atomic_sub_fetch_64(&queue->budget->memOfItems, queue->budgetOfNodes);
   taosThreadMutexUnlock(&queue->mutex);
 
   if (queue->qset) {
@@ -112,7 +245,7 @@ bool taosQueueEmpty(STaosQueue *queue) {
 
   bool empty = false;
   taosThreadMutexLock(&queue->mutex);
-  if (queue->head == NULL && queue->tail == NULL && queue->numOfItems == 0 /*&& queue->memOfItems == 0*/) {
+  if (!taosQueueHasItems(queue) && atomic_load_32(&queue->numOfItems) == 0 /*&& queue->memOfItems == 0*/) {
     empty = true;
   }
   taosThreadMutexUnlock(&queue->mutex);
@@ -122,28 +255,27 @@ bool taosQueueEmpty(STaosQueue *queue) {
 
 void taosUpdateItemSize(STaosQueue *queue, int32_t items) {
   if (queue == NULL) return;
-
-  taosThreadMutexLock(&queue->mutex);
-  queue->numOfItems -= items;
-  taosThreadMutexUnlock(&queue->mutex);
+  (void)atomic_sub_fetch_32(&queue->numOfItems, items);
 }
 
 int32_t taosQueueItemSize(STaosQueue *queue) {
   if (queue == NULL) return 0;
 
-  taosThreadMutexLock(&queue->mutex);
-  int32_t numOfItems = queue->numOfItems;
-  taosThreadMutexUnlock(&queue->mutex);
-
-  uTrace("queue:%p, numOfItems:%d memOfItems:%" PRId64, queue, queue->numOfItems, queue->memOfItems);
+  int32_t numOfItems = atomic_load_32(&queue->numOfItems);
+  uTrace("queue:%p, numOfItems:%d memOfItems:%" PRId64, queue, numOfItems, atomic_load_64(&queue->memOfItems));
   return numOfItems;
 }
 
-int64_t taosQueueMemorySize(STaosQueue *queue) {
-  taosThreadMutexLock(&queue->mutex);
-  int64_t memOfItems = queue->memOfItems;
-  taosThreadMutexUnlock(&queue->mutex);
-  return memOfItems;
+int64_t taosQueueMemorySize(STaosQueue *queue) { return atomic_load_64(&queue->memOfItems); }
+
+int64_t taosQueueMemoryPeak(STaosQueue *queue, bool reset) {
+  if (reset) return atomic_exchange_64(&queue->memPeak, atomic_load_64(&queue->memOfItems));
+  return atomic_load_64(&queue->memPeak);
+}
+
+int64_t taosQueueRejects(STaosQueue *queue, bool reset) {
+  if (reset) return atomic_exchange_64(&queue->numOfRejects, 0);
+  return atomic_load_64(&queue->numOfRejects);
 }
 
 void *taosAllocateQitem(int32_t size, EQItype itype, int64_t dataSize) {
@@ -159,11 +291,10 @@ void *taosAllocateQitem(int32_t size, EQItype itype, int64_t dataSize) {
   pNode->timestamp = taosGetTimestampUs();
 
   if (itype == RPC_QITEM) {
-    int64_t alloced = atomic_add_fetch_64(&tsRpcQueueMemoryUsed, size + dataSize);
-    if (alloced > tsRpcQueueMemoryAllowed) {
+    int64_t alloced = 0;
+    if (taosAcquireQueueMemory(&tsRpcQueueMemoryUsed, size + dataSize, tsRpcQueueMemoryAllowed, &alloced) != 0) {
       uError("failed to alloc qitem, size:%" PRId64 " alloc:%" PRId64 " allowed:%" PRId64, size + dataSize, alloced,
-             tsRpcQueueMemoryUsed);
-      atomic_sub_fetch_64(&tsRpcQueueMemoryUsed, size + dataSize);
+             tsRpcQueueMemoryAllowed);
       taosMemoryFree(pNode);
       terrno = TSDB_CODE_OUT_OF_RPC_MEMORY_QUEUE;
       return NULL;
@@ -190,60 +321,81 @@ void taosFreeQitem(void *pItem) {
   taosMemoryFree(pNode);
 }
 
-int32_t taosWriteQitem(STaosQueue *queue, void *pItem) {
+// writers never lock the queue, the item is pushed into inbox and collected into head list by readers
+static int32_t taosWriteQitemImpl(STaosQueue *queue, void *pItem, bool charge) {
   int32_t     code = 0;
   STaosQnode *pNode = (STaosQnode *)(((char *)pItem) - sizeof(STaosQnode));
+  int64_t     size = pNode->size + pNode->dataSize;
   pNode->timestamp = taosGetTimestampUs();
-  pNode->next = NULL;
+  pNode->charged = (charge && queue->budget != NULL);
+
+  int64_t memOfBudget = 0;
+  if (pNode->charged && taosAcquireQueueMemory(&queue->budget->memOfItems, size, queue->budget->memLimit,
+                                               &memOfBudget) != 0) {
+    code = TSDB_CODE_OUT_OF_RPC_MEMORY_QUEUE;
+    uError("item:%p failed to put into queue:%p, budget mem limit: %" PRId64 ", reason: %s", pItem, queue,
+           queue->budget->memLimit, tstrerror(code));
+    (void)atomic_add_fetch_64(&queue->numOfRejects, 1);
+    terrno = code;
+    return code;
+  }
 
-  taosThreadMutexLock(&queue->mutex);
-  if (queue->memLimit > 0 && (queue->memOfItems + pNode->size + pNode->dataSize) > queue->memLimit) {
+  int64_t memOfItems = atomic_add_fetch_64(&queue->memOfItems, size);
+  int32_t numOfItems = atomic_add_fetch_32(&queue->numOfItems, 1);
+  if (queue->memLimit > 0 && memOfItems > queue->memLimit) {
     code = TSDB_CODE_UTIL_QUEUE_OUT_OF_MEMORY;
     uError("item:%p failed to put into queue:%p, queue mem limit: %" PRId64 ", reason: %s" PRId64, pItem, queue,
            queue->memLimit, tstrerror(code));
-
-    taosThreadMutexUnlock(&queue->mutex);
-    return code;
-  } else if (queue->itemLimit > 0 && queue->numOfItems + 1 > queue->itemLimit) {
+  } else if (queue->itemLimit > 0 && numOfItems > queue->itemLimit) {
     code = TSDB_CODE_UTIL_QUEUE_OUT_OF_MEMORY;
     uError("item:%p failed to put into queue:%p, queue size limit: %" PRId64 ", reason: %s" PRId64, pItem, queue,
            queue->itemLimit, tstrerror(code));
-    taosThreadMutexUnlock(&queue->mutex);
-    return code;
   }
 
-  if (queue->tail) {
-    queue->tail->next = pNode;
-    queue->tail = pNode;
-  } else {
-    queue->head = pNode;
-    queue->tail = pNode;
+  if (code != 0) {
+    (void)atomic_sub_fetch_64(&queue->memOfItems, size);
+    (void)atomic_sub_fetch_32(&queue->numOfItems, 1);
+    if (pNode->charged) (void)atomic_sub_fetch_64(&queue->budget->memOfItems, size);
+    (void)atomic_add_fetch_64(&queue->numOfRejects, 1);
+    terrno = code;
+    return code;
   }
-  queue->numOfItems++;
-  queue->memOfItems += (pNode->size + pNode->dataSize);
-  if (queue->qset) atomic_add_fetch_32(&queue->qset->numOfItems, 1);
 
-  uTrace("item:%p is put into queue:%p, items:%d mem:%" PRId64, pItem, queue, queue->numOfItems, queue->memOfItems);
+  if (memOfItems > atomic_load_64(&queue->memPeak)) atomic_store_64(&queue->memPeak, memOfItems);
 
-  taosThreadMutexUnlock(&queue->mutex);
+  while (1) {
+    STaosQnode *pTop = atomic_load_ptr(&queue->inbox);
+    pNode->next = pTop;
+    if (atomic_val_compare_exchange_ptr(&queue->inbox, pTop, pNode) == pTop) break;
+  }
+
+  uTrace("item:%p is put into queue:%p, items:%d mem:%" PRId64, pItem, queue, numOfItems, memOfItems);
 
-  if (queue->qset) tsem_post(&queue->qset->sem);
+  STaosQset *qset = atomic_load_ptr(&queue->qset);
+  if (qset) {
+    (void)atomic_add_fetch_32(&qset->numOfItems, 1);
+    (void)atomic_add_fetch_32(&qset->numOfWrites, 1);
+    if (atomic_load_32(&qset->numOfWaiters) > 0) tsem_post(&qset->sem);
+  }
   return code;
 }
 
+int32_t taosWriteQitem(STaosQueue *queue, void *pItem) { return taosWriteQitemImpl(queue, pItem, false); }
+
+int32_t taosWriteQitemInBudget(STaosQueue *queue, void *pItem) { return taosWriteQitemImpl(queue, pItem, true); }
+
 int32_t taosReadQitem(STaosQueue *queue, void **ppItem) {
   STaosQnode *pNode = NULL;
+  int32_t     numOfItems = 0;
+  int64_t     memOfItems = 0;
   int32_t     code = 0;
 
   taosThreadMutexLock(&queue->mutex);
 
-  if (queue->head) {
-    pNode = queue->head;
+  pNode = taosPopQitems(queue, 1, &numOfItems, &memOfItems);
+  if (pNode) {
     *ppItem = pNode->item;
-    queue->head = pNode->next;
-    if (queue->head == NULL) queue->tail = NULL;
-    queue->numOfItems--;
-    queue->memOfItems -= (pNode->size + pNode->dataSize);
+    (void)atomic_sub_fetch_32(&queue->numOfItems, 1);
     if (queue->qset) atomic_sub_fetch_32(&queue->qset->numOfItems, 1);
     code = 1;
     uTrace("item:%p is read out from queue:%p, items:%d mem:%" PRId64, *ppItem, queue, queue->numOfItems,
@@ -265,29 +417,27 @@ STaosQall *taosAllocateQall() {
 
 void taosFreeQall(STaosQall *qall) { taosMemoryFree(qall); }
 
+static void taosSetQall(STaosQall *qall, STaosQnode *pStart, int32_t numOfItems, int64_t memOfItems) {
+  memset(qall, 0, sizeof(STaosQall));
+  qall->current = pStart;
+  qall->start = pStart;
+  qall->numOfItems = numOfItems;
+  qall->memOfItems = memOfItems;
+
+  qall->unAccessedNumOfItems = numOfItems;
+  qall->unAccessMemOfItems = memOfItems;
+}
+
 int32_t taosReadAllQitems(STaosQueue *queue, STaosQall *qall) {
   int32_t numOfItems = 0;
-  bool    empty;
+  int64_t memOfItems = 0;
 
   taosThreadMutexLock(&queue->mutex);
 
-  empty = queue->head == NULL;
-  if (!empty) {
-    memset(qall, 0, sizeof(STaosQall));
-    qall->current = queue->head;
-    qall->start = queue->head;
-    qall->numOfItems = queue->numOfItems;
-    qall->memOfItems = queue->memOfItems;
-
-    qall->unAccessedNumOfItems = queue->numOfItems;
-    qall->unAccessMemOfItems = queue->memOfItems;
-
-    numOfItems = qall->numOfItems;
-
-    queue->head = NULL;
-    queue->tail = NULL;
-    queue->numOfItems = 0;
-    queue->memOfItems = 0;
+  STaosQnode *pStart = taosPopQitems(queue, 0, &numOfItems, &memOfItems);
+  if (pStart != NULL) {
+    taosSetQall(qall, pStart, numOfItems, memOfItems);
+    (void)atomic_sub_fetch_32(&queue->numOfItems, numOfItems);
     uTrace("read %d items from queue:%p, items:%d mem:%" PRId64, numOfItems, queue, queue->numOfItems,
            queue->memOfItems);
     if (queue->qset) atomic_sub_fetch_32(&queue->qset->numOfItems, qall->numOfItems);
@@ -296,7 +446,7 @@ int32_t taosReadAllQitems(STaosQueue *queue, STaosQall *qall) {
   taosThreadMutexUnlock(&queue->mutex);
 
   // if source queue is empty, we set destination qall to empty too.
-  if (empty) {
+  if (pStart == NULL) {
     qall->current = NULL;
     qall->start = NULL;
     qall->numOfItems = 0;
@@ -336,6 +486,12 @@ STaosQset *taosOpenQset() {
   taosThreadMutexInit(&qset->mutex, NULL);
   tsem_init(&qset->sem, 0, 0);
 
+  // no writer runs while a reader spins on a single cpu, and tsNumOfCores is raised to 2 at least, so the cpus
+  // available are counted here. The spinning rounds stay 0 once set to 0.
+  float numOfCores = 0;
+  (void)taosGetCpuCores(&numOfCores, false);
+  qset->spinRounds = (numOfCores > 1) ? QSET_MIN_SPINS : 0;
+
   uDebug("qset:%p is opened", qset);
   return qset;
 }
@@ -360,11 +516,10 @@ void taosCloseQset(STaosQset *qset) {
   uDebug("qset:%p is closed", qset);
 }
 
-// tsem_post 'qset->sem', so that reader threads waiting for it
-// resumes execution and return, should only be used to signal the
-// thread to exit.
+// ask one reader thread to exit, it returns once there are no items in the qset
 void taosQsetThreadResume(STaosQset *qset) {
   uDebug("qset:%p, it will exit", qset);
+  (void)atomic_add_fetch_32(&qset->numOfExits, 1);
   tsem_post(&qset->sem);
 }
 
@@ -380,7 +535,7 @@ int32_t taosAddIntoQset(STaosQset *qset, STaosQueue *queue, void *ahandle) {
 
   taosThreadMutexLock(&queue->mutex);
   atomic_add_fetch_32(&qset->numOfItems, queue->numOfItems);
-  queue->qset = qset;
+  atomic_store_ptr(&queue->qset, qset);
   taosThreadMutexUnlock(&queue->mutex);
 
   taosThreadMutexUnlock(&qset->mutex);
@@ -418,7 +573,7 @@ void taosRemoveFromQset(STaosQset *qset, STaosQueue *queue) {
 
       taosThreadMutexLock(&queue->mutex);
       atomic_sub_fetch_32(&qset->numOfItems, queue->numOfItems);
-      queue->qset = NULL;
+      atomic_store_ptr(&queue->qset, NULL);
       queue->next = NULL;
       taosThreadMutexUnlock(&queue->mutex);
     }
@@ -429,11 +584,10 @@ void taosRemoveFromQset(STaosQset *qset, STaosQueue *queue) {
   uDebug("queue:%p is removed from qset:%p", queue, qset);
 }
 
-int32_t taosReadQitemFromQset(STaosQset *qset, void **ppItem, SQueueInfo *qinfo) {
-  STaosQnode *pNode = NULL;
-  int32_t     code = 0;
-
-  tsem_wait(&qset->sem);
+// pop at most maxItems items from the next non-empty queue in round robin, all of them if maxItems is not positive
+static STaosQnode *taosPopQitemsFromQset(STaosQset *qset, int32_t maxItems, int32_t *numOfItems, int64_t *memOfItems,
+                                         STaosQueue **ppQueue) {
+  STaosQnode *pStart = NULL;
 
   taosThreadMutexLock(&qset->mutex);
 
@@ -442,86 +596,121 @@ int32_t taosReadQitemFromQset(STaosQset *qset, void **ppItem, SQueueInfo *qinfo)
     STaosQueue *queue = qset->current;
     if (queue) qset->current = queue->next;
     if (queue == NULL) break;
-    if (queue->head == NULL) continue;
+    if (!taosQueueHasItems(queue)) continue;
 
     taosThreadMutexLock(&queue->mutex);
+    pStart = taosPopQitems(queue, maxItems, numOfItems, memOfItems);
+    taosThreadMutexUnlock(&queue->mutex);
 
-    if (queue->head) {
-      pNode = queue->head;
-      *ppItem = pNode->item;
-      qinfo->ahandle = queue->ahandle;
-      qinfo->fp = queue->itemFp;
-      qinfo->queue = queue;
-      qinfo->timestamp = pNode->timestamp;
-
-      queue->head = pNode->next;
-      if (queue->head == NULL) queue->tail = NULL;
-      // queue->numOfItems--;
-      queue->memOfItems -= (pNode->size + pNode->dataSize);
-      atomic_sub_fetch_32(&qset->numOfItems, 1);
-      code = 1;
-      uTrace("item:%p is read out from queue:%p, items:%d mem:%" PRId64, *ppItem, queue, queue->numOfItems - 1,
-             queue->memOfItems);
+    if (pStart) {
+      // queue->numOfItems is decreased by taosUpdateItemSize after the items are processed
+      atomic_sub_fetch_32(&qset->numOfItems, *numOfItems);
+      *ppQueue = queue;
+      break;
     }
-
-    taosThreadMutexUnlock(&queue->mutex);
-    if (pNode) break;
   }
 
   taosThreadMutexUnlock(&qset->mutex);
+  return pStart;
+}
 
-  return code;
+static bool taosQsetThreadExit(STaosQset *qset) {
+  while (1) {
+    int32_t numOfExits = atomic_load_32(&qset->numOfExits);
+    if (numOfExits <= 0) return false;
+    if (atomic_val_compare_exchange_32(&qset->numOfExits, numOfExits, numOfExits - 1) == numOfExits) return true;
+  }
 }
 
-int32_t taosReadAllQitemsFromQset(STaosQset *qset, STaosQall *qall, SQueueInfo *qinfo) {
-  STaosQueue *queue;
-  int32_t     code = 0;
+// Readers spin for a while before sleeping on sem, since the next item comes soon under heavy load, and writers post
+// sem only if there are readers sleeping. The spinning rounds grow when spinning catches items and shrink otherwise.
+static STaosQnode *taosWaitQitemsFromQset(STaosQset *qset, int32_t maxItems, int32_t *numOfItems,
+                                          int64_t *memOfItems, STaosQueue **ppQueue) {
+  while (1) {
+    int32_t     numOfWrites = atomic_load_32(&qset->numOfWrites);
+    STaosQnode *pStart = taosPopQitemsFromQset(qset, maxItems, numOfItems, memOfItems, ppQueue);
+    if (pStart) return pStart;
+    if (taosQsetThreadExit(qset)) return NULL;
+
+    int32_t spinRounds = atomic_load_32(&qset->spinRounds);
+    int32_t spin = 0;
+    for (; spin < spinRounds; ++spin) {
+      if (atomic_load_32(&qset->numOfWrites) != numOfWrites || atomic_load_32(&qset->numOfExits) > 0) break;
+      if ((spin + 1) % QSET_SPIN_YIELDS == 0) sched_yield();
+    }
 
-  tsem_wait(&qset->sem);
-  taosThreadMutexLock(&qset->mutex);
+    if (spin < spinRounds) {
+      if (spinRounds < QSET_MAX_SPINS) atomic_store_32(&qset->spinRounds, spinRounds * 2);
+      continue;
+    }
+    if (spinRounds > QSET_MIN_SPINS) atomic_store_32(&qset->spinRounds, spinRounds / 2);
 
-  for (int32_t i = 0; i < qset->numOfQueues; ++i) {
-    if (qset->current == NULL) qset->current = qset->head;
-    queue = qset->current;
-    if (queue) qset->current = queue->next;
-    if (queue == NULL) break;
-    if (queue->head == NULL) continue;
+    (void)atomic_add_fetch_32(&qset->numOfWaiters, 1);
+    if (atomic_load_32(&qset->numOfWrites) == numOfWrites && atomic_load_32(&qset->numOfExits) == 0) {
+      tsem_wait(&qset->sem);
+    }
+    (void)atomic_sub_fetch_32(&qset->numOfWaiters, 1);
+  }
+}
 
-    taosThreadMutexLock(&queue->mutex);
+int32_t taosReadQitemFromQset(STaosQset *qset, void **ppItem, SQueueInfo *qinfo) {
+  STaosQueue *queue = NULL;
+  int32_t     numOfItems = 0;
+  int64_t     memOfItems = 0;
+
+  STaosQnode *pNode = taosWaitQitemsFromQset(qset, 1, &numOfItems, &memOfItems, &queue);
+  if (pNode == NULL) return 0;
+
+  *ppItem = pNode->item;
+  qinfo->ahandle = queue->ahandle;
+  qinfo->fp = queue->itemFp;
+  qinfo->queue = queue;
+  qinfo->timestamp = pNode->timestamp;
+  uTrace("item:%p is read out from queue:%p, items:%d mem:%" PRId64, *ppItem, queue, queue->numOfItems - 1,
+         queue->memOfItems);
+  return 1;
+}
 
-    if (queue->head) {
-      qall->current = queue->head;
-      qall->start = queue->head;
-      qall->numOfItems = queue->numOfItems;
-      qall->memOfItems = queue->memOfItems;
-
-      code = qall->numOfItems;
-      qinfo->ahandle = queue->ahandle;
-      qinfo->fp = queue->itemsFp;
-      qinfo->queue = queue;
-      qinfo->timestamp = queue->head->timestamp;
-
-      queue->head = NULL;
-      queue->tail = NULL;
-      // queue->numOfItems = 0;
-      queue->memOfItems = 0;
-      uTrace("read %d items from queue:%p, items:0 mem:%" PRId64, code, queue, queue->memOfItems);
-
-      atomic_sub_fetch_32(&qset->numOfItems, qall->numOfItems);
-      for (int32_t j = 1; j < qall->numOfItems; ++j) {
-        tsem_wait(&qset->sem);
-      }
-    }
+int32_t taosReadQitemsFromQset(STaosQset *qset, STaosQall *qall, int32_t maxItems, SQueueInfo *qinfo) {
+  STaosQueue *queue = NULL;
+  int32_t     numOfItems = 0;
+  int64_t     memOfItems = 0;
 
-    taosThreadMutexUnlock(&queue->mutex);
+  STaosQnode *pStart = taosWaitQitemsFromQset(qset, TMAX(maxItems, 1), &numOfItems, &memOfItems, &queue);
+  if (pStart == NULL) return 0;
 
-    if (code != 0) break;
-  }
+  taosSetQall(qall, pStart, numOfItems, memOfItems);
+  qinfo->ahandle = queue->ahandle;
+  qinfo->fp = queue->itemFp;
+  qinfo->queue = queue;
+  qinfo->timestamp = pStart->timestamp;
+  uTrace("read %d items from queue:%p, mem:%" PRId64, numOfItems, queue, queue->memOfItems);
+  return numOfItems;
+}
 
-  taosThreadMutexUnlock(&qset->mutex);
-  return code;
+int32_t taosReadAllQitemsFromQset(STaosQset *qset, STaosQall *qall, SQueueInfo *qinfo) {
+  STaosQueue *queue = NULL;
+  int32_t     numOfItems = 0;
+  int64_t     memOfItems = 0;
+
+  STaosQnode *pStart = taosWaitQitemsFromQset(qset, 0, &numOfItems, &memOfItems, &queue);
+  if (pStart == NULL) return 0;
+
+  qall->current = pStart;
+  qall->start = pStart;
+  qall->numOfItems = numOfItems;
+  qall->memOfItems = memOfItems;
+
+  qinfo->ahandle = queue->ahandle;
+  qinfo->fp = queue->itemsFp;
+  qinfo->queue = queue;
+  qinfo->timestamp = pStart->timestamp;
+  uTrace("read %d items from queue:%p, items:0 mem:%" PRId64, numOfItems, queue, queue->memOfItems);
+  return numOfItems;
 }
 
+int32_t taosQsetItemSize(STaosQset *qset) { return atomic_load_32(&qset->numOfItems); }
+
 int32_t taosQallItemSize(STaosQall *qall) { return qall->numOfItems; }
 int64_t taosQallMemSize(STaosQall *qall) { return qall->memOfItems; }
 
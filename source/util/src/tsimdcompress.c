@@ -0,0 +1,575 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * SIMD encoders for simple8b, delta-of-delta timestamp and xor float/double compression.
+ *
+ * The output of every encoder here is byte-identical to the scalar one in tcompression.c. The differences (and
+ * overflow checks) of a batch of values are computed with vector instructions first, then the selector search and
+ * the byte emission run over the precomputed values. Since every failure of the scalar encoders ends up with the
+ * same "copy the raw input" output, the checks can be hoisted out of the emission loop.
+ */
+
+#include "os.h"
+#include "tcompression.h"
+#include "tlog.h"
+#include "ttypes.h"
+
+#if defined(_TD_X86_) && !defined(WINDOWS) && (defined(__GNUC__) || defined(__clang__))
+#define COMPRESS_MULTIVERSION
+#define COMPRESS_TARGET(_t) __attribute__((target(_t)))
+#include <immintrin.h>
+#else
+#define COMPRESS_TARGET(_t)
+#endif
+
+#define SIMPLE8B_MAX_INT64  ((uint64_t)1152921504606846974LL)
+#define COMPRESS_BATCH_SIZE 256  // must be even, the timestamp/float encoders emit values in pairs
+
+#ifdef COMPRESS_MULTIVERSION
+// Selector value:                          0    1    2   3   4   5   6   7   8  9  10 11 12 13 14 15
+static const char    BIT_PER_INTEGER[] = {0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 15, 20, 30, 60};
+static const int32_t SELECTOR_TO_ELEMS[] = {240, 120, 60, 30, 20, 15, 12, 10, 8, 7, 6, 5, 4, 3, 2, 1};
+static const char    BIT_TO_SELECTOR[] = {0,  2,  3,  4,  5,  6,  7,  8,  9,  10, 10, 11, 11, 12, 12, 12,
+                                          13, 13, 13, 13, 13, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 15,
+                                          15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+                                          15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15};
+
+#define BIT_WIDTH(_v)     ((_v) == 0 ? 0 : (LONG_BYTES * BITS_PER_BYTE - BUILDIN_CLZL(_v)))
+#define SELECTOR_OF(_v)   BIT_TO_SELECTOR[BIT_WIDTH(_v)]
+#define ADD_OVERFLOW(_a, _b, _s) ((((_a) ^ (_s)) & ((_b) ^ (_s))) < 0)
+
+static FORCE_INLINE int64_t compressGetInt64(const char *input, int32_t i, const char type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      return *((int8_t *)input + i);
+    case TSDB_DATA_TYPE_SMALLINT:
+      return *((int16_t *)input + i);
+    case TSDB_DATA_TYPE_INT:
+      return *((int32_t *)input + i);
+    default:
+      return *((int64_t *)input + i);
+  }
+}
+
+// zigzag encoded difference between the value i and its predecessor, the one before the first value is 0.
+static FORCE_INLINE uint64_t compressZigzagDelta(const char *input, int32_t i, const char type) {
+  int64_t prev = (i == 0) ? 0 : compressGetInt64(input, i - 1, type);
+  int64_t diff = (int64_t)((uint64_t)compressGetInt64(input, i, type) - (uint64_t)prev);
+  return ZIGZAG_ENCODE(int64_t, diff);
+}
+
+COMPRESS_TARGET("avx2")
+static FORCE_INLINE __m256i compressLoadInt64x4(const char *input, int32_t i, const char type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT: {
+      int32_t v = 0;
+      memcpy(&v, (int8_t *)input + i, sizeof(v));
+      return _mm256_cvtepi8_epi64(_mm_cvtsi32_si128(v));
+    }
+    case TSDB_DATA_TYPE_SMALLINT:
+      return _mm256_cvtepi16_epi64(_mm_loadl_epi64((const __m128i *)((int16_t *)input + i)));
+    case TSDB_DATA_TYPE_INT:
+      return _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)((int32_t *)input + i)));
+    default:
+      return _mm256_loadu_si256((const __m256i *)((int64_t *)input + i));
+  }
+}
+
+COMPRESS_TARGET("avx2")
+static FORCE_INLINE __m256i compressZigzag4(__m256i diff) {
+  // ZIGZAG_ENCODE(T, v) (((u##T)((v) >> (sizeof(T) * 8 - 1))) ^ (((u##T)(v)) << 1))
+  return _mm256_xor_si256(_mm256_slli_epi64(diff, 1), _mm256_cmpgt_epi64(_mm256_setzero_si256(), diff));
+}
+
+// zigzag encoded differences of the values [i, i + 4), i must be larger than 0.
+COMPRESS_TARGET("avx2")
+static FORCE_INLINE __m256i compressZigzagDelta4(const char *input, int32_t i, const char type) {
+  __m256i diff = _mm256_sub_epi64(compressLoadInt64x4(input, i, type), compressLoadInt64x4(input, i - 1, type));
+  return compressZigzag4(diff);
+}
+
+// a + b overflows, given s = a + b computed in wraparound arithmetic.
+COMPRESS_TARGET("avx2")
+static FORCE_INLINE __m256i compressAddOverflow4(__m256i a, __m256i b, __m256i s) {
+  return _mm256_and_si256(_mm256_xor_si256(a, s), _mm256_xor_si256(b, s));
+}
+
+COMPRESS_TARGET("avx2")
+static FORCE_INLINE uint64_t compressOrReduce4(__m256i v) {
+  __m128i  x = _mm_or_si128(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+  uint64_t r = 0;
+  _mm_storel_epi64((__m128i *)&r, _mm_or_si128(x, _mm_unpackhi_epi64(x, x)));
+  return r;
+}
+
+// Whether the scalar simple8b encoder gives up for the input: the difference of two values overflows, or the zigzag
+// encoded difference is too large to be held in one block. Only bigint can hit either of them.
+COMPRESS_TARGET("avx2")
+static bool compressIntOutOfRange(const char *input, const int32_t nelements, const char type) {
+  if (type != TSDB_DATA_TYPE_BIGINT) {
+    return false;
+  }
+
+  const int64_t *p = (const int64_t *)input;
+  __m256i        signBit = _mm256_set1_epi64x(INT64_MIN);
+  __m256i        maxVal = _mm256_set1_epi64x((int64_t)((SIMPLE8B_MAX_INT64 - 1) ^ (uint64_t)INT64_MIN));
+  __m256i        overflow = _mm256_setzero_si256();
+  __m256i        tooLarge = _mm256_setzero_si256();
+
+  int32_t i = 1;
+  for (; i + 4 <= nelements; i += 4) {
+    __m256i curr = _mm256_loadu_si256((const __m256i *)(p + i));
+    __m256i prev = _mm256_loadu_si256((const __m256i *)(p + i - 1));
+    __m256i diff = _mm256_sub_epi64(curr, prev);
+    overflow = _mm256_or_si256(
+        overflow, compressAddOverflow4(curr, _mm256_sub_epi64(_mm256_setzero_si256(), prev), diff));
+
+    // unsigned zigzag >= SIMPLE8B_MAX_INT64
+    __m256i zigzag = _mm256_xor_si256(compressZigzag4(diff), signBit);
+    tooLarge = _mm256_or_si256(tooLarge, _mm256_cmpgt_epi64(zigzag, maxVal));
+  }
+
+  if (_mm256_movemask_pd(_mm256_castsi256_pd(overflow)) != 0 || !_mm256_testz_si256(tooLarge, tooLarge)) {
+    return true;
+  }
+
+  // the first value and the remains
+  for (int32_t j = 0; j < nelements; j = (j == 0) ? i : j + 1) {
+    int64_t prev = (j == 0) ? 0 : p[j - 1];
+    int64_t diff = (int64_t)((uint64_t)p[j] - (uint64_t)prev);
+    if (ADD_OVERFLOW(p[j], (int64_t)(0 - (uint64_t)prev), diff) ||
+        ZIGZAG_ENCODE(int64_t, diff) >= SIMPLE8B_MAX_INT64) {
+      return true;
+    }
+  }
+
+  return false;
+}
+#endif
+
+COMPRESS_TARGET("avx2")
+int32_t tsCompressIntImplAvx2(const char *const input, const int32_t nelements, char *const output, const char type) {
+#ifdef COMPRESS_MULTIVERSION
+  int32_t word_length = getWordLength(type);
+  if (word_length < 0) {
+    return tsCompressIntImpl_Scalar(input, nelements, output, type);
+  }
+
+  int32_t byte_limit = nelements * word_length + 1;
+  int32_t opos = 1;
+
+  if (compressIntOutOfRange(input, nelements, type)) {
+    goto _copy_and_exit;
+  }
+
+  for (int32_t i = 0; i < nelements;) {
+    // Selector search. The widest value decides the selector, so the block can hold one more value as long as the
+    // bit width of all values or'ed together leaves room for it. Try four values at a time first.
+    uint64_t orVal = 0;
+    int32_t  elems = 0;
+    bool     full = false;
+
+    for (int32_t j = i; j < nelements;) {
+      if (j > 0 && j + 4 <= nelements) {
+        uint64_t v = orVal | compressOrReduce4(compressZigzagDelta4(input, j, type));
+        if (elems + 4 <= SELECTOR_TO_ELEMS[(int32_t)SELECTOR_OF(v)]) {
+          orVal = v;
+          elems += 4;
+          j += 4;
+          continue;
+        }
+      }
+
+      uint64_t v = orVal | compressZigzagDelta(input, j, type);
+      if (elems + 1 > SELECTOR_TO_ELEMS[(int32_t)SELECTOR_OF(v)]) {
+        full = true;
+        break;
+      }
+      orVal = v;
+      elems++;
+      j++;
+    }
+
+    int32_t selector = SELECTOR_OF(orVal);
+    if (full) {
+      // if cannot hold another one.
+      while (elems < SELECTOR_TO_ELEMS[selector]) selector++;
+      elems = SELECTOR_TO_ELEMS[selector];
+    }
+
+    int32_t  bit = BIT_PER_INTEGER[selector];
+    uint64_t buffer = (uint64_t)selector;
+    if (bit > 0) {
+      int32_t k = 0;
+      if (i == 0) {
+        buffer |= compressZigzagDelta(input, 0, type) << 4;
+        k = 1;
+      }
+
+      __m256i shiftBits = _mm256_set_epi64x(bit * (k + 3) + 4, bit * (k + 2) + 4, bit * (k + 1) + 4, bit * k + 4);
+      __m256i inc = _mm256_set1_epi64x(bit << 2);
+      __m256i packed = _mm256_setzero_si256();
+      for (; k + 4 <= elems; k += 4) {
+        packed = _mm256_or_si256(packed, _mm256_sllv_epi64(compressZigzagDelta4(input, i + k, type), shiftBits));
+        shiftBits = _mm256_add_epi64(shiftBits, inc);
+      }
+      buffer |= compressOrReduce4(packed);
+
+      for (; k < elems; k++) {
+        buffer |= compressZigzagDelta(input, i + k, type) << (bit * k + 4);
+      }
+    }
+
+    // Output the encoded value to the output.
+    if (opos + sizeof(buffer) <= byte_limit) {
+      memcpy(output + opos, &buffer, sizeof(buffer));
+      opos += sizeof(buffer);
+    } else {
+      goto _copy_and_exit;
+    }
+    i += elems;
+  }
+
+  // set the indicator.
+  output[0] = 0;
+  return opos;
+
+_copy_and_exit:
+  output[0] = 1;
+  memcpy(output + 1, input, byte_limit - 1);
+  return byte_limit;
+#else
+  return tsCompressIntImpl_Scalar(input, nelements, output, type);
+#endif
+}
+
+#ifdef COMPRESS_MULTIVERSION
+// Zigzag encoded delta of delta of the timestamps [start, start + num). Before the first timestamp, the value is
+// regarded as the first timestamp itself and the delta as its negation, the same as the scalar encoder does.
+// Return false if any of the differences overflows.
+COMPRESS_TARGET("avx2")
+static bool compressTimestampDod(const int64_t *istream, int32_t start, int32_t num, uint64_t *zz) {
+  int32_t k = 0;
+  for (; k < num && start + k < 2; ++k) {
+    int32_t i = start + k;
+    int64_t prevValue = istream[0];
+    int64_t prevDelta = (i == 0) ? (int64_t)(0 - (uint64_t)istream[0]) : 0;
+
+    int64_t currDelta = (int64_t)((uint64_t)istream[i] - (uint64_t)prevValue);
+    if (ADD_OVERFLOW(istream[i], (int64_t)(0 - (uint64_t)prevValue), currDelta)) return false;
+    int64_t dod = (int64_t)((uint64_t)currDelta - (uint64_t)prevDelta);
+    if (ADD_OVERFLOW(currDelta, (int64_t)(0 - (uint64_t)prevDelta), dod)) return false;
+    zz[k] = ZIGZAG_ENCODE(int64_t, dod);
+  }
+
+  __m256i overflow = _mm256_setzero_si256();
+  for (; k + 4 <= num; k += 4) {
+    const int64_t *p = istream + start + k;
+
+    __m256i curr = _mm256_loadu_si256((const __m256i *)p);
+    __m256i prev = _mm256_loadu_si256((const __m256i *)(p - 1));
+    __m256i prev2 = _mm256_loadu_si256((const __m256i *)(p - 2));
+
+    __m256i currDelta = _mm256_sub_epi64(curr, prev);
+    __m256i prevDelta = _mm256_sub_epi64(prev, prev2);
+    __m256i dod = _mm256_sub_epi64(currDelta, prevDelta);
+    overflow = _mm256_or_si256(
+        overflow, compressAddOverflow4(curr, _mm256_sub_epi64(_mm256_setzero_si256(), prev), currDelta));
+    overflow = _mm256_or_si256(
+        overflow, compressAddOverflow4(currDelta, _mm256_sub_epi64(_mm256_setzero_si256(), prevDelta), dod));
+
+    _mm256_storeu_si256((__m256i *)(zz + k), compressZigzag4(dod));
+  }
+
+  if (_mm256_movemask_pd(_mm256_castsi256_pd(overflow)) != 0) return false;
+
+  for (; k < num; ++k) {
+    const int64_t *p = istream + start + k;
+
+    int64_t currDelta = (int64_t)((uint64_t)p[0] - (uint64_t)p[-1]);
+    int64_t prevDelta = (int64_t)((uint64_t)p[-1] - (uint64_t)p[-2]);
+    int64_t dod = (int64_t)((uint64_t)currDelta - (uint64_t)prevDelta);
+    if (ADD_OVERFLOW(p[0], (int64_t)(0 - (uint64_t)p[-1]), currDelta)) return false;
+    if (ADD_OVERFLOW(currDelta, (int64_t)(0 - (uint64_t)prevDelta), dod)) return false;
+    zz[k] = ZIGZAG_ENCODE(int64_t, dod);
+  }
+
+  return true;
+}
+
+// Append the low nbytes of the value. A whole word is stored when it fits in the limit, the bytes beyond nbytes are
+// either overwritten later or beyond the returned length.
+static FORCE_INLINE void compressPutBytes(char *const output, int32_t *pos, int32_t limit, uint64_t val,
+                                          int32_t nbytes, int32_t wordBytes) {
+  if (*pos + wordBytes <= limit) {
+    memcpy(output + *pos, &val, wordBytes);
+  } else {
+    memcpy(output + *pos, &val, nbytes);
+  }
+  *pos += nbytes;
+}
+#endif
+
+COMPRESS_TARGET("avx2")
+int32_t tsCompressTimestampImplAvx2(const char *const input, const int32_t nelements, char *const output) {
+#ifdef COMPRESS_MULTIVERSION
+  ASSERTS(nelements >= 0, "nelements is negative");
+
+  if (nelements == 0) return 0;
+
+  int64_t *istream = (int64_t *)input;
+  int32_t  limit = nelements * LONG_BYTES;
+  int32_t  _pos = 1;
+  uint64_t zz[COMPRESS_BATCH_SIZE];
+
+  if (istream[0] < 0) {
+    uWarn("compression timestamp is over signed long long range. ts = 0x%" PRIx64 " \n", istream[0]);
+    goto _exit_over;
+  }
+
+  for (int32_t start = 0; start < nelements; start += COMPRESS_BATCH_SIZE) {
+    int32_t num = TMIN(COMPRESS_BATCH_SIZE, nelements - start);
+    if (!compressTimestampDod(istream, start, num, zz)) goto _exit_over;
+
+    for (int32_t k = 0; k < num; k += 2) {
+      uint64_t dd1 = zz[k];
+      uint64_t dd2 = (k + 1 < num) ? zz[k + 1] : 0;
+      uint8_t  flag1 = (dd1 == 0) ? 0 : (uint8_t)(LONG_BYTES - BUILDIN_CLZL(dd1) / BITS_PER_BYTE);
+      uint8_t  flag2 = (dd2 == 0) ? 0 : (uint8_t)(LONG_BYTES - BUILDIN_CLZL(dd2) / BITS_PER_BYTE);
+
+      // Encode the flag.
+      if (_pos >= limit) goto _exit_over;
+      output[_pos++] = (char)(flag1 | (flag2 << 4));
+
+      // Encode dd1
+      if ((_pos + flag1 - 1) >= limit) goto _exit_over;
+      compressPutBytes(output, &_pos, limit, dd1, flag1, LONG_BYTES);
+
+      // Encode dd2
+      if (k + 1 < num) {
+        if ((_pos + flag2 - 1) >= limit) goto _exit_over;
+        compressPutBytes(output, &_pos, limit, dd2, flag2, LONG_BYTES);
+      }
+    }
+  }
+
+  output[0] = 1;  // Means the string is compressed
+  return _pos;
+
+_exit_over:
+  output[0] = 0;  // Means the string is not compressed
+  memcpy(output + 1, input, nelements * LONG_BYTES);
+  return nelements * LONG_BYTES + 1;
+#else
+  return tsCompressTimestampImpl_Scalar(input, nelements, output);
+#endif
+}
+
+#ifdef COMPRESS_MULTIVERSION
+// xor between each value and its predecessor, the one before the first value is 0.
+COMPRESS_TARGET("avx2")
+static void compressXorDiff64(const uint64_t *bits, int32_t start, int32_t num, uint64_t *diff) {
+  int32_t k = 0;
+  if (start == 0 && num > 0) {
+    diff[k++] = bits[0];
+  }
+  for (; k + 4 <= num; k += 4) {
+    __m256i curr = _mm256_loadu_si256((const __m256i *)(bits + start + k));
+    __m256i prev = _mm256_loadu_si256((const __m256i *)(bits + start + k - 1));
+    _mm256_storeu_si256((__m256i *)(diff + k), _mm256_xor_si256(curr, prev));
+  }
+  for (; k < num; ++k) {
+    diff[k] = bits[start + k] ^ bits[start + k - 1];
+  }
+}
+
+COMPRESS_TARGET("avx2")
+static void compressXorDiff32(const uint32_t *bits, int32_t start, int32_t num, uint32_t *diff) {
+  int32_t k = 0;
+  if (start == 0 && num > 0) {
+    diff[k++] = bits[0];
+  }
+  for (; k + 8 <= num; k += 8) {
+    __m256i curr = _mm256_loadu_si256((const __m256i *)(bits + start + k));
+    __m256i prev = _mm256_loadu_si256((const __m256i *)(bits + start + k - 1));
+    _mm256_storeu_si256((__m256i *)(diff + k), _mm256_xor_si256(curr, prev));
+  }
+  for (; k < num; ++k) {
+    diff[k] = bits[start + k] ^ bits[start + k - 1];
+  }
+}
+
+static FORCE_INLINE uint8_t compressDoubleFlag(uint64_t diff) {
+  if (diff == 0) return 0;
+
+  int32_t trailing_zeros = BUILDIN_CTZL(diff);
+  int32_t leading_zeros = BUILDIN_CLZL(diff);
+  uint8_t nbytes = 0;
+  if (trailing_zeros > leading_zeros) {
+    nbytes = (uint8_t)(LONG_BYTES - trailing_zeros / BITS_PER_BYTE);
+    if (nbytes > 0) nbytes--;
+    return ((uint8_t)1 << 3) | nbytes;
+  } else {
+    nbytes = (uint8_t)(LONG_BYTES - leading_zeros / BITS_PER_BYTE);
+    if (nbytes > 0) nbytes--;
+    return nbytes;
+  }
+}
+
+static FORCE_INLINE uint8_t compressFloatFlag(uint32_t diff) {
+  if (diff == 0) return 0;
+
+  int32_t ctz = BUILDIN_CTZ(diff);
+  int32_t clz = BUILDIN_CLZ(diff);
+  uint8_t nbytes = 0;
+  if (ctz > clz) {
+    nbytes = (uint8_t)(FLOAT_BYTES - ctz / BITS_PER_BYTE);
+    if (nbytes > 0) nbytes--;
+    return ((uint8_t)1 << 3) | nbytes;
+  } else {
+    nbytes = (uint8_t)(FLOAT_BYTES - clz / BITS_PER_BYTE);
+    if (nbytes > 0) nbytes--;
+    return nbytes;
+  }
+}
+#endif
+
+COMPRESS_TARGET("avx2")
+int32_t tsCompressDoubleImplAvx2(const char *const input, const int32_t nelements, char *const output) {
+#ifdef COMPRESS_MULTIVERSION
+  const uint64_t *istream = (const uint64_t *)input;
+  int32_t         byte_limit = nelements * DOUBLE_BYTES + 1;
+  int32_t         opos = 1;
+  uint64_t        diff[COMPRESS_BATCH_SIZE];
+
+  for (int32_t start = 0; start < nelements; start += COMPRESS_BATCH_SIZE) {
+    int32_t num = TMIN(COMPRESS_BATCH_SIZE, nelements - start);
+    compressXorDiff64(istream, start, num, diff);
+
+    for (int32_t k = 0; k < num; k += 2) {
+      uint64_t diff1 = diff[k];
+      uint64_t diff2 = (k + 1 < num) ? diff[k + 1] : 0;
+      uint8_t  flag1 = compressDoubleFlag(diff1);
+      uint8_t  flag2 = (k + 1 < num) ? compressDoubleFlag(diff2) : 0;
+      int32_t  nbyte1 = (flag1 & INT8MASK(3)) + 1;
+      int32_t  nbyte2 = (flag2 & INT8MASK(3)) + 1;
+
+      if (opos + 1 + nbyte1 + nbyte2 > byte_limit) {
+        output[0] = 1;
+        memcpy(output + 1, input, byte_limit - 1);
+        return byte_limit;
+      }
+
+      output[opos++] = (char)(flag1 | (flag2 << 4));
+      compressPutBytes(output, &opos, byte_limit, diff1 >> ((DOUBLE_BYTES - nbyte1) * BITS_PER_BYTE * (flag1 >> 3)),
+                       nbyte1, DOUBLE_BYTES);
+      compressPutBytes(output, &opos, byte_limit, diff2 >> ((DOUBLE_BYTES - nbyte2) * BITS_PER_BYTE * (flag2 >> 3)),
+                       nbyte2, DOUBLE_BYTES);
+    }
+  }
+
+  output[0] = 0;
+  return opos;
+#else
+  return tsCompressDoubleImpl_Scalar(input, nelements, output);
+#endif
+}
+
+COMPRESS_TARGET("avx2")
+int32_t tsCompressFloatImplAvx2(const char *const input, const int32_t nelements, char *const output) {
+#ifdef COMPRESS_MULTIVERSION
+  const uint32_t *istream = (const uint32_t *)input;
+  int32_t         byte_limit = nelements * FLOAT_BYTES + 1;
+  int32_t         opos = 1;
+  uint32_t        diff[COMPRESS_BATCH_SIZE];
+
+  for (int32_t start = 0; start < nelements; start += COMPRESS_BATCH_SIZE) {
+    int32_t num = TMIN(COMPRESS_BATCH_SIZE, nelements - start);
+    compressXorDiff32(istream, start, num, diff);
+
+    for (int32_t k = 0; k < num; k += 2) {
+      uint32_t diff1 = diff[k];
+      uint32_t diff2 = (k + 1 < num) ? diff[k + 1] : 0;
+      uint8_t  flag1 = compressFloatFlag(diff1);
+      uint8_t  flag2 = (k + 1 < num) ? compressFloatFlag(diff2) : 0;
+      int32_t  nbyte1 = (flag1 & INT8MASK(3)) + 1;
+      int32_t  nbyte2 = (flag2 & INT8MASK(3)) + 1;
+
+      if (opos + 1 + nbyte1 + nbyte2 > byte_limit) {
+        output[0] = 1;
+        memcpy(output + 1, input, byte_limit - 1);
+        return byte_limit;
+      }
+
+      output[opos++] = (char)(flag1 | (flag2 << 4));
+      compressPutBytes(output, &opos, byte_limit, diff1 >> ((FLOAT_BYTES - nbyte1) * BITS_PER_BYTE * (flag1 >> 3)),
+                       nbyte1, FLOAT_BYTES);
+      compressPutBytes(output, &opos, byte_limit, diff2 >> ((FLOAT_BYTES - nbyte2) * BITS_PER_BYTE * (flag2 >> 3)),
+                       nbyte2, FLOAT_BYTES);
+    }
+  }
+
+  output[0] = 0;
+  return opos;
+#else
+  return tsCompressFloatImpl_Scalar(input, nelements, output);
+#endif
+}
+
+static const SCompressKernel compressKernels[COMPRESS_KERNEL_MAX] = {
+    [COMPRESS_KERNEL_SCALAR] = {"scalar", tsCompressIntImpl_Scalar, tsCompressTimestampImpl_Scalar,
+                                tsCompressFloatImpl_Scalar, tsCompressDoubleImpl_Scalar},
+    [COMPRESS_KERNEL_SSE42] = {"sse4.2", tsCompressIntImpl_Scalar, tsCompressTimestampImpl_Scalar,
+                               tsCompressFloatImpl_Scalar, tsCompressDoubleImpl_Scalar},
+    [COMPRESS_KERNEL_AVX2] = {"avx2", tsCompressIntImplAvx2, tsCompressTimestampImplAvx2, tsCompressFloatImplAvx2,
+                              tsCompressDoubleImplAvx2},
+    [COMPRESS_KERNEL_AVX512] = {"avx512", tsCompressIntImplAvx2, tsCompressTimestampImplAvx2,
+                                tsCompressFloatImplAvx2, tsCompressDoubleImplAvx2},
+};
+
+const SCompressKernel *tsCompressKernel = &compressKernels[COMPRESS_KERNEL_SCALAR];
+
+const SCompressKernel *tsGetCompressKernel(ECompressKernel kernel) {
+  if (kernel < COMPRESS_KERNEL_SCALAR || kernel >= COMPRESS_KERNEL_MAX) {
+    return NULL;
+  }
+  return &compressKernels[kernel];
+}
+
+int32_t tsSetCompressKernel(ECompressKernel kernel) {
+  tsInitCompressKernels();  // so that the kernel set here is not replaced on the first use
+  if (!tsCompressKernelSupported(kernel)) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  tsCompressKernel = &compressKernels[kernel];
+  return TSDB_CODE_SUCCESS;
+}
+
+ECompressKernel tsSelectCompressKernel() {
+  ECompressKernel kernel = COMPRESS_KERNEL_SCALAR;
+  if (tsSIMDEnable) {
+    for (int32_t i = COMPRESS_KERNEL_MAX - 1; i > COMPRESS_KERNEL_SCALAR; --i) {
+      if (tsCompressKernelSupported(i)) {
+        kernel = i;
+        break;
+      }
+    }
+  }
+
+  tsCompressKernel = &compressKernels[kernel];
+  return kernel;
+}
@@ -74,35 +74,54 @@ static void *tQWorkerThreadFp(SQueueWorker *worker) {
   SQueueInfo    qinfo = {0};
   void         *msg = NULL;
   int32_t       code = 0;
+  int32_t       numOfMsgs = 0;
 
   taosBlockSIGPIPE();
   setThreadName(pool->name);
   worker->pid = taosGetSelfPthreadId();
   uInfo("worker:%s:%d is running, thread:%08" PRId64, pool->name, worker->id, worker->pid);
 
+  STaosQall *qall = taosAllocateQall();
+  if (qall == NULL) {
+    uError("worker:%s:%d failed to allocate qall since %s", pool->name, worker->id, terrstr());
+    return NULL;
+  }
+
   while (1) {
-    if (taosReadQitemFromQset(pool->qset, (void **)&msg, &qinfo) == 0) {
+    // take a batch only when there are enough messages for all workers, so that no worker is idle
+    int32_t batchSize = 1;
+    if (pool->batchSize > 1) {
+      batchSize = TMIN(pool->batchSize, taosQsetItemSize(pool->qset) / TMAX(pool->num, 1) + 1);
+    }
+    numOfMsgs = taosReadQitemsFromQset(pool->qset, qall, batchSize, &qinfo);
+    if (numOfMsgs == 0) {
       uInfo("worker:%s:%d qset:%p, got no message and exiting, thread:%08" PRId64, pool->name, worker->id, pool->qset,
             worker->pid);
       break;
     }
 
-    if (qinfo.timestamp != 0) {
-      int64_t cost = taosGetTimestampUs() - qinfo.timestamp;
-      if (cost > QUEUE_THRESHOLD) {
-        uWarn("worker:%s,message has been queued for too long, cost: %" PRId64 "s", pool->name, cost / QUEUE_THRESHOLD);
+    for (int32_t i = 0; i < numOfMsgs; ++i) {
+      (void)taosGetQitem(qall, &msg);
+      qinfo.timestamp = ((STaosQnode *)((char *)msg - sizeof(STaosQnode)))->timestamp;
+      if (qinfo.timestamp != 0) {
+        int64_t cost = taosGetTimestampUs() - qinfo.timestamp;
+        if (cost > QUEUE_THRESHOLD) {
+          uWarn("worker:%s,message has been queued for too long, cost: %" PRId64 "s", pool->name,
+                cost / QUEUE_THRESHOLD);
+        }
       }
-    }
 
-    if (qinfo.fp != NULL) {
-      qinfo.workerId = worker->id;
-      qinfo.threadNum = pool->num;
-      (*((FItem)qinfo.fp))(&qinfo, msg);
-    }
+      if (qinfo.fp != NULL) {
+        qinfo.workerId = worker->id;
+        qinfo.threadNum = pool->num;
+        (*((FItem)qinfo.fp))(&qinfo, msg);
+      }
 
-    taosUpdateItemSize(qinfo.queue, 1);
+      taosUpdateItemSize(qinfo.queue, 1);
+    }
   }
 
+  taosFreeQall(qall);
   destroyThreadLocalGeosCtx();
   DestoryThreadLocalRegComp();
 
@@ -437,6 +456,7 @@ int32_t tSingleWorkerInit(SSingleWorker *pWorker, const SSingleWorkerCfg *pCfg)
   pPool->name = pCfg->name;
   pPool->min = pCfg->min;
   pPool->max = pCfg->max;
+  pPool->batchSize = pCfg->batchSize;
   if (tQWorkerInit(pPool) != 0) return -1;
 
   pWorker->queue = tQWorkerAllocQueue(pPool, pCfg->param, pCfg->fp);
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Encode and decode throughput of every compress kernel supported by the host, e.g.
+//   decompressBench [numOfRows] [loops]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "os.h"
+#include "tcompression.h"
+#include "ttypes.h"
+
+typedef int32_t (*__compress_fn_t)(void *pIn, int32_t nIn, int32_t nEle, void *pOut, int32_t nOut, uint8_t cmprAlg,
+                                   void *pBuf, int32_t nBuf);
+
+typedef struct {
+  int8_t          type;
+  __compress_fn_t compressFn;
+  __compress_fn_t decompressFn;
+} SBenchType;
+
+static SBenchType benchTypes[] = {
+    {TSDB_DATA_TYPE_TIMESTAMP, tsCompressTimestamp, tsDecompressTimestamp},
+    {TSDB_DATA_TYPE_BIGINT, tsCompressBigint, tsDecompressBigint},
+    {TSDB_DATA_TYPE_INT, tsCompressInt, tsDecompressInt},
+    {TSDB_DATA_TYPE_SMALLINT, tsCompressSmallint, tsDecompressSmallint},
+    {TSDB_DATA_TYPE_TINYINT, tsCompressTinyint, tsDecompressTinyint},
+    {TSDB_DATA_TYPE_FLOAT, tsCompressFloat, tsDecompressFloat},
+    {TSDB_DATA_TYPE_DOUBLE, tsCompressDouble, tsDecompressDouble},
+};
+
+static void genBenchData(int8_t type, char *pData, int32_t num) {
+  uint32_t seed = 100;
+  int64_t  val = 1700000000000;
+
+  for (int32_t i = 0; i < num; ++i) {
+    val += taosRandR(&seed) % 10;
+    switch (type) {
+      case TSDB_DATA_TYPE_TIMESTAMP:
+      case TSDB_DATA_TYPE_BIGINT:
+        ((int64_t *)pData)[i] = val;
+        break;
+      case TSDB_DATA_TYPE_INT:
+        ((int32_t *)pData)[i] = (int32_t)val;
+        break;
+      case TSDB_DATA_TYPE_SMALLINT:
+        ((int16_t *)pData)[i] = (int16_t)(taosRandR(&seed) % 1000);
+        break;
+      case TSDB_DATA_TYPE_TINYINT:
+        ((int8_t *)pData)[i] = (int8_t)(taosRandR(&seed) % 100);
+        break;
+      case TSDB_DATA_TYPE_FLOAT:
+        ((float *)pData)[i] = 220.0f + (taosRandR(&seed) % 100) / 10.0f;
+        break;
+      case TSDB_DATA_TYPE_DOUBLE:
+        ((double *)pData)[i] = 220.0 + (taosRandR(&seed) % 100) / 10.0;
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+int main(int argc, char *argv[]) {
+  int32_t num = (argc > 1) ? atoi(argv[1]) : 4096;
+  int32_t loops = (argc > 2) ? atoi(argv[2]) : 20000;
+
+  taosGetSystemInfo();
+
+  int32_t size = num * sizeof(int64_t);
+  char   *pData = (char *)taosMemoryMalloc(size);
+  char   *pComp = (char *)taosMemoryMalloc(size + 64);
+  char   *pOutput = (char *)taosMemoryMalloc(size + 64);
+  if (pData == NULL || pComp == NULL || pOutput == NULL) {
+    printf("failed to allocate memory\n");
+    return -1;
+  }
+
+  printf("%-10s %-8s %-6s %12s %10s\n", "type", "kernel", "stage", "elapsed(us)", "GB/s");
+  for (int32_t i = 0; i < sizeof(benchTypes) / sizeof(benchTypes[0]); ++i) {
+    SBenchType *pType = &benchTypes[i];
+    int32_t     bytes = num * tDataTypes[pType->type].bytes;
+
+    genBenchData(pType->type, pData, num);
+
+    int32_t len = 0;
+    for (int32_t k = COMPRESS_KERNEL_SCALAR; k < COMPRESS_KERNEL_MAX; ++k) {
+      if (tsSetCompressKernel((ECompressKernel)k) != 0) {
+        continue;
+      }
+
+      int64_t st = taosGetTimestampUs();
+      for (int32_t j = 0; j < loops; ++j) {
+        len = pType->compressFn(pData, bytes, num, pComp, size + 64, ONE_STAGE_COMP, NULL, 0);
+      }
+      int64_t el = taosGetTimestampUs() - st;
+
+      double gbps = (el > 0) ? ((double)bytes * loops) / el / 1000.0 : 0;
+      printf("%-10s %-8s %-6s %12" PRId64 " %10.3f\n", tDataTypes[pType->type].name,
+             tsGetCompressKernel((ECompressKernel)k)->name, "encode", el, gbps);
+    }
+
+    for (int32_t k = COMPRESS_KERNEL_SCALAR; k < COMPRESS_KERNEL_MAX; ++k) {
+      if (tsSetDecompressKernel((ECompressKernel)k) != 0) {
+        continue;
+      }
+
+      int64_t st = taosGetTimestampUs();
+      for (int32_t j = 0; j < loops; ++j) {
+        pType->decompressFn(pComp, len, num, pOutput, size + 64, ONE_STAGE_COMP, NULL, 0);
+      }
+      int64_t el = taosGetTimestampUs() - st;
+
+      if (memcmp(pData, pOutput, bytes) != 0) {
+        printf("%-10s %-8s decoded data mismatch\n", tDataTypes[pType->type].name,
+               tsGetDecompressKernel((ECompressKernel)k)->name);
+        continue;
+      }
+
+      double gbps = (el > 0) ? ((double)bytes * loops) / el / 1000.0 : 0;
+      printf("%-10s %-8s %-6s %12" PRId64 " %10.3f\n", tDataTypes[pType->type].name,
+             tsGetDecompressKernel((ECompressKernel)k)->name, "decode", el, gbps);
+    }
+  }
+
+  taosMemoryFree(pData);
+  taosMemoryFree(pComp);
+  taosMemoryFree(pOutput);
+  return 0;
+}
@@ -140,6 +140,154 @@ void compressImplTest(void* pVal, int8_t type, int32_t sz, uint32_t cmprAlg) {
   }
 }
 
+TEST(utilTest, decompress_kernel_test) {
+  int32_t num = 1027;
+
+  taosGetSystemInfo();
+
+  int64_t* pList = static_cast<int64_t*>(taosMemoryCalloc(num, sizeof(int64_t)));
+  char*    px = static_cast<char*>(taosMemoryMalloc(num * sizeof(int64_t) + 64));
+  char*    pOutput = static_cast<char*>(taosMemoryMalloc(num * sizeof(int64_t)));
+
+  uint32_t v = 100;
+  int64_t  iniVal = 1700000000;
+  for (int32_t i = 0; i < num; ++i) {
+    iniVal += taosRandR(&v) % 1000 - 300;
+    pList[i] = iniVal;
+  }
+
+  int32_t tsLen = tsCompressTimestamp(pList, num * sizeof(int64_t), num, px, num * sizeof(int64_t) + 64,
+                                      ONE_STAGE_COMP, NULL, 0);
+  for (int32_t k = COMPRESS_KERNEL_SCALAR; k < COMPRESS_KERNEL_MAX; ++k) {
+    if (tsSetDecompressKernel((ECompressKernel)k) != 0) continue;
+
+    memset(pOutput, 0, num * sizeof(int64_t));
+    tsDecompressTimestamp(px, tsLen, num, pOutput, num * sizeof(int64_t), ONE_STAGE_COMP, NULL, 0);
+    ASSERT_EQ(memcmp(pList, pOutput, num * sizeof(int64_t)), 0) << tsGetDecompressKernel((ECompressKernel)k)->name;
+  }
+
+  int32_t intLen =
+      tsCompressBigint(pList, num * sizeof(int64_t), num, px, num * sizeof(int64_t) + 64, ONE_STAGE_COMP, NULL, 0);
+  for (int32_t k = COMPRESS_KERNEL_SCALAR; k < COMPRESS_KERNEL_MAX; ++k) {
+    if (tsSetDecompressKernel((ECompressKernel)k) != 0) continue;
+
+    memset(pOutput, 0, num * sizeof(int64_t));
+    tsDecompressBigint(px, intLen, num, pOutput, num * sizeof(int64_t), ONE_STAGE_COMP, NULL, 0);
+    ASSERT_EQ(memcmp(pList, pOutput, num * sizeof(int64_t)), 0) << tsGetDecompressKernel((ECompressKernel)k)->name;
+  }
+
+  tsSetDecompressKernel(COMPRESS_KERNEL_SCALAR);
+  taosMemoryFree(pList);
+  taosMemoryFree(px);
+  taosMemoryFree(pOutput);
+}
+
+typedef int32_t (*__kernel_compress_fn_t)(void* pIn, int32_t nIn, int32_t nEle, void* pOut, int32_t nOut,
+                                          uint8_t cmprAlg, void* pBuf, int32_t nBuf);
+
+static void genKernelFuzzData(char* pData, int8_t type, int32_t num, int32_t mode, uint32_t* seed) {
+  int64_t val = taosRandR(seed) % 1000000;
+  for (int32_t i = 0; i < num; ++i) {
+    switch (mode) {
+      case 0:  // regular interval
+        val += 1000;
+        break;
+      case 1:  // small jitter
+        val += taosRandR(seed) % 10 - 3;
+        break;
+      case 2:  // long runs with sparse jumps
+        val = (taosRandR(seed) % 64 == 0) ? ((int64_t)taosRandR(seed) << 20) : val;
+        break;
+      case 3:  // random bit width, exercise all selectors
+        val = (int64_t)(((uint64_t)taosRandR(seed) << 32 | taosRandR(seed)) & ((1ull << (taosRandR(seed) % 63)) - 1));
+        break;
+      default:  // full range, overflow of the differences
+        val = (int64_t)((uint64_t)taosRandR(seed) << 40 ^ (uint64_t)taosRandR(seed) << 9 ^ taosRandR(seed));
+        break;
+    }
+
+    switch (type) {
+      case TSDB_DATA_TYPE_TINYINT:
+        ((int8_t*)pData)[i] = (int8_t)val;
+        break;
+      case TSDB_DATA_TYPE_SMALLINT:
+        ((int16_t*)pData)[i] = (int16_t)val;
+        break;
+      case TSDB_DATA_TYPE_INT:
+        ((int32_t*)pData)[i] = (int32_t)val;
+        break;
+      case TSDB_DATA_TYPE_FLOAT:
+        ((float*)pData)[i] = (mode == 4) ? *(float*)&val : (float)(val % 100000) / 8;
+        break;
+      case TSDB_DATA_TYPE_DOUBLE:
+        ((double*)pData)[i] = (mode == 4) ? *(double*)&val : (double)val / 3;
+        break;
+      default:
+        ((int64_t*)pData)[i] = val;
+        break;
+    }
+  }
+}
+
+TEST(utilTest, compress_kernel_fuzz_test) {
+  struct {
+    int8_t                 type;
+    __kernel_compress_fn_t compressFn;
+    __kernel_compress_fn_t decompressFn;
+  } fuzzTypes[] = {
+      {TSDB_DATA_TYPE_TIMESTAMP, tsCompressTimestamp, tsDecompressTimestamp},
+      {TSDB_DATA_TYPE_BIGINT, tsCompressBigint, tsDecompressBigint},
+      {TSDB_DATA_TYPE_INT, tsCompressInt, tsDecompressInt},
+      {TSDB_DATA_TYPE_SMALLINT, tsCompressSmallint, tsDecompressSmallint},
+      {TSDB_DATA_TYPE_TINYINT, tsCompressTinyint, tsDecompressTinyint},
+      {TSDB_DATA_TYPE_FLOAT, tsCompressFloat, tsDecompressFloat},
+      {TSDB_DATA_TYPE_DOUBLE, tsCompressDouble, tsDecompressDouble},
+  };
+
+  taosGetSystemInfo();
+
+  int32_t  maxNum = 2000;
+  int32_t  size = maxNum * sizeof(int64_t) + 64;
+  char*    pData = static_cast<char*>(taosMemoryMalloc(size));
+  char*    pRef = static_cast<char*>(taosMemoryMalloc(size));
+  char*    pComp = static_cast<char*>(taosMemoryMalloc(size));
+  char*    pOutput = static_cast<char*>(taosMemoryMalloc(size));
+  uint32_t seed = 1024;
+
+  for (int32_t loop = 0; loop < 1000; ++loop) {
+    int32_t num = 1 + taosRandR(&seed) % ((loop % 4 == 0) ? 16 : maxNum);
+    int32_t mode = loop % 5;
+
+    for (int32_t i = 0; i < sizeof(fuzzTypes) / sizeof(fuzzTypes[0]); ++i) {
+      int8_t  type = fuzzTypes[i].type;
+      int32_t bytes = num * tDataTypes[type].bytes;
+      genKernelFuzzData(pData, type, num, mode, &seed);
+
+      ASSERT_EQ(tsSetCompressKernel(COMPRESS_KERNEL_SCALAR), 0);
+      int32_t refLen = fuzzTypes[i].compressFn(pData, bytes, num, pRef, size, ONE_STAGE_COMP, NULL, 0);
+
+      for (int32_t k = COMPRESS_KERNEL_SCALAR + 1; k < COMPRESS_KERNEL_MAX; ++k) {
+        if (tsSetCompressKernel((ECompressKernel)k) != 0) continue;
+
+        const char* name = tsGetCompressKernel((ECompressKernel)k)->name;
+        int32_t     len = fuzzTypes[i].compressFn(pData, bytes, num, pComp, size, ONE_STAGE_COMP, NULL, 0);
+        ASSERT_EQ(len, refLen) << name << " " << tDataTypes[type].name << " mode:" << mode << " num:" << num;
+        ASSERT_EQ(memcmp(pComp, pRef, len), 0) << name << " " << tDataTypes[type].name << " mode:" << mode;
+
+        memset(pOutput, 0, bytes);
+        fuzzTypes[i].decompressFn(pComp, len, num, pOutput, size, ONE_STAGE_COMP, NULL, 0);
+        ASSERT_EQ(memcmp(pOutput, pData, bytes), 0) << name << " " << tDataTypes[type].name << " mode:" << mode;
+      }
+    }
+  }
+
+  tsSetCompressKernel(COMPRESS_KERNEL_SCALAR);
+  taosMemoryFree(pData);
+  taosMemoryFree(pRef);
+  taosMemoryFree(pComp);
+  taosMemoryFree(pOutput);
+}
+
 const char* alg[] = {"disabled", "lz4", "zlib", "zstd", "tsz", "xz"};
 const char* end[] = {"disabled", "simppe8b", "delta", "test", "test"};
 void        compressImplTestByAlg(void* pVal, int8_t type, int32_t num, uint32_t cmprAlg) {
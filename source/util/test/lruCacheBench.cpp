@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Hit ratio and throughput of the lru cache policies under zipfian and scan-mixed workloads, e.g.
+//   lruCacheBench [numOfKeys] [numOfOps] [numOfThreads]
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "os.h"
+#include "tlrucache.h"
+
+typedef struct {
+  const char *name;
+  LRUPolicy   policy;
+} SBenchPolicy;
+
+static SBenchPolicy benchPolicies[] = {
+    {"lru", TAOS_LRU_POLICY_LRU},
+    {"clock", TAOS_LRU_POLICY_CLOCK},
+};
+
+typedef struct {
+  const char *name;
+  int32_t     scanPercent;  // percent of the accesses to cold keys scanned only once
+} SBenchWorkload;
+
+static SBenchWorkload benchWorkloads[] = {
+    {"zipf", 0},
+    {"scan20", 20},
+    {"scan50", 50},
+};
+
+typedef struct {
+  SLRUCache *pCache;
+  int64_t   *pKeys;
+  int32_t    numOfOps;
+  int64_t    hits;
+  TdThread   thread;
+} SBenchThread;
+
+// keys of zipf(0.99) over [0, numOfKeys), and scan keys never seen before beyond numOfKeys
+static void genBenchKeys(int64_t *pKeys, int32_t numOfOps, int32_t numOfKeys, int32_t scanPercent, uint32_t seed) {
+  double *pCdf = (double *)taosMemoryMalloc(sizeof(double) * numOfKeys);
+  double  sum = 0;
+  for (int32_t i = 0; i < numOfKeys; ++i) {
+    sum += 1.0 / pow(i + 1, 0.99);
+    pCdf[i] = sum;
+  }
+
+  int64_t scanKey = numOfKeys + (int64_t)seed * numOfOps;
+  for (int32_t i = 0; i < numOfOps;) {
+    if (taosRandR(&seed) % 100 < scanPercent) {
+      pKeys[i++] = scanKey++;
+      continue;
+    }
+
+    double  r = (double)taosRandR(&seed) / RAND_MAX * sum;
+    int32_t lo = 0, hi = numOfKeys - 1;
+    while (lo < hi) {
+      int32_t mid = (lo + hi) / 2;
+      if (pCdf[mid] < r) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    pKeys[i++] = lo;
+  }
+
+  taosMemoryFree(pCdf);
+}
+
+static void *benchThreadFp(void *param) {
+  SBenchThread *pThread = (SBenchThread *)param;
+
+  for (int32_t i = 0; i < pThread->numOfOps; ++i) {
+    int64_t    key = pThread->pKeys[i];
+    LRUHandle *h = taosLRUCacheLookup(pThread->pCache, &key, sizeof(key));
+    if (h) {
+      pThread->hits++;
+      taosLRUCacheRelease(pThread->pCache, h, false);
+    } else {
+      taosLRUCacheInsert(pThread->pCache, &key, sizeof(key), NULL, 1, NULL, NULL, TAOS_LRU_PRIORITY_LOW, NULL);
+    }
+  }
+
+  return NULL;
+}
+
+int main(int argc, char *argv[]) {
+  int32_t numOfKeys = (argc > 1) ? atoi(argv[1]) : 100000;
+  int32_t numOfOps = (argc > 2) ? atoi(argv[2]) : 2000000;
+  int32_t numOfThreads = (argc > 3) ? atoi(argv[3]) : 4;
+
+  SBenchThread *pThreads = (SBenchThread *)taosMemoryCalloc(numOfThreads, sizeof(SBenchThread));
+  for (int32_t i = 0; i < numOfThreads; ++i) {
+    pThreads[i].pKeys = (int64_t *)taosMemoryMalloc(sizeof(int64_t) * numOfOps);
+    if (pThreads[i].pKeys == NULL) {
+      printf("failed to allocate memory\n");
+      return -1;
+    }
+  }
+
+  // the cache holds 10% of the hot keys
+  size_t capacity = numOfKeys / 10;
+
+  printf("%-10s %-6s %8s %10s %12s %10s\n", "workload", "policy", "threads", "hit(%)", "elapsed(us)", "Mops/s");
+  for (int32_t w = 0; w < sizeof(benchWorkloads) / sizeof(benchWorkloads[0]); ++w) {
+    SBenchWorkload *pWorkload = &benchWorkloads[w];
+    for (int32_t i = 0; i < numOfThreads; ++i) {
+      genBenchKeys(pThreads[i].pKeys, numOfOps, numOfKeys, pWorkload->scanPercent, i + 1);
+    }
+
+    for (int32_t p = 0; p < sizeof(benchPolicies) / sizeof(benchPolicies[0]); ++p) {
+      SBenchPolicy *pPolicy = &benchPolicies[p];
+
+      // one thread for a deterministic hit ratio, then all threads for throughput
+      int32_t runs[] = {1, numOfThreads};
+      for (int32_t r = 0; r < sizeof(runs) / sizeof(runs[0]); ++r) {
+        int32_t    nThreads = runs[r];
+        SLRUCache *pCache = taosLRUCacheInit(capacity, nThreads > 1 ? 4 : 0, 0.5, pPolicy->policy);
+        if (pCache == NULL) {
+          printf("failed to init cache\n");
+          return -1;
+        }
+
+        int64_t st = taosGetTimestampUs();
+        for (int32_t i = 0; i < nThreads; ++i) {
+          pThreads[i].pCache = pCache;
+          pThreads[i].numOfOps = numOfOps;
+          pThreads[i].hits = 0;
+          taosThreadCreate(&pThreads[i].thread, NULL, benchThreadFp, &pThreads[i]);
+        }
+
+        int64_t hits = 0;
+        for (int32_t i = 0; i < nThreads; ++i) {
+          taosThreadJoin(pThreads[i].thread, NULL);
+          hits += pThreads[i].hits;
+        }
+        int64_t el = taosGetTimestampUs() - st;
+
+        int64_t ops = (int64_t)numOfOps * nThreads;
+        printf("%-10s %-6s %8d %10.2f %12" PRId64 " %10.3f\n", pWorkload->name, pPolicy->name, nThreads,
+               100.0 * hits / ops, el, (el > 0) ? (double)ops / el : 0);
+
+        taosLRUCacheCleanup(pCache);
+      }
+    }
+  }
+
+  for (int32_t i = 0; i < numOfThreads; ++i) {
+    taosMemoryFree(pThreads[i].pKeys);
+  }
+  taosMemoryFree(pThreads);
+  return 0;
+}
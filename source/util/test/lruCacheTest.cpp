@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+
+#include "os.h"
+#include "tlrucache.h"
+
+typedef struct {
+  int32_t  magic;
+  int32_t  key;
+  int32_t *freed;
+} SLRUTestValue;
+
+#define LRU_TEST_MAGIC 0x5a5a5a5a
+
+static SLRUTestValue *lruTestValue(int32_t key, int32_t *freed) {
+  SLRUTestValue *pValue = (SLRUTestValue *)taosMemoryMalloc(sizeof(SLRUTestValue));
+  pValue->magic = LRU_TEST_MAGIC;
+  pValue->key = key;
+  pValue->freed = freed;
+  return pValue;
+}
+
+static void lruTestDeleter(const void *key, size_t keyLen, void *value, void *ud) {
+  SLRUTestValue *pValue = (SLRUTestValue *)value;
+  ASSERT_EQ(pValue->magic, LRU_TEST_MAGIC);
+  pValue->magic = 0;
+  (void)atomic_add_fetch_32(pValue->freed, 1);
+  taosMemoryFree(pValue);
+}
+
+static LRUStatus lruTestInsert(SLRUCache *pCache, int32_t key, int32_t *freed, LRUHandle **handle,
+                               LRUPriority priority = TAOS_LRU_PRIORITY_LOW) {
+  return taosLRUCacheInsert(pCache, &key, sizeof(key), lruTestValue(key, freed), 1, lruTestDeleter, handle, priority,
+                            NULL);
+}
+
+static LRUHandle *lruTestLookup(SLRUCache *pCache, int32_t key) { return taosLRUCacheLookup(pCache, &key, sizeof(key)); }
+
+TEST(lruCacheClockTest, refs) {
+  SLRUCache *pCache = taosLRUCacheInit(16, 0, .5, TAOS_LRU_POLICY_CLOCK);
+  ASSERT_NE(pCache, nullptr);
+  int32_t freed = 0;
+
+  // the handle of insert and the ones of lookups are all references of the entry
+  LRUHandle *h0 = NULL;
+  ASSERT_EQ(lruTestInsert(pCache, 1, &freed, &h0), TAOS_LRU_STATUS_OK);
+  ASSERT_NE(h0, nullptr);
+  LRUHandle *h1 = lruTestLookup(pCache, 1);
+  ASSERT_EQ(h1, h0);
+  ASSERT_TRUE(taosLRUCacheRef(pCache, h1));
+  EXPECT_EQ(((SLRUTestValue *)taosLRUCacheValue(pCache, h1))->key, 1);
+  EXPECT_EQ(taosLRUCacheGetUsage(pCache), 1);
+  EXPECT_EQ(taosLRUCacheGetPinnedUsage(pCache), 1);
+
+  EXPECT_FALSE(taosLRUCacheRelease(pCache, h0, false));
+  EXPECT_FALSE(taosLRUCacheRelease(pCache, h1, false));
+  EXPECT_FALSE(taosLRUCacheRelease(pCache, h1, false));
+  EXPECT_EQ(freed, 0);
+  EXPECT_EQ(taosLRUCacheGetElems(pCache), 1);
+  EXPECT_EQ(taosLRUCacheGetPinnedUsage(pCache), 0);
+
+  // an entry erased while referenced is freed on its last release
+  h1 = lruTestLookup(pCache, 1);
+  ASSERT_NE(h1, nullptr);
+  int32_t key = 1;
+  taosLRUCacheErase(pCache, &key, sizeof(key));
+  EXPECT_EQ(lruTestLookup(pCache, 1), nullptr);
+  EXPECT_EQ(taosLRUCacheGetElems(pCache), 0);
+  EXPECT_EQ(taosLRUCacheGetUsage(pCache), 0);
+  EXPECT_EQ(freed, 0);
+  EXPECT_EQ(((SLRUTestValue *)taosLRUCacheValue(pCache, h1))->key, 1);
+  EXPECT_TRUE(taosLRUCacheRelease(pCache, h1, false));
+  EXPECT_EQ(freed, 1);
+
+  // an entry not referenced is freed on erase
+  ASSERT_EQ(lruTestInsert(pCache, 2, &freed, NULL), TAOS_LRU_STATUS_OK);
+  key = 2;
+  taosLRUCacheErase(pCache, &key, sizeof(key));
+  EXPECT_EQ(freed, 2);
+
+  // an entry overwritten while referenced is freed on its last release
+  ASSERT_EQ(lruTestInsert(pCache, 3, &freed, &h0), TAOS_LRU_STATUS_OK);
+  ASSERT_EQ(lruTestInsert(pCache, 3, &freed, &h1), TAOS_LRU_STATUS_OK_OVERWRITTEN);
+  ASSERT_NE(h0, h1);
+  EXPECT_EQ(taosLRUCacheGetElems(pCache), 1);
+  EXPECT_EQ(taosLRUCacheGetUsage(pCache), 1);
+  EXPECT_TRUE(taosLRUCacheRelease(pCache, h0, false));
+  EXPECT_EQ(freed, 3);
+
+  // the last release with eraseIfLastRef takes the entry out of the cache
+  LRUHandle *h2 = lruTestLookup(pCache, 3);
+  ASSERT_EQ(h2, h1);
+  EXPECT_FALSE(taosLRUCacheRelease(pCache, h1, true));
+  EXPECT_EQ(taosLRUCacheGetElems(pCache), 1);
+  EXPECT_TRUE(taosLRUCacheRelease(pCache, h2, true));
+  EXPECT_EQ(taosLRUCacheGetElems(pCache), 0);
+  EXPECT_EQ(freed, 4);
+
+  // the entries left in the cache are freed on cleanup
+  ASSERT_EQ(lruTestInsert(pCache, 4, &freed, NULL), TAOS_LRU_STATUS_OK);
+  taosLRUCacheCleanup(pCache);
+  EXPECT_EQ(freed, 5);
+}
+
+TEST(lruCacheClockTest, rejectedInsert) {
+  const int32_t capacity = 8;
+  SLRUCache    *pCache = taosLRUCacheInit(capacity, 0, .5, TAOS_LRU_POLICY_CLOCK);
+  ASSERT_NE(pCache, nullptr);
+  int32_t freed = 0;
+
+  // the entries in the cache are looked up, so that they are estimated more frequent than a new key
+  for (int32_t key = 0; key < capacity; ++key) {
+    ASSERT_EQ(lruTestInsert(pCache, key, &freed, NULL), TAOS_LRU_STATUS_OK);
+  }
+  for (int32_t i = 0; i < 3; ++i) {
+    for (int32_t key = 0; key < capacity; ++key) {
+      LRUHandle *h = lruTestLookup(pCache, key);
+      ASSERT_NE(h, nullptr);
+      (void)taosLRUCacheRelease(pCache, h, false);
+    }
+  }
+  EXPECT_EQ(taosLRUCacheGetElems(pCache), capacity);
+
+  // the new key is not admitted, and a detached handle of it is returned
+  LRUHandle *h = NULL;
+  ASSERT_EQ(lruTestInsert(pCache, 100, &freed, &h), TAOS_LRU_STATUS_OK);
+  ASSERT_NE(h, nullptr);
+  EXPECT_EQ(((SLRUTestValue *)taosLRUCacheValue(pCache, h))->key, 100);
+  EXPECT_EQ(lruTestLookup(pCache, 100), nullptr);
+  EXPECT_EQ(taosLRUCacheGetElems(pCache), capacity);
+  EXPECT_EQ(taosLRUCacheGetUsage(pCache), capacity);
+  EXPECT_EQ(freed, 0);
+
+  // the detached handle can be referenced, and is freed on its last release
+  ASSERT_TRUE(taosLRUCacheRef(pCache, h));
+  EXPECT_FALSE(taosLRUCacheRelease(pCache, h, false));
+  EXPECT_EQ(freed, 0);
+  EXPECT_TRUE(taosLRUCacheRelease(pCache, h, true));
+  EXPECT_EQ(freed, 1);
+  EXPECT_EQ(taosLRUCacheGetElems(pCache), capacity);
+
+  // without a handle, the rejected entry is freed at once
+  ASSERT_EQ(lruTestInsert(pCache, 101, &freed, NULL), TAOS_LRU_STATUS_OK);
+  EXPECT_EQ(freed, 2);
+  EXPECT_EQ(lruTestLookup(pCache, 101), nullptr);
+
+  // a high priority entry is always admitted, and takes the place of an entry evicted
+  ASSERT_EQ(lruTestInsert(pCache, 102, &freed, &h, TAOS_LRU_PRIORITY_HIGH), TAOS_LRU_STATUS_OK);
+  EXPECT_EQ(freed, 3);
+  EXPECT_EQ(taosLRUCacheGetElems(pCache), capacity);
+  LRUHandle *h1 = lruTestLookup(pCache, 102);
+  EXPECT_EQ(h1, h);
+  (void)taosLRUCacheRelease(pCache, h1, false);
+  EXPECT_FALSE(taosLRUCacheRelease(pCache, h, false));
+
+  taosLRUCacheCleanup(pCache);
+  EXPECT_EQ(freed, capacity + 3);
+}
+
+typedef struct {
+  SLRUCache *pCache;
+  int32_t    key;
+  int32_t    numOfOps;
+  int32_t    numOfHits;
+  TdThread   thread;
+} SLRUTestReader;
+
+static void *lruTestReaderFp(void *param) {
+  SLRUTestReader *pReader = (SLRUTestReader *)param;
+
+  for (int32_t i = 0; i < pReader->numOfOps; ++i) {
+    LRUHandle *h = lruTestLookup(pReader->pCache, pReader->key);
+    if (h == NULL) continue;
+
+    // the value is not freed as long as the handle is held
+    SLRUTestValue *pValue = (SLRUTestValue *)taosLRUCacheValue(pReader->pCache, h);
+    EXPECT_EQ(pValue->magic, LRU_TEST_MAGIC);
+    EXPECT_EQ(pValue->key, pReader->key);
+    pReader->numOfHits++;
+    (void)taosLRUCacheRelease(pReader->pCache, h, (i % 4) == 0);
+  }
+
+  return NULL;
+}
+
+// the readers look up the key erased and inserted again and again, so that the last reference is dropped by either
+// the eraser or a reader
+TEST(lruCacheClockTest, concurrentLookupErase) {
+  SLRUCache *pCache = taosLRUCacheInit(1024, 0, .5, TAOS_LRU_POLICY_CLOCK);
+  ASSERT_NE(pCache, nullptr);
+
+  const int32_t  numOfReaders = 4;
+  const int32_t  numOfInserts = 20000;
+  int32_t        key = 7;
+  int32_t        freed = 0;
+  SLRUTestReader readers[numOfReaders] = {0};
+  for (int32_t i = 0; i < numOfReaders; ++i) {
+    readers[i].pCache = pCache;
+    readers[i].key = key;
+    readers[i].numOfOps = numOfInserts * 2;
+    ASSERT_EQ(taosThreadCreate(&readers[i].thread, NULL, lruTestReaderFp, &readers[i]), 0);
+  }
+
+  int32_t numOfInserted = 0;
+  for (int32_t i = 0; i < numOfInserts; ++i) {
+    LRUStatus status = lruTestInsert(pCache, key, &freed, NULL, TAOS_LRU_PRIORITY_HIGH);
+    ASSERT_TRUE(status == TAOS_LRU_STATUS_OK || status == TAOS_LRU_STATUS_OK_OVERWRITTEN);
+    numOfInserted++;
+    if (i % 64 == 0) sched_yield();
+    taosLRUCacheErase(pCache, &key, sizeof(key));
+  }
+
+  for (int32_t i = 0; i < numOfReaders; ++i) {
+    taosThreadJoin(readers[i].thread, NULL);
+  }
+
+  EXPECT_EQ(taosLRUCacheGetElems(pCache), 0);
+  EXPECT_EQ(taosLRUCacheGetUsage(pCache), 0);
+  EXPECT_EQ(taosLRUCacheGetPinnedUsage(pCache), 0);
+  EXPECT_EQ(atomic_load_32(&freed), numOfInserted);
+
+  taosLRUCacheCleanup(pCache);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <cassert>
 #include <iostream>
+#include <vector>
 
 #include "taos.h"
 #include "tpagedbuf.h"
@@ -220,8 +221,98 @@ void testFlushAndReadBackBuffer() {
   taosMemoryFree(rowData);
 }
 
+void fillSpillPage(SFilePage* pPg, int32_t pageId, int32_t version, int32_t pageSize) {
+  int32_t* p = (int32_t*)pPg->data;
+  for (int32_t i = 0; i < pageSize / sizeof(int32_t); ++i) {
+    p[i] = (i % 16 == 0) ? pageId * 1000 + version : i / 64;  // compressible
+  }
+  pPg->num = pageId;
+}
+
+bool checkSpillPage(SFilePage* pPg, int32_t pageId, int32_t version, int32_t pageSize) {
+  int32_t* p = (int32_t*)pPg->data;
+  for (int32_t i = 0; i < pageSize / sizeof(int32_t); ++i) {
+    if (p[i] != ((i % 16 == 0) ? pageId * 1000 + version : i / 64)) {
+      return false;
+    }
+  }
+  return pPg->num == pageId;
+}
+
+// spill far more pages than the in-memory pages, and read them back both in order and at random
+void spillPageTest(EPageCodec codec, int32_t maxIoPages) {
+  SDiskbasedBuf* pBuf = NULL;
+  int32_t        pageSize = 4096;
+  int32_t        numOfPages = 64;
+  ASSERT_EQ(createDiskbasedBuf(&pBuf, pageSize, pageSize * 4, "spill", TD_TMP_DIR_PATH), 0);
+  dBufSetPageCodec(pBuf, codec);
+  ASSERT_EQ(dBufSetWriteBehind(pBuf, maxIoPages), 0);
+
+  std::vector<int32_t> versions(numOfPages, 0);
+  for (int32_t i = 0; i < numOfPages; ++i) {
+    int32_t pageId = -1;
+    auto*   pPg = (SFilePage*)getNewBufPage(pBuf, &pageId);
+    ASSERT_TRUE(pPg != nullptr);
+    ASSERT_EQ(pageId, i);
+    fillSpillPage(pPg, pageId, 0, pageSize);
+    setBufPageDirty(pPg, true);
+    releaseBufPage(pBuf, pPg);
+  }
+
+  // sequential scan with read-ahead of the next page
+  for (int32_t i = 0; i < numOfPages; ++i) {
+    if (i + 1 < numOfPages) {
+      dBufPrefetchPage(pBuf, i + 1);
+    }
+    auto* pPg = (SFilePage*)getBufPage(pBuf, i);
+    ASSERT_TRUE(pPg != nullptr);
+    ASSERT_TRUE(checkSpillPage(pPg, i, versions[i], pageSize)) << "page:" << i;
+    releaseBufPage(pBuf, pPg);
+  }
+
+  // modify and read back at random, some of the pages are still in flight
+  for (int32_t loop = 0; loop < numOfPages * 4; ++loop) {
+    int32_t id = taosRand() % numOfPages;
+    dBufPrefetchPage(pBuf, taosRand() % numOfPages);
+
+    auto* pPg = (SFilePage*)getBufPage(pBuf, id);
+    ASSERT_TRUE(pPg != nullptr);
+    ASSERT_TRUE(checkSpillPage(pPg, id, versions[id], pageSize)) << "page:" << id;
+    if (loop % 3 == 0) {
+      versions[id] += 1;
+      fillSpillPage(pPg, id, versions[id], pageSize);
+      setBufPageDirty(pPg, true);
+    }
+    releaseBufPage(pBuf, pPg);
+  }
+
+  SDiskbasedBufStatis statis = getDBufStatis(pBuf);
+  ASSERT_GT(statis.flushPages, numOfPages - 4);
+  if (codec != PAGE_CODEC_NONE) {
+    ASSERT_LT(statis.flushBytes, (int64_t)statis.flushPages * pageSize);
+  }
+
+  destroyDiskbasedBuf(pBuf);
+}
+
 }  // namespace
 
+TEST(testCase, spillPageTest) {
+  taosSeedRand(taosGetTimestampSec());
+  spillPageTest(PAGE_CODEC_NONE, 0);
+  spillPageTest(PAGE_CODEC_LZ4, 0);
+  spillPageTest(PAGE_CODEC_ZSTD, 0);
+
+  // write-behind falls back to the synchronous io before the io threads are started
+  spillPageTest(PAGE_CODEC_LZ4, 8);
+
+  ASSERT_EQ(dBufIoPoolInit(), 0);
+  spillPageTest(PAGE_CODEC_NONE, 4);
+  spillPageTest(PAGE_CODEC_LZ4, 8);
+  spillPageTest(PAGE_CODEC_ZSTD, 1);
+  dBufIoPoolCleanup();
+}
+
 TEST(testCase, resultBufferTest) {
   taosSeedRand(taosGetTimestampSec());
   simpleTest();
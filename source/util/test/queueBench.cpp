@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Throughput and wake-up latency of the queue set across producer and consumer counts, e.g.
+//   queueBench [numOfOps] [numOfThreads] [intervalUs]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "os.h"
+#include "tqueue.h"
+
+typedef struct {
+  STaosQset  *qset;
+  STaosQueue *queue;
+  int32_t     numOfOps;
+  int32_t     batchSize;  // 0 for one item per read
+  int32_t     intervalUs;
+  int64_t     numOfItems;
+  int64_t     latency;
+  int64_t     maxLatency;
+  TdThread    thread;
+} SBenchThread;
+
+static int64_t benchConsumed = 0;
+
+static void *benchProducerFp(void *param) {
+  SBenchThread *pThread = (SBenchThread *)param;
+
+  for (int32_t i = 0; i < pThread->numOfOps; ++i) {
+    int64_t *pItem = (int64_t *)taosAllocateQitem(sizeof(int64_t), DEF_QITEM, 0);
+    *pItem = i;
+    (void)taosWriteQitem(pThread->queue, pItem);
+    if (pThread->intervalUs > 0) taosUsleep(pThread->intervalUs);
+  }
+
+  return NULL;
+}
+
+static void benchConsumeItem(SBenchThread *pThread, void *pItem, int64_t timestamp) {
+  int64_t latency = taosGetTimestampUs() - timestamp;
+  pThread->latency += latency;
+  if (latency > pThread->maxLatency) pThread->maxLatency = latency;
+  pThread->numOfItems++;
+  taosFreeQitem(pItem);
+}
+
+static void *benchConsumerFp(void *param) {
+  SBenchThread *pThread = (SBenchThread *)param;
+  STaosQall    *qall = taosAllocateQall();
+  SQueueInfo    qinfo = {0};
+  void         *pItem = NULL;
+
+  while (1) {
+    if (pThread->batchSize == 0) {
+      if (taosReadQitemFromQset(pThread->qset, &pItem, &qinfo) == 0) break;
+      benchConsumeItem(pThread, pItem, qinfo.timestamp);
+      taosUpdateItemSize((STaosQueue *)qinfo.queue, 1);
+      (void)atomic_add_fetch_64(&benchConsumed, 1);
+    } else {
+      int32_t num = taosReadQitemsFromQset(pThread->qset, qall, pThread->batchSize, &qinfo);
+      if (num == 0) break;
+      for (int32_t i = 0; i < num; ++i) {
+        (void)taosGetQitem(qall, &pItem);
+        benchConsumeItem(pThread, pItem, ((STaosQnode *)((char *)pItem - sizeof(STaosQnode)))->timestamp);
+      }
+      taosUpdateItemSize((STaosQueue *)qinfo.queue, num);
+      (void)atomic_add_fetch_64(&benchConsumed, num);
+    }
+  }
+
+  taosFreeQall(qall);
+  return NULL;
+}
+
+static void runBench(const char *name, int32_t numOfProducers, int32_t numOfConsumers, int32_t numOfOps,
+                     int32_t batchSize, int32_t intervalUs) {
+  SBenchThread *pProducers = (SBenchThread *)taosMemoryCalloc(numOfProducers, sizeof(SBenchThread));
+  SBenchThread *pConsumers = (SBenchThread *)taosMemoryCalloc(numOfConsumers, sizeof(SBenchThread));
+  STaosQset    *qset = taosOpenQset();
+
+  for (int32_t i = 0; i < numOfProducers; ++i) {
+    pProducers[i].queue = taosOpenQueue();
+    pProducers[i].numOfOps = numOfOps / numOfProducers;
+    pProducers[i].intervalUs = intervalUs;
+    (void)taosAddIntoQset(qset, pProducers[i].queue, NULL);
+  }
+
+  atomic_store_64(&benchConsumed, 0);
+  int64_t st = taosGetTimestampUs();
+  for (int32_t i = 0; i < numOfConsumers; ++i) {
+    pConsumers[i].qset = qset;
+    pConsumers[i].batchSize = batchSize;
+    taosThreadCreate(&pConsumers[i].thread, NULL, benchConsumerFp, &pConsumers[i]);
+  }
+  for (int32_t i = 0; i < numOfProducers; ++i) {
+    taosThreadCreate(&pProducers[i].thread, NULL, benchProducerFp, &pProducers[i]);
+  }
+
+  int64_t total = 0;
+  for (int32_t i = 0; i < numOfProducers; ++i) {
+    taosThreadJoin(pProducers[i].thread, NULL);
+    total += pProducers[i].numOfOps;
+  }
+  while (atomic_load_64(&benchConsumed) < total) {
+    taosUsleep(10);
+  }
+  int64_t el = taosGetTimestampUs() - st;
+
+  for (int32_t i = 0; i < numOfConsumers; ++i) {
+    taosQsetThreadResume(qset);
+  }
+
+  int64_t latency = 0, maxLatency = 0;
+  for (int32_t i = 0; i < numOfConsumers; ++i) {
+    taosThreadJoin(pConsumers[i].thread, NULL);
+    latency += pConsumers[i].latency;
+    if (pConsumers[i].maxLatency > maxLatency) maxLatency = pConsumers[i].maxLatency;
+  }
+
+  printf("%-8s %9d %9d %6d %12" PRId64 " %10.3f %12.1f %12" PRId64 "\n", name, numOfProducers, numOfConsumers,
+         batchSize, el, (el > 0) ? (double)total / el : 0, (total > 0) ? (double)latency / total : 0, maxLatency);
+
+  for (int32_t i = 0; i < numOfProducers; ++i) {
+    taosCloseQueue(pProducers[i].queue);
+  }
+  taosCloseQset(qset);
+  taosMemoryFree(pProducers);
+  taosMemoryFree(pConsumers);
+}
+
+int main(int argc, char *argv[]) {
+  int32_t numOfOps = (argc > 1) ? atoi(argv[1]) : 2000000;
+  int32_t numOfThreads = (argc > 2) ? atoi(argv[2]) : 4;
+  int32_t intervalUs = (argc > 3) ? atoi(argv[3]) : 100;
+
+  taosGetSystemInfo();
+
+  printf("%-8s %9s %9s %6s %12s %10s %12s %12s\n", "mode", "producers", "consumers", "batch", "elapsed(us)", "Mops/s",
+         "avgWait(us)", "maxWait(us)");
+
+  int32_t counts[] = {1, numOfThreads};
+  for (int32_t p = 0; p < sizeof(counts) / sizeof(counts[0]); ++p) {
+    for (int32_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+      runBench("flood", counts[p], counts[c], numOfOps, 0, 0);
+      runBench("flood", counts[p], counts[c], numOfOps, 8, 0);
+    }
+  }
+
+  // items are written one by one with an interval, so that consumers go to sleep and wake up for each of them
+  int32_t numOfPaced = TMIN(numOfOps, 10000);
+  for (int32_t c = 0; c < sizeof(counts) / sizeof(counts[0]); ++c) {
+    runBench("paced", 1, counts[c], numOfPaced, 0, intervalUs);
+  }
+
+  return 0;
+}
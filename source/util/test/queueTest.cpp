@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "os.h"
+#include "tqueue.h"
+
+typedef struct {
+  int32_t producer;
+  int32_t seq;
+} SQueueTestItem;
+
+typedef struct {
+  STaosQueue *queue;
+  int32_t     producer;
+  int32_t     numOfItems;
+  TdThread    thread;
+} SQueueTestProducer;
+
+typedef struct {
+  STaosQset *qset;
+  int32_t    batchSize;  // 0 for one item per read
+  int32_t    numOfProducers;
+  int32_t   *lastSeq;    // the last seq of each producer read by this consumer
+  int32_t   *counts;     // the items of each producer read by this consumer
+  int32_t    numOfDisorders;
+  TdThread   thread;
+} SQueueTestConsumer;
+
+static void *queueTestProducerFp(void *param) {
+  SQueueTestProducer *pProducer = (SQueueTestProducer *)param;
+
+  for (int32_t i = 0; i < pProducer->numOfItems; ++i) {
+    SQueueTestItem *pItem = (SQueueTestItem *)taosAllocateQitem(sizeof(SQueueTestItem), DEF_QITEM, 0);
+    pItem->producer = pProducer->producer;
+    pItem->seq = i;
+    while (taosWriteQitem(pProducer->queue, pItem) != 0) {
+      taosUsleep(1);
+    }
+    if (i % 1024 == 0) sched_yield();
+  }
+
+  return NULL;
+}
+
+static void queueTestConsumeItem(SQueueTestConsumer *pConsumer, SQueueTestItem *pItem) {
+  if (pItem->seq <= pConsumer->lastSeq[pItem->producer]) {
+    pConsumer->numOfDisorders++;
+  }
+  pConsumer->lastSeq[pItem->producer] = pItem->seq;
+  pConsumer->counts[pItem->producer]++;
+  taosFreeQitem(pItem);
+}
+
+// a consumer pops the items of a queue in the order they are written, so that the items of each producer it reads
+// are in order, even if the other consumers read some of them in between
+static void *queueTestConsumerFp(void *param) {
+  SQueueTestConsumer *pConsumer = (SQueueTestConsumer *)param;
+  STaosQall          *qall = taosAllocateQall();
+  SQueueInfo          qinfo = {0};
+  void               *pItem = NULL;
+
+  while (1) {
+    if (pConsumer->batchSize == 0) {
+      if (taosReadQitemFromQset(pConsumer->qset, &pItem, &qinfo) == 0) break;
+      queueTestConsumeItem(pConsumer, (SQueueTestItem *)pItem);
+      taosUpdateItemSize((STaosQueue *)qinfo.queue, 1);
+    } else {
+      int32_t num = taosReadQitemsFromQset(pConsumer->qset, qall, pConsumer->batchSize, &qinfo);
+      if (num == 0) break;
+      for (int32_t i = 0; i < num; ++i) {
+        (void)taosGetQitem(qall, &pItem);
+        queueTestConsumeItem(pConsumer, (SQueueTestItem *)pItem);
+      }
+      taosUpdateItemSize((STaosQueue *)qinfo.queue, num);
+    }
+  }
+
+  taosFreeQall(qall);
+  return NULL;
+}
+
+// The producers share the queues in pairs. The consumers are asked to exit once the producers are done, and they read
+// all the items left before exiting.
+static void runQueueTest(int32_t numOfQueues, int32_t numOfProducers, int32_t numOfConsumers, int32_t batchSize,
+                         int32_t numOfItems) {
+  STaosQset   *qset = taosOpenQset();
+  STaosQueue **queues = (STaosQueue **)taosMemoryCalloc(numOfQueues, sizeof(STaosQueue *));
+  for (int32_t i = 0; i < numOfQueues; ++i) {
+    queues[i] = taosOpenQueue();
+    ASSERT_EQ(taosAddIntoQset(qset, queues[i], NULL), 0);
+  }
+
+  SQueueTestConsumer *pConsumers = (SQueueTestConsumer *)taosMemoryCalloc(numOfConsumers, sizeof(SQueueTestConsumer));
+  for (int32_t i = 0; i < numOfConsumers; ++i) {
+    pConsumers[i].qset = qset;
+    pConsumers[i].batchSize = batchSize;
+    pConsumers[i].numOfProducers = numOfProducers;
+    pConsumers[i].lastSeq = (int32_t *)taosMemoryMalloc(numOfProducers * sizeof(int32_t));
+    pConsumers[i].counts = (int32_t *)taosMemoryCalloc(numOfProducers, sizeof(int32_t));
+    for (int32_t p = 0; p < numOfProducers; ++p) {
+      pConsumers[i].lastSeq[p] = -1;
+    }
+    ASSERT_EQ(taosThreadCreate(&pConsumers[i].thread, NULL, queueTestConsumerFp, &pConsumers[i]), 0);
+  }
+
+  SQueueTestProducer *pProducers = (SQueueTestProducer *)taosMemoryCalloc(numOfProducers, sizeof(SQueueTestProducer));
+  for (int32_t i = 0; i < numOfProducers; ++i) {
+    pProducers[i].queue = queues[(i / 2) % numOfQueues];
+    pProducers[i].producer = i;
+    pProducers[i].numOfItems = numOfItems;
+    ASSERT_EQ(taosThreadCreate(&pProducers[i].thread, NULL, queueTestProducerFp, &pProducers[i]), 0);
+  }
+
+  for (int32_t i = 0; i < numOfProducers; ++i) {
+    taosThreadJoin(pProducers[i].thread, NULL);
+  }
+  for (int32_t i = 0; i < numOfConsumers; ++i) {
+    taosQsetThreadResume(qset);
+  }
+  for (int32_t i = 0; i < numOfConsumers; ++i) {
+    taosThreadJoin(pConsumers[i].thread, NULL);
+  }
+
+  for (int32_t p = 0; p < numOfProducers; ++p) {
+    int32_t total = 0;
+    for (int32_t i = 0; i < numOfConsumers; ++i) {
+      total += pConsumers[i].counts[p];
+    }
+    EXPECT_EQ(total, numOfItems) << "producer:" << p;
+  }
+  for (int32_t i = 0; i < numOfConsumers; ++i) {
+    EXPECT_EQ(pConsumers[i].numOfDisorders, 0) << "consumer:" << i;
+    // with one consumer all the items of a producer are read, so the last one read is the last one written
+    if (numOfConsumers == 1) {
+      for (int32_t p = 0; p < numOfProducers; ++p) {
+        EXPECT_EQ(pConsumers[i].lastSeq[p], numOfItems - 1);
+      }
+    }
+    taosMemoryFree(pConsumers[i].lastSeq);
+    taosMemoryFree(pConsumers[i].counts);
+  }
+  for (int32_t i = 0; i < numOfQueues; ++i) {
+    EXPECT_EQ(taosQueueItemSize(queues[i]), 0);
+    taosCloseQueue(queues[i]);
+  }
+
+  taosCloseQset(qset);
+  taosMemoryFree(queues);
+  taosMemoryFree(pProducers);
+  taosMemoryFree(pConsumers);
+}
+
+TEST(queueTest, oneConsumerBatch) { runQueueTest(4, 8, 1, 8, 50000); }
+
+TEST(queueTest, multiConsumerBatch) { runQueueTest(4, 8, 4, 8, 50000); }
+
+TEST(queueTest, multiConsumerLargeBatch) { runQueueTest(2, 4, 4, 1024, 50000); }
+
+TEST(queueTest, multiConsumerSingle) { runQueueTest(4, 8, 4, 0, 20000); }
+
+TEST(queueTest, budget) {
+  int64_t       itemSize = sizeof(SQueueTestItem);
+  STaosQbudget *budget = taosOpenQbudget(itemSize * 2);
+  STaosQueue   *queue1 = taosOpenQueue();
+  STaosQueue   *queue2 = taosOpenQueue();
+  ASSERT_NE(budget, nullptr);
+  ASSERT_NE(queue1, nullptr);
+  ASSERT_NE(queue2, nullptr);
+  taosSetQueueBudget(queue1, budget);
+  taosSetQueueBudget(queue2, budget);
+
+  // the items written in budget share the memory of the budget
+  void *pItem1 = taosAllocateQitem(sizeof(SQueueTestItem), DEF_QITEM, 0);
+  void *pItem2 = taosAllocateQitem(sizeof(SQueueTestItem), DEF_QITEM, 0);
+  void *pItem3 = taosAllocateQitem(sizeof(SQueueTestItem), DEF_QITEM, 0);
+  EXPECT_EQ(taosWriteQitemInBudget(queue1, pItem1), 0);
+  EXPECT_EQ(taosWriteQitemInBudget(queue2, pItem2), 0);
+  EXPECT_EQ(taosQbudgetMemorySize(budget), itemSize * 2);
+  EXPECT_EQ(taosWriteQitemInBudget(queue1, pItem3), TSDB_CODE_OUT_OF_RPC_MEMORY_QUEUE);
+  EXPECT_EQ(taosQbudgetMemorySize(budget), itemSize * 2);
+
+  // the other items are not charged to the budget, so they are never rejected by it
+  EXPECT_EQ(taosWriteQitem(queue1, pItem3), 0);
+  EXPECT_EQ(taosQbudgetMemorySize(budget), itemSize * 2);
+  EXPECT_EQ(taosQueueMemorySize(queue1), itemSize * 2);
+
+  // reading the items releases only the memory they are charged
+  void *pItem = NULL;
+  EXPECT_EQ(taosReadQitem(queue1, &pItem), 1);
+  EXPECT_EQ(pItem, pItem1);
+  taosFreeQitem(pItem);
+  EXPECT_EQ(taosQbudgetMemorySize(budget), itemSize);
+  EXPECT_EQ(taosReadQitem(queue1, &pItem), 1);
+  EXPECT_EQ(pItem, pItem3);
+  taosFreeQitem(pItem);
+  EXPECT_EQ(taosQbudgetMemorySize(budget), itemSize);
+
+  // closing a queue releases the memory of the items left in it
+  taosCloseQueue(queue2);
+  EXPECT_EQ(taosQbudgetMemorySize(budget), 0);
+
+  taosCloseQueue(queue1);
+  taosCloseQbudget(budget);
+}
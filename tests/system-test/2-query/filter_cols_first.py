@@ -0,0 +1,169 @@
+###################################################################
+#           Copyright (c) 2016 by TAOS Technologies, Inc.
+#                     All rights reserved.
+#
+#  This file is proprietary and confidential to TAOS Technologies.
+#  No part of this file may be reproduced, stored, transmitted,
+#  disclosed or used in any form or by any means other than as
+#  expressly provided by the written permission from Jianhui Tao
+#
+###################################################################
+
+# -*- coding: utf-8 -*-
+
+# The table scan loads the columns of the filter of a file block first, and loads the rest columns only if some rows
+# of the block qualify. The results of the queries that go this way are checked against the generated rows, and
+# against the same queries with a filter on all the columns, which load the whole block at once.
+
+import glob
+import hashlib
+import os
+
+from util.log import *
+from util.cases import *
+from util.sql import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor(), logSql)
+        self.conn = conn
+
+        self.dbname = "db_filter_cols"
+        self.ts = 1700000000000
+        self.rowsPerBlock = 4096
+        self.numOfBlocks = 3
+        self.rowNum = self.rowsPerBlock * self.numOfBlocks
+
+        selfPath = os.path.dirname(os.path.realpath(__file__))
+        if ("community" in selfPath):
+            projPath = selfPath[:selfPath.find("community")]
+        else:
+            projPath = selfPath[:selfPath.find("tests")]
+        self.projDir = f"{projPath}sim/"
+
+    # a random like string, so that the c2 column takes the most of the data file even if compressed
+    def c2Value(self, i):
+        return "".join(hashlib.md5(f"{i}-{j}".encode()).hexdigest() for j in range(8))
+
+    def insertData(self):
+        tdSql.execute(f"create database {self.dbname} vgroups 1 stt_trigger 1 minrows 100 maxrows {self.rowsPerBlock}")
+        tdSql.execute(f"create table {self.dbname}.t1 (ts timestamp, c1 int, c2 binary(256), c3 double)")
+
+        batch = 200
+        for start in range(0, self.rowNum, batch):
+            values = "".join(f"({self.ts + i}, {i}, '{self.c2Value(i)}', {i * 0.5})"
+                             for i in range(start, min(start + batch, self.rowNum)))
+            tdSql.execute(f"insert into {self.dbname}.t1 values {values}")
+
+        # the rows are written into the data file as blocks of maxrows
+        tdSql.execute(f"flush database {self.dbname}")
+
+    def checkResult(self, sql, expected):
+        tdSql.query(sql)
+        tdSql.checkRows(len(expected))
+        for row, (res, exp) in enumerate(zip(tdSql.queryResult, expected)):
+            if list(res[1:]) != list(exp):
+                tdLog.exit(f"sql:{sql} row:{row} result:{res} expected:{exp}")
+
+    # the filter on c1 only loads c1 first, and the filter on all the columns loads the block at once
+    def checkFilter(self, cond, pred):
+        expected = [(i, self.c2Value(i), i * 0.5) for i in range(self.rowNum) if pred(i)]
+        self.checkResult(f"select ts, c1, c2, c3 from {self.dbname}.t1 where {cond} order by ts", expected)
+        self.checkResult(f"select ts, c1, c2, c3 from {self.dbname}.t1 where {cond} "
+                         f"and (c2 is null or c2 is not null) and (c3 is null or c3 is not null) order by ts", expected)
+
+    def checkFilteredBlocks(self):
+        # no rows of any block qualify, so that the rest columns are never loaded
+        self.checkFilter("c1 % 7 = 100", lambda i: False)
+
+        # the rows of the first two blocks are all filtered out, and some of the last one qualify
+        first = self.rowsPerBlock * 2 + 10
+        self.checkFilter(f"c1 + 0 >= {first}", lambda i: i >= first)
+
+        # some rows of each block qualify, and the rest columns of them are appended to the filter columns
+        self.checkFilter("c1 % 97 = 3", lambda i: i % 97 == 3)
+        self.checkFilter("c1 % 2 = 0", lambda i: i % 2 == 0)
+
+        # all the rows qualify
+        self.checkFilter("c1 >= 0", lambda i: True)
+
+        tdSql.query(f"select count(*), sum(c3) from {self.dbname}.t1 where c1 % 97 = 3")
+        tdSql.checkData(0, 0, len([i for i in range(self.rowNum) if i % 97 == 3]))
+
+    def checkMissingColumns(self):
+        # c4 is not in the file blocks, so that it is filled by null for the rows of them
+        tdSql.execute(f"alter table {self.dbname}.t1 add column c4 int")
+        tdSql.execute(f"insert into {self.dbname}.t1 values ({self.ts + self.rowNum}, 3, 'x', 1.5, 10)")
+
+        tdSql.query(f"select ts, c4, c2 from {self.dbname}.t1 where c1 % 97 = 3 order by ts")
+        expected = [i for i in range(self.rowNum) if i % 97 == 3]
+        tdSql.checkRows(len(expected) + 1)
+        for row, i in enumerate(expected):
+            tdSql.checkData(row, 1, None)
+            tdSql.checkData(row, 2, self.c2Value(i))
+        tdSql.checkData(len(expected), 1, 10)
+        tdSql.checkData(len(expected), 2, 'x')
+
+        tdSql.query(f"select count(c4), count(c2) from {self.dbname}.t1 where c1 % 97 = 3")
+        tdSql.checkData(0, 0, 1)
+        tdSql.checkData(0, 1, len(expected) + 1)
+
+    def queryError(self, sql):
+        cursor = self.conn.cursor()
+        try:
+            cursor.execute(sql)
+            cursor.fetchall()
+        except BaseException as e:
+            tdLog.info(f"sql:{sql} err:{e}")
+            return
+        finally:
+            cursor.close()
+        tdLog.exit(f"sql:{sql} expect error not occured")
+
+    def dataFile(self):
+        tdSql.query(f"show {self.dbname}.vgroups")
+        vgId = tdSql.queryResult[0][0]
+        files = glob.glob(f"{self.projDir}dnode*/data/vnode/vnode{vgId}/tsdb/*.data")
+        if len(files) == 0:
+            tdLog.exit(f"no data file of vnode{vgId}")
+        return max(files, key=os.path.getsize)
+
+    def checkRestColumnsError(self):
+        # the c2 of the second block takes the middle of the data file, so that the filter columns of the blocks are
+        # loaded and the error only comes up when the rest columns are loaded
+        fname = self.dataFile()
+        size = os.path.getsize(fname)
+        tdLog.info(f"corrupt {fname} size:{size}")
+        with open(fname, "r+b") as f:
+            f.seek(size // 2)
+            data = bytearray(f.read(64))
+            f.seek(size // 2)
+            f.write(bytes(b ^ 0xff for b in data))
+
+        # the reader is released on the error, otherwise the query would hang on closing the reader
+        for _ in range(3):
+            self.queryError(f"select ts, c2 from {self.dbname}.t1 where c1 % 97 = 3")
+
+        # the filter columns are fine, and so are the queries that do not load the broken column
+        tdSql.query(f"select count(*) from {self.dbname}.t1 where c1 % 97 = 3")
+        tdSql.checkData(0, 0, len([i for i in range(self.rowNum) if i % 97 == 3]) + 1)
+        tdSql.query(f"select c1 from {self.dbname}.t1 where c1 + 0 >= {self.rowNum - 10}")
+        tdSql.checkRows(10)
+
+    def run(self):
+        self.insertData()
+        self.checkFilteredBlocks()
+        self.checkMissingColumns()
+        self.checkRestColumnsError()
+
+    def stop(self):
+        tdSql.execute(f"drop database if exists {self.dbname}")
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addLinux(__file__, TDTestCase())
+tdCases.addWindows(__file__, TDTestCase())